@@ -8,6 +8,7 @@
 #include "CubismFramework.hpp"
 #include "Utils/CubismDebug.hpp"
 #include "Utils/CubismJson.hpp"
+#include "Utils/CubismProfiler.hpp"
 #include "Id/CubismIdManager.hpp"
 #include "Rendering/CubismRenderer.hpp"
 
@@ -232,6 +233,8 @@ CubismIdManager* CubismFramework::GetIdManager()
 
 void* CubismFramework::Allocate(csmSizeType size, const csmChar* fileName, csmInt32 lineNumber)
 {
+    CSM_PROFILE_COUNT(Counter_Allocations, 1);
+
     void* address = GetAllocator()->Allocate(size);
 
     CubismLogVerbose("CubismFramework::Allocate(0x%p, %dbytes) %s(%d)", address, size, fileName, lineNumber);
@@ -246,6 +249,8 @@ void* CubismFramework::Allocate(csmSizeType size, const csmChar* fileName, csmIn
 
 void* CubismFramework::AllocateAligned(csmSizeType size, csmUint32 alignment, const csmChar* fileName, csmInt32 lineNumber)
 {
+    CSM_PROFILE_COUNT(Counter_Allocations, 1);
+
     void* address = GetAllocator()->AllocateAligned(size, alignment);
 
     CubismLogVerbose("CubismFramework::AllocateAligned(0x%p, a:%d, %dbytes) %s(%d)", address, alignment, size, fileName, lineNumber);
@@ -314,11 +319,15 @@ void CubismFramework::DeallocateAligned(void* address, const csmChar* fileName,
 
 void* CubismFramework::Allocate(csmSizeType size)
 {
+    CSM_PROFILE_COUNT(Counter_Allocations, 1);
+
     return GetAllocator()->Allocate(size);
 }
 
 void* CubismFramework::AllocateAligned(csmSizeType size, csmUint32 alignment)
 {
+    CSM_PROFILE_COUNT(Counter_Allocations, 1);
+
     return GetAllocator()->AllocateAligned(size, alignment);
 }
 
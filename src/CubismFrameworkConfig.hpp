@@ -24,6 +24,14 @@
  */
 // #define CSM_DEBUG_MEMORY_LEAKING
 
+/**
+ * Enables the profiling zones and counters placed in Cubism Framework.
+ *
+ * @note Results are collected only while Utils::CubismProfiler is running. Without this macro the instrumentation compiles to nothing.<br>
+ *       With CMake, -DCSM_PROFILE=ON can be used instead; it defines this macro for the library and the targets that link it.
+ */
+// #define CSM_PROFILE
+
 
 /**
  * A set of macros to configure the logging level forcefully.
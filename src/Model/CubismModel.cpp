@@ -10,6 +10,7 @@
 #include "Id/CubismId.hpp"
 #include "Id/CubismIdManager.hpp"
 #include "Math/CubismMath.hpp"
+#include "Utils/CubismProfiler.hpp"
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -29,6 +30,7 @@ CubismModel::CubismModel(Core::csmModel* model)
     , _isOverriddenParameterRepeat(true)
     , _isOverriddenCullings(false)
     , _isBlendModeEnabled(false)
+    , _isAccumulatingParameters(false)
 { }
 
 CubismModel::~CubismModel()
@@ -73,6 +75,15 @@ void CubismModel::MultiplyParameterValue(csmInt32 parameterIndex, csmFloat32 val
 
 void CubismModel::Update() const
 {
+    CSM_PROFILE_ZONE(Zone_ModelUpdate, this);
+
+    // 蓄積中の値は範囲外の可能性があるため、Coreに渡す前に範囲を適用する
+    if (_isAccumulatingParameters)
+    {
+        ApplyParameterRange();
+        _isAccumulatingParameters = false;
+    }
+
     // Update model.
     Core::csmUpdateModel(_model);
 
@@ -208,6 +219,12 @@ CubismIdHandle CubismModel::GetParameterId(csmUint32 parameterIndex)
 
 csmFloat32 CubismModel::GetParameterValue(csmInt32 parameterIndex)
 {
+    // 非存在パラメータのインデックスはモデルのパラメータ数以降に割り当てられるため、範囲内なら検索を省く
+    if (0 <= parameterIndex && parameterIndex < static_cast<csmInt32>(_parameterIds.GetSize()))
+    {
+        return _parameterValues[parameterIndex];
+    }
+
     if (_notExistParameterValues.IsExist(parameterIndex))
     {
         return _notExistParameterValues[parameterIndex];
@@ -221,6 +238,15 @@ csmFloat32 CubismModel::GetParameterValue(csmInt32 parameterIndex)
 
 void CubismModel::SetParameterValue(csmInt32 parameterIndex, csmFloat32 value, csmFloat32 weight)
 {
+    // 蓄積中は範囲の適用を EndParameterAccumulation() まで遅らせる
+    if (_isAccumulatingParameters && 0 <= parameterIndex && parameterIndex < static_cast<csmInt32>(_parameterIds.GetSize()))
+    {
+        _parameterValues[parameterIndex] = (weight == 1)
+                                          ? value
+                                          : (_parameterValues[parameterIndex] * (1 - weight)) + (value * weight);
+        return;
+    }
+
     if (_notExistParameterValues.IsExist(parameterIndex))
     {
         _notExistParameterValues[parameterIndex] = (weight == 1)
@@ -247,6 +273,44 @@ void CubismModel::SetParameterValue(csmInt32 parameterIndex, csmFloat32 value, c
                                       : _parameterValues[parameterIndex] = (_parameterValues[parameterIndex] * (1 - weight)) + (value * weight);
 }
 
+void CubismModel::BeginParameterAccumulation()
+{
+    _isAccumulatingParameters = true;
+}
+
+void CubismModel::EndParameterAccumulation()
+{
+    if (!_isAccumulatingParameters)
+    {
+        return;
+    }
+
+    ApplyParameterRange();
+    _isAccumulatingParameters = false;
+}
+
+csmBool CubismModel::IsAccumulatingParameters() const
+{
+    return _isAccumulatingParameters;
+}
+
+void CubismModel::ApplyParameterRange() const
+{
+    const csmInt32 parameterCount = static_cast<csmInt32>(_parameterIds.GetSize());
+
+    for (csmInt32 i = 0; i < parameterCount; ++i)
+    {
+        if (IsRepeat(i))
+        {
+            _parameterValues[i] = GetParameterRepeatValue(i, _parameterValues[i]);
+        }
+        else
+        {
+            _parameterValues[i] = CubismMath::ClampF(_parameterValues[i], _parameterMinimumValues[i], _parameterMaximumValues[i]);
+        }
+    }
+}
+
 csmBool CubismModel::IsRepeat(const csmInt32 parameterIndex) const
 {
     if (_notExistParameterValues.IsExist(parameterIndex))
@@ -893,6 +957,12 @@ void CubismModel::LoadParameters()
 
 void CubismModel::SaveParameters()
 {
+    // 保存する値は蓄積中でも範囲内に収めておく
+    if (_isAccumulatingParameters)
+    {
+        ApplyParameterRange();
+    }
+
     const csmInt32 parameterCount = Core::csmGetParameterCount(_model);
     const csmInt32 savedParameterCount = static_cast<csmInt32>(_savedParameters.GetSize());
 
@@ -548,6 +548,31 @@ public:
      */
     void MultiplyParameterValue(csmInt32 parameterIndex, csmFloat32 value, csmFloat32 weight = 1.0f);
 
+    /**
+     * Starts accumulating parameter values.<br>
+     * Until EndParameterAccumulation() is called, SetParameterValue(), AddParameterValue() and
+     * MultiplyParameterValue() blend directly into the parameter array of the model
+     * without clamping or repeating each write. The range of every parameter is applied once at the end.
+     *
+     * @note Intended to wrap the update of motions, expressions and effects in a frame.<br>
+     *       Values read during accumulation may be out of the parameter's range.<br>
+     *       Update() and CubismPhysics end the accumulation themselves because they read the parameter array directly.
+     */
+    void BeginParameterAccumulation();
+
+    /**
+     * Ends accumulating parameter values and applies the range of every parameter once.<br>
+     * Does nothing if the accumulation has not been started.
+     */
+    void EndParameterAccumulation();
+
+    /**
+     * Returns whether parameter values are being accumulated.
+     *
+     * @return true if BeginParameterAccumulation() has been called and the accumulation has not ended; otherwise false.
+     */
+    csmBool IsAccumulatingParameters() const;
+
     //========================================================
     //  Drawable Functions.
     //========================================================
@@ -1085,6 +1110,11 @@ protected:
 
     void SetupPartsHierarchy();
 
+    /**
+     * Clamps or repeats every parameter value of the model into its range in place.
+     */
+    void ApplyParameterRange() const;
+
     csmMap<csmInt32, csmFloat32>        _notExistPartOpacities;
     csmMap<CubismIdHandle, csmInt32>   _notExistPartId;
 
@@ -1114,6 +1144,7 @@ protected:
     csmBool _isOverriddenParameterRepeat;
     csmBool _isOverriddenCullings;
     csmBool _isBlendModeEnabled;
+    mutable csmBool _isAccumulatingParameters;     ///< Whether parameter writes skip the range until EndParameterAccumulation()
 };
 
 }}}
@@ -186,6 +186,12 @@ const csmVector<const csmString*>& ACubismMotion::GetFiredEvent(csmFloat32 befor
     return _firedEventValues;
 }
 
+const csmVector<const csmString*>& ACubismMotion::GetFiredEvent(CubismMotionQueueEntry*, csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds)
+{
+    // 検索位置を持たない既定の実装では再生ごとの情報は使わない
+    return GetFiredEvent(beforeCheckTimeSeconds, motionTimeSeconds);
+}
+
 void ACubismMotion::SetBeganMotionHandler(BeganMotionCallback onBeganMotionHandler)
 {
     this->_onBeganMotion = onBeganMotionHandler;
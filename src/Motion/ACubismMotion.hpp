@@ -167,6 +167,22 @@ public:
     virtual const csmVector<const csmString*>& GetFiredEvent(csmFloat32 beforeCheckTimeSeconds,
                                                                    csmFloat32 motionTimeSeconds);
 
+    /**
+     * Returns the triggered user data events for a playback.<br>
+     * Subclasses can keep a search position on the queue entry to avoid scanning every event.
+     *
+     * @param motionQueueEntry motion managed by the CubismMotionQueueManager
+     * @param beforeCheckTimeSeconds previous playback time in seconds
+     * @param motionTimeSeconds current playback time in seconds
+     *
+     * @return instance of the collection of triggered user data events
+     *
+     * @note The default implementation calls GetFiredEvent(beforeCheckTimeSeconds, motionTimeSeconds).
+     */
+    virtual const csmVector<const csmString*>& GetFiredEvent(CubismMotionQueueEntry* motionQueueEntry,
+                                                                   csmFloat32 beforeCheckTimeSeconds,
+                                                                   csmFloat32 motionTimeSeconds);
+
     /**
      * Sets the motion playback completion callback.
      *
@@ -10,6 +10,7 @@
 #include "CubismMotionQueueEntry.hpp"
 #include "CubismFramework.hpp"
 #include "Math/CubismMath.hpp"
+#include "Utils/CubismProfiler.hpp"
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -37,6 +38,8 @@ CubismExpressionMotionManager::~CubismExpressionMotionManager()
 
 csmBool CubismExpressionMotionManager::UpdateMotion(CubismModel* model, csmFloat32 deltaTimeSeconds)
 {
+    CSM_PROFILE_ZONE(Zone_Expression, model);
+
     _userTimeSeconds += deltaTimeSeconds;
     csmBool updated = false;
     csmVector<CubismMotionQueueEntry*>* motions = GetCubismMotionQueueEntries();
@@ -65,7 +68,7 @@ csmBool CubismExpressionMotionManager::UpdateMotion(CubismModel* model, csmFloat
 
         if (expressionMotion == NULL)
         {
-            CSM_DELETE(motionQueueEntry);
+            ReleaseMotionQueueEntry(motionQueueEntry);
             ite = motions->Erase(ite);          // 削除
             continue;
         }
@@ -140,13 +143,21 @@ csmBool CubismExpressionMotionManager::UpdateMotion(CubismModel* model, csmFloat
         if (latestFadeWeight >= 1.0f)
         {
             // 配列の最後の要素は削除しない
-            for (csmInt32 i = motions->GetSize()-2; i >= 0; i--)
+            const csmInt32 removeCount = motions->GetSize() - 1;
+            for (csmInt32 i = 0; i < removeCount; ++i)
+            {
+                ReleaseMotionQueueEntry(motions->At(i));
+            }
+
+            // 1要素ずつ削除せず、残す要素を先頭へ寄せてからまとめて縮める
+            motions->At(0) = motions->At(removeCount);
+            motions->UpdateSize(1, NULL, false);
+
+            for (csmUint32 i = static_cast<csmUint32>(removeCount); i < _fadeWeights->GetSize(); ++i)
             {
-                CubismMotionQueueEntry* motionQueueEntry = motions->At(i);
-                CSM_DELETE(motionQueueEntry);
-                motions->Remove(i);
-                _fadeWeights->Remove(i);
+                _fadeWeights->At(i - removeCount) = _fadeWeights->At(i);
             }
+            _fadeWeights->UpdateSize(_fadeWeights->GetSize() - removeCount, 0.0f, false);
         }
     }
 
@@ -16,15 +16,20 @@
 #include "Type/csmVector.hpp"
 #include "Id/CubismIdManager.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CSM_MOTION_BEZIER_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CSM_MOTION_BEZIER_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Live2D { namespace Cubism { namespace Framework {
 
 namespace {
 
 const csmChar* EffectNameEyeBlink = "EyeBlink";
 const csmChar* EffectNameLipSync  = "LipSync";
-const csmChar* TargetNameModel = "Model";
-const csmChar* TargetNameParameter = "Parameter";
-const csmChar* TargetNamePartOpacity = "PartOpacity";
 
 // Id
 const csmChar* IdNameOpacity = "Opacity";
@@ -187,6 +192,445 @@ csmFloat32 InverseSteppedEvaluate(const CubismMotionPoint* points, const csmFloa
     return points[1].Value;
 }
 
+/*
+ * 3次ベジェのセグメントを4本まとめて評価する
+ * Cardanoの公式は逆三角関数や立方根を含むため、時間方向に単調なセグメントについては
+ * 範囲で挟み込んだニュートン法で媒介変数を求め、レーンごとに並列に評価する。
+ * 収束しなかったレーンはスカラーの評価に戻すため、結果はスカラーの評価と許容誤差内で一致する。
+ * SSE2とAArch64のNEONではSIMD命令で評価し、それ以外（除算命令のないARMv7のNEONなど）ではレーンごとのループで評価する。
+ */
+const csmInt32 BezierLaneCount = 4;                 ///< まとめて評価するセグメント数
+const csmInt32 BezierNewtonIterationCount = 6;      ///< ニュートン法の反復回数
+const csmFloat32 BezierTimeTolerance = 0.00001f;    ///< 収束したとみなす時間の誤差（セグメントの長さに対する比）
+
+#ifdef CSM_MOTION_BEZIER_SSE2
+typedef __m128 BezierLanes;
+
+inline BezierLanes LanesLoad(const csmFloat32* src)
+{
+    return _mm_loadu_ps(src);
+}
+
+inline void LanesStore(csmFloat32* dst, const BezierLanes value)
+{
+    _mm_storeu_ps(dst, value);
+}
+
+inline BezierLanes LanesSet(const csmFloat32 value)
+{
+    return _mm_set1_ps(value);
+}
+
+inline BezierLanes LanesAdd(const BezierLanes a, const BezierLanes b)
+{
+    return _mm_add_ps(a, b);
+}
+
+inline BezierLanes LanesSub(const BezierLanes a, const BezierLanes b)
+{
+    return _mm_sub_ps(a, b);
+}
+
+inline BezierLanes LanesMul(const BezierLanes a, const BezierLanes b)
+{
+    return _mm_mul_ps(a, b);
+}
+
+inline BezierLanes LanesDiv(const BezierLanes a, const BezierLanes b)
+{
+    return _mm_div_ps(a, b);
+}
+
+inline BezierLanes LanesClamp(const BezierLanes value, const BezierLanes minValue, const BezierLanes maxValue)
+{
+    return _mm_min_ps(_mm_max_ps(value, minValue), maxValue);
+}
+
+inline BezierLanes LanesLess(const BezierLanes a, const BezierLanes b)
+{
+    return _mm_cmplt_ps(a, b);
+}
+
+inline BezierLanes LanesLessEqual(const BezierLanes a, const BezierLanes b)
+{
+    return _mm_cmple_ps(a, b);
+}
+
+inline BezierLanes LanesAnd(const BezierLanes a, const BezierLanes b)
+{
+    return _mm_and_ps(a, b);
+}
+
+inline BezierLanes LanesSelect(const BezierLanes mask, const BezierLanes a, const BezierLanes b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline csmInt32 LanesMask(const BezierLanes mask)
+{
+    return _mm_movemask_ps(mask);
+}
+#elif defined(CSM_MOTION_BEZIER_NEON)
+// 比較結果はSSE2と同じく全ビットが立ったレーンで表し、float32x4_tのまま受け渡す
+// 除算命令を持たないARMv7のNEONは対象外とし、スカラーの評価を使う
+typedef float32x4_t BezierLanes;
+
+inline BezierLanes LanesLoad(const csmFloat32* src)
+{
+    return vld1q_f32(src);
+}
+
+inline void LanesStore(csmFloat32* dst, const BezierLanes value)
+{
+    vst1q_f32(dst, value);
+}
+
+inline BezierLanes LanesSet(const csmFloat32 value)
+{
+    return vdupq_n_f32(value);
+}
+
+inline BezierLanes LanesAdd(const BezierLanes a, const BezierLanes b)
+{
+    return vaddq_f32(a, b);
+}
+
+inline BezierLanes LanesSub(const BezierLanes a, const BezierLanes b)
+{
+    return vsubq_f32(a, b);
+}
+
+inline BezierLanes LanesMul(const BezierLanes a, const BezierLanes b)
+{
+    return vmulq_f32(a, b);
+}
+
+inline BezierLanes LanesDiv(const BezierLanes a, const BezierLanes b)
+{
+    return vdivq_f32(a, b);
+}
+
+inline BezierLanes LanesClamp(const BezierLanes value, const BezierLanes minValue, const BezierLanes maxValue)
+{
+    return vminq_f32(vmaxq_f32(value, minValue), maxValue);
+}
+
+inline BezierLanes LanesLess(const BezierLanes a, const BezierLanes b)
+{
+    return vreinterpretq_f32_u32(vcltq_f32(a, b));
+}
+
+inline BezierLanes LanesLessEqual(const BezierLanes a, const BezierLanes b)
+{
+    return vreinterpretq_f32_u32(vcleq_f32(a, b));
+}
+
+inline BezierLanes LanesAnd(const BezierLanes a, const BezierLanes b)
+{
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+
+inline BezierLanes LanesSelect(const BezierLanes mask, const BezierLanes a, const BezierLanes b)
+{
+    return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+}
+
+inline csmInt32 LanesMask(const BezierLanes mask)
+{
+    // 各レーンの最上位ビットを取り出し、レーン番号のビットに並べる
+    const uint32_t laneBitValues[BezierLaneCount] = { 1, 2, 4, 8 };
+    const uint32x4_t laneBits = vshrq_n_u32(vreinterpretq_u32_f32(mask), 31);
+    return static_cast<csmInt32>(vaddvq_u32(vmulq_u32(laneBits, vld1q_u32(laneBitValues))));
+}
+#else
+struct BezierLanes
+{
+    csmFloat32 Value[BezierLaneCount];
+};
+
+inline BezierLanes LanesLoad(const csmFloat32* src)
+{
+    BezierLanes result;
+    for (csmInt32 i = 0; i < BezierLaneCount; ++i)
+    {
+        result.Value[i] = src[i];
+    }
+    return result;
+}
+
+inline void LanesStore(csmFloat32* dst, const BezierLanes value)
+{
+    for (csmInt32 i = 0; i < BezierLaneCount; ++i)
+    {
+        dst[i] = value.Value[i];
+    }
+}
+
+inline BezierLanes LanesSet(const csmFloat32 value)
+{
+    BezierLanes result;
+    for (csmInt32 i = 0; i < BezierLaneCount; ++i)
+    {
+        result.Value[i] = value;
+    }
+    return result;
+}
+
+inline BezierLanes LanesAdd(const BezierLanes a, const BezierLanes b)
+{
+    BezierLanes result;
+    for (csmInt32 i = 0; i < BezierLaneCount; ++i)
+    {
+        result.Value[i] = a.Value[i] + b.Value[i];
+    }
+    return result;
+}
+
+inline BezierLanes LanesSub(const BezierLanes a, const BezierLanes b)
+{
+    BezierLanes result;
+    for (csmInt32 i = 0; i < BezierLaneCount; ++i)
+    {
+        result.Value[i] = a.Value[i] - b.Value[i];
+    }
+    return result;
+}
+
+inline BezierLanes LanesMul(const BezierLanes a, const BezierLanes b)
+{
+    BezierLanes result;
+    for (csmInt32 i = 0; i < BezierLaneCount; ++i)
+    {
+        result.Value[i] = a.Value[i] * b.Value[i];
+    }
+    return result;
+}
+
+inline BezierLanes LanesDiv(const BezierLanes a, const BezierLanes b)
+{
+    BezierLanes result;
+    for (csmInt32 i = 0; i < BezierLaneCount; ++i)
+    {
+        result.Value[i] = a.Value[i] / b.Value[i];
+    }
+    return result;
+}
+
+inline BezierLanes LanesClamp(const BezierLanes value, const BezierLanes minValue, const BezierLanes maxValue)
+{
+    BezierLanes result;
+    for (csmInt32 i = 0; i < BezierLaneCount; ++i)
+    {
+        result.Value[i] = CubismMath::RangeF(value.Value[i], minValue.Value[i], maxValue.Value[i]);
+    }
+    return result;
+}
+
+// 比較結果は真なら1.0f、偽なら0.0fで表す
+inline BezierLanes LanesLess(const BezierLanes a, const BezierLanes b)
+{
+    BezierLanes result;
+    for (csmInt32 i = 0; i < BezierLaneCount; ++i)
+    {
+        result.Value[i] = (a.Value[i] < b.Value[i]) ? 1.0f : 0.0f;
+    }
+    return result;
+}
+
+inline BezierLanes LanesLessEqual(const BezierLanes a, const BezierLanes b)
+{
+    BezierLanes result;
+    for (csmInt32 i = 0; i < BezierLaneCount; ++i)
+    {
+        result.Value[i] = (a.Value[i] <= b.Value[i]) ? 1.0f : 0.0f;
+    }
+    return result;
+}
+
+inline BezierLanes LanesAnd(const BezierLanes a, const BezierLanes b)
+{
+    return LanesMul(a, b);
+}
+
+inline BezierLanes LanesSelect(const BezierLanes mask, const BezierLanes a, const BezierLanes b)
+{
+    BezierLanes result;
+    for (csmInt32 i = 0; i < BezierLaneCount; ++i)
+    {
+        result.Value[i] = (mask.Value[i] != 0.0f) ? a.Value[i] : b.Value[i];
+    }
+    return result;
+}
+
+inline csmInt32 LanesMask(const BezierLanes mask)
+{
+    csmInt32 result = 0;
+    for (csmInt32 i = 0; i < BezierLaneCount; ++i)
+    {
+        if (mask.Value[i] != 0.0f)
+        {
+            result |= 1 << i;
+        }
+    }
+    return result;
+}
+#endif
+
+inline BezierLanes LanesLerp(const BezierLanes a, const BezierLanes b, const BezierLanes t)
+{
+    return LanesAdd(a, LanesMul(LanesSub(b, a), t));
+}
+
+/**
+ * BezierEvaluateCardanoInterpretation で評価するセグメントをレーンに集めて、まとめて評価する
+ */
+struct BezierLaneBatch
+{
+    BezierLaneBatch()
+        : Count(0)
+    { }
+
+    /**
+     * セグメントの評価を追加する
+     * 時間方向に単調でないセグメントや範囲外の時間は、その場でスカラーの評価を行う
+     *
+     * @param points    セグメントの制御点
+     * @param time      評価する時間
+     * @param output    評価結果の書き込み先。Flush()までに書き込まれる
+     */
+    void Push(const CubismMotionPoint* points, const csmFloat32 time, csmFloat32* output)
+    {
+        const csmBool isMonotonic = points[0].Time < points[3].Time
+            && points[0].Time <= points[1].Time
+            && points[1].Time <= points[2].Time
+            && points[2].Time <= points[3].Time;
+
+        if (!isMonotonic || time < points[0].Time || points[3].Time < time)
+        {
+            *output = BezierEvaluateCardanoInterpretation(points, time);
+            return;
+        }
+
+        // 精度を保つため、時間はセグメントの開始からの相対値で扱う
+        for (csmInt32 i = 0; i < 4; ++i)
+        {
+            X[i][Count] = points[i].Time - points[0].Time;
+            Y[i][Count] = points[i].Value;
+        }
+        Time[Count] = time;
+        Origin[Count] = points[0].Time;
+        Tolerance[Count] = (points[3].Time - points[0].Time) * BezierTimeTolerance;
+        Points[Count] = points;
+        Outputs[Count] = output;
+        ++Count;
+
+        if (Count == BezierLaneCount)
+        {
+            Flush();
+        }
+    }
+
+    /**
+     * 集めたセグメントを評価して書き込む
+     */
+    void Flush()
+    {
+        if (Count == 0)
+        {
+            return;
+        }
+
+        // 空きレーンは先頭のレーンで埋めて計算だけ行う
+        for (csmInt32 lane = Count; lane < BezierLaneCount; ++lane)
+        {
+            for (csmInt32 i = 0; i < 4; ++i)
+            {
+                X[i][lane] = X[i][0];
+                Y[i][lane] = Y[i][0];
+            }
+            Time[lane] = Time[0];
+            Origin[lane] = Origin[0];
+            Tolerance[lane] = Tolerance[0];
+        }
+
+        const BezierLanes zero = LanesSet(0.0f);
+        const BezierLanes one = LanesSet(1.0f);
+        const BezierLanes two = LanesSet(2.0f);
+        const BezierLanes three = LanesSet(3.0f);
+        const BezierLanes half = LanesSet(0.5f);
+
+        const BezierLanes x0 = LanesLoad(X[0]);
+        const BezierLanes x1 = LanesLoad(X[1]);
+        const BezierLanes x2 = LanesLoad(X[2]);
+        const BezierLanes x3 = LanesLoad(X[3]);
+        const BezierLanes time = LanesSub(LanesLoad(Time), LanesLoad(Origin));
+
+        // x(t) = a * t^3 + b * t^2 + c * t + x0
+        const BezierLanes a = LanesAdd(LanesSub(x3, x0), LanesMul(three, LanesSub(x1, x2)));
+        const BezierLanes b = LanesMul(three, LanesAdd(LanesSub(x2, LanesMul(two, x1)), x0));
+        const BezierLanes c = LanesMul(three, LanesSub(x1, x0));
+        const BezierLanes d = LanesSub(x0, time);
+        const BezierLanes a3 = LanesMul(three, a);
+        const BezierLanes b2 = LanesMul(two, b);
+
+        BezierLanes lower = zero;
+        BezierLanes upper = one;
+        BezierLanes t = LanesClamp(LanesDiv(LanesSub(time, x0), LanesSub(x3, x0)), zero, one);
+
+        for (csmInt32 iteration = 0; iteration < BezierNewtonIterationCount; ++iteration)
+        {
+            const BezierLanes f = LanesAdd(LanesMul(LanesAdd(LanesMul(LanesAdd(LanesMul(a, t), b), t), c), t), d);
+            const BezierLanes df = LanesAdd(LanesMul(LanesAdd(LanesMul(a3, t), b2), t), c);
+
+            // 単調増加のため、f > 0 なら解は t より前にある
+            const BezierLanes isAfter = LanesLess(zero, f);
+            upper = LanesSelect(isAfter, t, upper);
+            lower = LanesSelect(isAfter, lower, t);
+
+            // ニュートン法の次の値が範囲外（傾きが0の場合を含む）なら二分法に切り替える
+            const BezierLanes next = LanesSub(t, LanesDiv(f, df));
+            const BezierLanes isInside = LanesAnd(LanesLessEqual(lower, next), LanesLessEqual(next, upper));
+            t = LanesSelect(isInside, next, LanesMul(LanesAdd(lower, upper), half));
+        }
+
+        const BezierLanes f = LanesAdd(LanesMul(LanesAdd(LanesMul(LanesAdd(LanesMul(a, t), b), t), c), t), d);
+        const BezierLanes tolerance = LanesLoad(Tolerance);
+        const csmInt32 convergedMask = LanesMask(LanesAnd(LanesLess(f, tolerance), LanesLess(LanesSub(zero, f), tolerance)));
+
+        const BezierLanes y0 = LanesLoad(Y[0]);
+        const BezierLanes y1 = LanesLoad(Y[1]);
+        const BezierLanes y2 = LanesLoad(Y[2]);
+        const BezierLanes y3 = LanesLoad(Y[3]);
+
+        const BezierLanes p01 = LanesLerp(y0, y1, t);
+        const BezierLanes p12 = LanesLerp(y1, y2, t);
+        const BezierLanes p23 = LanesLerp(y2, y3, t);
+        const BezierLanes p012 = LanesLerp(p01, p12, t);
+        const BezierLanes p123 = LanesLerp(p12, p23, t);
+
+        csmFloat32 values[BezierLaneCount];
+        LanesStore(values, LanesLerp(p012, p123, t));
+
+        for (csmInt32 lane = 0; lane < Count; ++lane)
+        {
+            *Outputs[lane] = ((convergedMask >> lane) & 1)
+                ? values[lane]
+                : BezierEvaluateCardanoInterpretation(Points[lane], Time[lane]);
+        }
+
+        Count = 0;
+    }
+
+    csmFloat32 X[4][BezierLaneCount];                   ///< 制御点の時間
+    csmFloat32 Y[4][BezierLaneCount];                   ///< 制御点の値
+    csmFloat32 Time[BezierLaneCount];                   ///< 評価する時間
+    csmFloat32 Origin[BezierLaneCount];                 ///< セグメントの開始時間
+    csmFloat32 Tolerance[BezierLaneCount];              ///< 収束したとみなす時間の誤差
+    const CubismMotionPoint* Points[BezierLaneCount];   ///< スカラーの評価に戻す場合の制御点
+    csmFloat32* Outputs[BezierLaneCount];               ///< 評価結果の書き込み先
+    csmInt32 Count;                                     ///< 集めたセグメント数
+};
+
 csmFloat32 CorrectEndPoint(
     const CubismMotionData* motionData,
     const csmInt32 segmentIndex,
@@ -231,37 +675,357 @@ csmFloat32 EvaluateCurve(const CubismMotionData* motionData, const csmInt32 inde
                 : 1);
 
 
-        // Break if time lies within current segment.
-        if (motionData->Points[pointPosition].Time > time)
+        // Break if time lies within current segment.
+        if (motionData->Points[pointPosition].Time > time)
+        {
+            target = i;
+            break;
+        }
+    }
+
+
+    if (target == -1)
+    {
+        if (isCorrection && time < endTime)
+        {
+            // 終点から始点への補正処理
+            return CorrectEndPoint(
+                motionData,
+                totalSegmentCount - 1,
+                motionData->Segments[curve.BaseSegmentIndex].BasePointIndex,
+                pointPosition,
+                time,
+                endTime
+                );
+        }
+
+        return motionData->Points[pointPosition].Value;
+    }
+
+
+    const CubismMotionSegment& segment = motionData->Segments[target];
+
+    return segment.Evaluate(&motionData->Points[segment.BasePointIndex], time);
+}
+
+/**
+ * time を含むセグメントを探す
+ *
+ * @param searchStart   探索を始めるセグメント。time がこれより前のセグメントに含まれないことが分かっている場合に使う
+ *
+ * @return  セグメントのインデックス。曲線の終端を過ぎている場合は-1
+ */
+csmInt32 FindSegment(const CubismMotionData* motionData, const CubismMotionCurve& curve, const csmInt32 searchStart, const csmFloat32 time)
+{
+    const csmInt32 totalSegmentCount = curve.BaseSegmentIndex + curve.SegmentCount;
+
+    for (csmInt32 i = searchStart; i < totalSegmentCount; ++i)
+    {
+        const csmInt32 pointPosition = motionData->Segments[i].BasePointIndex
+            + (motionData->Segments[i].SegmentType == CubismMotionSegmentType_Bezier
+                ? 3
+                : 1);
+
+        if (motionData->Points[pointPosition].Time > time)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * 1つの曲線を複数の時間でまとめて評価する
+ * 同じセグメントに含まれる連続した時間はセグメントの探索を共有し、線形・ステップのセグメントは1つのループで評価する
+ */
+void EvaluateCurveBatch(const CubismMotionData* motionData, const csmInt32 index, const csmFloat32* times, const csmInt32 count,
+                        const csmBool isCorrection, const csmFloat32 endTime, csmFloat32* values)
+{
+    const CubismMotionCurve& curve = motionData->Curves[index];
+
+    csmInt32 searchStart = curve.BaseSegmentIndex;
+    csmFloat32 searchStartTime = -FLT_MAX;
+    BezierLaneBatch bezierLanes;
+
+    csmInt32 i = 0;
+    while (i < count)
+    {
+        // 時間が前回のセグメントより前に戻った場合は先頭から探し直す
+        if (times[i] < searchStartTime)
+        {
+            searchStart = curve.BaseSegmentIndex;
+            searchStartTime = -FLT_MAX;
+        }
+
+        const csmInt32 target = FindSegment(motionData, curve, searchStart, times[i]);
+
+        if (target == -1)
+        {
+            // 終端以降は補正があるため1つずつ評価する
+            values[i] = EvaluateCurve(motionData, index, times[i], isCorrection, endTime);
+            ++i;
+            continue;
+        }
+
+        const CubismMotionSegment& segment = motionData->Segments[target];
+        const CubismMotionPoint* points = &motionData->Points[segment.BasePointIndex];
+        const csmInt32 lastPoint = (segment.SegmentType == CubismMotionSegmentType_Bezier) ? 3 : 1;
+
+        // 先頭のセグメントは開始時間より前の時間も受け持つ
+        const csmFloat32 lowerTime = (target == curve.BaseSegmentIndex) ? -FLT_MAX : points[0].Time;
+        const csmFloat32 upperTime = points[lastPoint].Time;
+
+        // 同じセグメントに含まれる時間が続く範囲を求める
+        csmInt32 runEnd = i + 1;
+        while (runEnd < count && lowerTime <= times[runEnd] && times[runEnd] < upperTime)
+        {
+            ++runEnd;
+        }
+
+        switch (segment.SegmentType)
+        {
+        case CubismMotionSegmentType_Linear:
+        {
+            const csmFloat32 startTime = points[0].Time;
+            const csmFloat32 timeRange = points[1].Time - points[0].Time;
+            const csmFloat32 startValue = points[0].Value;
+            const csmFloat32 valueRange = points[1].Value - points[0].Value;
+
+            for (csmInt32 j = i; j < runEnd; ++j)
+            {
+                csmFloat32 t = (times[j] - startTime) / timeRange;
+                t = (t < 0.0f) ? 0.0f : t;
+                values[j] = startValue + valueRange * t;
+            }
+            break;
+        }
+        case CubismMotionSegmentType_Stepped:
+        case CubismMotionSegmentType_InverseStepped:
+        {
+            const csmFloat32 value = (segment.SegmentType == CubismMotionSegmentType_Stepped) ? points[0].Value : points[1].Value;
+
+            for (csmInt32 j = i; j < runEnd; ++j)
+            {
+                values[j] = value;
+            }
+            break;
+        }
+        default:
+            if (segment.Evaluate == BezierEvaluateCardanoInterpretation)
+            {
+                for (csmInt32 j = i; j < runEnd; ++j)
+                {
+                    bezierLanes.Push(points, times[j], &values[j]);
+                }
+            }
+            else
+            {
+                for (csmInt32 j = i; j < runEnd; ++j)
+                {
+                    values[j] = segment.Evaluate(points, times[j]);
+                }
+            }
+            break;
+        }
+
+        searchStart = target;
+        searchStartTime = lowerTime;
+        i = runEnd;
+    }
+
+    bezierLanes.Flush();
+}
+
+/**
+ * すべての曲線を同じ時間で評価する
+ * 異なる曲線のベジェのセグメントはレーンに集めてまとめて評価する
+ */
+void EvaluateCurvesAt(const CubismMotionData* motionData, const csmFloat32 time, const csmBool isCorrection, const csmFloat32 endTime, csmFloat32* values)
+{
+    BezierLaneBatch bezierLanes;
+
+    for (csmInt32 c = 0; c < motionData->CurveCount; ++c)
+    {
+        const CubismMotionCurve& curve = motionData->Curves[c];
+        const csmInt32 target = FindSegment(motionData, curve, curve.BaseSegmentIndex, time);
+
+        if (target == -1)
+        {
+            values[c] = EvaluateCurve(motionData, c, time, isCorrection, endTime);
+            continue;
+        }
+
+        const CubismMotionSegment& segment = motionData->Segments[target];
+        const CubismMotionPoint* points = &motionData->Points[segment.BasePointIndex];
+
+        // Cardanoの公式で解くベジェは、他の曲線のベジェとまとめて評価する
+        if (segment.Evaluate == BezierEvaluateCardanoInterpretation)
+        {
+            bezierLanes.Push(points, time, &values[c]);
+        }
+        else
+        {
+            values[c] = segment.Evaluate(points, time);
+        }
+    }
+
+    bezierLanes.Flush();
+}
+
+/**
+ * 整列済みの [begin, middle) と [middle, end) をマージする
+ * 同じ時間のイベントは前半を先に置き、ファイル上の順序を保つ
+ */
+void MergeEvents(csmVector<CubismMotionEvent>& events, csmVector<CubismMotionEvent>& scratch, csmUint32 begin, csmUint32 middle, csmUint32 end)
+{
+    // 境界が整列済みならマージは不要
+    if (events[middle - 1].FireTime <= events[middle].FireTime)
+    {
+        return;
+    }
+
+    const csmUint32 leftCount = middle - begin;
+    for (csmUint32 i = 0; i < leftCount; ++i)
+    {
+        scratch[i] = events[begin + i];
+    }
+
+    csmUint32 i = 0;
+    csmUint32 j = middle;
+    csmUint32 k = begin;
+    while (i < leftCount && j < end)
+    {
+        if (scratch[i].FireTime <= events[j].FireTime)
+        {
+            events[k++] = scratch[i++];
+        }
+        else
+        {
+            events[k++] = events[j++];
+        }
+    }
+
+    while (i < leftCount)
+    {
+        events[k++] = scratch[i++];
+    }
+}
+
+/**
+ * イベントを発火時間の順に並べ替える
+ * 同じ時間のイベントはファイル上の順序を保つ
+ */
+void SortEvents(csmVector<CubismMotionEvent>& events)
+{
+    const csmUint32 count = events.GetSize();
+
+    // 書き出されたファイルはほぼ整列済みのため、まず整列済みかを確かめる
+    csmUint32 unsortedIndex = 1;
+    while (unsortedIndex < count && events[unsortedIndex - 1].FireTime <= events[unsortedIndex].FireTime)
+    {
+        ++unsortedIndex;
+    }
+
+    if (unsortedIndex >= count)
+    {
+        return;
+    }
+
+    // 安定なボトムアップのマージソート
+    // csmVectorSort::MergeSort は比較関数に要素を値渡しし、同じ時間の順序も保たないため使わない
+    csmVector<CubismMotionEvent> scratch;
+    scratch.UpdateSize(static_cast<csmInt32>(count));
+
+    for (csmUint32 width = 1; width < count; width *= 2)
+    {
+        for (csmUint32 begin = 0; begin + width < count; begin += width * 2)
+        {
+            const csmUint32 middle = begin + width;
+            const csmUint32 end = (middle + width < count) ? middle + width : count;
+            MergeEvents(events, scratch, begin, middle, end);
+        }
+    }
+}
+
+/**
+ * 発火時間が time より後になる最初のイベントのインデックスを二分探索で求める
+ */
+csmInt32 FindNextEventIndex(const CubismMotionData* motionData, csmFloat32 time)
+{
+    csmInt32 low = 0;
+    csmInt32 high = motionData->EventCount;
+
+    while (low < high)
+    {
+        const csmInt32 middle = low + (high - low) / 2;
+        if (motionData->Events[middle].FireTime > time)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * モデルに存在するパラメータのインデックスを探す
+ * CubismModel::GetParameterIndex と異なり、存在しないIDをモデルに登録しない
+ *
+ * @return  パラメータのインデックス。存在しない場合は-1
+ */
+csmInt32 FindExistingParameterIndex(CubismModel* model, CubismIdHandle parameterId)
+{
+    const csmInt32 parameterCount = model->GetParameterCount();
+
+    for (csmInt32 i = 0; i < parameterCount; ++i)
+    {
+        if (model->GetParameterId(i) == parameterId)
         {
-            target = i;
-            break;
+            return i;
         }
     }
 
+    return -1;
+}
 
-    if (target == -1)
+/**
+ * モデルに存在するパーツのインデックスを探す
+ * CubismModel::GetPartIndex と異なり、存在しないIDをモデルに登録しない
+ *
+ * @return  パーツのインデックス。存在しない場合は-1
+ */
+csmInt32 FindExistingPartIndex(CubismModel* model, CubismIdHandle partId)
+{
+    const csmInt32 partCount = model->GetPartCount();
+
+    for (csmInt32 i = 0; i < partCount; ++i)
     {
-        if (isCorrection && time < endTime)
+        if (model->GetPartId(i) == partId)
         {
-            // 終点から始点への補正処理
-            return CorrectEndPoint(
-                motionData,
-                totalSegmentCount - 1,
-                motionData->Segments[curve.BaseSegmentIndex].BasePointIndex,
-                pointPosition,
-                time,
-                endTime
-                );
+            return i;
         }
-
-        return motionData->Points[pointPosition].Value;
     }
 
+    return -1;
+}
 
-    const CubismMotionSegment& segment = motionData->Segments[target];
+void ReleaseMotionData(CubismMotionData* motionData)
+{
+    if (motionData == NULL)
+    {
+        return;
+    }
 
-    return segment.Evaluate(&motionData->Points[segment.BasePointIndex], time);
+    // 最後の参照が外れた時点で破棄する
+    if (--motionData->ReferenceCount <= 0)
+    {
+        CSM_DELETE(motionData);
+    }
 }
 
 }
@@ -280,10 +1044,7 @@ CubismMotion::CubismMotion()
 
 CubismMotion::~CubismMotion()
 {
-    if(_motionData != NULL)
-    {
-        CSM_DELETE(_motionData);
-    }
+    ReleaseMotionData(_motionData);
 }
 
 CubismMotion* CubismMotion::Create(const csmByte* buffer, csmSizeInt size, FinishedMotionCallback onFinishedMotionHandler, BeganMotionCallback onBeganMotionHandler, csmBool shouldCheckMotionConsistency)
@@ -310,6 +1071,44 @@ CubismMotion* CubismMotion::Create(const csmByte* buffer, csmSizeInt size, Finis
     return ret;
 }
 
+CubismMotion* CubismMotion::CreateShared(const CubismMotion* source, FinishedMotionCallback onFinishedMotionHandler, BeganMotionCallback onBeganMotionHandler)
+{
+    if (source == NULL || source->_motionData == NULL)
+    {
+        return NULL;
+    }
+
+    CubismMotion* ret = CSM_NEW CubismMotion();
+
+    // 解析済みのデータは複製せず参照を増やす
+    ret->_motionData = source->_motionData;
+    ++ret->_motionData->ReferenceCount;
+
+    ret->_sourceFrameRate = source->_sourceFrameRate;
+    ret->_loopDurationSeconds = source->_loopDurationSeconds;
+    ret->_motionBehavior = source->_motionBehavior;
+    ret->_fadeInSeconds = source->_fadeInSeconds;
+    ret->_fadeOutSeconds = source->_fadeOutSeconds;
+    ret->_onFinishedMotion = onFinishedMotionHandler;
+    ret->_onBeganMotion = onBeganMotionHandler;
+
+    return ret;
+}
+
+void CubismMotion::PrepareMotionDataForWrite()
+{
+    if (_motionData == NULL || _motionData->ReferenceCount <= 1)
+    {
+        return;
+    }
+
+    // 他のインスタンスと共有しているデータは書き換えず、複製してから書き換える
+    CubismMotionData* motionData = CSM_NEW CubismMotionData(*_motionData);
+
+    ReleaseMotionData(_motionData);
+    _motionData = motionData;
+}
+
 csmFloat32 CubismMotion::GetDuration()
 {
     return _isLoop ? -1.0f : _loopDurationSeconds;
@@ -397,11 +1196,15 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
 
     csmVector<CubismMotionCurve>& curves = _motionData->Curves;
 
+    // 曲線をまとめて評価しておき、以降はその値を参照する
+    EvaluateCurves(time, isCorrection, duration);
+    const csmFloat32* curveValues = _curveValues.GetPtr();
+
     // Evaluate model curves.
     for (c = 0; c < _motionData->CurveCount && curves[c].Type == CubismMotionCurveTarget_Model; ++c)
     {
         // Evaluate curve and call handler.
-        value = EvaluateCurve(_motionData, c, time, isCorrection, duration);
+        value = curveValues[c];
 
         if (curves[c].Id == _modelCurveIdEyeBlink)
         {
@@ -413,10 +1216,12 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         }
         else if (curves[c].Id == _modelCurveIdOpacity)
         {
+            // 不透明度は再生ごとの状態としてエントリに保持する
+            motionQueueEntry->_modelOpacity = value;
             _modelOpacity = value;
 
             // ------ 不透明度の値が存在すれば反映する ------
-            model->SetModelOpacity(GetModelOpacityValue());
+            model->SetModelOpacity(motionQueueEntry->_modelOpacity);
         }
     }
 
@@ -438,7 +1243,7 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         const csmFloat32 sourceValue = model->GetParameterValue(parameterIndex);
 
         // Evaluate curve and apply value.
-        value = EvaluateCurve(_motionData, c, time, isCorrection, duration);
+        value = curveValues[c];
 
         if (eyeBlinkValue != FLT_MAX)
         {
@@ -564,7 +1369,7 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
         }
 
         // Evaluate curve and apply value.
-        value = EvaluateCurve(_motionData, c, time, isCorrection, duration);
+        value = curveValues[c];
 
         model->SetParameterValue(parameterIndex, value);
     }
@@ -589,6 +1394,190 @@ void CubismMotion::DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSec
     _lastWeight = fadeWeight;
 }
 
+void CubismMotion::EvaluateCurves(csmFloat32 time, csmBool isCorrection, csmFloat32 endTime)
+{
+    _curveValues.UpdateSize(_motionData->CurveCount, 0.0f, false);
+    EvaluateCurvesAt(_motionData, time, isCorrection, endTime, _curveValues.GetPtr());
+}
+
+csmSizeType CubismMotion::GetMotionDataSize() const
+{
+    if (_motionData == NULL)
+    {
+        return 0;
+    }
+
+    csmSizeType size = sizeof(CubismMotionData);
+    size += sizeof(CubismMotionCurve) * _motionData->Curves.GetSize();
+    size += sizeof(CubismMotionSegment) * _motionData->Segments.GetSize();
+    size += sizeof(CubismMotionPoint) * _motionData->Points.GetSize();
+    size += sizeof(CubismMotionEvent) * _motionData->Events.GetSize();
+
+    for (csmUint32 i = 0; i < _motionData->Events.GetSize(); ++i)
+    {
+        size += _motionData->Events[i].Value.GetLength() + 1;
+    }
+
+    return size;
+}
+
+csmInt32 CubismMotion::GetCurveCount() const
+{
+    return _motionData->CurveCount;
+}
+
+CubismIdHandle CubismMotion::GetCurveId(csmInt32 curveIndex) const
+{
+    if (curveIndex < 0 || curveIndex >= _motionData->CurveCount)
+    {
+        return NULL;
+    }
+
+    return _motionData->Curves[curveIndex].Id;
+}
+
+CubismMotion::CurveTarget CubismMotion::GetCurveTarget(csmInt32 curveIndex) const
+{
+    if (curveIndex < 0 || curveIndex >= _motionData->CurveCount)
+    {
+        return CurveTarget_Model;
+    }
+
+    switch (_motionData->Curves[curveIndex].Type)
+    {
+    case CubismMotionCurveTarget_Model:
+    default:
+        return CurveTarget_Model;
+    case CubismMotionCurveTarget_Parameter:
+        return CurveTarget_Parameter;
+    case CubismMotionCurveTarget_PartOpacity:
+        return CurveTarget_PartOpacity;
+    }
+}
+
+void CubismMotion::Sample(csmFloat32 timeSeconds, csmFloat32* values) const
+{
+    if (values == NULL)
+    {
+        return;
+    }
+
+    csmFloat32 time = (timeSeconds < 0.0f) ? 0.0f : timeSeconds;
+
+    // 'Repeat' time as necessary.
+    csmFloat32 duration = _motionData->Duration;
+    const csmBool isCorrection = _motionBehavior == MotionBehavior_V2 && _isLoop;
+
+    if (_isLoop)
+    {
+        if (_motionBehavior == MotionBehavior_V2)
+        {
+            duration += 1.0f / _motionData->Fps;
+        }
+        while (time > duration)
+        {
+            time -= duration;
+        }
+    }
+
+    // メンバの作業領域を使わないため、複数のスレッドから同時に呼び出せる
+    EvaluateCurvesAt(_motionData, time, isCorrection, duration, values);
+}
+
+void CubismMotion::SampleRange(csmFloat32 startTimeSeconds, csmFloat32 intervalSeconds, csmInt32 sampleCount, csmFloat32* values) const
+{
+    if (values == NULL || sampleCount <= 0)
+    {
+        return;
+    }
+
+    const csmInt32 curveCount = _motionData->CurveCount;
+
+    for (csmInt32 i = 0; i < sampleCount; ++i)
+    {
+        // 誤差が積み重ならないよう、時間は開始時間から毎回求める
+        Sample(startTimeSeconds + intervalSeconds * static_cast<csmFloat32>(i), values + static_cast<csmSizeInt>(i) * curveCount);
+    }
+}
+
+void CubismMotion::EvaluateBatch(CubismModel* model, const csmFloat32* timeSeconds, csmFloat32* const* parameterValues, csmInt32 instanceCount, const csmFloat32* fadeWeights, csmFloat32* const* partOpacities)
+{
+    if (model == NULL || timeSeconds == NULL || parameterValues == NULL || instanceCount <= 0)
+    {
+        return;
+    }
+
+    // 'Repeat' time as necessary.
+    csmFloat32 duration = _motionData->Duration;
+    const csmBool isCorrection = _motionBehavior == MotionBehavior_V2 && _isLoop;
+
+    if (_isLoop && _motionBehavior == MotionBehavior_V2)
+    {
+        duration += 1.0f / _motionData->Fps;
+    }
+
+    _batchTimes.UpdateSize(instanceCount, 0.0f, false);
+    _batchValues.UpdateSize(instanceCount, 0.0f, false);
+
+    csmFloat32* times = _batchTimes.GetPtr();
+    csmFloat32* values = _batchValues.GetPtr();
+
+    for (csmInt32 i = 0; i < instanceCount; ++i)
+    {
+        csmFloat32 time = (timeSeconds[i] < 0.0f) ? 0.0f : timeSeconds[i];
+
+        if (_isLoop)
+        {
+            while (time > duration)
+            {
+                time -= duration;
+            }
+        }
+
+        times[i] = time;
+    }
+
+    const csmVector<CubismMotionCurve>& curves = _motionData->Curves;
+
+    for (csmInt32 c = 0; c < _motionData->CurveCount; ++c)
+    {
+        const csmBool isPartOpacity = (curves[c].Type == CubismMotionCurveTarget_PartOpacity);
+
+        if (curves[c].Type == CubismMotionCurveTarget_Model || (isPartOpacity && partOpacities == NULL))
+        {
+            continue;
+        }
+
+        // 出力先の配列はモデルに存在するパラメータ・パーツのみを持つため、存在しないIDを登録しない方法で探す
+        csmFloat32* const* outputs = isPartOpacity ? partOpacities : parameterValues;
+        const csmInt32 outputIndex = isPartOpacity
+            ? FindExistingPartIndex(model, curves[c].Id)
+            : FindExistingParameterIndex(model, curves[c].Id);
+        if (outputIndex < 0)
+        {
+            continue;
+        }
+
+        EvaluateCurveBatch(_motionData, c, times, instanceCount, isCorrection, duration, values);
+
+        if (fadeWeights == NULL || isPartOpacity)
+        {
+            for (csmInt32 i = 0; i < instanceCount; ++i)
+            {
+                outputs[i][outputIndex] = values[i];
+            }
+        }
+        else
+        {
+            for (csmInt32 i = 0; i < instanceCount; ++i)
+            {
+                const csmFloat32 sourceValue = outputs[i][outputIndex];
+                outputs[i][outputIndex] = sourceValue + (values[i] - sourceValue) * fadeWeights[i];
+            }
+        }
+    }
+}
+
 void CubismMotion::UpdateForNextLoop(CubismMotionQueueEntry* motionQueueEntry, const csmFloat32 userTimeSeconds, const csmFloat32 time)
 {
     switch (_motionBehavior)
@@ -622,20 +1611,22 @@ void CubismMotion::UpdateForNextLoop(CubismMotionQueueEntry* motionQueueEntry, c
 
 void CubismMotion::Parse(const csmByte* motionJson, const csmSizeInt size, csmBool shouldCheckMotionConsistency)
 {
-    CubismMotionJson* json = CSM_NEW CubismMotionJson(motionJson, size);
+    // DOMを作らず、1回の走査で CubismMotionData に直接読み込む
+    CubismMotionJsonReader reader(motionJson, size);
+    CubismMotionData* motionData = CSM_NEW CubismMotionData;
 
-    if (!json->IsValid())
+    if (!reader.Read(*motionData))
     {
-        CSM_DELETE(json);
+        CSM_DELETE(motionData);
         return;
     }
 
     if (shouldCheckMotionConsistency)
     {
-        csmBool consistency = json->HasConsistency();
+        csmBool consistency = reader.HasConsistency();
         if(!consistency)
         {
-            CSM_DELETE(json);
+            CSM_DELETE(motionData);
 
             // 整合性が確認できなければ処理しない
             CubismLogError("Inconsistent motion3.json.");
@@ -643,183 +1634,73 @@ void CubismMotion::Parse(const csmByte* motionJson, const csmSizeInt size, csmBo
         }
     }
 
-    _motionData = CSM_NEW CubismMotionData;
-
-    _motionData->Duration = json->GetMotionDuration();
-    _motionData->Loop = json->IsMotionLoop();
-    _motionData->CurveCount = json->GetMotionCurveCount();
-    _motionData->Fps = json->GetMotionFps();
-    _motionData->EventCount = json->GetEventCount();
-
-    csmBool areBeziersRestricted = json->GetEvaluationOptionFlag( EvaluationOptionFlag_AreBeziersRestricted );
+    _motionData = motionData;
 
-    if (json->IsExistMotionFadeInTime())
+    if (reader.IsExistMotionFadeInTime())
     {
-        _fadeInSeconds = (json->GetMotionFadeInTime() < 0.0f)
+        _fadeInSeconds = (reader.GetMotionFadeInTime() < 0.0f)
                              ? 1.0f
-                             : json->GetMotionFadeInTime();
+                             : reader.GetMotionFadeInTime();
     }
     else
     {
         _fadeInSeconds = 1.0f;
     }
 
-    if (json->IsExistMotionFadeOutTime())
+    if (reader.IsExistMotionFadeOutTime())
     {
-        _fadeOutSeconds = (json->GetMotionFadeOutTime() < 0.0f)
+        _fadeOutSeconds = (reader.GetMotionFadeOutTime() < 0.0f)
                               ? 1.0f
-                              : json->GetMotionFadeOutTime();
+                              : reader.GetMotionFadeOutTime();
     }
     else
     {
         _fadeOutSeconds = 1.0f;
     }
 
-    _motionData->Curves.UpdateSize(_motionData->CurveCount, CubismMotionCurve(), true);
-    _motionData->Segments.UpdateSize(json->GetMotionTotalSegmentCount(), CubismMotionSegment(), true);
-    _motionData->Points.UpdateSize(json->GetMotionTotalPointCount(), CubismMotionPoint(), true);
-    _motionData->Events.UpdateSize(_motionData->EventCount, CubismMotionEvent(), true);
+    // AreBeziersRestricted は Curves より後に書かれていてもよいため、評価関数は読み込み後に決める
+    const csmBool areBeziersRestricted = reader.GetEvaluationOptionFlag(EvaluationOptionFlag_AreBeziersRestricted);
+    const csmInt32 segmentCount = static_cast<csmInt32>(_motionData->Segments.GetSize());
 
-    csmInt32 totalPointCount = 0;
-    csmInt32 totalSegmentCount = 0;
-
-    // Curves
-    for (csmInt32 curveCount = 0; curveCount < _motionData->CurveCount; ++curveCount)
+    for (csmInt32 i = 0; i < segmentCount; ++i)
     {
-        if (strcmp(json->GetMotionCurveTarget(curveCount), TargetNameModel) == 0)
-        {
-            _motionData->Curves[curveCount].Type = CubismMotionCurveTarget_Model;
-        }
-        else if (strcmp(json->GetMotionCurveTarget(curveCount), TargetNameParameter) == 0)
-        {
-            _motionData->Curves[curveCount].Type = CubismMotionCurveTarget_Parameter;
-        }
-        else if (strcmp(json->GetMotionCurveTarget(curveCount), TargetNamePartOpacity) == 0)
-        {
-            _motionData->Curves[curveCount].Type = CubismMotionCurveTarget_PartOpacity;
-        }
-        else
-        {
-            CubismLogWarning("Warning : Unable to get segment type from Curve! The number of \"CurveCount\" may be incorrect!");
-        }
-
-        _motionData->Curves[curveCount].Id = json->GetMotionCurveId(curveCount);
-
-        _motionData->Curves[curveCount].BaseSegmentIndex = totalSegmentCount;
+        CubismMotionSegment& segment = _motionData->Segments[i];
 
-        _motionData->Curves[curveCount].FadeInTime =
-                (json->IsExistMotionCurveFadeInTime(curveCount))
-                    ? json->GetMotionCurveFadeInTime(curveCount)
-                    : -1.0f ;
-        _motionData->Curves[curveCount].FadeOutTime =
-                (json->IsExistMotionCurveFadeOutTime(curveCount))
-                    ? json->GetMotionCurveFadeOutTime(curveCount)
-                    : -1.0f;
-
-        // Segments
-        for (csmInt32 segmentPosition = 0; segmentPosition < json->GetMotionCurveSegmentCount(curveCount);)
+        switch (segment.SegmentType)
         {
-            if (segmentPosition == 0)
+        case CubismMotionSegmentType_Linear:
+            segment.Evaluate = LinearEvaluate;
+            break;
+        case CubismMotionSegmentType_Bezier:
+            if (areBeziersRestricted || UseOldBeziersCurveMotion)
             {
-                _motionData->Segments[totalSegmentCount].BasePointIndex = totalPointCount;
-
-                _motionData->Points[totalPointCount].Time = json->GetMotionCurveSegment(curveCount, segmentPosition);
-                _motionData->Points[totalPointCount].Value = json->GetMotionCurveSegment(curveCount, segmentPosition + 1);
-
-                totalPointCount += 1;
-                segmentPosition += 2;
+                segment.Evaluate = BezierEvaluate;
             }
             else
             {
-                _motionData->Segments[totalSegmentCount].BasePointIndex = totalPointCount - 1;
+                segment.Evaluate = BezierEvaluateCardanoInterpretation;
             }
-
-            const csmInt32 segment = static_cast<csmInt32>(json->GetMotionCurveSegment(curveCount, segmentPosition));
-
-            switch (segment)
-            {
-            case CubismMotionSegmentType_Linear: {
-                _motionData->Segments[totalSegmentCount].SegmentType = CubismMotionSegmentType_Linear;
-                _motionData->Segments[totalSegmentCount].Evaluate = LinearEvaluate;
-
-                _motionData->Points[totalPointCount].Time = json->GetMotionCurveSegment(curveCount, (segmentPosition + 1));
-                _motionData->Points[totalPointCount].Value = json->GetMotionCurveSegment(curveCount, (segmentPosition + 2));
-
-                totalPointCount += 1;
-                segmentPosition += 3;
-
-                break;
-            }
-            case CubismMotionSegmentType_Bezier: {
-                _motionData->Segments[totalSegmentCount].SegmentType = CubismMotionSegmentType_Bezier;
-                if (areBeziersRestricted || UseOldBeziersCurveMotion) {
-                    _motionData->Segments[totalSegmentCount].Evaluate = BezierEvaluate;
-                }
-                else
-                {
-                    _motionData->Segments[totalSegmentCount].Evaluate = BezierEvaluateCardanoInterpretation;
-                }
-
-                _motionData->Points[totalPointCount].Time = json->GetMotionCurveSegment(curveCount, (segmentPosition + 1));
-                _motionData->Points[totalPointCount].Value = json->GetMotionCurveSegment(curveCount, (segmentPosition + 2));
-
-                _motionData->Points[totalPointCount + 1].Time = json->GetMotionCurveSegment(curveCount, (segmentPosition + 3));
-                _motionData->Points[totalPointCount + 1].Value = json->GetMotionCurveSegment(curveCount, (segmentPosition + 4));
-
-                _motionData->Points[totalPointCount + 2].Time = json->GetMotionCurveSegment(curveCount, (segmentPosition + 5));
-                _motionData->Points[totalPointCount + 2].Value = json->GetMotionCurveSegment(curveCount, (segmentPosition + 6));
-
-                totalPointCount += 3;
-                segmentPosition += 7;
-
-                break;
-            }
-            case CubismMotionSegmentType_Stepped: {
-                _motionData->Segments[totalSegmentCount].SegmentType = CubismMotionSegmentType_Stepped;
-                _motionData->Segments[totalSegmentCount].Evaluate = SteppedEvaluate;
-
-                _motionData->Points[totalPointCount].Time = json->GetMotionCurveSegment(curveCount, (segmentPosition + 1));
-                _motionData->Points[totalPointCount].Value = json->GetMotionCurveSegment(curveCount, (segmentPosition + 2));
-
-                totalPointCount += 1;
-                segmentPosition += 3;
-
-                break;
-            }
-            case CubismMotionSegmentType_InverseStepped: {
-                _motionData->Segments[totalSegmentCount].SegmentType = CubismMotionSegmentType_InverseStepped;
-                _motionData->Segments[totalSegmentCount].Evaluate = InverseSteppedEvaluate;
-
-                _motionData->Points[totalPointCount].Time = json->GetMotionCurveSegment(curveCount, (segmentPosition + 1));
-                _motionData->Points[totalPointCount].Value = json->GetMotionCurveSegment(curveCount, (segmentPosition + 2));
-
-                totalPointCount += 1;
-                segmentPosition += 3;
-
-                break;
-            }
-            default: {
-                CSM_ASSERT(0);
-                break;
-            }
-            }
-
-            ++_motionData->Curves[curveCount].SegmentCount;
-            ++totalSegmentCount;
+            break;
+        case CubismMotionSegmentType_Stepped:
+            segment.Evaluate = SteppedEvaluate;
+            break;
+        case CubismMotionSegmentType_InverseStepped:
+            segment.Evaluate = InverseSteppedEvaluate;
+            break;
+        default:
+            CSM_ASSERT(0);
+            break;
         }
     }
 
-    for (csmInt32 userdatacount = 0; userdatacount < json->GetEventCount(); ++userdatacount)
-    {
-        _motionData->Events[userdatacount].FireTime = json->GetEventTime(userdatacount);
-        _motionData->Events[userdatacount].Value = json->GetEventValue(userdatacount);
-    }
-
-    CSM_DELETE(json);
+    // 発火判定で二分探索できるよう時間順に並べておく
+    SortEvents(_motionData->Events);
 }
 
 void CubismMotion::SetParameterFadeInTime(CubismIdHandle parameterId, csmFloat32 value)
 {
+    PrepareMotionDataForWrite();
+
     csmVector<CubismMotionCurve>& curves = _motionData->Curves;
 
     for (csmInt16 i = 0; i < _motionData->CurveCount; ++i)
@@ -834,6 +1715,8 @@ void CubismMotion::SetParameterFadeInTime(CubismIdHandle parameterId, csmFloat32
 
 void CubismMotion::SetParameterFadeOutTime(CubismIdHandle parameterId, csmFloat32 value)
 {
+    PrepareMotionDataForWrite();
+
     csmVector<CubismMotionCurve>& curves = _motionData->Curves;
 
     for (csmInt16 i = 0; i < _motionData->CurveCount; ++i)
@@ -901,16 +1784,51 @@ const csmVector<const csmString*>& CubismMotion::GetFiredEvent(csmFloat32 before
 {
     _firedEventValues.UpdateSize(0);
     /// イベントの発火チェック
-    for (csmInt32 u = 0; u < _motionData->EventCount; ++u)
+    CollectFiredEvents(FindNextEventIndex(_motionData, beforeCheckTimeSeconds), motionTimeSeconds);
+
+    return _firedEventValues;
+}
+
+const csmVector<const csmString*>& CubismMotion::GetFiredEvent(CubismMotionQueueEntry* motionQueueEntry, csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds)
+{
+    if (motionQueueEntry == NULL)
+    {
+        return GetFiredEvent(beforeCheckTimeSeconds, motionTimeSeconds);
+    }
+
+    _firedEventValues.UpdateSize(0);
+
+    // 前回の続きから再生していれば、前回の位置がそのまま beforeCheckTimeSeconds の直後のイベントを指している
+    // シークやループで位置がずれた場合だけ二分探索し直す
+    csmInt32 eventIndex = motionQueueEntry->_eventCursor;
+    const csmBool isCursorValid = eventIndex >= 0 && eventIndex <= _motionData->EventCount
+        && (eventIndex == 0 || _motionData->Events[eventIndex - 1].FireTime <= beforeCheckTimeSeconds)
+        && (eventIndex == _motionData->EventCount || _motionData->Events[eventIndex].FireTime > beforeCheckTimeSeconds);
+
+    if (!isCursorValid)
+    {
+        eventIndex = FindNextEventIndex(_motionData, beforeCheckTimeSeconds);
+    }
+
+    /// イベントの発火チェック
+    motionQueueEntry->_eventCursor = CollectFiredEvents(eventIndex, motionTimeSeconds);
+
+    return _firedEventValues;
+}
+
+csmInt32 CubismMotion::CollectFiredEvents(csmInt32 eventIndex, csmFloat32 motionTimeSeconds)
+{
+    for (; eventIndex < _motionData->EventCount; ++eventIndex)
     {
-        if ((_motionData->Events[u].FireTime >beforeCheckTimeSeconds) &&
-            (_motionData->Events[u].FireTime <= motionTimeSeconds))
+        if (_motionData->Events[eventIndex].FireTime > motionTimeSeconds)
         {
-            _firedEventValues.PushBack(&_motionData->Events[u].Value);
+            break;
         }
+
+        _firedEventValues.PushBack(&_motionData->Events[eventIndex].Value);
     }
 
-    return _firedEventValues;
+    return eventIndex;
 }
 
 csmBool CubismMotion::IsExistModelOpacity() const
@@ -33,6 +33,16 @@ public:
         MotionBehavior_V2,
     };
 
+    /**
+     * Targets of the motion curves
+     */
+    enum CurveTarget
+    {
+        CurveTarget_Model,          ///< Applied to the model (EyeBlink, LipSync, Opacity)
+        CurveTarget_Parameter,      ///< Applied to a parameter
+        CurveTarget_PartOpacity,    ///< Applied to the opacity of a part
+    };
+
     /**
      * Makes an instance.
      *
@@ -46,6 +56,24 @@ public:
      */
     static CubismMotion* Create(const csmByte* buffer, csmSizeInt size, FinishedMotionCallback onFinishedMotionHandler = NULL, BeganMotionCallback onBeganMotionHandler = NULL, csmBool shouldCheckMotionConsistency = false);
 
+    /**
+     * Makes an instance that shares the parsed motion data of another instance.<br>
+     * The curves, points and events are not copied, so the same motion can be played<br>
+     * on many models while being parsed and held in memory only once.
+     *
+     * @param source instance whose motion data is shared
+     * @param onFinishedMotionHandler callback function for when motion playback ends
+     * @param onBeganMotionHandler callback function for when motion playback starts
+     *
+     * @return created instance<br>
+     *         NULL if source is NULL.
+     *
+     * @note The fade times, frame rate and Motion Behavior are copied from source.<br>
+     *       The effect IDs, loop settings and callbacks are set per instance.<br>
+     *       The shared data is released when the last instance referencing it is deleted.
+     */
+    static CubismMotion* CreateShared(const CubismMotion* source, FinishedMotionCallback onFinishedMotionHandler = NULL, BeganMotionCallback onBeganMotionHandler = NULL);
+
     /**
      * Updates the model parameters.
      *
@@ -56,6 +84,29 @@ public:
      */
     virtual void        DoUpdateParameters(CubismModel* model, csmFloat32 userTimeSeconds, csmFloat32 fadeWeight, CubismMotionQueueEntry* motionQueueEntry);
 
+    /**
+     * Evaluates the parameter curves of the motion for many instances at once.<br>
+     * Each curve is evaluated for all instances together. Instances whose times fall in the same segment<br>
+     * share the segment lookup, and linear and stepped segments are evaluated in one loop over the instances.
+     *
+     * @param model model used to find the parameter and part indices; every instance must use the same moc
+     * @param timeSeconds array of instanceCount playback times in seconds, with the motion start set to zero
+     * @param parameterValues array of instanceCount parameter arrays, each indexed by parameter index of the model
+     * @param instanceCount number of instances
+     * @param fadeWeights array of instanceCount weights to blend with the current parameter values, or NULL to overwrite them
+     * @param partOpacities array of instanceCount part opacity arrays, each indexed by part index of the model,<br>
+     *                      or NULL to skip the part opacity curves
+     *
+     * @note Only parameter and part opacity curves are evaluated. Eye blink, lip sync, opacity and<br>
+     *       per-curve fades, which depend on a queue entry, are not applied.<br>
+     *       Part opacities are overwritten without fadeWeights. Curves whose IDs are not in the model are skipped,<br>
+     *       and the model is not modified.<br>
+     *       Values are written without applying the parameter range. When writing into the parameter arrays<br>
+     *       of models, wrap the call in CubismModel::BeginParameterAccumulation() and EndParameterAccumulation().<br>
+     *       Sorting the instances by time increases the number of shared segment lookups.
+     */
+    void        EvaluateBatch(CubismModel* model, const csmFloat32* timeSeconds, csmFloat32* const* parameterValues, csmInt32 instanceCount, const csmFloat32* fadeWeights = NULL, csmFloat32* const* partOpacities = NULL);
+
     /**
      * Sets the version of the Motion Behavior.
      *
@@ -70,6 +121,64 @@ public:
      */
     MotionBehavior GetMotionBehavior() const;
 
+    /**
+     * Returns the number of bytes held by the parsed motion data.<br>
+     * Motions created with CreateShared() report the size of the data they share.
+     *
+     * @return size of the motion data in bytes
+     */
+    csmSizeType GetMotionDataSize() const;
+
+    /**
+     * Returns the number of curves in the motion.<br>
+     * This is the number of values written by Sample() for one time.
+     *
+     * @return number of curves
+     */
+    csmInt32 GetCurveCount() const;
+
+    /**
+     * Returns the ID of the parameter, part or model value the curve is applied to.
+     *
+     * @param curveIndex index of the curve
+     *
+     * @return ID of the curve<br>
+     *         NULL if the index is out of range.
+     */
+    CubismIdHandle GetCurveId(csmInt32 curveIndex) const;
+
+    /**
+     * Returns what the curve is applied to.
+     *
+     * @param curveIndex index of the curve
+     *
+     * @return target of the curve
+     */
+    CurveTarget GetCurveTarget(csmInt32 curveIndex) const;
+
+    /**
+     * Samples every curve of the motion at a time without a model.
+     *
+     * @param timeSeconds time from the start of the motion in seconds; wrapped in the same way as playback when the motion loops
+     * @param values array of GetCurveCount() elements that receives the value of each curve in curve order
+     *
+     * @note Fades, eye blink and lip sync are not applied, and values are not clamped to any parameter range.<br>
+     *       Does not modify the instance, so it can be called from several threads at once.
+     */
+    void Sample(csmFloat32 timeSeconds, csmFloat32* values) const;
+
+    /**
+     * Samples every curve of the motion at evenly spaced times into a matrix.
+     *
+     * @param startTimeSeconds time of the first sample in seconds
+     * @param intervalSeconds interval between samples in seconds
+     * @param sampleCount number of samples
+     * @param values array of sampleCount * GetCurveCount() elements; row i receives the values at startTimeSeconds + i * intervalSeconds
+     *
+     * @note See Sample() for how each row is evaluated.
+     */
+    void SampleRange(csmFloat32 startTimeSeconds, csmFloat32 intervalSeconds, csmInt32 sampleCount, csmFloat32* values) const;
+
     /**
      * Returns the length of the motion.
      *
@@ -143,6 +252,21 @@ public:
      */
     virtual const csmVector<const csmString*>& GetFiredEvent(csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds);
 
+    /**
+     * Returns the triggered user data events for a playback.<br>
+     * The position of the next event is kept on the queue entry, so a playback moving forward<br>
+     * only visits the events that fire. Seeks and loops find the position with a binary search.
+     *
+     * @param motionQueueEntry motion managed by the CubismMotionQueueManager
+     * @param beforeCheckTimeSeconds previous playback time in seconds
+     * @param motionTimeSeconds current playback time in seconds
+     *
+     * @return instance of the collection of triggered user data events
+     *
+     * @note The input times should be in seconds, with the motion timing set to zero.
+     */
+    virtual const csmVector<const csmString*>& GetFiredEvent(CubismMotionQueueEntry* motionQueueEntry, csmFloat32 beforeCheckTimeSeconds, csmFloat32 motionTimeSeconds);
+
     /**
      * Checks whether there is an opacity curve.
      *
@@ -165,6 +289,13 @@ public:
     CubismIdHandle GetModelOpacityId(csmInt32 index);
 
 protected:
+    /**
+     * Returns the model opacity last evaluated by this instance.
+     *
+     * @return model opacity
+     *
+     * @note The opacity of each playback is kept on its CubismMotionQueueEntry; this returns the value of the latest one.
+     */
     csmFloat32 GetModelOpacityValue() const;
 
 private:
@@ -179,12 +310,37 @@ private:
 
     void Parse(const csmByte* motionJson, const csmSizeInt size, csmBool shouldCheckMotionConsistency);
 
+    /**
+     * Makes the motion data owned only by this instance before it is modified.
+     */
+    void PrepareMotionDataForWrite();
+
+    /**
+     * Collects the events that fire after beforeCheckTimeSeconds and up to motionTimeSeconds.
+     *
+     * @param eventIndex index of the first event whose fire time is after beforeCheckTimeSeconds
+     * @param motionTimeSeconds current playback time in seconds
+     *
+     * @return index of the first event that did not fire
+     */
+    csmInt32 CollectFiredEvents(csmInt32 eventIndex, csmFloat32 motionTimeSeconds);
+
+    /**
+     * Evaluates every curve at the same time into the curve value buffer.<br>
+     * Bezier segments of different curves are gathered into lanes and evaluated together.
+     *
+     * @param time time to evaluate in seconds
+     * @param isCorrection true to correct the end point toward the start point of a looping motion
+     * @param endTime end time of the motion in seconds
+     */
+    void EvaluateCurves(csmFloat32 time, csmBool isCorrection, csmFloat32 endTime);
+
     csmFloat32      _sourceFrameRate;
     csmFloat32      _loopDurationSeconds;
     MotionBehavior  _motionBehavior;
     csmFloat32      _lastWeight;
 
-    CubismMotionData*    _motionData;
+    CubismMotionData*    _motionData;   ///< Motion data, possibly shared with other instances
 
     csmVector<CubismIdHandle>  _eyeBlinkParameterIds;
     csmVector<CubismIdHandle>  _lipSyncParameterIds;
@@ -194,6 +350,10 @@ private:
     CubismIdHandle _modelCurveIdOpacity;
 
     csmFloat32 _modelOpacity;
+
+    csmVector<csmFloat32>  _batchTimes;     ///< Work buffer for EvaluateBatch() holding the looped times
+    csmVector<csmFloat32>  _batchValues;    ///< Work buffer for EvaluateBatch() holding the curve values
+    csmVector<csmFloat32>  _curveValues;    ///< Values of every curve evaluated by DoUpdateParameters()
 };
 
 }}}
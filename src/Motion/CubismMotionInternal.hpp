@@ -8,6 +8,7 @@
 #pragma once
 
 #include "CubismFramework.hpp"
+#include <atomic>
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -118,6 +119,10 @@ struct CubismMotionEvent
 
 /**
  * Data for motion
+ *
+ * @note Shared by every CubismMotion created from the same motion3.json with CubismMotion::CreateShared().<br>
+ *       Treated as read-only while shared; a CubismMotion that modifies its curves makes its own copy first.<br>
+ *       The reference count is atomic, so instances sharing the data may be created and deleted on different threads.
  */
 struct CubismMotionData
 {
@@ -130,6 +135,24 @@ struct CubismMotionData
         , CurveCount(0)
         , EventCount(0)
         , Fps(0.0f)
+        , ReferenceCount(1)
+    { }
+
+    /**
+     * Copy constructor<br>
+     * The copy starts with a single reference.
+     */
+    CubismMotionData(const CubismMotionData& other)
+        : Duration(other.Duration)
+        , Loop(other.Loop)
+        , CurveCount(other.CurveCount)
+        , EventCount(other.EventCount)
+        , Fps(other.Fps)
+        , Curves(other.Curves)
+        , Segments(other.Segments)
+        , Points(other.Points)
+        , Events(other.Events)
+        , ReferenceCount(1)
     { }
 
     csmFloat32 Duration;                            ///< Motion length [seconds]
@@ -141,6 +164,11 @@ struct CubismMotionData
     csmVector<CubismMotionSegment> Segments;        ///< Segment collection
     csmVector<CubismMotionPoint> Points;            ///< Control point collection
     csmVector<CubismMotionEvent> Events;            ///< User data event collection
+    std::atomic<csmInt32> ReferenceCount;           ///< Number of CubismMotion instances referencing this data
+
+private:
+    // Prevention of assignment
+    CubismMotionData& operator=(const CubismMotionData&);
 };
 
 }}}
@@ -9,6 +9,8 @@
 #include "CubismMotionInternal.hpp"
 #include "Id/CubismId.hpp"
 #include "Id/CubismIdManager.hpp"
+#include "Utils/CubismProfiler.hpp"
+#include <math.h>
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -33,6 +35,33 @@ const csmChar* UserDataCount = "UserDataCount";
 const csmChar* TotalUserDataSize = "TotalUserDataSize";
 const csmChar* Time = "Time";
 const csmChar* Value = "Value";
+
+// Target
+const csmChar* TargetNameModel = "Model";
+const csmChar* TargetNameParameter = "Parameter";
+const csmChar* TargetNamePartOpacity = "PartOpacity";
+
+/**
+ * 読み込んだキーが指定の名前と一致するか
+ */
+csmBool IsKey(const csmChar* key, csmInt32 keyLength, const csmChar* name)
+{
+    return strncmp(key, name, keyLength) == 0 && name[keyLength] == '\0';
+}
+
+/**
+ * 容量の予約に使うメタデータの個数を、ファイルサイズで頭打ちにする<br>
+ * 1要素に少なくとも1バイトは要るため、壊れたメタデータで巨大な領域を確保しない
+ */
+csmInt32 GetCapacityHint(csmInt32 metaCount, csmInt32 bufferSize)
+{
+    if (metaCount <= 0)
+    {
+        return 0;
+    }
+
+    return (metaCount < bufferSize) ? metaCount : bufferSize;
+}
 }
 
 CubismMotionJson::CubismMotionJson(const csmByte* buffer, csmSizeInt size)
@@ -238,4 +267,855 @@ const csmChar* CubismMotionJson::GetEventValue(csmInt32 userDataIndex) const
     return _json->GetRoot()[UserData][userDataIndex][Value].GetRawString();
 }
 
+CubismMotionJsonReader::CubismMotionJsonReader(const csmByte* buffer, csmSizeInt size)
+    : _buffer(reinterpret_cast<const csmChar*>(buffer))
+    , _size(static_cast<csmInt32>(size))
+    , _position(0)
+    , _error(NULL)
+    , _duration(0.0f)
+    , _isLoop(false)
+    , _areBeziersRestricted(false)
+    , _fps(0.0f)
+    , _isExistFadeInTime(false)
+    , _isExistFadeOutTime(false)
+    , _fadeInTime(0.0f)
+    , _fadeOutTime(0.0f)
+    , _metaCurveCount(0)
+    , _metaTotalSegmentCount(0)
+    , _metaTotalPointCount(0)
+    , _metaUserDataCount(0)
+    , _curveCount(0)
+    , _totalSegmentCount(0)
+    , _totalPointCount(0)
+{
+    if (_buffer == NULL)
+    {
+        _size = 0;
+    }
+}
+
+csmBool CubismMotionJsonReader::Read(CubismMotionData& motionData)
+{
+    csmBool isFirst = true;
+
+    // UTF-8のBOMを読み飛ばす
+    if (_size >= 3 && static_cast<csmUint8>(_buffer[0]) == 0xEF && static_cast<csmUint8>(_buffer[1]) == 0xBB && static_cast<csmUint8>(_buffer[2]) == 0xBF)
+    {
+        _position = 3;
+    }
+
+    if (Expect('{'))
+    {
+        CSM_PROFILE_COUNT(Counter_JsonNodes, 1);
+
+        while (NextElement('}', isFirst))
+        {
+            const csmChar* key;
+            csmInt32 keyLength;
+
+            if (!ReadKey(key, keyLength))
+            {
+                break;
+            }
+
+            if (IsKey(key, keyLength, Meta))
+            {
+                ReadMeta();
+            }
+            else if (IsKey(key, keyLength, Curves))
+            {
+                ReadCurves(motionData);
+            }
+            else if (IsKey(key, keyLength, UserData))
+            {
+                ReadUserData(motionData);
+            }
+            else
+            {
+                SkipValue();
+            }
+
+            if (_error)
+            {
+                break;
+            }
+        }
+    }
+
+    if (_error)
+    {
+        CubismLogError("[CubismMotionJsonReader] Invalid motion3.json. %s (position: %d)", _error, _position);
+        return false;
+    }
+
+    motionData.Duration = _duration;
+    motionData.Loop = _isLoop;
+    motionData.Fps = _fps;
+    motionData.CurveCount = static_cast<csmInt16>(_curveCount);
+    motionData.EventCount = static_cast<csmInt32>(motionData.Events.GetSize());
+
+    return true;
+}
+
+csmBool CubismMotionJsonReader::HasConsistency() const
+{
+    csmBool result = true;
+
+    if (_error)
+    {
+        return false;
+    }
+
+    // 個数チェック
+    if (_curveCount != _metaCurveCount)
+    {
+        CubismLogWarning("The number of curves does not match the metadata.");
+        result = false;
+    }
+    if (_totalSegmentCount != _metaTotalSegmentCount)
+    {
+        CubismLogWarning("The number of segment does not match the metadata.");
+        result = false;
+    }
+    if (_totalPointCount != _metaTotalPointCount)
+    {
+        CubismLogWarning("The number of point does not match the metadata.");
+        result = false;
+    }
+
+    return result;
+}
+
+csmBool CubismMotionJsonReader::GetEvaluationOptionFlag(const csmInt32 flagType) const
+{
+    if (EvaluationOptionFlag_AreBeziersRestricted == flagType)
+    {
+        return _areBeziersRestricted;
+    }
+
+    return false;
+}
+
+csmBool CubismMotionJsonReader::IsExistMotionFadeInTime() const
+{
+    return _isExistFadeInTime;
+}
+
+csmBool CubismMotionJsonReader::IsExistMotionFadeOutTime() const
+{
+    return _isExistFadeOutTime;
+}
+
+csmFloat32 CubismMotionJsonReader::GetMotionFadeInTime() const
+{
+    return _fadeInTime;
+}
+
+csmFloat32 CubismMotionJsonReader::GetMotionFadeOutTime() const
+{
+    return _fadeOutTime;
+}
+
+void CubismMotionJsonReader::SkipWhitespace()
+{
+    while (_position < _size)
+    {
+        switch (_buffer[_position])
+        {
+        case ' ': case '\t': case '\r': case '\n':
+            ++_position;
+            break;
+        default:
+            return;
+        }
+    }
+}
+
+csmBool CubismMotionJsonReader::Expect(csmChar c)
+{
+    SkipWhitespace();
+
+    if (_position >= _size || _buffer[_position] != c)
+    {
+        if (!_error)
+        {
+            _error = "unexpected character";
+        }
+        return false;
+    }
+
+    ++_position;
+    return true;
+}
+
+csmBool CubismMotionJsonReader::NextElement(csmChar closing, csmBool& isFirst)
+{
+    if (_error)
+    {
+        return false;
+    }
+
+    SkipWhitespace();
+
+    // 2つ目以降の要素の前には , が必要
+    if (!isFirst && _position < _size && _buffer[_position] == ',')
+    {
+        ++_position;
+        SkipWhitespace();
+    }
+    else if (!isFirst && (_position >= _size || _buffer[_position] != closing))
+    {
+        _error = "missing ',' between elements";
+        return false;
+    }
+    isFirst = false;
+
+    if (_position >= _size)
+    {
+        _error = "unexpected end of file";
+        return false;
+    }
+
+    // 空の配列・オブジェクトと、末尾の不要な , はここで閉じる
+    if (_buffer[_position] == closing)
+    {
+        ++_position;
+        return false;
+    }
+
+    // 要素ごとに1つの値を読むため、CubismJsonの値の数と揃えてここで数える
+    CSM_PROFILE_COUNT(Counter_JsonNodes, 1);
+
+    return true;
+}
+
+csmBool CubismMotionJsonReader::ReadKey(const csmChar*& key, csmInt32& keyLength)
+{
+    csmBool isEscaped;
+
+    if (!Expect('\"'))
+    {
+        return false;
+    }
+
+    // motion3.jsonのキーはエスケープを含まないため、バッファ上の文字列をそのまま比較する
+    if (!ReadStringRange(key, keyLength, isEscaped))
+    {
+        return false;
+    }
+
+    return Expect(':');
+}
+
+csmBool CubismMotionJsonReader::ReadStringRange(const csmChar*& begin, csmInt32& length, csmBool& isEscaped)
+{
+    const csmInt32 start = _position;
+
+    isEscaped = false;
+
+    for (; _position < _size; ++_position)
+    {
+        if (_buffer[_position] == '\"')
+        {
+            begin = _buffer + start;
+            length = _position - start;
+            ++_position;
+            return true;
+        }
+
+        if (_buffer[_position] == '\\')
+        {
+            // エスケープは2文字をセットで扱う
+            isEscaped = true;
+            ++_position;
+        }
+    }
+
+    _error = "unterminated string";
+    return false;
+}
+
+csmBool CubismMotionJsonReader::ReadString(csmString& value)
+{
+    const csmChar* begin;
+    csmInt32 length;
+    csmBool isEscaped;
+
+    if (!Expect('\"') || !ReadStringRange(begin, length, isEscaped))
+    {
+        return false;
+    }
+
+    if (!isEscaped)
+    {
+        value = csmString(begin, length);
+        return true;
+    }
+
+    // エスケープを含む場合だけ1文字ずつ組み立てる
+    value = "";
+    csmInt32 runStart = 0;
+    for (csmInt32 i = 0; i < length; ++i)
+    {
+        if (begin[i] != '\\')
+        {
+            continue;
+        }
+
+        value.Append(begin + runStart, i - runStart);
+        ++i;
+
+        switch (begin[i])
+        {
+        case '\\': value.Append(1, '\\'); break;
+        case '\"': value.Append(1, '\"'); break;
+        case '/': value.Append(1, '/'); break;
+        case 'b': value.Append(1, '\b'); break;
+        case 'f': value.Append(1, '\f'); break;
+        case 'n': value.Append(1, '\n'); break;
+        case 'r': value.Append(1, '\r'); break;
+        case 't': value.Append(1, '\t'); break;
+        case 'u':
+            _error = "unicode escape not supported";
+            return false;
+        default:
+            break;
+        }
+
+        runStart = i + 1;
+    }
+    value.Append(begin + runStart, length - runStart);
+
+    return true;
+}
+
+csmBool CubismMotionJsonReader::ReadNumber(csmFloat32& value)
+{
+    csmBool isNegative = false;
+    csmBool isDigitFound = false;
+    csmFloat32 decimalMultiplier = 0.1f;
+
+    SkipWhitespace();
+
+    if (_position < _size && _buffer[_position] == '-')
+    {
+        isNegative = true;
+        ++_position;
+    }
+
+    // CubismJsonと同じ順序で積み上げ、DOM経由で読んだ場合と同じ値にする
+    value = 0.0f;
+    for (; _position < _size && _buffer[_position] >= '0' && _buffer[_position] <= '9'; ++_position)
+    {
+        value = value * 10 + (_buffer[_position] - '0');
+        isDigitFound = true;
+    }
+
+    if (_position < _size && _buffer[_position] == '.')
+    {
+        for (++_position; _position < _size && _buffer[_position] >= '0' && _buffer[_position] <= '9'; ++_position)
+        {
+            value += (_buffer[_position] - '0') * decimalMultiplier;
+            decimalMultiplier *= 0.1f;
+            isDigitFound = true;
+        }
+    }
+
+    if (!isDigitFound)
+    {
+        _error = "number expected";
+        return false;
+    }
+
+    if (_position < _size && (_buffer[_position] == 'e' || _buffer[_position] == 'E'))
+    {
+        csmBool isExponentNegative = false;
+        csmInt32 exponent = 0;
+
+        ++_position;
+        if (_position < _size && (_buffer[_position] == '-' || _buffer[_position] == '+'))
+        {
+            isExponentNegative = (_buffer[_position] == '-');
+            ++_position;
+        }
+        for (; _position < _size && _buffer[_position] >= '0' && _buffer[_position] <= '9'; ++_position)
+        {
+            exponent = exponent * 10 + (_buffer[_position] - '0');
+        }
+
+        value *= powf(10.0f, static_cast<csmFloat32>(isExponentNegative ? -exponent : exponent));
+    }
+
+    if (isNegative)
+    {
+        value *= -1;
+    }
+
+    return true;
+}
+
+csmBool CubismMotionJsonReader::ReadOptionalNumber(csmFloat32& value, csmBool& isExist)
+{
+    SkipWhitespace();
+
+    // null は値が無いものとして扱う
+    if (_position + 4 <= _size && strncmp(_buffer + _position, "null", 4) == 0)
+    {
+        _position += 4;
+        isExist = false;
+        return true;
+    }
+
+    isExist = ReadNumber(value);
+    return isExist;
+}
+
+csmBool CubismMotionJsonReader::ReadBoolean(csmBool& value)
+{
+    csmFloat32 number;
+
+    SkipWhitespace();
+
+    if (_position + 4 <= _size && strncmp(_buffer + _position, "true", 4) == 0)
+    {
+        _position += 4;
+        value = true;
+        return true;
+    }
+    if (_position + 5 <= _size && strncmp(_buffer + _position, "false", 5) == 0)
+    {
+        _position += 5;
+        value = false;
+        return true;
+    }
+    if (_position + 4 <= _size && strncmp(_buffer + _position, "null", 4) == 0)
+    {
+        _position += 4;
+        value = false;
+        return true;
+    }
+
+    if (!ReadNumber(number))
+    {
+        return false;
+    }
+
+    value = (number != 0.0f);
+    return true;
+}
+
+csmBool CubismMotionJsonReader::SkipValue()
+{
+    const csmChar* begin;
+    csmInt32 length;
+    csmBool isEscaped;
+    csmBool isFirst = true;
+    csmBool boolean;
+    csmFloat32 number;
+
+    SkipWhitespace();
+
+    if (_position >= _size)
+    {
+        _error = "unexpected end of file";
+        return false;
+    }
+
+    switch (_buffer[_position])
+    {
+    case '{':
+        ++_position;
+        while (NextElement('}', isFirst))
+        {
+            if (!ReadKey(begin, length) || !SkipValue())
+            {
+                return false;
+            }
+        }
+        break;
+    case '[':
+        ++_position;
+        while (NextElement(']', isFirst))
+        {
+            if (!SkipValue())
+            {
+                return false;
+            }
+        }
+        break;
+    case '\"':
+        ++_position;
+        return ReadStringRange(begin, length, isEscaped);
+    case 't': case 'f': case 'n':
+        return ReadBoolean(boolean);
+    default:
+        return ReadNumber(number);
+    }
+
+    return !_error;
+}
+
+csmBool CubismMotionJsonReader::ReadMeta()
+{
+    csmBool isFirst = true;
+    csmFloat32 number;
+
+    if (!Expect('{'))
+    {
+        return false;
+    }
+
+    while (NextElement('}', isFirst))
+    {
+        const csmChar* key;
+        csmInt32 keyLength;
+
+        if (!ReadKey(key, keyLength))
+        {
+            return false;
+        }
+
+        if (IsKey(key, keyLength, Duration))
+        {
+            ReadNumber(_duration);
+        }
+        else if (IsKey(key, keyLength, Loop))
+        {
+            ReadBoolean(_isLoop);
+        }
+        else if (IsKey(key, keyLength, AreBeziersRestricted))
+        {
+            ReadBoolean(_areBeziersRestricted);
+        }
+        else if (IsKey(key, keyLength, Fps))
+        {
+            ReadNumber(_fps);
+        }
+        else if (IsKey(key, keyLength, FadeInTime))
+        {
+            ReadOptionalNumber(_fadeInTime, _isExistFadeInTime);
+        }
+        else if (IsKey(key, keyLength, FadeOutTime))
+        {
+            ReadOptionalNumber(_fadeOutTime, _isExistFadeOutTime);
+        }
+        else if (IsKey(key, keyLength, CurveCount))
+        {
+            if (ReadNumber(number))
+            {
+                _metaCurveCount = static_cast<csmInt32>(number);
+            }
+        }
+        else if (IsKey(key, keyLength, TotalSegmentCount))
+        {
+            if (ReadNumber(number))
+            {
+                _metaTotalSegmentCount = static_cast<csmInt32>(number);
+            }
+        }
+        else if (IsKey(key, keyLength, TotalPointCount))
+        {
+            if (ReadNumber(number))
+            {
+                _metaTotalPointCount = static_cast<csmInt32>(number);
+            }
+        }
+        else if (IsKey(key, keyLength, UserDataCount))
+        {
+            if (ReadNumber(number))
+            {
+                _metaUserDataCount = static_cast<csmInt32>(number);
+            }
+        }
+        else
+        {
+            SkipValue();
+        }
+
+        if (_error)
+        {
+            return false;
+        }
+    }
+
+    return !_error;
+}
+
+csmBool CubismMotionJsonReader::ReadCurves(CubismMotionData& motionData)
+{
+    csmBool isFirst = true;
+
+    if (!Expect('['))
+    {
+        return false;
+    }
+
+    // 通常は Meta が先にあるため、その個数で領域を一度に確保しておく
+    motionData.Curves.PrepareCapacity(GetCapacityHint(_metaCurveCount, _size));
+    motionData.Segments.PrepareCapacity(GetCapacityHint(_metaTotalSegmentCount, _size));
+    motionData.Points.PrepareCapacity(GetCapacityHint(_metaTotalPointCount, _size));
+
+    while (NextElement(']', isFirst))
+    {
+        if (!ReadCurve(motionData))
+        {
+            return false;
+        }
+    }
+
+    return !_error;
+}
+
+csmBool CubismMotionJsonReader::ReadCurve(CubismMotionData& motionData)
+{
+    CubismMotionCurve curve;
+    csmBool isFirst = true;
+    csmBool isExist;
+    csmString text;
+
+    curve.BaseSegmentIndex = static_cast<csmInt32>(motionData.Segments.GetSize());
+    curve.FadeInTime = -1.0f;
+    curve.FadeOutTime = -1.0f;
+
+    if (!Expect('{'))
+    {
+        return false;
+    }
+
+    while (NextElement('}', isFirst))
+    {
+        const csmChar* key;
+        csmInt32 keyLength;
+
+        if (!ReadKey(key, keyLength))
+        {
+            return false;
+        }
+
+        if (IsKey(key, keyLength, Target))
+        {
+            if (!ReadString(text))
+            {
+                return false;
+            }
+
+            if (text == TargetNameModel)
+            {
+                curve.Type = CubismMotionCurveTarget_Model;
+            }
+            else if (text == TargetNameParameter)
+            {
+                curve.Type = CubismMotionCurveTarget_Parameter;
+            }
+            else if (text == TargetNamePartOpacity)
+            {
+                curve.Type = CubismMotionCurveTarget_PartOpacity;
+            }
+            else
+            {
+                CubismLogWarning("Warning : Unable to get segment type from Curve! The number of \"CurveCount\" may be incorrect!");
+            }
+        }
+        else if (IsKey(key, keyLength, Id))
+        {
+            if (!ReadString(text))
+            {
+                return false;
+            }
+
+            curve.Id = CubismFramework::GetIdManager()->GetId(text);
+        }
+        else if (IsKey(key, keyLength, FadeInTime))
+        {
+            ReadOptionalNumber(curve.FadeInTime, isExist);
+            if (!isExist)
+            {
+                curve.FadeInTime = -1.0f;
+            }
+        }
+        else if (IsKey(key, keyLength, FadeOutTime))
+        {
+            ReadOptionalNumber(curve.FadeOutTime, isExist);
+            if (!isExist)
+            {
+                curve.FadeOutTime = -1.0f;
+            }
+        }
+        else if (IsKey(key, keyLength, Segments))
+        {
+            ReadSegments(motionData, curve.SegmentCount);
+        }
+        else
+        {
+            SkipValue();
+        }
+
+        if (_error)
+        {
+            return false;
+        }
+    }
+
+    if (_error)
+    {
+        return false;
+    }
+
+    motionData.Curves.PushBack(curve);
+    ++_curveCount;
+
+    return true;
+}
+
+csmBool CubismMotionJsonReader::ReadSegments(CubismMotionData& motionData, csmInt32& segmentCount)
+{
+    csmBool isFirst = true;
+    csmBool isFirstPoint = true;
+    csmFloat32 values[7];
+    csmInt32 valueCount = 0;
+    csmInt32 requiredCount = 2;
+    csmInt32 segmentType = CubismMotionSegmentType_Linear;
+
+    if (!Expect('['))
+    {
+        return false;
+    }
+
+    // 先頭の制御点の後は、セグメントの種類に続いて 1 または 3 個の制御点が並ぶ
+    while (NextElement(']', isFirst))
+    {
+        if (!ReadNumber(values[valueCount]))
+        {
+            return false;
+        }
+        ++valueCount;
+
+        if (!isFirstPoint && valueCount == 1)
+        {
+            segmentType = static_cast<csmInt32>(values[0]);
+
+            switch (segmentType)
+            {
+            case CubismMotionSegmentType_Linear:
+            case CubismMotionSegmentType_Stepped:
+            case CubismMotionSegmentType_InverseStepped:
+                requiredCount = 3;
+                break;
+            case CubismMotionSegmentType_Bezier:
+                requiredCount = 7;
+                break;
+            default:
+                _error = "unknown segment type";
+                return false;
+            }
+        }
+
+        if (valueCount < requiredCount)
+        {
+            continue;
+        }
+
+        if (isFirstPoint)
+        {
+            CubismMotionPoint point;
+            point.Time = values[0];
+            point.Value = values[1];
+            motionData.Points.PushBack(point);
+            ++_totalPointCount;
+
+            isFirstPoint = false;
+        }
+        else
+        {
+            CubismMotionSegment segment;
+            segment.BasePointIndex = static_cast<csmInt32>(motionData.Points.GetSize()) - 1;
+            segment.SegmentType = segmentType;
+            motionData.Segments.PushBack(segment);
+
+            for (csmInt32 i = 1; i < requiredCount; i += 2)
+            {
+                CubismMotionPoint point;
+                point.Time = values[i];
+                point.Value = values[i + 1];
+                motionData.Points.PushBack(point);
+                ++_totalPointCount;
+            }
+
+            ++segmentCount;
+            ++_totalSegmentCount;
+        }
+
+        valueCount = 0;
+        requiredCount = 1;
+    }
+
+    if (!_error && valueCount != 0)
+    {
+        _error = "segments end in the middle of a segment";
+    }
+
+    return !_error;
+}
+
+csmBool CubismMotionJsonReader::ReadUserData(CubismMotionData& motionData)
+{
+    csmBool isFirst = true;
+
+    if (!Expect('['))
+    {
+        return false;
+    }
+
+    motionData.Events.PrepareCapacity(GetCapacityHint(_metaUserDataCount, _size));
+
+    while (NextElement(']', isFirst))
+    {
+        CubismMotionEvent event;
+        csmBool isFirstKey = true;
+
+        if (!Expect('{'))
+        {
+            return false;
+        }
+
+        while (NextElement('}', isFirstKey))
+        {
+            const csmChar* key;
+            csmInt32 keyLength;
+
+            if (!ReadKey(key, keyLength))
+            {
+                return false;
+            }
+
+            if (IsKey(key, keyLength, Time))
+            {
+                ReadNumber(event.FireTime);
+            }
+            else if (IsKey(key, keyLength, Value))
+            {
+                ReadString(event.Value);
+            }
+            else
+            {
+                SkipValue();
+            }
+
+            if (_error)
+            {
+                return false;
+            }
+        }
+
+        if (_error)
+        {
+            return false;
+        }
+
+        motionData.Events.PushBack(event);
+    }
+
+    return !_error;
+}
+
 }}}
@@ -14,6 +14,8 @@
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
+struct CubismMotionData;
+
 enum EvaluationOptionFlag
 {
     EvaluationOptionFlag_AreBeziersRestricted = 0,
@@ -230,4 +232,234 @@ public:
     const csmChar* GetEventValue(csmInt32 userDataIndex) const;
 };
 
+/**
+ * Reads a motion file directly into CubismMotionData in a single pass.<br>
+ * Unlike CubismMotionJson, no JSON document is built; segments are decoded as their numbers are scanned.
+ */
+class CubismMotionJsonReader
+{
+public:
+    /**
+     * Constructor
+     *
+     * @param buffer buffer containing the loaded motion file
+     * @param size size of the buffer in bytes
+     */
+    CubismMotionJsonReader(const csmByte* buffer, csmSizeInt size);
+
+    /**
+     * Reads the motion file into the motion data.<br>
+     * Curves, segments, points and user data events are appended, and the counts are set from what was actually read.
+     *
+     * @param motionData motion data to fill; expected to be empty
+     *
+     * @return true if the file was read; false if it is not a valid motion file.
+     *
+     * @note Evaluate of each segment is left NULL; pick it from the segment type and GetEvaluationOptionFlag().
+     */
+    csmBool Read(CubismMotionData& motionData);
+
+    /**
+     * Returns the consistency of the motion file read by Read().
+     *
+     * @return true if the counts in the metadata match the contents; otherwise false.
+     */
+    csmBool HasConsistency() const;
+
+    /**
+     * Returns the option settings used during the motion curve evaluation.
+     *
+     * @param flagType option to retrieve
+     *
+     * @return option setting; true if enabled
+     *
+     * @note Use EvaluationOptionFlag to specify the option to retrieve.
+     */
+    csmBool GetEvaluationOptionFlag(csmInt32 flagType) const;
+
+    /**
+     * Checks whether the fade-in duration of the motion is set.
+     *
+     * @return true if the fade-in duration is set; otherwise false.
+     */
+    csmBool IsExistMotionFadeInTime() const;
+
+    /**
+     * Checks whether the fade-out duration of the motion is set.
+     *
+     * @return true if the fade-out duration is set; otherwise false.
+     */
+    csmBool IsExistMotionFadeOutTime() const;
+
+    /**
+     * Returns the fade-in duration of the motion.
+     *
+     * @return fade-in duration in seconds
+     */
+    csmFloat32 GetMotionFadeInTime() const;
+
+    /**
+     * Returns the fade-out duration of the motion.
+     *
+     * @return fade-out duration in seconds
+     */
+    csmFloat32 GetMotionFadeOutTime() const;
+
+private:
+    /**
+     * Advances the read position past whitespace.
+     */
+    void SkipWhitespace();
+
+    /**
+     * Reads the expected character after any whitespace.
+     *
+     * @param c character to read
+     *
+     * @return true if the character was read; otherwise false and the error is set.
+     */
+    csmBool Expect(csmChar c);
+
+    /**
+     * Advances to the next element of an array or object.
+     *
+     * @param closing closing bracket of the array or object
+     * @param isFirst true before the first element; updated by this function
+     *
+     * @return true if another element follows; false if the closing bracket was read or an error occurred.
+     */
+    csmBool NextElement(csmChar closing, csmBool& isFirst);
+
+    /**
+     * Reads an object key and the following colon.
+     *
+     * @param key receives the key within the buffer; not null-terminated
+     * @param keyLength receives the length of the key
+     *
+     * @return true if the key was read; otherwise false.
+     */
+    csmBool ReadKey(const csmChar*& key, csmInt32& keyLength);
+
+    /**
+     * Finds the end of a string whose opening quote has already been read.
+     *
+     * @param begin receives the first character of the string within the buffer
+     * @param length receives the length of the string, escapes included
+     * @param isEscaped receives whether the string contains escapes
+     *
+     * @return true if the string was read; otherwise false.
+     */
+    csmBool ReadStringRange(const csmChar*& begin, csmInt32& length, csmBool& isEscaped);
+
+    /**
+     * Reads a string value, resolving escapes.
+     *
+     * @param value receives the string
+     *
+     * @return true if the string was read; otherwise false.
+     */
+    csmBool ReadString(csmString& value);
+
+    /**
+     * Reads a number value.
+     *
+     * @param value receives the number
+     *
+     * @return true if the number was read; otherwise false.
+     */
+    csmBool ReadNumber(csmFloat32& value);
+
+    /**
+     * Reads a number value that may be null.
+     *
+     * @param value receives the number; unchanged for null
+     * @param isExist receives false for null
+     *
+     * @return true if the value was read; otherwise false.
+     */
+    csmBool ReadOptionalNumber(csmFloat32& value, csmBool& isExist);
+
+    /**
+     * Reads a boolean value. null reads as false and numbers read as true when non-zero.
+     *
+     * @param value receives the boolean
+     *
+     * @return true if the value was read; otherwise false.
+     */
+    csmBool ReadBoolean(csmBool& value);
+
+    /**
+     * Skips a value of any type, including nested arrays and objects.
+     *
+     * @return true if the value was skipped; otherwise false.
+     */
+    csmBool SkipValue();
+
+    /**
+     * Reads the Meta object.
+     *
+     * @return true if the object was read; otherwise false.
+     */
+    csmBool ReadMeta();
+
+    /**
+     * Reads the Curves array into the motion data.
+     *
+     * @param motionData motion data to append to
+     *
+     * @return true if the array was read; otherwise false.
+     */
+    csmBool ReadCurves(CubismMotionData& motionData);
+
+    /**
+     * Reads one curve object into the motion data.
+     *
+     * @param motionData motion data to append to
+     *
+     * @return true if the object was read; otherwise false.
+     */
+    csmBool ReadCurve(CubismMotionData& motionData);
+
+    /**
+     * Decodes the Segments array of a curve into segments and points.
+     *
+     * @param motionData motion data to append to
+     * @param segmentCount segment count of the curve; incremented for each segment
+     *
+     * @return true if the array was read; otherwise false.
+     */
+    csmBool ReadSegments(CubismMotionData& motionData, csmInt32& segmentCount);
+
+    /**
+     * Reads the UserData array into the motion data.
+     *
+     * @param motionData motion data to append to
+     *
+     * @return true if the array was read; otherwise false.
+     */
+    csmBool ReadUserData(CubismMotionData& motionData);
+
+    const csmChar* _buffer;             ///< Motion file being read
+    csmInt32 _size;                     ///< Size of the motion file in bytes
+    csmInt32 _position;                 ///< Read position in bytes
+    const csmChar* _error;              ///< Description of the parse error; NULL if none
+
+    csmFloat32 _duration;               ///< Duration in the metadata
+    csmBool _isLoop;                    ///< Loop in the metadata
+    csmBool _areBeziersRestricted;      ///< AreBeziersRestricted in the metadata
+    csmFloat32 _fps;                    ///< Fps in the metadata
+    csmBool _isExistFadeInTime;         ///< Whether FadeInTime is in the metadata
+    csmBool _isExistFadeOutTime;        ///< Whether FadeOutTime is in the metadata
+    csmFloat32 _fadeInTime;             ///< FadeInTime in the metadata
+    csmFloat32 _fadeOutTime;            ///< FadeOutTime in the metadata
+    csmInt32 _metaCurveCount;           ///< CurveCount in the metadata
+    csmInt32 _metaTotalSegmentCount;    ///< TotalSegmentCount in the metadata
+    csmInt32 _metaTotalPointCount;      ///< TotalPointCount in the metadata
+    csmInt32 _metaUserDataCount;        ///< UserDataCount in the metadata
+
+    csmInt32 _curveCount;               ///< Number of curves actually read
+    csmInt32 _totalSegmentCount;        ///< Number of segments actually read
+    csmInt32 _totalPointCount;          ///< Number of points actually read
+};
+
 }}}
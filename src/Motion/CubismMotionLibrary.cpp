@@ -0,0 +1,471 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismMotionLibrary.hpp"
+#include "Utils/CubismString.hpp"
+#include <string>
+
+namespace Live2D { namespace Cubism { namespace Framework {
+
+CubismMotionLibrary::CubismMotionLibrary(csmSizeType memoryBudget, csmBool shouldCheckMotionConsistency)
+    : _shouldCheckMotionConsistency(shouldCheckMotionConsistency)
+    , _head(-1)
+    , _tail(-1)
+    , _memoryBudget(memoryBudget)
+    , _residentSize(0)
+    , _prefetchThread(NULL)
+    , _isStopping(false)
+{ }
+
+CubismMotionLibrary::~CubismMotionLibrary()
+{
+    if (_prefetchThread)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isStopping = true;
+        }
+        _queueCondition.notify_all();
+
+        _prefetchThread->join();
+        CSM_DELETE(_prefetchThread);
+        _prefetchThread = NULL;
+    }
+
+    for (csmUint32 i = 0; i < _entries.GetSize(); ++i)
+    {
+        MotionEntry& entry = _entries[i];
+
+        if (entry.Motion)
+        {
+            ACubismMotion::Delete(entry.Motion);
+        }
+
+        if (entry.Buffer)
+        {
+            CubismFramework::GetReleaseBytesFunction()(entry.Buffer);
+        }
+    }
+}
+
+void CubismMotionLibrary::RegisterMotion(const csmChar* group, csmInt32 index, const csmString& filePath, csmFloat32 fadeInSeconds, csmFloat32 fadeOutSeconds)
+{
+    const csmString key = Utils::CubismString::GetFormatedString("%s_%d", group, index);
+
+    if (_entryIndices.IsExist(key))
+    {
+        CubismLogWarning("[CubismMotionLibrary] The motion is already registered. %s", key.GetRawString());
+        return;
+    }
+
+    MotionEntry entry;
+    entry.FilePath = filePath;
+    entry.Group = group;
+    entry.FadeInSeconds = fadeInSeconds;
+    entry.FadeOutSeconds = fadeOutSeconds;
+    entry.Motion = NULL;
+    entry.DataSize = 0;
+    entry.Previous = -1;
+    entry.Next = -1;
+    entry.State = PrefetchState_None;
+    entry.Buffer = NULL;
+    entry.BufferSize = 0;
+
+    {
+        // 再確保の間に先読みスレッドが書き込まないようにする
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entryIndices[key] = static_cast<csmInt32>(_entries.GetSize());
+        _entries.PushBack(entry);
+    }
+}
+
+void CubismMotionLibrary::RegisterMotions(ICubismModelSetting* modelSetting, const csmString& directory)
+{
+    for (csmInt32 i = 0; i < modelSetting->GetMotionGroupCount(); ++i)
+    {
+        const csmChar* group = modelSetting->GetMotionGroupName(i);
+
+        for (csmInt32 j = 0; j < modelSetting->GetMotionCount(group); ++j)
+        {
+            csmString path = directory;
+            path += modelSetting->GetMotionFileName(group, j);
+
+            RegisterMotion(group, j, path,
+                           modelSetting->GetMotionFadeInTimeValue(group, j),
+                           modelSetting->GetMotionFadeOutTimeValue(group, j));
+        }
+    }
+}
+
+void CubismMotionLibrary::SetEffectIds(const csmVector<CubismIdHandle>& eyeBlinkParameterIds, const csmVector<CubismIdHandle>& lipSyncParameterIds)
+{
+    _eyeBlinkParameterIds = eyeBlinkParameterIds;
+    _lipSyncParameterIds = lipSyncParameterIds;
+
+    for (csmInt32 i = _head; i != -1; i = _entries[i].Next)
+    {
+        _entries[i].Motion->SetEffectIds(_eyeBlinkParameterIds, _lipSyncParameterIds);
+    }
+}
+
+void CubismMotionLibrary::SetMemoryBudget(csmSizeType memoryBudget)
+{
+    _memoryBudget = memoryBudget;
+    Evict(-1);
+}
+
+csmSizeType CubismMotionLibrary::GetMemoryBudget() const
+{
+    return _memoryBudget;
+}
+
+csmSizeType CubismMotionLibrary::GetResidentSize() const
+{
+    return _residentSize;
+}
+
+CubismMotion* CubismMotionLibrary::GetMotion(const csmChar* group, csmInt32 index)
+{
+    const csmInt32 entryIndex = FindEntry(group, index);
+
+    if (entryIndex < 0)
+    {
+        CubismLogError("[CubismMotionLibrary] The motion is not registered. %s_%d", group, index);
+        return NULL;
+    }
+
+    ResolvePrefetchedMotions();
+
+    return AcquireMotion(entryIndex);
+}
+
+CubismMotionQueueEntryHandle CubismMotionLibrary::StartMotion(CubismMotionManager* manager, const csmChar* group, csmInt32 index, csmInt32 priority,
+                                                              ACubismMotion::FinishedMotionCallback onFinishedMotionHandler, ACubismMotion::BeganMotionCallback onBeganMotionHandler)
+{
+    CubismMotion* motion = GetMotion(group, index);
+
+    if (!motion)
+    {
+        return InvalidMotionQueueEntryHandleValue;
+    }
+
+    // 再生用のインスタンスは解析済みのデータを共有するため、再生中にキャッシュから外れても問題ない
+    CubismMotion* instance = CubismMotion::CreateShared(motion, onFinishedMotionHandler, onBeganMotionHandler);
+    instance->SetEffectIds(_eyeBlinkParameterIds, _lipSyncParameterIds);
+
+    return manager->StartMotionPriority(instance, true, priority);
+}
+
+void CubismMotionLibrary::PrefetchGroup(const csmChar* group)
+{
+    csmBool isQueued = false;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (csmUint32 i = 0; i < _entries.GetSize(); ++i)
+        {
+            MotionEntry& entry = _entries[i];
+
+            if (entry.Motion || entry.State != PrefetchState_None || !(entry.Group == group))
+            {
+                continue;
+            }
+
+            entry.State = PrefetchState_Queued;
+            _prefetchQueue.PushBack(static_cast<csmInt32>(i));
+            isQueued = true;
+        }
+
+        // フレームワークのアロケータはスレッドセーフではないため、読み込みスレッドが追加する分の領域をここで確保しておく
+        _loadedEntries.PrepareCapacity(static_cast<csmInt32>(_entries.GetSize()));
+    }
+
+    if (!isQueued)
+    {
+        return;
+    }
+
+    if (!_prefetchThread)
+    {
+        _prefetchThread = CSM_NEW std::thread(&CubismMotionLibrary::PrefetchLoop, this);
+    }
+
+    _queueCondition.notify_one();
+}
+
+csmInt32 CubismMotionLibrary::FindEntry(const csmChar* group, csmInt32 index)
+{
+    const csmString key = Utils::CubismString::GetFormatedString("%s_%d", group, index);
+
+    if (!_entryIndices.IsExist(key))
+    {
+        return -1;
+    }
+
+    return _entryIndices[key];
+}
+
+CubismMotion* CubismMotionLibrary::AcquireMotion(csmInt32 entryIndex)
+{
+    if (_entries[entryIndex].Motion)
+    {
+        Touch(entryIndex);
+        return _entries[entryIndex].Motion;
+    }
+
+    csmByte* buffer = NULL;
+    csmSizeInt size = 0;
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        MotionEntry& entry = _entries[entryIndex];
+
+        // 先読み待ちなら取り消し、読み込み中なら完了を待つ
+        if (entry.State == PrefetchState_Queued)
+        {
+            entry.State = PrefetchState_None;
+        }
+        while (_entries[entryIndex].State == PrefetchState_Loading)
+        {
+            _loadedCondition.wait(lock);
+        }
+
+        MotionEntry& loadedEntry = _entries[entryIndex];
+        if (loadedEntry.State == PrefetchState_Loaded)
+        {
+            buffer = loadedEntry.Buffer;
+            size = loadedEntry.BufferSize;
+            loadedEntry.Buffer = NULL;
+            loadedEntry.BufferSize = 0;
+            loadedEntry.State = PrefetchState_None;
+        }
+    }
+
+    if (!buffer)
+    {
+        buffer = CubismFramework::GetLoadFileFunction()(_entries[entryIndex].FilePath.GetRawString(), &size);
+    }
+
+    CacheMotion(entryIndex, buffer, size);
+
+    return _entries[entryIndex].Motion;
+}
+
+void CubismMotionLibrary::CacheMotion(csmInt32 entryIndex, csmByte* buffer, csmSizeInt size)
+{
+    MotionEntry& entry = _entries[entryIndex];
+
+    if (!buffer)
+    {
+        CubismLogError("[CubismMotionLibrary] Failed to load the motion file. %s", entry.FilePath.GetRawString());
+        return;
+    }
+
+    CubismMotion* motion = CubismMotion::Create(buffer, size, NULL, NULL, _shouldCheckMotionConsistency);
+    CubismFramework::GetReleaseBytesFunction()(buffer);
+
+    if (!motion)
+    {
+        CubismLogError("[CubismMotionLibrary] Failed to create the motion. %s", entry.FilePath.GetRawString());
+        return;
+    }
+
+    // model3.json にフェード値があれば motion3.json の値を上書きする
+    if (entry.FadeInSeconds >= 0.0f)
+    {
+        motion->SetFadeInTime(entry.FadeInSeconds);
+    }
+    if (entry.FadeOutSeconds >= 0.0f)
+    {
+        motion->SetFadeOutTime(entry.FadeOutSeconds);
+    }
+    motion->SetEffectIds(_eyeBlinkParameterIds, _lipSyncParameterIds);
+
+    entry.Motion = motion;
+    entry.DataSize = motion->GetMotionDataSize();
+    _residentSize += entry.DataSize;
+
+    Touch(entryIndex);
+    Evict(entryIndex);
+}
+
+void CubismMotionLibrary::ResolvePrefetchedMotions()
+{
+    if (!_prefetchThread)
+    {
+        return;
+    }
+
+    csmVector<csmInt32> loadedEntries;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        loadedEntries = _loadedEntries;
+        _loadedEntries.UpdateSize(0, 0, false);
+    }
+
+    for (csmUint32 i = 0; i < loadedEntries.GetSize(); ++i)
+    {
+        const csmInt32 entryIndex = loadedEntries[i];
+        csmByte* buffer = NULL;
+        csmSizeInt size = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            MotionEntry& entry = _entries[entryIndex];
+
+            // GetMotion() で先に使われたものは処理済み
+            if (entry.State != PrefetchState_Loaded)
+            {
+                continue;
+            }
+
+            buffer = entry.Buffer;
+            size = entry.BufferSize;
+            entry.Buffer = NULL;
+            entry.BufferSize = 0;
+            entry.State = PrefetchState_None;
+        }
+
+        // 解析は IdManager を使うため、呼び出し元のスレッドで行う
+        CacheMotion(entryIndex, buffer, size);
+    }
+}
+
+void CubismMotionLibrary::Touch(csmInt32 entryIndex)
+{
+    if (_head == entryIndex)
+    {
+        return;
+    }
+
+    Unlink(entryIndex);
+
+    MotionEntry& entry = _entries[entryIndex];
+    entry.Previous = -1;
+    entry.Next = _head;
+
+    if (_head != -1)
+    {
+        _entries[_head].Previous = entryIndex;
+    }
+    _head = entryIndex;
+
+    if (_tail == -1)
+    {
+        _tail = entryIndex;
+    }
+}
+
+void CubismMotionLibrary::Unlink(csmInt32 entryIndex)
+{
+    MotionEntry& entry = _entries[entryIndex];
+
+    if (entry.Previous != -1)
+    {
+        _entries[entry.Previous].Next = entry.Next;
+    }
+    else if (_head == entryIndex)
+    {
+        _head = entry.Next;
+    }
+
+    if (entry.Next != -1)
+    {
+        _entries[entry.Next].Previous = entry.Previous;
+    }
+    else if (_tail == entryIndex)
+    {
+        _tail = entry.Previous;
+    }
+
+    entry.Previous = -1;
+    entry.Next = -1;
+}
+
+void CubismMotionLibrary::Evict(csmInt32 keepIndex)
+{
+    if (_memoryBudget == 0)
+    {
+        return;
+    }
+
+    // 最後に使ってから最も時間の経ったものから解放する
+    while (_residentSize > _memoryBudget && _tail != -1 && _tail != keepIndex)
+    {
+        const csmInt32 entryIndex = _tail;
+        MotionEntry& entry = _entries[entryIndex];
+
+        Unlink(entryIndex);
+
+        // 再生中のインスタンスはデータの参照を持つため、ここで解放されるのはキャッシュの参照だけ
+        ACubismMotion::Delete(entry.Motion);
+        entry.Motion = NULL;
+        _residentSize -= entry.DataSize;
+        entry.DataSize = 0;
+    }
+}
+
+void CubismMotionLibrary::PrefetchLoop()
+{
+    for (;;)
+    {
+        csmInt32 entryIndex = -1;
+        std::string filePath;   // csmStringはフレームワークのアロケータを使うため、このスレッドではstd::stringに写す
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            while (!_isStopping && entryIndex < 0)
+            {
+                if (_prefetchQueue.GetSize() == 0)
+                {
+                    _queueCondition.wait(lock);
+                    continue;
+                }
+
+                const csmInt32 queuedIndex = _prefetchQueue[0];
+                _prefetchQueue.Erase(_prefetchQueue.Begin());
+
+                // 取り消されたものは読み飛ばす
+                if (_entries[queuedIndex].State == PrefetchState_Queued)
+                {
+                    entryIndex = queuedIndex;
+                }
+            }
+
+            if (_isStopping)
+            {
+                return;
+            }
+
+            _entries[entryIndex].State = PrefetchState_Loading;
+            filePath = _entries[entryIndex].FilePath.GetRawString();
+        }
+
+        csmSizeInt size = 0;
+        csmByte* buffer = CubismFramework::GetLoadFileFunction()(filePath.c_str(), &size);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            MotionEntry& entry = _entries[entryIndex];
+
+            entry.Buffer = buffer;
+            entry.BufferSize = size;
+            entry.State = buffer ? PrefetchState_Loaded : PrefetchState_None;
+
+            if (buffer)
+            {
+                _loadedEntries.PushBack(entryIndex);
+            }
+        }
+        _loadedCondition.notify_all();
+    }
+}
+
+}}}
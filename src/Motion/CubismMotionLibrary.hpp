@@ -0,0 +1,247 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+#include "CubismMotion.hpp"
+#include "CubismMotionManager.hpp"
+#include "ICubismModelSetting.hpp"
+#include "Type/csmMap.hpp"
+#include "Type/csmString.hpp"
+#include "Type/csmVector.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Live2D { namespace Cubism { namespace Framework {
+
+/**
+ * Holds the motions of a model by file reference and parses them on first use.<br>
+ * Parsed motions are kept in a least recently used cache bounded by a memory budget.
+ *
+ * @note Files are read with CubismFramework::GetLoadFileFunction() and released with GetReleaseBytesFunction().<br>
+ *       When PrefetchGroup() is used, the load function is also called from a background thread.<br>
+ *       The background thread never allocates through the framework allocator, so the allocator does not have to be thread-safe.
+ */
+class CubismMotionLibrary
+{
+public:
+    /**
+     * Constructor
+     *
+     * @param memoryBudget maximum number of bytes of parsed motion data to keep; 0 for no limit
+     * @param shouldCheckMotionConsistency true to check the consistency of each motion3.json when it is parsed
+     */
+    CubismMotionLibrary(csmSizeType memoryBudget = 0, csmBool shouldCheckMotionConsistency = false);
+
+    /**
+     * Destructor<br>
+     * Stops the prefetch thread and releases all cached motions.
+     */
+    ~CubismMotionLibrary();
+
+    /**
+     * Registers a motion file.<br>
+     * The file is not read until the motion is used.
+     *
+     * @param group name of the motion group
+     * @param index index of the motion in the group
+     * @param filePath path of the motion3.json passed to the load function
+     * @param fadeInSeconds fade-in duration that overrides motion3.json; negative to keep it
+     * @param fadeOutSeconds fade-out duration that overrides motion3.json; negative to keep it
+     */
+    void RegisterMotion(const csmChar* group, csmInt32 index, const csmString& filePath, csmFloat32 fadeInSeconds = -1.0f, csmFloat32 fadeOutSeconds = -1.0f);
+
+    /**
+     * Registers every motion listed in the model settings.
+     *
+     * @param modelSetting model setting information
+     * @param directory directory prepended to each motion file name
+     */
+    void RegisterMotions(ICubismModelSetting* modelSetting, const csmString& directory);
+
+    /**
+     * Sets the IDs of the parameters applied to the eye blink and lip sync effects of each motion.
+     *
+     * @param eyeBlinkParameterIds parameter IDs for eye blink
+     * @param lipSyncParameterIds parameter IDs for lip sync
+     */
+    void SetEffectIds(const csmVector<CubismIdHandle>& eyeBlinkParameterIds, const csmVector<CubismIdHandle>& lipSyncParameterIds);
+
+    /**
+     * Sets the memory budget and evicts motions until the cache fits in it.
+     *
+     * @param memoryBudget maximum number of bytes of parsed motion data to keep; 0 for no limit
+     */
+    void SetMemoryBudget(csmSizeType memoryBudget);
+
+    /**
+     * Returns the memory budget.
+     *
+     * @return maximum number of bytes of parsed motion data to keep; 0 for no limit
+     */
+    csmSizeType GetMemoryBudget() const;
+
+    /**
+     * Returns the number of bytes of parsed motion data kept in the cache.
+     *
+     * @return size of the cached motion data in bytes
+     */
+    csmSizeType GetResidentSize() const;
+
+    /**
+     * Returns the motion, parsing it if it is not cached.<br>
+     * The motion is owned by the library and may be released by a later call that evicts it.
+     *
+     * @param group name of the motion group
+     * @param index index of the motion in the group
+     *
+     * @return motion; NULL if the motion is not registered or could not be loaded
+     */
+    CubismMotion* GetMotion(const csmChar* group, csmInt32 index);
+
+    /**
+     * Plays the motion with the specified priority, parsing it if it is not cached.<br>
+     * The played instance shares the cached motion data and is deleted by the manager when playback ends,<br>
+     * so evicting the motion from the cache during playback is safe.
+     *
+     * @param manager motion manager to play the motion
+     * @param group name of the motion group
+     * @param index index of the motion in the group
+     * @param priority priority of the motion
+     * @param onFinishedMotionHandler callback function when motion playback finishes
+     * @param onBeganMotionHandler callback function when motion playback begins
+     *
+     * @return ID of the played motion.<br>
+     *         InvalidMotionQueueEntryHandleValue if the motion could not be started.
+     */
+    CubismMotionQueueEntryHandle StartMotion(CubismMotionManager* manager, const csmChar* group, csmInt32 index, csmInt32 priority,
+                                             ACubismMotion::FinishedMotionCallback onFinishedMotionHandler = NULL, ACubismMotion::BeganMotionCallback onBeganMotionHandler = NULL);
+
+    /**
+     * Reads the files of a motion group on a background thread ahead of use.<br>
+     * Only the files are read in the background; they are parsed on the calling thread by the next GetMotion() or StartMotion().
+     *
+     * @param group name of the motion group
+     */
+    void PrefetchGroup(const csmChar* group);
+
+private:
+    /**
+     * Prefetch state of a registered motion
+     */
+    enum PrefetchState
+    {
+        PrefetchState_None,         ///< Not prefetched
+        PrefetchState_Queued,       ///< Waiting for the prefetch thread
+        PrefetchState_Loading,      ///< Being read by the prefetch thread
+        PrefetchState_Loaded,       ///< File read; waiting to be parsed
+    };
+
+    /**
+     * Registered motion
+     */
+    struct MotionEntry
+    {
+        csmString FilePath;                 ///< Path of the motion3.json
+        csmString Group;                    ///< Name of the motion group
+        csmFloat32 FadeInSeconds;           ///< Fade-in duration that overrides motion3.json; negative to keep it
+        csmFloat32 FadeOutSeconds;          ///< Fade-out duration that overrides motion3.json; negative to keep it
+        CubismMotion* Motion;               ///< Parsed motion; NULL if not cached
+        csmSizeType DataSize;               ///< Size of the parsed motion data in bytes
+        csmInt32 Previous;                  ///< Index of the more recently used cached motion; -1 if none
+        csmInt32 Next;                      ///< Index of the less recently used cached motion; -1 if none
+        PrefetchState State;                ///< Prefetch state
+        csmByte* Buffer;                    ///< File read by the prefetch thread
+        csmSizeInt BufferSize;              ///< Size of Buffer in bytes
+    };
+
+    // Prevention of copy Constructor
+    CubismMotionLibrary(const CubismMotionLibrary&);
+    CubismMotionLibrary& operator=(const CubismMotionLibrary&);
+
+    /**
+     * Returns the index of the registered motion.
+     *
+     * @param group name of the motion group
+     * @param index index of the motion in the group
+     *
+     * @return index into _entries; -1 if not registered
+     */
+    csmInt32 FindEntry(const csmChar* group, csmInt32 index);
+
+    /**
+     * Returns the cached motion of the entry, parsing it if needed, and marks it as most recently used.
+     *
+     * @param entryIndex index into _entries
+     *
+     * @return motion; NULL if it could not be loaded
+     */
+    CubismMotion* AcquireMotion(csmInt32 entryIndex);
+
+    /**
+     * Parses the motion from the file and adds it to the cache.
+     *
+     * @param entryIndex index into _entries
+     * @param buffer contents of the motion file; released by this function
+     * @param size size of buffer in bytes
+     */
+    void CacheMotion(csmInt32 entryIndex, csmByte* buffer, csmSizeInt size);
+
+    /**
+     * Parses every motion whose file has been read by the prefetch thread.
+     */
+    void ResolvePrefetchedMotions();
+
+    /**
+     * Moves the cached motion to the head of the LRU list.
+     *
+     * @param entryIndex index into _entries
+     */
+    void Touch(csmInt32 entryIndex);
+
+    /**
+     * Removes the cached motion from the LRU list.
+     *
+     * @param entryIndex index into _entries
+     */
+    void Unlink(csmInt32 entryIndex);
+
+    /**
+     * Releases least recently used motions until the cache fits in the memory budget.
+     *
+     * @param keepIndex index into _entries that is never released; -1 for none
+     */
+    void Evict(csmInt32 keepIndex);
+
+    /**
+     * Processing of the prefetch thread
+     */
+    void PrefetchLoop();
+
+    csmVector<MotionEntry> _entries;                    ///< Registered motions
+    csmMap<csmString, csmInt32> _entryIndices;          ///< Index into _entries keyed by "group_index"
+    csmVector<CubismIdHandle> _eyeBlinkParameterIds;    ///< Parameter IDs for eye blink
+    csmVector<CubismIdHandle> _lipSyncParameterIds;     ///< Parameter IDs for lip sync
+    csmBool _shouldCheckMotionConsistency;              ///< Whether to check the consistency of motion3.json
+
+    csmInt32 _head;                                     ///< Most recently used cached motion; -1 if none
+    csmInt32 _tail;                                     ///< Least recently used cached motion; -1 if none
+    csmSizeType _memoryBudget;                          ///< Maximum bytes of cached motion data; 0 for no limit
+    csmSizeType _residentSize;                          ///< Bytes of cached motion data
+
+    std::thread* _prefetchThread;                       ///< Prefetch thread; NULL until the first PrefetchGroup()
+    std::mutex _mutex;                                  ///< Guards _entries and the queues against the prefetch thread
+    std::condition_variable _queueCondition;            ///< Notifies the prefetch thread of queued files
+    std::condition_variable _loadedCondition;           ///< Notifies that the prefetch thread finished a file
+    csmVector<csmInt32> _prefetchQueue;                 ///< Entries waiting for the prefetch thread
+    csmVector<csmInt32> _loadedEntries;                 ///< Entries read by the prefetch thread and waiting to be parsed
+    csmBool _isStopping;                                ///< Whether to stop the prefetch thread
+};
+
+}}}
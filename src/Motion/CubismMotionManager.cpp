@@ -6,6 +6,7 @@
  */
 
 #include "CubismMotionManager.hpp"
+#include "Utils/CubismProfiler.hpp"
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -46,6 +47,8 @@ CubismMotionQueueEntryHandle CubismMotionManager::StartMotionPriority(ACubismMot
 
 csmBool CubismMotionManager::UpdateMotion(CubismModel* model, csmFloat32 deltaTimeSeconds)
 {
+    CSM_PROFILE_ZONE(Zone_Motion, model);
+
     _userTimeSeconds += deltaTimeSeconds;
 
     const csmBool updated = CubismMotionQueueManager::DoUpdateMotion(model, _userTimeSeconds);
@@ -25,6 +25,8 @@ CubismMotionQueueEntry::CubismMotionQueueEntry()
     , _motionQueueEntryHandle(NULL)
     , _fadeOutSeconds(0.0f)
     , _IsTriggeredFadeOut(false)
+    , _modelOpacity(1.0f)
+    , _eventCursor(0)
 {
     this->_motionQueueEntryHandle = this;
 }
@@ -37,6 +39,31 @@ CubismMotionQueueEntry::~CubismMotionQueueEntry()
     }
 }
 
+void CubismMotionQueueEntry::Reset()
+{
+    if (_autoDelete && _motion)
+    {
+        ACubismMotion::Delete(_motion);
+    }
+
+    _autoDelete = false;
+    _motion = NULL;
+    _available = true;
+    _finished = false;
+    _started = false;
+    _startTimeSeconds = -1.0f;
+    _fadeInStartTimeSeconds = 0.0f;
+    _endTimeSeconds = -1.0f;
+    _stateTimeSeconds = 0.0f;
+    _stateWeight = 0.0f;
+    _lastEventCheckSeconds = 0.0f;
+    _fadeOutSeconds = 0.0f;
+    _IsTriggeredFadeOut = false;
+    _modelOpacity = 1.0f;
+    _eventCursor = 0;
+    _motionQueueEntryHandle = NULL;
+}
+
 void CubismMotionQueueEntry::SetFadeout(csmFloat32 fadeOutSeconds)
 {
     _fadeOutSeconds = fadeOutSeconds;
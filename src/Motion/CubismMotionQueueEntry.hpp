@@ -187,6 +187,12 @@ public:
     ACubismMotion* GetCubismMotion();
 
 private:
+    /**
+     * Returns the entry to its initial state so that the manager can reuse it.<br>
+     * The motion is deleted if the entry owns it.
+     */
+    void        Reset();
+
     csmBool         _autoDelete;
     ACubismMotion*  _motion;
 
@@ -201,6 +207,8 @@ private:
     csmFloat32      _lastEventCheckSeconds;
     csmFloat32      _fadeOutSeconds;
     csmBool         _IsTriggeredFadeOut;
+    csmFloat32      _modelOpacity;      ///< Model opacity evaluated by this playback
+    csmInt32        _eventCursor;       ///< Index of the first user data event that has not fired yet
 
     CubismMotionQueueEntryHandle  _motionQueueEntryHandle;
 };
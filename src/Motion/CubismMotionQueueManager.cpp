@@ -16,6 +16,7 @@ const CubismMotionQueueEntryHandle InvalidMotionQueueEntryHandleValue = reinterp
 
 CubismMotionQueueManager::CubismMotionQueueManager()
     : _userTimeSeconds(0.0f)
+    , _nextMotionQueueEntryHandle(1)
     , _eventCallback(NULL)
     , _eventCustomData(NULL)
 {}
@@ -29,6 +30,11 @@ CubismMotionQueueManager::~CubismMotionQueueManager()
             CSM_DELETE(_motions[i]);
         }
     }
+
+    for (csmUint32 i = 0; i < _motionQueueEntryPool.GetSize(); ++i)
+    {
+        CSM_DELETE(_motionQueueEntryPool[i]);
+    }
 }
 
 CubismMotionQueueEntryHandle CubismMotionQueueManager::StartMotion(ACubismMotion* motion, csmBool autoDelete)
@@ -52,7 +58,7 @@ CubismMotionQueueEntryHandle CubismMotionQueueManager::StartMotion(ACubismMotion
         motionQueueEntry->SetFadeout(motionQueueEntry->_motion->GetFadeOutTime());
     }
 
-    motionQueueEntry = CSM_NEW CubismMotionQueueEntry(); // 終了時に破棄する
+    motionQueueEntry = AcquireMotionQueueEntry(); // 終了時にプールへ戻す
     motionQueueEntry->_autoDelete = autoDelete;
     motionQueueEntry->_motion = motion;
 
@@ -67,24 +73,23 @@ csmBool CubismMotionQueueManager::DoUpdateMotion(CubismModel* model, csmFloat32
 
     // ------- 処理を行う --------
     // 既にモーションがあれば終了フラグを立てる
+    // 終了したエントリは削除のたびに後ろを詰めず、残すエントリを順序を保ったまま前へ書き戻す
+    csmUint32 remainCount = 0;
 
-    for (csmVector<CubismMotionQueueEntry*>::iterator ite = _motions.Begin(); ite != _motions.End();)
+    for (csmUint32 i = 0; i < _motions.GetSize(); ++i)
     {
-        CubismMotionQueueEntry* motionQueueEntry = *ite;
+        CubismMotionQueueEntry* motionQueueEntry = _motions[i];
 
         if (motionQueueEntry == NULL)
         {
-            ite = _motions.Erase(ite);          // 削除
-            continue;
+            continue;                           // 削除
         }
 
         ACubismMotion* motion = motionQueueEntry->_motion;
 
         if (motion == NULL)
         {
-            CSM_DELETE(motionQueueEntry);
-            ite = _motions.Erase(ite);          // 削除
-
+            ReleaseMotionQueueEntry(motionQueueEntry);  // 削除
             continue;
         }
 
@@ -94,13 +99,14 @@ csmBool CubismMotionQueueManager::DoUpdateMotion(CubismModel* model, csmFloat32
 
         // ------ ユーザトリガーイベントを検査する ----
         const csmVector<const csmString*>& firedList = motion->GetFiredEvent(
-            motionQueueEntry->GetLastCheckEventTime() - motionQueueEntry->GetStartTime()
+            motionQueueEntry
+            , motionQueueEntry->GetLastCheckEventTime() - motionQueueEntry->GetStartTime()
             , userTimeSeconds - motionQueueEntry->GetStartTime()
         );
 
-        for (csmUint32 i = 0; i < firedList.GetSize(); ++i)
+        for (csmUint32 j = 0; j < firedList.GetSize(); ++j)
         {
-            _eventCallback(this, *(firedList[i]), _eventCustomData);
+            _eventCallback(this, *(firedList[j]), _eventCustomData);
         }
 
         motionQueueEntry->SetLastCheckEventTime(userTimeSeconds);
@@ -108,20 +114,21 @@ csmBool CubismMotionQueueManager::DoUpdateMotion(CubismModel* model, csmFloat32
         // ----- 終了済みの処理があれば削除する ------
         if (motionQueueEntry->IsFinished())
         {
-            CSM_DELETE(motionQueueEntry);
-            ite = _motions.Erase(ite);          // 削除
+            ReleaseMotionQueueEntry(motionQueueEntry);  // 削除
+            continue;
         }
-        else
-        {
-            if (motionQueueEntry->IsTriggeredFadeOut())
-            {
-                motionQueueEntry->StartFadeout(motionQueueEntry->GetFadeOutSeconds(), userTimeSeconds);
-            }
 
-            ++ite;
+        if (motionQueueEntry->IsTriggeredFadeOut())
+        {
+            motionQueueEntry->StartFadeout(motionQueueEntry->GetFadeOutSeconds(), userTimeSeconds);
         }
+
+        _motions[remainCount++] = motionQueueEntry;
     }
 
+    // 容量は残したまま要素数だけを縮める
+    _motions.UpdateSize(remainCount, NULL, false);
+
     return updated;
 }
 
@@ -157,38 +164,35 @@ csmBool CubismMotionQueueManager::IsFinished()
 {
     // ------- 処理を行う --------
     // 既にモーションがあれば終了フラグを立てる
+    csmBool isFinished = true;
+    csmUint32 remainCount = 0;
 
-    for (csmVector<CubismMotionQueueEntry*>::iterator ite = _motions.Begin(); ite != _motions.End();)
+    for (csmUint32 i = 0; i < _motions.GetSize(); ++i)
     {
-        CubismMotionQueueEntry* motionQueueEntry = *ite;
+        CubismMotionQueueEntry* motionQueueEntry = _motions[i];
 
         if (motionQueueEntry == NULL)
         {
-            ite = _motions.Erase(ite);          // 削除
-            continue;
+            continue;                           // 削除
         }
 
-        ACubismMotion* motion = motionQueueEntry->_motion;
-
-        if (motion == NULL)
+        if (motionQueueEntry->_motion == NULL)
         {
-            CSM_DELETE(motionQueueEntry);
-            ite = _motions.Erase(ite);          // 削除
+            ReleaseMotionQueueEntry(motionQueueEntry);  // 削除
             continue;
         }
 
-        // ----- 終了済みの処理があれば削除する ------
         if (!motionQueueEntry->IsFinished())
         {
-            return false;
-        }
-        else
-        {
-            ++ite;
+            isFinished = false;
         }
+
+        _motions[remainCount++] = motionQueueEntry;
     }
 
-    return true;
+    _motions.UpdateSize(remainCount, NULL, false);
+
+    return isFinished;
 }
 
 csmBool CubismMotionQueueManager::IsFinished(CubismMotionQueueEntryHandle motionQueueEntryNumber)
@@ -218,21 +222,57 @@ void CubismMotionQueueManager::StopAllMotions()
     // ------- 処理を行う --------
     // 既にモーションがあれば終了フラグを立てる
 
-    for (csmVector<CubismMotionQueueEntry*>::iterator ite = _motions.Begin(); ite != _motions.End();)
+    for (csmUint32 i = 0; i < _motions.GetSize(); ++i)
     {
-        CubismMotionQueueEntry* motionQueueEntry = *ite;
+        CubismMotionQueueEntry* motionQueueEntry = _motions[i];
 
         if (motionQueueEntry == NULL)
         {
-            ite = _motions.Erase(ite);
-
             continue;
         }
 
         // ----- 終了済みの処理があれば削除する ------
-        CSM_DELETE(motionQueueEntry);
-        ite = _motions.Erase(ite); //削除
+        ReleaseMotionQueueEntry(motionQueueEntry); //削除
+    }
+
+    // 次の再生で確保し直さないよう、容量は残す
+    _motions.UpdateSize(0, NULL, false);
+}
+
+CubismMotionQueueEntry* CubismMotionQueueManager::AcquireMotionQueueEntry()
+{
+    CubismMotionQueueEntry* motionQueueEntry = NULL;
+
+    if (_motionQueueEntryPool.GetSize() > 0)
+    {
+        motionQueueEntry = _motionQueueEntryPool[_motionQueueEntryPool.GetSize() - 1];
+        _motionQueueEntryPool.UpdateSize(_motionQueueEntryPool.GetSize() - 1, NULL, false);
     }
+    else
+    {
+        motionQueueEntry = CSM_NEW CubismMotionQueueEntry();
+    }
+
+    // エントリは使い回すため、ハンドルにはアドレスではなく通し番号を使う
+    // 0(NULL)とInvalidMotionQueueEntryHandleValue(-1)は避ける
+    if (_nextMotionQueueEntryHandle == 0 || _nextMotionQueueEntryHandle == static_cast<csmSizeType>(-1))
+    {
+        _nextMotionQueueEntryHandle = 1;
+    }
+    motionQueueEntry->_motionQueueEntryHandle = reinterpret_cast<CubismMotionQueueEntryHandle>(_nextMotionQueueEntryHandle++);
+
+    return motionQueueEntry;
+}
+
+void CubismMotionQueueManager::ReleaseMotionQueueEntry(CubismMotionQueueEntry* motionQueueEntry)
+{
+    if (motionQueueEntry == NULL)
+    {
+        return;
+    }
+
+    motionQueueEntry->Reset();
+    _motionQueueEntryPool.PushBack(motionQueueEntry, false);
 }
 
 void CubismMotionQueueManager::SetEventCallback(CubismMotionEventFunction callback, void* customData)
@@ -107,11 +107,29 @@ public:
 protected:
     virtual csmBool     DoUpdateMotion(CubismModel* model, csmFloat32 userTimeSeconds);
 
+    /**
+     * Takes a queue entry from the pool, or creates one if the pool is empty.<br>
+     * The entry is given a new handle, so handles of released entries never match it.
+     *
+     * @return queue entry in its initial state
+     */
+    CubismMotionQueueEntry* AcquireMotionQueueEntry();
+
+    /**
+     * Returns a queue entry to the pool.<br>
+     * The motion is deleted here if the entry owns it.
+     *
+     * @param motionQueueEntry queue entry that is no longer in the queue
+     */
+    void        ReleaseMotionQueueEntry(CubismMotionQueueEntry* motionQueueEntry);
+
 
     csmFloat32 _userTimeSeconds;
 
 private:
     csmVector<CubismMotionQueueEntry*>      _motions;
+    csmVector<CubismMotionQueueEntry*>      _motionQueueEntryPool;      ///< Released entries kept for reuse
+    csmSizeType                             _nextMotionQueueEntryHandle; ///< Serial number given to the next acquired entry
 
     CubismMotionEventFunction         _eventCallback;
     void*                             _eventCustomData;
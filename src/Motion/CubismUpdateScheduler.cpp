@@ -7,9 +7,40 @@
 
 #include "CubismUpdateScheduler.hpp"
 #include "Type/csmVectorSort.hpp"
+#include "Utils/CubismProfiler.hpp"
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
+#ifdef CSM_PROFILE
+namespace {
+/**
+ * Gets the name of an updater for profiling from its order of operations.
+ */
+const csmChar* GetUpdaterName(const csmInt32 executionOrder)
+{
+    switch (executionOrder)
+    {
+    case CubismUpdateOrder_EyeBlink:
+        return "EyeBlinkUpdater";
+    case CubismUpdateOrder_Expression:
+        return "ExpressionUpdater";
+    case CubismUpdateOrder_Look:
+        return "LookUpdater";
+    case CubismUpdateOrder_Breath:
+        return "BreathUpdater";
+    case CubismUpdateOrder_Physics:
+        return "PhysicsUpdater";
+    case CubismUpdateOrder_LipSync:
+        return "LipSyncUpdater";
+    case CubismUpdateOrder_Pose:
+        return "PoseUpdater";
+    default:
+        return "Updater";
+    }
+}
+}
+#endif
+
 CubismUpdateScheduler::CubismUpdateScheduler()
     : _needsSort(true)
 {
@@ -49,6 +80,7 @@ void CubismUpdateScheduler::OnLateUpdate(CubismModel* model, const csmFloat32 de
 
     for (csmUint32 i = 0; i < _cubismUpdatableList.GetSize(); ++i)
     {
+        CSM_PROFILE_NAMED_ZONE(Zone_Updater, model, GetUpdaterName(_cubismUpdatableList[i]->GetExecutionOrder()));
         _cubismUpdatableList[i]->OnLateUpdate(model, deltaTimeSeconds);
     }
 }
@@ -23,4 +23,9 @@ ICubismUpdater::ICubismUpdater(const csmInt32 executionOrder)
     : _executionOrder(executionOrder)
 {
 }
+
+csmInt32 ICubismUpdater::GetExecutionOrder() const
+{
+    return _executionOrder;
+}
 }}}
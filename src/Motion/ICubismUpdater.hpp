@@ -68,6 +68,13 @@ public:
      */
     virtual void OnLateUpdate(CubismModel* model, csmFloat32 deltaTimeSeconds) = 0;
 
+    /**
+     * Gets the order of operations.
+     *
+     * @return Order of operations
+     */
+    csmInt32 GetExecutionOrder() const;
+
 private:
     csmInt32 _executionOrder;
 };
@@ -12,6 +12,7 @@
 #include "Utils/CubismString.hpp"
 #include "Math/CubismMath.hpp"
 #include "Math/CubismVector2.hpp"
+#include "Utils/CubismProfiler.hpp"
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -671,6 +672,9 @@ void CubismPhysics::Parse(const csmByte* physicsJson, csmSizeInt size)
 
 void CubismPhysics::Stabilization(CubismModel* model)
 {
+    // パラメータ配列を直接読むため、蓄積中の値に範囲を適用してから処理する
+    model->EndParameterAccumulation();
+
     csmFloat32 totalAngle;
     csmFloat32 weight;
     csmFloat32 radAngle;
@@ -842,6 +846,11 @@ void CubismPhysics::Stabilization(CubismModel* model)
 /// @param deltaTimeSeconds  rendering delta time.
 void CubismPhysics::Evaluate(CubismModel* model, csmFloat32 deltaTimeSeconds)
 {
+    CSM_PROFILE_ZONE(Zone_Physics, model);
+
+    // パラメータ配列を直接読むため、蓄積中の値に範囲を適用してから処理する
+    model->EndParameterAccumulation();
+
     csmFloat32 totalAngle;
     csmFloat32 weight;
     csmFloat32 radAngle;
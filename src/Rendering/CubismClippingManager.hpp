@@ -13,6 +13,7 @@
 #include "Type/csmRectF.hpp"
 #include "Math/CubismVector2.hpp"
 #include "Math/CubismMatrix44.hpp"
+#include "Math/CubismMath.hpp"
 #include "Model/CubismModel.hpp"
 
 //------------ LIVE2D NAMESPACE ------------
@@ -55,7 +56,8 @@ public:
     /**
      * @brief   既にマスクを作っているかを確認。<br>
      *          作っているようであれば該当するクリッピングマスクのインスタンスを返す。<br>
-     *          作っていなければNULLを返す
+     *          作っていなければNULLを返す。<br>
+     *          マスクの組み合わせを昇順に並べ替えた正規形のハッシュ値で検索する
      *
      * @param[in]   drawableMasks    ->  描画オブジェクトをマスクする描画オブジェクトのリスト
      * @param[in]   drawableMaskCounts ->  描画オブジェクトをマスクする描画オブジェクトの数
@@ -86,12 +88,26 @@ public:
     /**
      * @brief   クリッピングコンテキストを配置するレイアウト。<br>
      *           ひとつのレンダーテクスチャを極力いっぱいに使ってマスクをレイアウトする。<br>
-     *           マスクグループの数が4以下ならRGBA各チャンネルに１つずつマスクを配置し、5以上6以下ならRGBAを2,2,1,1と配置する。
+     *           マスクグループの数が4以下ならRGBA各チャンネルに１つずつマスクを配置し、5以上6以下ならRGBAを2,2,1,1と配置する。<br>
+     *           1つのチャンネルに複数のマスクを配置する場合は、マスクされる描画オブジェクトの囲み矩形の面積に応じて領域を割り当てる。
      *
      * @param[in]   usingClipCount  ->  配置するクリッピングコンテキストの数
      */
     void SetupLayoutBounds(csmInt32 usingClipCount) const;
 
+    /**
+     * @brief   1つのチャンネル内の領域を重みに応じて再帰的に2分割し、クリッピングコンテキストに割り当てる。
+     *
+     * @param[in]   clipIndexBegin  ->  割り当てるクリッピングコンテキストの先頭インデックス
+     * @param[in]   clipIndexEnd    ->  割り当てるクリッピングコンテキストの終端インデックス（含まない）
+     * @param[in]   x               ->  領域の左端（0..1）
+     * @param[in]   y               ->  領域の下端（0..1）
+     * @param[in]   width           ->  領域の幅（0..1）
+     * @param[in]   height          ->  領域の高さ（0..1）
+     * @param[in]   weights         ->  クリッピングコンテキストごとの重み
+     */
+    void SplitLayoutBounds(csmInt32 clipIndexBegin, csmInt32 clipIndexEnd, csmFloat32 x, csmFloat32 y, csmFloat32 width, csmFloat32 height, const csmVector<csmFloat32>& weights) const;
+
     /**
      * @brief   マスクされるdrawableの描画オブジェクト群全体を囲む矩形(モデル座標系)を計算する
      *
@@ -176,6 +192,9 @@ protected:
     CubismMatrix44 _tmpMatrixForMask;       ///< マスク計算用の行列
     CubismMatrix44 _tmpMatrixForDraw;       ///< マスク計算用の行列
     csmRectF _tmpBoundsOnModel;       ///< マスク配置計算用の矩形
+
+    csmVector<csmInt32> _maskSignatureBuckets;   ///< マスクの組み合わせのハッシュ値ごとの、_clippingContextListForMask内の先頭インデックス（-1は空）
+    csmVector<csmInt32> _maskSignatureChain;     ///< 同じバケットに属する次のクリッピングコンテキストのインデックス（-1は終端）
 };
 
 #include "CubismClippingManager.tpp"
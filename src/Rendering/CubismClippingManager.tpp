@@ -105,6 +105,16 @@ void CubismClippingManager<T_ClippingContext, T_RenderTarget>::Initialize(Cubism
         break;
     }
 
+    // マスクの組み合わせを検索するハッシュテーブルを用意する（バケット数は2の累乗）
+    csmInt32 bucketCount = 16;
+    while (bucketCount < objectCount * 2)
+    {
+        bucketCount *= 2;
+    }
+    _maskSignatureBuckets.Clear();
+    _maskSignatureBuckets.Resize(bucketCount, -1);
+    _maskSignatureChain.Clear();
+
     //クリッピングマスクを使う描画オブジェクトを全て登録する
     //クリッピングマスクは、通常数個程度に限定して使うものとする
     for (csmInt32 i = 0; i < objectCount; ++i)
@@ -123,6 +133,11 @@ void CubismClippingManager<T_ClippingContext, T_RenderTarget>::Initialize(Cubism
             // 同一のマスクが存在していない場合は生成する
             cc = CSM_NEW T_ClippingContext(this, model, objectMasks[i], objectMaskCounts[i]);
             _clippingContextListForMask.PushBack(cc);
+
+            // ハッシュテーブルに登録
+            const csmInt32 bucket = static_cast<csmInt32>(cc->_maskSignatureHash & (_maskSignatureBuckets.GetSize() - 1));
+            _maskSignatureChain.PushBack(_maskSignatureBuckets[bucket]);
+            _maskSignatureBuckets[bucket] = _clippingContextListForMask.GetSize() - 1;
         }
 
         switch (drawableObjectType)
@@ -143,30 +158,30 @@ void CubismClippingManager<T_ClippingContext, T_RenderTarget>::Initialize(Cubism
 template <class T_ClippingContext, class T_RenderTarget>
 T_ClippingContext* CubismClippingManager<T_ClippingContext, T_RenderTarget>::FindSameClip(const csmInt32* drawableMasks, csmInt32 drawableMaskCounts) const
 {
-    // 作成済みClippingContextと一致するか確認
-    for (csmUint32 i = 0; i < _clippingContextListForMask.GetSize(); ++i)
-    {
-        T_ClippingContext* cc = _clippingContextListForMask[i];
-        const csmInt32 count = cc->_clippingIdCount;
-        if (count != drawableMaskCounts) continue; //個数が違う場合は別物
-        csmInt32 samecount = 0;
+    // 並び順に依存せず比較できるよう昇順に並べ替えた正規形を作る
+    csmVector<csmInt32> sortedMasks;
+    const csmUint32 hash = CubismClippingContext::MakeMaskSignature(drawableMasks, drawableMaskCounts, sortedMasks);
 
-        // 同じIDを持つか確認。配列の数が同じなので、一致した個数が同じなら同じ物を持つとする。
-        for (csmInt32 j = 0; j < count; ++j)
+    if (_maskSignatureBuckets.GetSize() == 0)
+    {
+        // ハッシュテーブルが未作成の場合は全て確認する
+        for (csmUint32 i = 0; i < _clippingContextListForMask.GetSize(); ++i)
         {
-            const csmInt32 clipId = cc->_clippingIdList[j];
-            for (csmInt32 k = 0; k < count; ++k)
+            if (_clippingContextListForMask[i]->IsSameMaskSignature(sortedMasks.GetPtr(), drawableMaskCounts, hash))
             {
-                if (drawableMasks[k] == clipId)
-                {
-                    ++samecount;
-                    break;
-                }
+                return _clippingContextListForMask[i];
             }
         }
-        if (samecount == count)
+        return NULL;
+    }
+
+    // 同じバケットに属する作成済みClippingContextと一致するか確認
+    const csmInt32 bucket = static_cast<csmInt32>(hash & (_maskSignatureBuckets.GetSize() - 1));
+    for (csmInt32 i = _maskSignatureBuckets[bucket]; i >= 0; i = _maskSignatureChain[i])
+    {
+        if (_clippingContextListForMask[i]->IsSameMaskSignature(sortedMasks.GetPtr(), drawableMaskCounts, hash))
         {
-            return cc;
+            return _clippingContextListForMask[i];
         }
     }
     return NULL; //見つからなかった
@@ -342,6 +357,20 @@ void CubismClippingManager<T_ClippingContext, T_RenderTarget>::SetupLayoutBounds
     const csmInt32 divCount = countPerSheetDiv / ColorChannelCount; //１チャンネルに配置する基本のマスク個数
     const csmInt32 modCount = countPerSheetDiv % ColorChannelCount; //余り、この番号のチャンネルまでに１つずつ配分する
 
+    // マスクされる描画オブジェクトの囲み矩形の面積を配置の重みとする
+    // 面積が前回採用した値の半分から2倍の範囲にある間は重みを維持し、レイアウトが毎フレーム変化しないようにする
+    csmVector<csmFloat32> weights(_clippingContextListForMask.GetSize());
+    for (csmUint32 index = 0; index < _clippingContextListForMask.GetSize(); ++index)
+    {
+        T_ClippingContext* cc = _clippingContextListForMask[index];
+        const csmFloat32 area = cc->_allClippedDrawRect->Width * cc->_allClippedDrawRect->Height;
+        if (cc->_layoutWeight <= 0.0f || area < cc->_layoutWeight * 0.5f || cc->_layoutWeight * 2.0f < area)
+        {
+            cc->_layoutWeight = area;
+        }
+        weights.PushBack(cc->_layoutWeight);
+    }
+
     // RGBAそれぞれのチャンネルを用意していく(0:R , 1:G , 2:B, 3:A, )
     csmInt32 curClipIndex = 0; //順番に設定していく
 
@@ -369,69 +398,26 @@ void CubismClippingManager<T_ClippingContext, T_RenderTarget>::SetupLayoutBounds
             {
                 // 何もしない
             }
-            else if (layoutCount == 1)
-            {
-                //全てをそのまま使う
-                T_ClippingContext* cc = _clippingContextListForMask[curClipIndex++];
-                cc->_layoutChannelIndex = channelIndex;
-                cc->_layoutBounds->X = 0.0f;
-                cc->_layoutBounds->Y = 0.0f;
-                cc->_layoutBounds->Width = 1.0f;
-                cc->_layoutBounds->Height = 1.0f;
-                cc->_bufferIndex = renderTextureIndex;
-            }
-            else if (layoutCount == 2)
+            else if (layoutCount <= layoutCountMaxValue)
             {
-                for (csmInt32 i = 0; i < layoutCount; ++i)
+                // 極端に小さな領域にならないよう、チャンネル内で最大の重みの1/16を下限とする
+                csmFloat32 maxWeight = 0.0f;
+                for (csmInt32 i = curClipIndex; i < curClipIndex + layoutCount; ++i)
                 {
-                    const csmInt32 xpos = i % 2;
-
-                    T_ClippingContext* cc = _clippingContextListForMask[curClipIndex++];
-                    cc->_layoutChannelIndex = channelIndex;
-
-                    cc->_layoutBounds->X = xpos * 0.5f;
-                    cc->_layoutBounds->Y = 0.0f;
-                    cc->_layoutBounds->Width = 0.5f;
-                    cc->_layoutBounds->Height = 1.0f;
-                    cc->_bufferIndex = renderTextureIndex;
-                    //UVを2つに分解して使う
+                    maxWeight = weights[i] > maxWeight ? weights[i] : maxWeight;
                 }
-            }
-            else if (layoutCount <= 4)
-            {
-                //4分割して使う
-                for (csmInt32 i = 0; i < layoutCount; ++i)
+                for (csmInt32 i = curClipIndex; i < curClipIndex + layoutCount; ++i)
                 {
-                    const csmInt32 xpos = i % 2;
-                    const csmInt32 ypos = i / 2;
+                    weights[i] = maxWeight > 0.0f ? CubismMath::Max(weights[i], maxWeight / 16.0f) : 1.0f;
 
-                    T_ClippingContext* cc = _clippingContextListForMask[curClipIndex++];
+                    T_ClippingContext* cc = _clippingContextListForMask[i];
                     cc->_layoutChannelIndex = channelIndex;
-
-                    cc->_layoutBounds->X = xpos * 0.5f;
-                    cc->_layoutBounds->Y = ypos * 0.5f;
-                    cc->_layoutBounds->Width = 0.5f;
-                    cc->_layoutBounds->Height = 0.5f;
                     cc->_bufferIndex = renderTextureIndex;
                 }
-            }
-            else if (layoutCount <= layoutCountMaxValue)
-            {
-                //9分割して使う
-                for (csmInt32 i = 0; i < layoutCount; ++i)
-                {
-                    const csmInt32 xpos = i % 3;
-                    const csmInt32 ypos = i / 3;
-
-                    T_ClippingContext* cc = _clippingContextListForMask[curClipIndex++];
-                    cc->_layoutChannelIndex = channelIndex;
 
-                    cc->_layoutBounds->X = xpos / 3.0f;
-                    cc->_layoutBounds->Y = ypos / 3.0f;
-                    cc->_layoutBounds->Width = 1.0f / 3.0f;
-                    cc->_layoutBounds->Height = 1.0f / 3.0f;
-                    cc->_bufferIndex = renderTextureIndex;
-                }
+                // 重みに応じてチャンネル全体を分割して使う
+                SplitLayoutBounds(curClipIndex, curClipIndex + layoutCount, 0.0f, 0.0f, 1.0f, 1.0f, weights);
+                curClipIndex += layoutCount;
             }
             // マスクの制限枚数を超えた場合の処理
             else
@@ -462,6 +448,51 @@ void CubismClippingManager<T_ClippingContext, T_RenderTarget>::SetupLayoutBounds
     }
 }
 
+template <class T_ClippingContext, class T_RenderTarget>
+void CubismClippingManager<T_ClippingContext, T_RenderTarget>::SplitLayoutBounds(csmInt32 clipIndexBegin, csmInt32 clipIndexEnd, csmFloat32 x, csmFloat32 y, csmFloat32 width, csmFloat32 height, const csmVector<csmFloat32>& weights) const
+{
+    if (clipIndexEnd - clipIndexBegin == 1)
+    {
+        T_ClippingContext* cc = _clippingContextListForMask[clipIndexBegin];
+        cc->_layoutBounds->X = x;
+        cc->_layoutBounds->Y = y;
+        cc->_layoutBounds->Width = width;
+        cc->_layoutBounds->Height = height;
+        return;
+    }
+
+    csmFloat32 totalWeight = 0.0f;
+    for (csmInt32 i = clipIndexBegin; i < clipIndexEnd; ++i)
+    {
+        totalWeight += weights[i];
+    }
+
+    // 並び順を保ったまま、重みの合計がなるべく半分ずつになる位置で分ける
+    csmInt32 splitIndex = clipIndexBegin + 1;
+    csmFloat32 frontWeight = weights[clipIndexBegin];
+    while (splitIndex < clipIndexEnd - 1 &&
+           CubismMath::AbsF(totalWeight - 2.0f * (frontWeight + weights[splitIndex])) < CubismMath::AbsF(totalWeight - 2.0f * frontWeight))
+    {
+        frontWeight += weights[splitIndex];
+        ++splitIndex;
+    }
+    const csmFloat32 ratio = frontWeight / totalWeight;
+
+    // 長辺で分割し、隣接するマスクが同じピクセルにまたがらないよう分割位置をピクセル境界に合わせる
+    if (width * _clippingMaskBufferSize.X >= height * _clippingMaskBufferSize.Y)
+    {
+        const csmFloat32 frontWidth = static_cast<csmInt32>(width * ratio * _clippingMaskBufferSize.X + 0.5f) / _clippingMaskBufferSize.X;
+        SplitLayoutBounds(clipIndexBegin, splitIndex, x, y, frontWidth, height, weights);
+        SplitLayoutBounds(splitIndex, clipIndexEnd, x + frontWidth, y, width - frontWidth, height, weights);
+    }
+    else
+    {
+        const csmFloat32 frontHeight = static_cast<csmInt32>(height * ratio * _clippingMaskBufferSize.Y + 0.5f) / _clippingMaskBufferSize.Y;
+        SplitLayoutBounds(clipIndexBegin, splitIndex, x, y, width, frontHeight, weights);
+        SplitLayoutBounds(splitIndex, clipIndexEnd, x, y + frontHeight, width, height - frontHeight, weights);
+    }
+}
+
 template <class T_ClippingContext, class T_RenderTarget>
 void CubismClippingManager<T_ClippingContext, T_RenderTarget>::CalcClippedTotalBounds(CubismModel& model, T_ClippingContext* clippingContext, CubismRenderer::DrawableObjectType drawableObjectType)
 {
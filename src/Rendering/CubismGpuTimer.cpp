@@ -0,0 +1,251 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismGpuTimer.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+namespace {
+    const csmUint32 FixedSectionCount = 2;  ///< オフスクリーン以外の区間の数（マスク・描画ループ）
+}
+
+CubismGpuTimer::CubismGpuTimer()
+    : _queryCountPerSlot(0)
+    , _isUnsupported(false)
+    , _recordingSlot(-1)
+    , _frameNumber(0)
+{
+    for (csmUint32 i = 0; i < FrameSlotCount; ++i)
+    {
+        _slots[i].IsPending = false;
+        _slots[i].FrameNumber = 0;
+        _slots[i].QueryCount = 0;
+        _slots[i].OffscreenCount = 0;
+    }
+}
+
+CubismGpuTimer::~CubismGpuTimer()
+{
+}
+
+void CubismGpuTimer::Release()
+{
+    if (_queryCountPerSlot > 0)
+    {
+        DestroyQueries();
+        _queryCountPerSlot = 0;
+    }
+
+    for (csmUint32 i = 0; i < FrameSlotCount; ++i)
+    {
+        _slots[i].IsPending = false;
+        _slots[i].QueryCount = 0;
+        _slots[i].Sections.Clear();
+    }
+    _recordingSlot = -1;
+}
+
+csmBool CubismGpuTimer::BeginFrame(csmInt32 offscreenCount)
+{
+    _recordingSlot = -1;
+
+    if (_isUnsupported)
+    {
+        return false;
+    }
+
+    // オフスクリーンは1フレームに1度ずつ合成されるため、区間の数はオフスクリーンの数で決まる
+    const csmUint32 requiredQueryCount = (FixedSectionCount + static_cast<csmUint32>(offscreenCount)) * 2;
+    if (_queryCountPerSlot < requiredQueryCount)
+    {
+        Release();
+        if (!CreateQueries(requiredQueryCount * FrameSlotCount))
+        {
+            CubismLogWarning("GPU timestamp queries are not supported. GPU timing is disabled.");
+            _isUnsupported = true;
+            return false;
+        }
+        _queryCountPerSlot = requiredQueryCount;
+        _timestamps.Resize(requiredQueryCount);
+    }
+
+    CollectResults();
+
+    const csmUint32 slotIndex = static_cast<csmUint32>(_frameNumber % FrameSlotCount);
+    const csmUint64 frameNumber = _frameNumber++;
+    FrameSlot& slot = _slots[slotIndex];
+
+    // 結果を待っている組は上書きせず、GPUを待たせないようにこのフレームの計測を見送る
+    if (slot.IsPending)
+    {
+        ++_stats.SkippedFrameCount;
+        return false;
+    }
+
+    slot.FrameNumber = frameNumber;
+    slot.QueryCount = 0;
+    slot.OffscreenCount = offscreenCount;
+    slot.Sections.Clear();
+    ResetQueries(slotIndex * _queryCountPerSlot, _queryCountPerSlot);
+
+    _recordingSlot = static_cast<csmInt32>(slotIndex);
+    return true;
+}
+
+void CubismGpuTimer::EndFrame()
+{
+    if (_recordingSlot < 0)
+    {
+        return;
+    }
+
+    FrameSlot& slot = _slots[_recordingSlot];
+    slot.IsPending = (slot.QueryCount > 0);
+    _recordingSlot = -1;
+}
+
+csmInt32 CubismGpuTimer::BeginSection(SectionType type, csmInt32 index)
+{
+    if (_recordingSlot < 0)
+    {
+        return -1;
+    }
+
+    FrameSlot& slot = _slots[_recordingSlot];
+    if (slot.QueryCount + 2 > _queryCountPerSlot)
+    {
+        return -1;
+    }
+
+    Section section;
+    section.Type = type;
+    section.Index = index;
+    section.BeginQuery = slot.QueryCount;
+    section.EndQuery = slot.QueryCount;
+    WriteTimestamp(_recordingSlot * _queryCountPerSlot + slot.QueryCount);
+    ++slot.QueryCount;
+
+    slot.Sections.PushBack(section);
+    return static_cast<csmInt32>(slot.Sections.GetSize()) - 1;
+}
+
+void CubismGpuTimer::EndSection(csmInt32 section)
+{
+    if (_recordingSlot < 0 || section < 0)
+    {
+        return;
+    }
+
+    FrameSlot& slot = _slots[_recordingSlot];
+    if (static_cast<csmUint32>(section) >= slot.Sections.GetSize() || slot.QueryCount >= _queryCountPerSlot)
+    {
+        return;
+    }
+
+    slot.Sections[section].EndQuery = slot.QueryCount;
+    WriteTimestamp(_recordingSlot * _queryCountPerSlot + slot.QueryCount);
+    ++slot.QueryCount;
+}
+
+const CubismRenderer::CubismGpuTimingStats& CubismGpuTimer::GetStats() const
+{
+    return _stats;
+}
+
+void CubismGpuTimer::ResetQueries(csmUint32, csmUint32)
+{
+}
+
+void CubismGpuTimer::CollectResults()
+{
+    // 古いフレームから順に読み出し、読み出せないフレームがあればそれ以降も待つ
+    for (csmUint32 i = 0; i < FrameSlotCount; ++i)
+    {
+        FrameSlot* oldest = NULL;
+        csmUint32 oldestIndex = 0;
+        for (csmUint32 slotIndex = 0; slotIndex < FrameSlotCount; ++slotIndex)
+        {
+            if (_slots[slotIndex].IsPending && (oldest == NULL || _slots[slotIndex].FrameNumber < oldest->FrameNumber))
+            {
+                oldest = &_slots[slotIndex];
+                oldestIndex = slotIndex;
+            }
+        }
+
+        if (oldest == NULL)
+        {
+            return;
+        }
+
+        const ReadResult result = ReadTimestamps(oldestIndex * _queryCountPerSlot, oldest->QueryCount, _timestamps.GetPtr());
+        if (result == ReadResult_NotReady)
+        {
+            return;
+        }
+
+        if (result == ReadResult_Ready)
+        {
+            UpdateStats(*oldest);
+        }
+        oldest->IsPending = false;
+    }
+}
+
+void CubismGpuTimer::UpdateStats(const FrameSlot& slot)
+{
+    _stats.IsValid = true;
+    _stats.FrameNumber = slot.FrameNumber;
+    _stats.Latency = static_cast<csmUint32>(_frameNumber - slot.FrameNumber);
+    _stats.MaskMilliseconds = 0.0f;
+    _stats.DrawLoopMilliseconds = 0.0f;
+    _stats.OffscreenMilliseconds = 0.0f;
+    _stats.OffscreenCount = 0;
+    // 計測時のオフスクリーンの数で集計し、その後にモデルが変わっても添字がずれないようにする
+    _stats.OffscreenMillisecondsList.Resize(slot.OffscreenCount);
+    for (csmInt32 i = 0; i < slot.OffscreenCount; ++i)
+    {
+        _stats.OffscreenMillisecondsList[i] = 0.0f;
+    }
+
+    for (csmUint32 i = 0; i < slot.Sections.GetSize(); ++i)
+    {
+        const Section& section = slot.Sections[i];
+        if (section.EndQuery == section.BeginQuery)
+        {
+            continue;
+        }
+
+        const csmUint64 begin = _timestamps[section.BeginQuery];
+        const csmUint64 end = _timestamps[section.EndQuery];
+        const csmFloat32 milliseconds = (end > begin) ? static_cast<csmFloat32>(end - begin) / 1000000.0f : 0.0f;
+
+        switch (section.Type)
+        {
+        case SectionType_Mask:
+            _stats.MaskMilliseconds += milliseconds;
+            break;
+        case SectionType_DrawLoop:
+            _stats.DrawLoopMilliseconds += milliseconds;
+            break;
+        case SectionType_Offscreen:
+            _stats.OffscreenMilliseconds += milliseconds;
+            ++_stats.OffscreenCount;
+            if (0 <= section.Index && section.Index < slot.OffscreenCount)
+            {
+                _stats.OffscreenMillisecondsList[section.Index] += milliseconds;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
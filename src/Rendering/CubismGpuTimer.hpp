@@ -0,0 +1,196 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismRenderer.hpp"
+#include "CubismFramework.hpp"
+#include "Type/csmVector.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+/**
+ * @brief   GPUのタイムスタンプで描画の区間ごとの時間を計測するクラス<br>
+ *           フレームごとにタイムスタンプの組を用意し、FrameSlotCount フレーム分を順に使い回す。<br>
+ *           結果は後のフレームの BeginFrame() で待たずに読み出し、まだ読み出せないフレームの組は使わずに計測を見送る。<br>
+ *           タイムスタンプの記録と読み出しはサブクラスで描画APIごとに実装する。
+ */
+class CubismGpuTimer
+{
+public:
+    /**
+     * @brief   計測する区間の種類
+     */
+    enum SectionType
+    {
+        SectionType_Mask,       ///< クリッピングマスクの生成
+        SectionType_DrawLoop,   ///< 描画順に従った描画ループ
+        SectionType_Offscreen,  ///< オフスクリーンの親への合成
+    };
+
+    /**
+     * @brief   タイムスタンプの読み出しの結果
+     */
+    enum ReadResult
+    {
+        ReadResult_NotReady,    ///< まだGPUの処理が終わっていない
+        ReadResult_Ready,       ///< 読み出せた
+        ReadResult_Invalid,     ///< GPUの処理は終わったが値が使えない
+    };
+
+    static const csmUint32 FrameSlotCount = 4;  ///< 結果を待つ間に使い回すフレームの数
+
+    /**
+     * @brief   コンストラクタ
+     */
+    CubismGpuTimer();
+
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~CubismGpuTimer();
+
+    /**
+     * @brief   フレームの計測を開始する<br>
+     *           読み出せるようになった過去のフレームの結果もここで集計する
+     *
+     * @param[in]   offscreenCount  ->  モデルのオフスクリーンの数
+     *
+     * @return  このフレームを計測する場合はtrue
+     */
+    csmBool BeginFrame(csmInt32 offscreenCount);
+
+    /**
+     * @brief   フレームの計測を終了する
+     */
+    void EndFrame();
+
+    /**
+     * @brief   区間の開始のタイムスタンプを記録する
+     *
+     * @param[in]   type    ->  区間の種類
+     * @param[in]   index   ->  オフスクリーンのインデックス。それ以外の区間では0
+     *
+     * @return  区間の番号。計測しない場合は-1
+     */
+    csmInt32 BeginSection(SectionType type, csmInt32 index);
+
+    /**
+     * @brief   区間の終了のタイムスタンプを記録する
+     *
+     * @param[in]   section ->  BeginSection() が返した区間の番号
+     */
+    void EndSection(csmInt32 section);
+
+    /**
+     * @brief   最新の計測結果を取得する
+     *
+     * @return  計測結果
+     */
+    const CubismRenderer::CubismGpuTimingStats& GetStats() const;
+
+protected:
+    /**
+     * @brief   タイムスタンプを記録するクエリを作成する
+     *
+     * @param[in]   queryCount  ->  クエリの数
+     *
+     * @return  作成できた場合はtrue。GPUが対応していない場合はfalse
+     */
+    virtual csmBool CreateQueries(csmUint32 queryCount) = 0;
+
+    /**
+     * @brief   作成したクエリを破棄する
+     */
+    virtual void DestroyQueries() = 0;
+
+    /**
+     * @brief   クエリを再び記録できる状態に戻す<br>
+     *           フレームの計測を始める前に呼ばれる。既定の実装は何もしない
+     *
+     * @param[in]   firstQuery  ->  最初のクエリ
+     * @param[in]   queryCount  ->  クエリの数
+     */
+    virtual void ResetQueries(csmUint32 firstQuery, csmUint32 queryCount);
+
+    /**
+     * @brief   クエリにGPUのタイムスタンプを記録する
+     *
+     * @param[in]   query   ->  クエリ
+     */
+    virtual void WriteTimestamp(csmUint32 query) = 0;
+
+    /**
+     * @brief   記録したタイムスタンプをGPUの処理を待たずに読み出す
+     *
+     * @param[in]   firstQuery  ->  最初のクエリ
+     * @param[in]   queryCount  ->  クエリの数
+     * @param[out]  nanoseconds ->  ナノ秒に換算したタイムスタンプ
+     *
+     * @return  読み出しの結果
+     */
+    virtual ReadResult ReadTimestamps(csmUint32 firstQuery, csmUint32 queryCount, csmUint64* nanoseconds) = 0;
+
+    /**
+     * @brief   作成したクエリを破棄し、計測していたフレームの結果を捨てる<br>
+     *           サブクラスのデストラクタから呼ぶ
+     */
+    void Release();
+
+private:
+    /**
+     * @brief   計測した区間
+     */
+    struct Section
+    {
+        SectionType Type;           ///< 区間の種類
+        csmInt32    Index;          ///< オフスクリーンのインデックス
+        csmUint32   BeginQuery;     ///< 開始を記録したフレーム内のクエリ
+        csmUint32   EndQuery;       ///< 終了を記録したフレーム内のクエリ。未記録の場合は開始と同じ
+    };
+
+    /**
+     * @brief   1フレーム分のクエリの組
+     */
+    struct FrameSlot
+    {
+        csmBool             IsPending;      ///< 結果の読み出しを待っているならtrue
+        csmUint64           FrameNumber;    ///< 計測したフレームの番号
+        csmUint32           QueryCount;     ///< 記録したクエリの数
+        csmInt32            OffscreenCount; ///< 計測したフレームのオフスクリーンの数
+        csmVector<Section>  Sections;       ///< 計測した区間
+    };
+
+    // Prevention of copy Constructor
+    CubismGpuTimer(const CubismGpuTimer&);
+    CubismGpuTimer& operator=(const CubismGpuTimer&);
+
+    /**
+     * @brief   読み出せるようになったフレームの結果を集計する
+     */
+    void CollectResults();
+
+    /**
+     * @brief   読み出したタイムスタンプから計測結果を作る
+     *
+     * @param[in]   slot    ->  フレームのクエリの組
+     */
+    void UpdateStats(const FrameSlot& slot);
+
+    FrameSlot                               _slots[FrameSlotCount];     ///< フレームごとのクエリの組
+    csmUint32                               _queryCountPerSlot;         ///< 1フレームで使えるクエリの数
+    csmBool                                 _isUnsupported;             ///< クエリを作成できなかった場合はtrue
+    csmInt32                                _recordingSlot;             ///< 計測中のフレームの組。計測していなければ-1
+    csmUint64                               _frameNumber;               ///< 次に計測するフレームの番号
+    csmVector<csmUint64>                    _timestamps;                ///< 読み出したタイムスタンプの作業領域
+    CubismRenderer::CubismGpuTimingStats    _stats;                     ///< 最新の計測結果
+};
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
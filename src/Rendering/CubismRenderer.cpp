@@ -9,10 +9,35 @@
 #include "CubismFramework.hpp"
 #include "Model/CubismModel.hpp"
 #include "Math/CubismMath.hpp"
+#include "Utils/CubismProfiler.hpp"
 
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
 
+namespace {
+    const csmFloat32 DefaultDirtyRectThreshold = 0.5f;  ///< 部分描画を行う範囲の描画先全体に対する割合の既定の上限
+    const csmUint32 DefaultAdaptiveClippingMaskMinSize = 256;     ///< 自動で選ぶマスク用バッファの既定の最小サイズ
+    const csmUint32 DefaultAdaptiveClippingMaskMaxSize = 2048;    ///< 自動で選ぶマスク用バッファの既定の最大サイズ
+    const csmFloat32 AdaptiveClippingMaskHysteresis = 0.25f;      ///< マスクを小さくする方向の判定に持たせる余裕の割合
+
+    /**
+     * @brief   2つの矩形が重なっているか
+     */
+    csmBool IsRectOverlapped(const csmRectF& a, const csmRectF& b)
+    {
+        return a.X < b.GetRight() && b.X < a.GetRight() &&
+               a.Y < b.GetBottom() && b.Y < a.GetBottom();
+    }
+
+    /**
+     * @brief   2つの色が同じか
+     */
+    csmBool IsSameColor(const CubismRenderer::CubismTextureColor& a, const CubismRenderer::CubismTextureColor& b)
+    {
+        return a.R == b.R && a.G == b.G && a.B == b.B && a.A == b.A;
+    }
+}
+
 void CubismRenderer::Delete(CubismRenderer* renderer)
 {
     CSM_DELETE_SELF(CubismRenderer, renderer);
@@ -26,9 +51,24 @@ CubismRenderer::CubismRenderer(csmUint32 width, csmUint32 height)
     , _anisotropy(0.0f)
     , _model(NULL)
     , _useHighPrecisionMask(false)
+    , _useImpostor(false)
+    , _isImpostorValid(false)
+    , _hasImpostorPendingChange(false)
+    , _impostorRefreshInterval(0)
+    , _impostorReusedFrameCount(0)
+    , _impostorWidth(0)
+    , _impostorHeight(0)
+    , _useDirtyRect(false)
+    , _dirtyRectThreshold(DefaultDirtyRectThreshold)
+    , _useAdaptiveClippingMask(false)
+    , _adaptiveClippingMaskMinSize(DefaultAdaptiveClippingMaskMinSize)
+    , _adaptiveClippingMaskMaxSize(DefaultAdaptiveClippingMaskMaxSize)
+    , _adaptiveClippingMaskSize(0)
+    , _useGpuTiming(false)
 {
     //単位行列に初期化
     _mvpMatrix4x4.LoadIdentity();
+    _impostorMvpMatrix.LoadIdentity();
 }
 
 CubismRenderer::~CubismRenderer()
@@ -42,6 +82,8 @@ void CubismRenderer::Initialize(Framework::CubismModel* model)
 void CubismRenderer::Initialize(Framework::CubismModel* model, csmInt32 maskBufferCount)
 {
     _model = model;
+    InvalidateImpostor();
+    _adaptiveClippingMaskSize = 0;
 
     // ブレンドモード使用時は必ず高精細にする
     if (model->IsBlendModeEnabled())
@@ -58,6 +100,8 @@ void CubismRenderer::DrawModel()
         return;
     }
 
+    CSM_PROFILE_ZONE(Zone_Draw, GetModel());
+
     /**
      * DoDrawModelの描画前と描画後に以下の関数を呼んでください。
      * ・SaveProfile();
@@ -68,7 +112,21 @@ void CubismRenderer::DrawModel()
 
     SaveProfile();
 
-    DoDrawModel();
+    UpdateAdaptiveClippingMask();
+
+    // 部分描画が使える場合は、キャッシュを使い続けずに変化した範囲だけを描き直す
+    // インポスターのキャッシュを使える場合はモデル全体の描画を省略する
+    const csmBool isDirtyRectAvailable = IsDirtyRectAvailable();
+    if (isDirtyRectAvailable && RedrawDirtyRect())
+    {
+        UpdateImpostorState();
+    }
+    else if (isDirtyRectAvailable || !IsImpostorReusable() || !DrawImpostor())
+    {
+        DoDrawModel();
+        UpdateImpostorState();
+        UpdateDirtyRectBounds();
+    }
 
     RestoreProfile();
 }
@@ -160,6 +218,481 @@ csmBool CubismRenderer::IsUsingHighPrecisionMask()
     return _useHighPrecisionMask;
 }
 
+void CubismRenderer::UseImpostor(csmBool enable)
+{
+    _useImpostor = enable;
+    InvalidateImpostor();
+}
+
+csmBool CubismRenderer::IsUsingImpostor() const
+{
+    return _useImpostor;
+}
+
+void CubismRenderer::SetImpostorRefreshInterval(csmUint32 frameCount)
+{
+    _impostorRefreshInterval = frameCount;
+}
+
+csmUint32 CubismRenderer::GetImpostorRefreshInterval() const
+{
+    return _impostorRefreshInterval;
+}
+
+void CubismRenderer::InvalidateImpostor()
+{
+    _isImpostorValid = false;
+    _hasImpostorPendingChange = false;
+    _impostorReusedFrameCount = 0;
+}
+
+csmBool CubismRenderer::DrawImpostor()
+{
+    return false;
+}
+
+void CubismRenderer::UseDirtyRect(csmBool enable)
+{
+    _useDirtyRect = enable;
+    InvalidateImpostor();
+}
+
+csmBool CubismRenderer::IsUsingDirtyRect() const
+{
+    return _useDirtyRect;
+}
+
+void CubismRenderer::SetDirtyRectThreshold(csmFloat32 ratio)
+{
+    _dirtyRectThreshold = ratio;
+}
+
+csmFloat32 CubismRenderer::GetDirtyRectThreshold() const
+{
+    return _dirtyRectThreshold;
+}
+
+void CubismRenderer::UseAdaptiveClippingMask(csmBool enable)
+{
+    _useAdaptiveClippingMask = enable;
+
+    // 次の描画で選びなおす
+    _adaptiveClippingMaskSize = 0;
+}
+
+csmBool CubismRenderer::IsUsingAdaptiveClippingMask() const
+{
+    return _useAdaptiveClippingMask;
+}
+
+void CubismRenderer::SetAdaptiveClippingMaskSizeRange(csmUint32 minSize, csmUint32 maxSize)
+{
+    _adaptiveClippingMaskMinSize = (minSize > 0) ? minSize : 1;
+    _adaptiveClippingMaskMaxSize = (maxSize > _adaptiveClippingMaskMinSize) ? maxSize : _adaptiveClippingMaskMinSize;
+    _adaptiveClippingMaskSize = 0;
+}
+
+csmUint32 CubismRenderer::GetAdaptiveClippingMaskSize() const
+{
+    return _adaptiveClippingMaskSize;
+}
+
+void CubismRenderer::UseGpuTiming(csmBool enable)
+{
+    _useGpuTiming = enable;
+}
+
+csmBool CubismRenderer::IsUsingGpuTiming() const
+{
+    return _useGpuTiming;
+}
+
+const CubismRenderer::CubismGpuTimingStats& CubismRenderer::GetGpuTimingStats() const
+{
+    return _gpuTimingStats;
+}
+
+csmBool CubismRenderer::DrawDirtyRect(const csmRectF&)
+{
+    return false;
+}
+
+void CubismRenderer::ApplyAdaptiveClippingMaskSize(csmUint32)
+{
+}
+
+csmBool CubismRenderer::IsDrawableInDirtyRect(const csmInt32 drawableIndex) const
+{
+    if (!_model->GetDrawableDynamicFlagIsVisible(drawableIndex))
+    {
+        return false;
+    }
+
+    return IsRectOverlapped(_dirtyRectDrawableBounds[drawableIndex], _dirtyRect);
+}
+
+csmBool CubismRenderer::IsImpostorReusable()
+{
+    if (!_useImpostor || !_isImpostorValid || !IsImpostorTargetUnchanged())
+    {
+        return false;
+    }
+
+    // 動的フラグは直前のUpdateでの変化を表すため、使い続けた変化はフラグが消えても記録しておく
+    const csmInt32 drawableCount = _model->GetDrawableCount();
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        // 表示状態や描画順、色やカリングの変化は見た目が大きく変わるため即座に描き直す
+        if (_model->GetDrawableDynamicFlagVisibilityDidChange(i) ||
+            _model->GetDrawableDynamicFlagDrawOrderDidChange(i) ||
+            _model->GetDrawableDynamicFlagRenderOrderDidChange(i) ||
+            _model->GetDrawableDynamicFlagBlendColorDidChange(i) ||
+            IsDrawableColorOrCullingChanged(i))
+        {
+            return false;
+        }
+
+        if (!_hasImpostorPendingChange &&
+            _model->GetDrawableDynamicFlagIsVisible(i) &&
+            (_model->GetDrawableDynamicFlagVertexPositionsDidChange(i) || _model->GetDrawableDynamicFlagOpacityDidChange(i)))
+        {
+            _hasImpostorPendingChange = true;
+        }
+    }
+
+    const csmInt32 offscreenCount = _model->GetOffscreenCount();
+    if (offscreenCount != static_cast<csmInt32>(_impostorOffscreenOpacities.GetSize()))
+    {
+        return false;
+    }
+
+    for (csmInt32 i = 0; i < offscreenCount; ++i)
+    {
+        if (IsOffscreenColorOrCullingChanged(i))
+        {
+            return false;
+        }
+
+        if (_model->GetOffscreenOpacity(i) != _impostorOffscreenOpacities[i])
+        {
+            _hasImpostorPendingChange = true;
+        }
+    }
+
+    // 小さな変化は最初の変化から指定の間隔だけキャッシュを使い続けてから描き直す
+    if (_hasImpostorPendingChange)
+    {
+        if (_impostorReusedFrameCount >= _impostorRefreshInterval)
+        {
+            return false;
+        }
+
+        ++_impostorReusedFrameCount;
+    }
+
+    return true;
+}
+
+void CubismRenderer::UpdateImpostorState()
+{
+    if (!_useImpostor)
+    {
+        return;
+    }
+
+    _isImpostorValid = true;
+    _hasImpostorPendingChange = false;
+    _impostorReusedFrameCount = 0;
+    _impostorMvpMatrix.SetMatrix(_mvpMatrix4x4.GetArray());
+    _impostorModelColor = _modelColor;
+    _impostorWidth = _modelRenderTargetWidth;
+    _impostorHeight = _modelRenderTargetHeight;
+
+    const csmInt32 offscreenCount = _model->GetOffscreenCount();
+    _impostorOffscreenOpacities.Resize(offscreenCount);
+    for (csmInt32 i = 0; i < offscreenCount; ++i)
+    {
+        _impostorOffscreenOpacities[i] = _model->GetOffscreenOpacity(i);
+    }
+
+    // 上書きした乗算色・スクリーン色・カリングはモデルの動的フラグに現れないため、値を記録して比較する
+    // アートメッシュの後ろにオフスクリーンの値を並べる
+    const CubismModelMultiplyAndScreenColor& overrideColor = _model->GetOverrideMultiplyAndScreenColor();
+    const csmInt32 drawableCount = _model->GetDrawableCount();
+    _impostorMultiplyColors.Resize(drawableCount + offscreenCount);
+    _impostorScreenColors.Resize(drawableCount + offscreenCount);
+    _impostorCullings.Resize(drawableCount + offscreenCount);
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        _impostorMultiplyColors[i] = overrideColor.GetDrawableMultiplyColor(i);
+        _impostorScreenColors[i] = overrideColor.GetDrawableScreenColor(i);
+        _impostorCullings[i] = _model->GetDrawableCulling(i);
+    }
+    for (csmInt32 i = 0; i < offscreenCount; ++i)
+    {
+        _impostorMultiplyColors[drawableCount + i] = overrideColor.GetOffscreenMultiplyColor(i);
+        _impostorScreenColors[drawableCount + i] = overrideColor.GetOffscreenScreenColor(i);
+        _impostorCullings[drawableCount + i] = _model->GetOffscreenCulling(i);
+    }
+}
+
+csmBool CubismRenderer::IsDrawableColorOrCullingChanged(const csmInt32 drawableIndex) const
+{
+    if (drawableIndex >= static_cast<csmInt32>(_impostorCullings.GetSize()))
+    {
+        return true;
+    }
+
+    const CubismModelMultiplyAndScreenColor& overrideColor = _model->GetOverrideMultiplyAndScreenColor();
+    return !IsSameColor(overrideColor.GetDrawableMultiplyColor(drawableIndex), _impostorMultiplyColors[drawableIndex]) ||
+           !IsSameColor(overrideColor.GetDrawableScreenColor(drawableIndex), _impostorScreenColors[drawableIndex]) ||
+           _model->GetDrawableCulling(drawableIndex) != _impostorCullings[drawableIndex];
+}
+
+csmBool CubismRenderer::IsOffscreenColorOrCullingChanged(const csmInt32 offscreenIndex) const
+{
+    const csmInt32 index = _model->GetDrawableCount() + offscreenIndex;
+    if (index >= static_cast<csmInt32>(_impostorCullings.GetSize()))
+    {
+        return true;
+    }
+
+    const CubismModelMultiplyAndScreenColor& overrideColor = _model->GetOverrideMultiplyAndScreenColor();
+    return !IsSameColor(overrideColor.GetOffscreenMultiplyColor(offscreenIndex), _impostorMultiplyColors[index]) ||
+           !IsSameColor(overrideColor.GetOffscreenScreenColor(offscreenIndex), _impostorScreenColors[index]) ||
+           _model->GetOffscreenCulling(offscreenIndex) != _impostorCullings[index];
+}
+
+csmBool CubismRenderer::IsImpostorTargetUnchanged()
+{
+    // 描画先・行列・モデルの色が変わった場合はキャッシュの見た目と一致しない
+    if (_impostorWidth != _modelRenderTargetWidth || _impostorHeight != _modelRenderTargetHeight)
+    {
+        return false;
+    }
+
+    const csmFloat32* mvp = _mvpMatrix4x4.GetArray();
+    const csmFloat32* impostorMvp = _impostorMvpMatrix.GetArray();
+    for (csmInt32 i = 0; i < 16; ++i)
+    {
+        if (mvp[i] != impostorMvp[i])
+        {
+            return false;
+        }
+    }
+
+    if (_modelColor.R != _impostorModelColor.R || _modelColor.G != _impostorModelColor.G ||
+        _modelColor.B != _impostorModelColor.B || _modelColor.A != _impostorModelColor.A)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+csmBool CubismRenderer::IsDirtyRectAvailable()
+{
+    if (!_useDirtyRect || !_useImpostor || !_isImpostorValid || !IsImpostorTargetUnchanged())
+    {
+        return false;
+    }
+
+    // モデル単位で合成するモデルは、範囲を限って描き直すと合成結果が変わる
+    if (_model->IsBlendModeEnabled() || _model->GetOffscreenCount() > 0)
+    {
+        return false;
+    }
+
+    const csmInt32 drawableCount = _model->GetDrawableCount();
+    if (drawableCount != static_cast<csmInt32>(_dirtyRectDrawableBounds.GetSize()) ||
+        drawableCount > static_cast<csmInt32>(_impostorCullings.GetSize()))
+    {
+        return false;
+    }
+
+    // 描画順が変わった場合は重なり方が変わるため、モデル全体を描き直す
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        if (_model->GetDrawableDynamicFlagDrawOrderDidChange(i) ||
+            _model->GetDrawableDynamicFlagRenderOrderDidChange(i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+csmBool CubismRenderer::RedrawDirtyRect()
+{
+    const csmInt32 drawableCount = _model->GetDrawableCount();
+    const csmInt32** masks = _model->GetDrawableMasks();
+    const csmInt32* maskCounts = _model->GetDrawableMaskCounts();
+
+    csmFloat32 left = 1.0f;
+    csmFloat32 bottom = 1.0f;
+    csmFloat32 right = -1.0f;
+    csmFloat32 top = -1.0f;
+
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        csmBool isChanged = _model->GetDrawableDynamicFlagVisibilityDidChange(i);
+        if (!isChanged && _model->GetDrawableDynamicFlagIsVisible(i))
+        {
+            // 上書きした色やカリングの変化は動的フラグに現れないため、記録した値と比較する
+            isChanged = _model->GetDrawableDynamicFlagVertexPositionsDidChange(i) ||
+                        _model->GetDrawableDynamicFlagOpacityDidChange(i) ||
+                        _model->GetDrawableDynamicFlagBlendColorDidChange(i) ||
+                        IsDrawableColorOrCullingChanged(i);
+
+            // マスクの形やカリングが変わった場合もマスクされる側の見た目が変わる
+            for (csmInt32 j = 0; j < maskCounts[i] && !isChanged; ++j)
+            {
+                isChanged = _model->GetDrawableDynamicFlagVertexPositionsDidChange(masks[i][j]) ||
+                            _model->GetDrawableCulling(masks[i][j]) != _impostorCullings[masks[i][j]];
+            }
+        }
+
+        if (!isChanged)
+        {
+            continue;
+        }
+
+        // 変化前と変化後の両方の描画範囲を描き直す
+        csmRectF bounds;
+        CalculateDrawableBounds(i, bounds);
+        const csmRectF* rects[] = { &_dirtyRectDrawableBounds[i], &bounds };
+        for (csmInt32 j = 0; j < 2; ++j)
+        {
+            if (rects[j]->Width <= 0.0f || rects[j]->Height <= 0.0f)
+            {
+                continue;
+            }
+
+            left = (rects[j]->X < left) ? rects[j]->X : left;
+            bottom = (rects[j]->Y < bottom) ? rects[j]->Y : bottom;
+            right = (rects[j]->GetRight() > right) ? rects[j]->GetRight() : right;
+            top = (rects[j]->GetBottom() > top) ? rects[j]->GetBottom() : top;
+        }
+        _dirtyRectDrawableBounds[i] = bounds;
+    }
+
+    // 変化がなければキャッシュをそのまま使う
+    if (left >= right || bottom >= top)
+    {
+        return DrawImpostor();
+    }
+
+    // 描画先の範囲外は描き直す必要がない
+    left = (left < -1.0f) ? -1.0f : left;
+    bottom = (bottom < -1.0f) ? -1.0f : bottom;
+    right = (right > 1.0f) ? 1.0f : right;
+    top = (top > 1.0f) ? 1.0f : top;
+    if (left >= right || bottom >= top)
+    {
+        return DrawImpostor();
+    }
+
+    // 変化した範囲が広い場合は、アートメッシュを選び出すよりモデル全体を描き直す方が速い
+    if ((right - left) * (top - bottom) * 0.25f > _dirtyRectThreshold)
+    {
+        return false;
+    }
+
+    _dirtyRect = csmRectF(left, bottom, right - left, top - bottom);
+    return DrawDirtyRect(_dirtyRect);
+}
+
+void CubismRenderer::UpdateDirtyRectBounds()
+{
+    if (!_useDirtyRect || !_useImpostor)
+    {
+        _dirtyRectDrawableBounds.Clear();
+        return;
+    }
+
+    const csmInt32 drawableCount = _model->GetDrawableCount();
+    _dirtyRectDrawableBounds.Resize(drawableCount);
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        CalculateDrawableBounds(i, _dirtyRectDrawableBounds[i]);
+    }
+}
+
+void CubismRenderer::UpdateAdaptiveClippingMask()
+{
+    if (!_useAdaptiveClippingMask)
+    {
+        return;
+    }
+
+    // キャンバスを行列で変換した大きさから、モデルが画面上で占めるピクセル数を求める
+    const csmFloat32* m = _mvpMatrix4x4.GetArray();
+    const csmFloat32 scaleX = CubismMath::SqrtF(m[0] * m[0] + m[1] * m[1]);
+    const csmFloat32 scaleY = CubismMath::SqrtF(m[4] * m[4] + m[5] * m[5]);
+    const csmFloat32 projectedWidth = _model->GetCanvasWidth() * scaleX * 0.5f * static_cast<csmFloat32>(_modelRenderTargetWidth);
+    const csmFloat32 projectedHeight = _model->GetCanvasHeight() * scaleY * 0.5f * static_cast<csmFloat32>(_modelRenderTargetHeight);
+    const csmFloat32 projectedSize = (projectedWidth > projectedHeight) ? projectedWidth : projectedHeight;
+
+    // 画面上の大きさを超える解像度は必要ないため、収まる最小の2の累乗のサイズを選ぶ
+    csmUint32 size = _adaptiveClippingMaskMinSize;
+    while (static_cast<csmFloat32>(size) < projectedSize && size < _adaptiveClippingMaskMaxSize)
+    {
+        size = (size * 2 < _adaptiveClippingMaskMaxSize) ? size * 2 : _adaptiveClippingMaskMaxSize;
+    }
+
+    // 大きくする場合はすぐに、小さくする場合は余裕を持って収まるようになってから切り替える
+    if (_adaptiveClippingMaskSize == 0 || size > _adaptiveClippingMaskSize ||
+        (size < _adaptiveClippingMaskSize && projectedSize * (1.0f + AdaptiveClippingMaskHysteresis) <= static_cast<csmFloat32>(size)))
+    {
+        _adaptiveClippingMaskSize = size;
+        ApplyAdaptiveClippingMaskSize(size);
+    }
+
+    // 最大サイズでも足りないほど大きく映る場合は、マスクをパーツごとに描き直す
+    // ブレンドモードを使うモデルは常に高精細マスクを使う
+    if (!_model->IsBlendModeEnabled())
+    {
+        const csmFloat32 maxSize = static_cast<csmFloat32>(_adaptiveClippingMaskMaxSize);
+        if (!_useHighPrecisionMask && projectedSize > maxSize)
+        {
+            _useHighPrecisionMask = true;
+        }
+        else if (_useHighPrecisionMask && projectedSize * (1.0f + AdaptiveClippingMaskHysteresis) <= maxSize)
+        {
+            _useHighPrecisionMask = false;
+        }
+    }
+}
+
+void CubismRenderer::CalculateDrawableBounds(const csmInt32 drawableIndex, csmRectF& bounds)
+{
+    const csmInt32 vertexCount = _model->GetDrawableVertexCount(drawableIndex);
+    if (!_model->GetDrawableDynamicFlagIsVisible(drawableIndex) || vertexCount == 0)
+    {
+        bounds = csmRectF(0.0f, 0.0f, 0.0f, 0.0f);
+        return;
+    }
+
+    const csmFloat32* m = _mvpMatrix4x4.GetArray();
+    const csmFloat32* vertices = _model->GetDrawableVertices(drawableIndex);
+    csmFloat32 left = m[0] * vertices[0] + m[4] * vertices[1] + m[12];
+    csmFloat32 bottom = m[1] * vertices[0] + m[5] * vertices[1] + m[13];
+    csmFloat32 right = left;
+    csmFloat32 top = bottom;
+    for (csmInt32 i = 1; i < vertexCount; ++i)
+    {
+        const csmFloat32 x = m[0] * vertices[i * 2] + m[4] * vertices[i * 2 + 1] + m[12];
+        const csmFloat32 y = m[1] * vertices[i * 2] + m[5] * vertices[i * 2 + 1] + m[13];
+        left = (x < left) ? x : left;
+        right = (x > right) ? x : right;
+        bottom = (y < bottom) ? y : bottom;
+        top = (y > top) ? y : top;
+    }
+
+    bounds = csmRectF(left, bottom, right - left, top - bottom);
+}
+
 /*********************************************************************************************************************
 *                                      CubismClippingContext
 ********************************************************************************************************************/
@@ -171,7 +704,11 @@ CubismClippingContext::CubismClippingContext(const csmInt32* clippingDrawableInd
     // マスクの数
     _clippingIdCount = clipCount;
 
+    // 並び順に依存せず比較できるよう、昇順に並べ替えた正規形とそのハッシュ値を保持する
+    _maskSignatureHash = MakeMaskSignature(clippingDrawableIndices, clipCount, _sortedClippingIdList);
+
     _layoutChannelIndex = 0;
+    _layoutWeight = 0.0f;
 
     _allClippedDrawRect = CSM_NEW csmRectF();
     _layoutBounds = CSM_NEW csmRectF();
@@ -217,6 +754,60 @@ void CubismClippingContext::AddClippedOffscreen(csmInt32 offscreenIndex)
     _clippedOffscreenIndexList->PushBack(offscreenIndex);
 }
 
+csmUint32 CubismClippingContext::MakeMaskSignature(const csmInt32* clippingIds, csmInt32 clipCount, csmVector<csmInt32>& sortedClippingIds)
+{
+    sortedClippingIds.Clear();
+    sortedClippingIds.PrepareCapacity(clipCount);
+
+    // マスクの数は通常数個程度のため、挿入ソートで並べ替える
+    for (csmInt32 i = 0; i < clipCount; ++i)
+    {
+        sortedClippingIds.PushBack(clippingIds[i]);
+        for (csmInt32 j = i; j > 0 && sortedClippingIds[j] < sortedClippingIds[j - 1]; --j)
+        {
+            const csmInt32 tmp = sortedClippingIds[j];
+            sortedClippingIds[j] = sortedClippingIds[j - 1];
+            sortedClippingIds[j - 1] = tmp;
+        }
+    }
+
+    return CalculateMaskSignatureHash(sortedClippingIds.GetPtr(), clipCount);
+}
+
+csmUint32 CubismClippingContext::CalculateMaskSignatureHash(const csmInt32* sortedClippingIds, csmInt32 clipCount)
+{
+    // FNV-1a
+    csmUint32 hash = 2166136261u;
+    for (csmInt32 i = 0; i < clipCount; ++i)
+    {
+        csmUint32 value = static_cast<csmUint32>(sortedClippingIds[i]);
+        for (csmInt32 byte = 0; byte < 4; ++byte)
+        {
+            hash ^= (value & 0xFF);
+            hash *= 16777619u;
+            value >>= 8;
+        }
+    }
+    return hash;
+}
+
+csmBool CubismClippingContext::IsSameMaskSignature(const csmInt32* sortedClippingIds, csmInt32 clipCount, csmUint32 hash) const
+{
+    if (_maskSignatureHash != hash || _clippingIdCount != clipCount)
+    {
+        return false;
+    }
+
+    for (csmInt32 i = 0; i < clipCount; ++i)
+    {
+        if (_sortedClippingIdList[i] != sortedClippingIds[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 }}}}
 
 //------------ LIVE2D NAMESPACE ------------
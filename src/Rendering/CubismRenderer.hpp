@@ -89,6 +89,38 @@ public:
 
     };
 
+    /**
+     * @brief   GPUでの描画時間の計測結果を保持する構造体<br>
+     *           計測は数フレーム遅れて非同期に読み出すため、結果は FrameNumber のフレームのもの。
+     */
+    struct CubismGpuTimingStats
+    {
+        /**
+         * @brief   コンストラクタ
+         */
+        CubismGpuTimingStats()
+            : IsValid(false)
+            , FrameNumber(0)
+            , Latency(0)
+            , MaskMilliseconds(0.0f)
+            , DrawLoopMilliseconds(0.0f)
+            , OffscreenMilliseconds(0.0f)
+            , OffscreenCount(0)
+            , SkippedFrameCount(0)
+        {
+        }
+
+        csmBool                 IsValid;                    ///< 計測結果があればtrue
+        csmUint64               FrameNumber;                ///< 計測したフレームの番号（計測を始めてからのモデル描画の回数）
+        csmUint32               Latency;                    ///< 計測してから結果を読み出すまでにかかったフレーム数
+        csmFloat32              MaskMilliseconds;           ///< クリッピングマスクをまとめて生成した時間（ミリ秒）。高精細マスクは描画ループに含まれる
+        csmFloat32              DrawLoopMilliseconds;       ///< モデルの描画順に従って描画した時間（ミリ秒）。オフスクリーンの合成を含む
+        csmFloat32              OffscreenMilliseconds;      ///< オフスクリーンを親に合成した時間の合計（ミリ秒）
+        csmInt32                OffscreenCount;             ///< 合成したオフスクリーンの数
+        csmVector<csmFloat32>   OffscreenMillisecondsList;  ///< オフスクリーンのインデックスごとの合成の時間（ミリ秒）。合成していなければ0
+        csmUint32               SkippedFrameCount;          ///< 結果が読み出せず計測を見送ったフレーム数の累計
+    };
+
     /**
      * @brief   レンダラのインスタンスを生成して取得する
      *
@@ -248,6 +280,144 @@ public:
      */
     csmBool IsUsingHighPrecisionMask();
 
+    /**
+     * @brief   インポスター描画の有効・無効をセットする。<br>
+     *           有効にすると、モデル全体を描画したモデル描画先の内容をキャッシュとして保持し、<br>
+     *           モデルに変化がない間はモデル全体を描き直さずにキャッシュを1枚の矩形で描画する。<br>
+     *           長時間待機している背景のキャラクターなど、動きの少ないモデル向けの機能で、<br>
+     *           対応していないレンダラでは常にモデル全体を描画する。
+     *
+     * @param[in]   enable  ->  有効にするならtrue
+     */
+    void UseImpostor(csmBool enable);
+
+    /**
+     * @brief   インポスター描画の有効・無効を取得する。
+     *
+     * @retval  true    ->  インポスター描画有効
+     * @retval  false   ->  インポスター描画無効
+     */
+    csmBool IsUsingImpostor() const;
+
+    /**
+     * @brief   インポスターのキャッシュを描き直す間隔をセットする。<br>
+     *           頂点位置や不透明度の変化のような小さな変化は、最初の変化から指定したフレーム数の間キャッシュを使い続けてから描き直す。<br>
+     *           表示状態・描画順・乗算色・スクリーン色・カリングの変化や、行列・モデルの色の変化があった場合は間隔によらず即座に描き直す。<br>
+     *           0の場合は小さな変化でも即座に描き直す。
+     *
+     * @param[in]   frameCount  ->  キャッシュを使い続ける最大のフレーム数
+     */
+    void SetImpostorRefreshInterval(csmUint32 frameCount);
+
+    /**
+     * @brief   インポスターのキャッシュを描き直す間隔を取得する。
+     *
+     * @return  キャッシュを使い続ける最大のフレーム数
+     */
+    csmUint32 GetImpostorRefreshInterval() const;
+
+    /**
+     * @brief   インポスターのキャッシュを破棄し、次の描画でモデル全体を描き直させる。<br>
+     *           乗算色・スクリーン色・カリングの上書きやレンダラのBindTextureによるテクスチャの差し替えは自動で検出する。<br>
+     *           テクスチャの内容を直接書き換えた場合など、レンダラから検出できない変更を行った場合に呼ぶ。
+     */
+    void InvalidateImpostor();
+
+    /**
+     * @brief   部分描画の有効・無効をセットする。<br>
+     *           インポスター描画が有効な場合に使われ、小さな変化があってもキャッシュを使い続ける代わりに、<br>
+     *           頂点位置・不透明度・表示状態・色が変化したアートメッシュの範囲だけを毎フレーム描き直す。<br>
+     *           対応していないレンダラや、ブレンドモード・オフスクリーンを使うモデルではインポスター描画と同じ動作になる。
+     *
+     * @param[in]   enable  ->  有効にするならtrue
+     */
+    void UseDirtyRect(csmBool enable);
+
+    /**
+     * @brief   部分描画の有効・無効を取得する。
+     *
+     * @retval  true    ->  部分描画有効
+     * @retval  false   ->  部分描画無効
+     */
+    csmBool IsUsingDirtyRect() const;
+
+    /**
+     * @brief   部分描画を行う変化した範囲の上限をセットする。<br>
+     *           変化した範囲が描画先全体に占める割合がこの値を超えた場合はモデル全体を描き直す。
+     *
+     * @param[in]   ratio   ->  描画先全体に対する割合(0.0~1.0)
+     */
+    void SetDirtyRectThreshold(csmFloat32 ratio);
+
+    /**
+     * @brief   部分描画を行う変化した範囲の上限を取得する。
+     *
+     * @return  描画先全体に対する割合(0.0~1.0)
+     */
+    csmFloat32 GetDirtyRectThreshold() const;
+
+    /**
+     * @brief   クリッピングマスクの解像度を自動で選ぶかをセットする。<br>
+     *           有効にすると、行列から求めたモデルの画面上の大きさに応じて、描画のたびにマスク用バッファのサイズと<br>
+     *           高精細マスクを使うかを選びなおす。画面上で小さいモデルには小さなマスクを、大きく映るモデルには大きなマスクを使う。<br>
+     *           切り替えが頻繁に起きないよう、小さくする方向と高精細マスクをやめる方向には余裕を持たせて判定する。<br>
+     *           有効な間は UseHighPrecisionMask() の設定を上書きする（ブレンドモードを使うモデルは常に高精細マスク）。
+     *
+     * @param[in]   enable  ->  有効にするならtrue
+     */
+    void UseAdaptiveClippingMask(csmBool enable);
+
+    /**
+     * @brief   クリッピングマスクの解像度を自動で選ぶかを取得する。
+     *
+     * @retval  true    ->  自動で選ぶ
+     * @retval  false   ->  マスク用バッファのサイズは固定
+     */
+    csmBool IsUsingAdaptiveClippingMask() const;
+
+    /**
+     * @brief   自動で選ぶクリッピングマスク用バッファのサイズの範囲をセットする。<br>
+     *           画面上の大きさが最大サイズを超えるモデルは高精細マスクに切り替える。
+     *
+     * @param[in]   minSize ->  最小のサイズ（ピクセル）
+     * @param[in]   maxSize ->  最大のサイズ（ピクセル）
+     */
+    void SetAdaptiveClippingMaskSizeRange(csmUint32 minSize, csmUint32 maxSize);
+
+    /**
+     * @brief   自動で選んだクリッピングマスク用バッファのサイズを取得する。
+     *
+     * @return  マスク用バッファの一辺のサイズ（ピクセル）。まだ選んでいない場合は0
+     */
+    csmUint32 GetAdaptiveClippingMaskSize() const;
+
+    /**
+     * @brief   GPUでの描画時間の計測の有効・無効をセットする。<br>
+     *           有効にすると、クリッピングマスクの生成・オフスクリーンの合成・描画ループの前後にタイムスタンプを記録し、<br>
+     *           数フレーム後に結果を待たずに読み出して GetGpuTimingStats() で取得できるようにする。<br>
+     *           対応していないレンダラやGPUでは何もしない。<br>
+     *           計測に対応しているのはOpenGL（GL_ARB_timer_query / GL_EXT_disjoint_timer_query）とVulkanのレンダラで、<br>
+     *           iOSのOpenGL ESはタイマークエリの拡張がないため計測しない。
+     *
+     * @param[in]   enable  ->  有効にするならtrue
+     */
+    void UseGpuTiming(csmBool enable);
+
+    /**
+     * @brief   GPUでの描画時間の計測の有効・無効を取得する。
+     *
+     * @retval  true    ->  計測する
+     * @retval  false   ->  計測しない
+     */
+    csmBool IsUsingGpuTiming() const;
+
+    /**
+     * @brief   GPUでの描画時間の最新の計測結果を取得する。
+     *
+     * @return  計測結果。まだ結果がない場合は IsValid がfalse
+     */
+    virtual const CubismGpuTimingStats& GetGpuTimingStats() const;
+
 protected:
     /**
      * @brief   コンストラクタ
@@ -288,6 +458,43 @@ protected:
      */
     virtual void AfterDrawModelRenderTarget() = 0;
 
+    /**
+     * @brief   前回モデル描画先に描画した内容をインポスターとして描画する<br>
+     *           インポスター描画に対応するレンダラで実装する
+     *
+     * @retval  true    ->  インポスターを描画した
+     * @retval  false   ->  インポスターを描画できないため、モデル全体を描画する必要がある
+     */
+    virtual csmBool DrawImpostor();
+
+    /**
+     * @brief   モデル描画先の変化した範囲だけを描き直してから、インポスターとして描画する<br>
+     *           部分描画に対応するレンダラで実装する
+     *
+     * @param[in]   dirtyRect   ->  描き直す範囲（NDC）
+     *
+     * @retval  true    ->  描き直して描画した
+     * @retval  false   ->  部分描画できないため、モデル全体を描画する必要がある
+     */
+    virtual csmBool DrawDirtyRect(const csmRectF& dirtyRect);
+
+    /**
+     * @brief   アートメッシュが部分描画で描き直す範囲にかかっているか
+     *
+     * @param[in]   drawableIndex   ->  アートメッシュのインデックス
+     *
+     * @return  表示されていて、描画範囲が描き直す範囲と重なっていればtrue
+     */
+    csmBool IsDrawableInDirtyRect(csmInt32 drawableIndex) const;
+
+    /**
+     * @brief   自動で選んだクリッピングマスク用バッファのサイズを反映する<br>
+     *           マスク用バッファのサイズを変更できるレンダラで実装する
+     *
+     * @param[in]   size    ->  マスク用バッファの一辺のサイズ（ピクセル）
+     */
+    virtual void ApplyAdaptiveClippingMaskSize(csmUint32 size);
+
     csmUint32 _modelRenderTargetWidth;
     csmUint32 _modelRenderTargetHeight;
 
@@ -296,6 +503,79 @@ private:
     CubismRenderer(const CubismRenderer&);
     CubismRenderer& operator=(const CubismRenderer&);
 
+    /**
+     * @brief   インポスターのキャッシュを今回の描画で使えるかを判定する<br>
+     *           使い続ける小さな変化があった場合は、描き直しが必要な変化として記録する
+     *
+     * @retval  true    ->  キャッシュを使える
+     * @retval  false   ->  モデル全体を描き直す必要がある
+     */
+    csmBool IsImpostorReusable();
+
+    /**
+     * @brief   モデル全体を描画した時点の状態をインポスターのキャッシュの状態として記録する
+     */
+    void UpdateImpostorState();
+
+    /**
+     * @brief   描画先・行列・モデルの色がインポスターのキャッシュを描画した時点から変わっていないか
+     *
+     * @return  変わっていなければtrue
+     */
+    csmBool IsImpostorTargetUnchanged();
+
+    /**
+     * @brief   アートメッシュの乗算色・スクリーン色・カリングがインポスターのキャッシュを描画した時点から変わったか<br>
+     *           ユーザーによる上書きやパーツ単位の設定を反映した値で比較する
+     *
+     * @param[in]   drawableIndex   ->  アートメッシュのインデックス
+     *
+     * @return  変わっていればtrue
+     */
+    csmBool IsDrawableColorOrCullingChanged(csmInt32 drawableIndex) const;
+
+    /**
+     * @brief   オフスクリーンの乗算色・スクリーン色・カリングがインポスターのキャッシュを描画した時点から変わったか
+     *
+     * @param[in]   offscreenIndex  ->  オフスクリーンのインデックス
+     *
+     * @return  変わっていればtrue
+     */
+    csmBool IsOffscreenColorOrCullingChanged(csmInt32 offscreenIndex) const;
+
+    /**
+     * @brief   今回の描画で部分描画を試みるかを判定する
+     *
+     * @return  キャッシュの変化した範囲だけを描き直せる状態ならtrue
+     */
+    csmBool IsDirtyRectAvailable();
+
+    /**
+     * @brief   変化したアートメッシュの描画範囲から描き直す範囲を求め、部分描画を行う
+     *
+     * @retval  true    ->  部分描画を行った
+     * @retval  false   ->  モデル全体を描き直す必要がある
+     */
+    csmBool RedrawDirtyRect();
+
+    /**
+     * @brief   全てのアートメッシュの描画範囲を求めなおす
+     */
+    void UpdateDirtyRectBounds();
+
+    /**
+     * @brief   アートメッシュの描画範囲をNDCで求める
+     *
+     * @param[in]   drawableIndex   ->  アートメッシュのインデックス
+     * @param[out]  bounds          ->  描画範囲。表示されていない場合は幅と高さが0
+     */
+    void CalculateDrawableBounds(csmInt32 drawableIndex, csmRectF& bounds);
+
+    /**
+     * @brief   モデルの画面上の大きさからクリッピングマスク用バッファのサイズと高精細マスクを使うかを選びなおす
+     */
+    void UpdateAdaptiveClippingMask();
+
     CubismMatrix44      _mvpMatrix4x4;          ///< Model-View-Projection 行列
     CubismTextureColor  _modelColor;            ///< モデル自体のカラー(RGBA)
     csmBool             _isCulling;             ///< カリングが有効ならtrue
@@ -304,6 +584,33 @@ private:
     CubismModel*        _model;                 ///< レンダリング対象のモデル
 
     csmBool             _useHighPrecisionMask;  ///< falseの場合、マスクを纏めて描画する trueの場合、マスクはパーツ描画ごとに書き直す
+
+    csmBool             _useImpostor;                       ///< インポスター描画が有効ならtrue
+    csmBool             _isImpostorValid;                   ///< インポスターのキャッシュが使える状態ならtrue
+    csmBool             _hasImpostorPendingChange;          ///< キャッシュに反映していない小さな変化があればtrue
+    csmUint32           _impostorRefreshInterval;           ///< 小さな変化があってもキャッシュを使い続ける最大のフレーム数
+    csmUint32           _impostorReusedFrameCount;          ///< 反映していない最初の小さな変化からキャッシュを使ったフレーム数
+    CubismMatrix44      _impostorMvpMatrix;                 ///< キャッシュを描画した時点の Model-View-Projection 行列
+    CubismTextureColor  _impostorModelColor;                ///< キャッシュを描画した時点のモデルのカラー
+    csmUint32           _impostorWidth;                     ///< キャッシュを描画した時点のモデル描画先の幅
+    csmUint32           _impostorHeight;                    ///< キャッシュを描画した時点のモデル描画先の高さ
+    csmVector<csmFloat32> _impostorOffscreenOpacities;      ///< キャッシュを描画した時点のオフスクリーンの不透明度
+    csmVector<CubismTextureColor> _impostorMultiplyColors;  ///< キャッシュを描画した時点のアートメッシュとオフスクリーンの乗算色
+    csmVector<CubismTextureColor> _impostorScreenColors;    ///< キャッシュを描画した時点のアートメッシュとオフスクリーンのスクリーン色
+    csmVector<csmInt32> _impostorCullings;                  ///< キャッシュを描画した時点のアートメッシュとオフスクリーンのカリング設定
+
+    csmBool             _useDirtyRect;                      ///< 部分描画が有効ならtrue
+    csmFloat32          _dirtyRectThreshold;                ///< 部分描画を行う範囲の描画先全体に対する割合の上限
+    csmRectF            _dirtyRect;                         ///< 今回の描画で描き直す範囲（NDC）
+    csmVector<csmRectF> _dirtyRectDrawableBounds;           ///< キャッシュを描画した時点のアートメッシュごとの描画範囲（NDC）
+
+    csmBool             _useAdaptiveClippingMask;           ///< クリッピングマスクの解像度を自動で選ぶならtrue
+    csmUint32           _adaptiveClippingMaskMinSize;       ///< 自動で選ぶマスク用バッファの最小のサイズ
+    csmUint32           _adaptiveClippingMaskMaxSize;       ///< 自動で選ぶマスク用バッファの最大のサイズ
+    csmUint32           _adaptiveClippingMaskSize;          ///< 自動で選んだマスク用バッファのサイズ。未選択の場合は0
+
+    csmBool             _useGpuTiming;                      ///< GPUでの描画時間を計測するならtrue
+    CubismGpuTimingStats _gpuTimingStats;                   ///< 計測に対応していないレンダラが返す空の計測結果
 };
 
 
@@ -339,12 +646,47 @@ public:
      */
     void AddClippedOffscreen(csmInt32 offscreenIndex);
 
+    /**
+     * @brief   マスクのIDリストを昇順に並べ替えた正規形を作り、そのハッシュ値を計算する
+     *
+     * @param[in]   clippingIds         ->  マスクのIDリスト
+     * @param[in]   clipCount           ->  マスクの数
+     * @param[out]  sortedClippingIds   ->  昇順に並べ替えたマスクのIDリスト
+     *
+     * @return  ハッシュ値
+     */
+    static csmUint32 MakeMaskSignature(const csmInt32* clippingIds, csmInt32 clipCount, csmVector<csmInt32>& sortedClippingIds);
+
+    /**
+     * @brief   マスクのIDリストを並べ替えた正規形からハッシュ値を計算する
+     *
+     * @param[in]   sortedClippingIds   ->  昇順に並べ替えたマスクのIDリスト
+     * @param[in]   clipCount           ->  マスクの数
+     *
+     * @return  ハッシュ値
+     */
+    static csmUint32 CalculateMaskSignatureHash(const csmInt32* sortedClippingIds, csmInt32 clipCount);
+
+    /**
+     * @brief   指定したマスクのIDリストがこのマスクと同じ組み合わせかを判定する
+     *
+     * @param[in]   sortedClippingIds   ->  昇順に並べ替えたマスクのIDリスト
+     * @param[in]   clipCount           ->  マスクの数
+     * @param[in]   hash                ->  CalculateMaskSignatureHashで計算したハッシュ値
+     *
+     * @return  同じ組み合わせならtrue
+     */
+    csmBool IsSameMaskSignature(const csmInt32* sortedClippingIds, csmInt32 clipCount, csmUint32 hash) const;
+
     csmBool _isUsing;                                ///< 現在の描画状態でマスクの準備が必要ならtrue
     const csmInt32* _clippingIdList;                 ///< クリッピングマスクのIDリスト
     csmInt32 _clippingIdCount;                       ///< クリッピングマスクの数
+    csmVector<csmInt32> _sortedClippingIdList;       ///< クリッピングマスクのIDリストを昇順に並べ替えたもの（マスクの組み合わせの正規形）
+    csmUint32 _maskSignatureHash;                    ///< _sortedClippingIdListのハッシュ値
     csmInt32 _layoutChannelIndex;                       ///< RGBAのいずれのチャンネルにこのクリップを配置するか(0:R , 1:G , 2:B , 3:A)
     csmRectF* _layoutBounds;                         ///< マスク用チャンネルのどの領域にマスクを入れるか(View座標-1..1, UVは0..1に直す)
     csmRectF* _allClippedDrawRect;                   ///< このクリッピングで、クリッピングされる全ての描画オブジェクトの囲み矩形（毎回更新）
+    csmFloat32 _layoutWeight;                        ///< マスク用チャンネル内で割り当てる面積の重み（囲み矩形の面積が大きく変わるまで維持する）
     CubismMatrix44 _matrixForMask;                   ///< マスクの位置計算結果を保持する行列
     CubismMatrix44 _matrixForDraw;                   ///< 描画オブジェクトの位置計算結果を保持する行列
     csmVector<csmInt32>* _clippedDrawableIndexList;  ///< このマスクにクリップされるDrawableのリスト
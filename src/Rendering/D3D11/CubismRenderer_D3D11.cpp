@@ -14,6 +14,7 @@
 #include "Type/csmVectorSort.hpp"
 #include "Model/CubismModel.hpp"
 #include "CubismShader_D3D11.hpp"
+#include "Utils/CubismProfiler.hpp"
 
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
@@ -192,6 +193,8 @@ DirectX::XMMATRIX ConvertToD3DX(CubismMatrix44& mtx)
 ********************************************************************************************************************/
 void CubismClippingManager_D3D11::SetupClippingContext(ID3D11Device* device, ID3D11DeviceContext* context, CubismRenderState_D3D11* renderState, CubismModel& model, CubismRenderer_D3D11* renderer, csmInt32 currentRenderTarget, CubismRenderer::DrawableObjectType drawableObjectType)
 {
+    CSM_PROFILE_ZONE(Zone_ClippingSetup, &model);
+
     // 全てのクリッピングを用意する
     // 同じクリップ（複数の場合はまとめて１つのクリップ）を使う場合は１度だけ設定する
     csmInt32 usingClipCount = 0;
@@ -1590,6 +1593,8 @@ void CubismRenderer_D3D11::DrawMeshDX11(const CubismModel& model, const csmInt32
 
 void CubismRenderer_D3D11::DrawOffscreenDX11(const CubismModel& model, CubismOffscreenRenderTarget_D3D11* offscreen)
 {
+    CSM_PROFILE_ZONE(Zone_OffscreenComposite, &model);
+
     // デバイス未設定
     if (_device == NULL)
     {
@@ -24,7 +24,7 @@ CubismRenderTarget_D3D9* CubismOffscreenManager_D3D9::GetOffscreenRenderTarget(L
     UpdateRenderTargetCount();
 
     // 使われていないリソースコンテナがあればそれを返す
-    CubismRenderTarget_D3D9* offscreenRenderTarget = GetUnusedOffscreenRenderTarget();
+    CubismRenderTarget_D3D9* offscreenRenderTarget = GetUnusedOffscreenRenderTarget(width, height);
     if (offscreenRenderTarget != nullptr)
     {
         // サイズが違う場合は再作成する
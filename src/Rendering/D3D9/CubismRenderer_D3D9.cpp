@@ -12,6 +12,7 @@
 #include "Math/CubismMatrix44.hpp"
 #include "Type/csmVectorSort.hpp"
 #include "Model/CubismModel.hpp"
+#include "Utils/CubismProfiler.hpp"
 
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
@@ -125,6 +126,8 @@ D3DXMATRIX ConvertToD3DX(CubismMatrix44& mtx)
 ********************************************************************************************************************/
 void CubismClippingManager_DX9::SetupClippingContext(LPDIRECT3DDEVICE9 device, CubismRenderState_D3D9* renderState, CubismModel& model, CubismRenderer_D3D9* renderer, csmInt32 currentRenderTarget, CubismRenderer::DrawableObjectType drawableObjectType)
 {
+    CSM_PROFILE_ZONE(Zone_ClippingSetup, &model);
+
     // 全てのクリッピングを用意する
     // 同じクリップ（複数の場合はまとめて１つのクリップ）を使う場合は１度だけ設定する
     csmInt32 usingClipCount = 0;
@@ -1448,6 +1451,8 @@ void CubismRenderer_D3D9::DrawMeshDX9(const CubismModel& model, const csmInt32 i
 
 void CubismRenderer_D3D9::DrawOffscreenDX9(const CubismModel& model, CubismOffscreenRenderTarget_D3D9* offscreen)
 {
+    CSM_PROFILE_ZONE(Zone_OffscreenComposite, &model);
+
     // デバイス未設定
     if (_device == NULL)
     {
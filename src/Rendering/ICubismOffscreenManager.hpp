@@ -87,6 +87,72 @@ public:
      */
     csmUint32 GetCurrentActiveRenderTextureCount() const;
 
+    /**
+     * @brief レンダーターゲットが使用するメモリの上限を設定する。<br>
+     *        上限を超える場合は未使用のレンダーターゲットを最後に使用された順が古いものから解放する。
+     *
+     * @param[in]  budgetSize  -> メモリの上限（バイト）。0の場合は上限なし
+     */
+    void SetMemoryBudget(csmUint64 budgetSize);
+
+    /**
+     * @brief レンダーターゲットが使用するメモリの上限を取得する。
+     *
+     * @return  メモリの上限（バイト）。0の場合は上限なし
+     */
+    csmUint64 GetMemoryBudget() const;
+
+    /**
+     * @brief 保持しているレンダーターゲットのメモリ使用量の概算を取得する。<br>
+     *        1ピクセルあたり4バイトとして計算する。
+     *
+     * @return  メモリ使用量（バイト）
+     */
+    csmUint64 GetUsedMemorySize() const;
+
+    /**
+     * @brief サイズを丸める単位を設定する。
+     *
+     * @param[in]  step  -> 丸める単位（ピクセル）。1以下の場合は丸めない
+     */
+    void SetSizeBucketStep(csmUint32 step);
+
+    /**
+     * @brief 要求サイズを再利用しやすいサイズに切り上げる。<br>
+     *        近いサイズの要求が同じレンダーターゲットを再利用できるよう、サイズが大きいほど粗い単位で丸める。
+     *
+     * @param[in]  size  -> 要求サイズ（ピクセル）
+     *
+     * @return  切り上げたサイズ
+     */
+    csmUint32 GetBucketedSize(csmUint32 size) const;
+
+    /**
+     * @brief 同じサイズの未使用レンダーターゲットを再利用できた回数を取得する。
+     *
+     * @return  再利用できた回数
+     */
+    csmUint32 GetHitCount() const;
+
+    /**
+     * @brief 同じサイズの未使用レンダーターゲットが見つからなかった回数を取得する。
+     *
+     * @return  見つからなかった回数
+     */
+    csmUint32 GetMissCount() const;
+
+    /**
+     * @brief 未使用のレンダーターゲットを解放した回数を取得する。
+     *
+     * @return  解放した回数
+     */
+    csmUint32 GetEvictionCount() const;
+
+    /**
+     * @brief 再利用・解放の回数をリセットする。
+     */
+    void ResetStatistics();
+
 protected:
     /**
      * @brief   コンストラクタ
@@ -105,6 +171,19 @@ protected:
      */
     T* GetUnusedOffscreenRenderTarget();
 
+    /**
+     * @brief 未使用のレンダーターゲットを取得する<br>
+     *        指定サイズと一致するものがあればそれを返す。<br>
+     *        なければメモリの上限が設定されていない場合は最後に使用された順が古い未使用のものを返し、
+     *        設定されている場合は上限に収まるよう未使用のものを解放してnullptrを返す。
+     *
+     * @param[in]  width  -> 幅
+     * @param[in]  height -> 高さ
+     *
+     * @return  未使用のレンダーターゲットを返す。サイズが異なる場合があるので呼び出し側で確認すること。なければnullptrを返す。
+     */
+    T* GetUnusedOffscreenRenderTarget(csmUint32 width, csmUint32 height);
+
     /**
      * @brief レンダーターゲットを作成する
      *
@@ -125,17 +204,46 @@ private:
         CubismRenderTargetContainer()
             : RenderTarget(nullptr)
             , IsUsed(true)
+            , LastUsedTick(0)
         {
         }
 
         T* RenderTarget; ///< レンダーターゲット本体
         csmBool IsUsed; ///< 使用中かどうか
+        csmUint64 LastUsedTick; ///< 最後に使用を開始した時点のカウンタ値
     };
 
+    /**
+     * @brief 最後に使用された順が最も古い未使用のレンダーターゲットのインデックスを取得する
+     *
+     * @return  インデックスを返す。未使用のものがなければ-1を返す。
+     */
+    csmInt32 FindLeastRecentlyUsedIndex() const;
+
+    /**
+     * @brief 指定したインデックスのレンダーターゲットを解放してリストから取り除く
+     *
+     * @param[in]  index  -> インデックス
+     */
+    void ReleaseRenderTargetAt(csmInt32 index);
+
+    /**
+     * @brief メモリの上限に収まるまで未使用のレンダーターゲットを古い順に解放する
+     *
+     * @param[in]  requiredSize  -> これから確保するメモリ量（バイト）
+     */
+    void EvictUnusedRenderTargets(csmUint64 requiredSize);
+
     csmVector<CubismRenderTargetContainer> _offscreenRenderTargetList;   ///< オフスクリーン描画用レンダーターゲットのコンテナリスト
     csmUint32 _previousActiveRenderTextureMaxCount; ///< 直前のアクティブなレンダーターゲットの最大数
     csmUint32 _currentActiveRenderTextureCount; ///< 現在のアクティブなレンダーターゲットの数
     csmBool _hasResetThisFrame; ///< 今フレームでリセットされたかどうか
+    csmUint64 _usedTick; ///< レンダーターゲットの使用開始ごとに進めるカウンタ
+    csmUint64 _memoryBudget; ///< メモリの上限（バイト）。0の場合は上限なし
+    csmUint32 _sizeBucketStep; ///< サイズを丸める単位
+    csmUint32 _hitCount; ///< 同じサイズのレンダーターゲットを再利用できた回数
+    csmUint32 _missCount; ///< 同じサイズのレンダーターゲットが見つからなかった回数
+    csmUint32 _evictionCount; ///< 未使用のレンダーターゲットを解放した回数
 };
 
 template<class T>
@@ -229,40 +337,18 @@ void ICubismOffscreenManager<T>::ReleaseStaleRenderTextures()
         return;
     }
 
-    // 未使用な場所を開放して直前の最大数までリサイズする
-    csmUint32 findPos = 0;
-    csmUint32 resize = _previousActiveRenderTextureMaxCount;
-    for (csmUint32 i = listSize; _previousActiveRenderTextureMaxCount < i; --i)
+    // 直前の最大数を超える分の未使用なものを、最後に使用された順が古いものから開放する
+    while (_previousActiveRenderTextureMaxCount < _offscreenRenderTargetList.GetSize())
     {
-        const csmUint32 index = i - 1;
-        if (_offscreenRenderTargetList[index].IsUsed)
+        const csmInt32 index = FindLeastRecentlyUsedIndex();
+        if (index < 0)
         {
-            // 空いている場所探して移動させる
-            csmBool isFind = false;
-            for (; findPos < _previousActiveRenderTextureMaxCount; ++findPos)
-            {
-                if (!_offscreenRenderTargetList[findPos].IsUsed)
-                {
-                    T* RenderTarget = _offscreenRenderTargetList[findPos].RenderTarget;
-                    _offscreenRenderTargetList[findPos].RenderTarget = _offscreenRenderTargetList[index].RenderTarget;
-                    _offscreenRenderTargetList[findPos].IsUsed = true;
-                    _offscreenRenderTargetList[index].RenderTarget = RenderTarget;
-                    _offscreenRenderTargetList[index].IsUsed = false;
-                    isFind = true;
-                    break;
-                }
-            }
-            if (!isFind)
-            {
-                // 空いている場所が見つからなかったら現状のサイズでリサイズする
-                resize = i;
-                break;
-            }
+            break;
         }
-        _offscreenRenderTargetList[index].RenderTarget->DestroyRenderTarget();
-        CSM_DELETE_SELF(T, _offscreenRenderTargetList[index].RenderTarget);
+
+        ReleaseRenderTargetAt(index);
+        ++_evictionCount;
     }
-    _offscreenRenderTargetList.Resize(resize);
 }
 
 template<class T>
@@ -291,11 +377,92 @@ csmUint32 ICubismOffscreenManager<T>::GetCurrentActiveRenderTextureCount() const
     return _currentActiveRenderTextureCount;
 }
 
+template<class T>
+void ICubismOffscreenManager<T>::SetMemoryBudget(csmUint64 budgetSize)
+{
+    _memoryBudget = budgetSize;
+    EvictUnusedRenderTargets(0);
+}
+
+template<class T>
+csmUint64 ICubismOffscreenManager<T>::GetMemoryBudget() const
+{
+    return _memoryBudget;
+}
+
+template<class T>
+csmUint64 ICubismOffscreenManager<T>::GetUsedMemorySize() const
+{
+    csmUint64 usedSize = 0;
+    for (csmUint32 i = 0; i < _offscreenRenderTargetList.GetSize(); ++i)
+    {
+        const T* renderTarget = _offscreenRenderTargetList[i].RenderTarget;
+        usedSize += static_cast<csmUint64>(renderTarget->GetBufferWidth()) * renderTarget->GetBufferHeight() * 4;
+    }
+    return usedSize;
+}
+
+template<class T>
+void ICubismOffscreenManager<T>::SetSizeBucketStep(csmUint32 step)
+{
+    _sizeBucketStep = step;
+}
+
+template<class T>
+csmUint32 ICubismOffscreenManager<T>::GetBucketedSize(csmUint32 size) const
+{
+    if (_sizeBucketStep <= 1)
+    {
+        return size;
+    }
+
+    // 丸めによる増分がサイズの1/8程度に収まるよう、サイズに応じて単位を広げる
+    csmUint32 step = _sizeBucketStep;
+    while (step * 8 < size)
+    {
+        step *= 2;
+    }
+
+    return (size + step - 1) / step * step;
+}
+
+template<class T>
+csmUint32 ICubismOffscreenManager<T>::GetHitCount() const
+{
+    return _hitCount;
+}
+
+template<class T>
+csmUint32 ICubismOffscreenManager<T>::GetMissCount() const
+{
+    return _missCount;
+}
+
+template<class T>
+csmUint32 ICubismOffscreenManager<T>::GetEvictionCount() const
+{
+    return _evictionCount;
+}
+
+template<class T>
+void ICubismOffscreenManager<T>::ResetStatistics()
+{
+    _hitCount = 0;
+    _missCount = 0;
+    _evictionCount = 0;
+}
+
 template<class T>
 ICubismOffscreenManager<T>::ICubismOffscreenManager()
     : _previousActiveRenderTextureMaxCount(0)
     , _currentActiveRenderTextureCount(0)
     , _hasResetThisFrame(false)
+    , _usedTick(0)
+    , _memoryBudget(0)
+    , _sizeBucketStep(32)
+    , _hitCount(0)
+    , _missCount(0)
+    , _evictionCount(0)
 {
 }
 
@@ -318,6 +485,7 @@ T* ICubismOffscreenManager<T>::GetUnusedOffscreenRenderTarget()
         if (!_offscreenRenderTargetList[i].IsUsed)
         {
             _offscreenRenderTargetList[i].IsUsed = true;
+            _offscreenRenderTargetList[i].LastUsedTick = ++_usedTick;
             return _offscreenRenderTargetList[i].RenderTarget;
         }
     }
@@ -325,14 +493,101 @@ T* ICubismOffscreenManager<T>::GetUnusedOffscreenRenderTarget()
     return nullptr;
 }
 
+template<class T>
+T* ICubismOffscreenManager<T>::GetUnusedOffscreenRenderTarget(csmUint32 width, csmUint32 height)
+{
+    for (csmUint32 i = 0; i < _offscreenRenderTargetList.GetSize(); ++i)
+    {
+        if (!_offscreenRenderTargetList[i].IsUsed &&
+            _offscreenRenderTargetList[i].RenderTarget->GetBufferWidth() == width &&
+            _offscreenRenderTargetList[i].RenderTarget->GetBufferHeight() == height)
+        {
+            _offscreenRenderTargetList[i].IsUsed = true;
+            _offscreenRenderTargetList[i].LastUsedTick = ++_usedTick;
+            ++_hitCount;
+            return _offscreenRenderTargetList[i].RenderTarget;
+        }
+    }
+
+    ++_missCount;
+
+    if (_memoryBudget == 0)
+    {
+        // 上限がない場合は最後に使用された順が古い未使用のものを作り直して使う
+        const csmInt32 index = FindLeastRecentlyUsedIndex();
+        if (index < 0)
+        {
+            return nullptr;
+        }
+
+        _offscreenRenderTargetList[index].IsUsed = true;
+        _offscreenRenderTargetList[index].LastUsedTick = ++_usedTick;
+        return _offscreenRenderTargetList[index].RenderTarget;
+    }
+
+    // 上限がある場合は他のサイズを残したまま新規作成できるよう、収まるまで古いものを解放する
+    EvictUnusedRenderTargets(static_cast<csmUint64>(width) * height * 4);
+    return nullptr;
+}
+
 template<class T>
 T* ICubismOffscreenManager<T>::CreateOffscreenRenderTarget()
 {
     _offscreenRenderTargetList.PushBack(CubismRenderTargetContainer());
     _offscreenRenderTargetList.Back().RenderTarget = CSM_NEW T();
+    _offscreenRenderTargetList.Back().LastUsedTick = ++_usedTick;
     return _offscreenRenderTargetList.Back().RenderTarget;
 }
 
+template<class T>
+csmInt32 ICubismOffscreenManager<T>::FindLeastRecentlyUsedIndex() const
+{
+    csmInt32 result = -1;
+    for (csmUint32 i = 0; i < _offscreenRenderTargetList.GetSize(); ++i)
+    {
+        if (_offscreenRenderTargetList[i].IsUsed)
+        {
+            continue;
+        }
+
+        if (result < 0 || _offscreenRenderTargetList[i].LastUsedTick < _offscreenRenderTargetList[result].LastUsedTick)
+        {
+            result = static_cast<csmInt32>(i);
+        }
+    }
+    return result;
+}
+
+template<class T>
+void ICubismOffscreenManager<T>::ReleaseRenderTargetAt(csmInt32 index)
+{
+    _offscreenRenderTargetList[index].RenderTarget->DestroyRenderTarget();
+    CSM_DELETE_SELF(T, _offscreenRenderTargetList[index].RenderTarget);
+    _offscreenRenderTargetList.Remove(index);
+}
+
+template<class T>
+void ICubismOffscreenManager<T>::EvictUnusedRenderTargets(csmUint64 requiredSize)
+{
+    if (_memoryBudget == 0)
+    {
+        return;
+    }
+
+    while (_memoryBudget < GetUsedMemorySize() + requiredSize)
+    {
+        const csmInt32 index = FindLeastRecentlyUsedIndex();
+        if (index < 0)
+        {
+            // 全て使用中の場合は描画を優先して上限を超えることを許容する
+            break;
+        }
+
+        ReleaseRenderTargetAt(index);
+        ++_evictionCount;
+    }
+}
+
 }}}}
 
 //------------ LIVE2D NAMESPACE ------------
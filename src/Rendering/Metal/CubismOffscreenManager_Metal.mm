@@ -24,7 +24,7 @@ CubismRenderTarget_Metal* CubismOffscreenManager_Metal::GetOffscreenRenderTarget
     UpdateRenderTargetCount();
 
     // 使われていないリソースコンテナがあればそれを返す
-    CubismRenderTarget_Metal* offscreenRenderTarget = GetUnusedOffscreenRenderTarget();
+    CubismRenderTarget_Metal* offscreenRenderTarget = GetUnusedOffscreenRenderTarget(width, height);
     if (offscreenRenderTarget != nullptr)
     {
         // サイズが違う場合は再作成する
@@ -12,6 +12,7 @@
 #include "Model/CubismModel.hpp"
 #include "CubismShader_Metal.hpp"
 #include "Shaders/MetalShaderTypes.h"
+#include "Utils/CubismProfiler.hpp"
 
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
@@ -51,6 +52,8 @@ namespace
 ********************************************************************************************************************/
 void CubismClippingManager_Metal::SetupClippingContext(CubismModel& model, CubismRenderer_Metal* renderer, CubismRenderTarget_Metal* lastColorBuffer, csmRectF lastViewport, CubismRenderer::DrawableObjectType drawableObjectType)
 {
+    CSM_PROFILE_ZONE(Zone_ClippingSetup, &model);
+
     // 全てのクリッピングを用意する
     // 同じクリップ（複数の場合はまとめて１つのクリップ）を使う場合は１度だけ設定する
     csmInt32 usingClipCount = 0;
@@ -1247,6 +1250,8 @@ void CubismRenderer_Metal::DrawMeshMetal(CubismCommandBuffer_Metal::DrawCommandB
 
 void CubismRenderer_Metal::DrawOffscreenMetal(id <MTLRenderCommandEncoder> renderEncoder, const CubismModel& model, CubismOffscreenRenderTarget_Metal* offscreen, id<MTLTexture> blendTexture)
 {
+    CSM_PROFILE_ZONE(Zone_OffscreenComposite, &model);
+
     // 裏面描画の有効・無効
     if (IsCulling())
     {
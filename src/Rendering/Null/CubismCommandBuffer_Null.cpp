@@ -0,0 +1,185 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismCommandBuffer_Null.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+namespace {
+    const csmUint32 HashOffsetBasis = 2166136261u;  ///< FNV-1aの初期値
+    const csmUint32 HashPrime = 16777619u;          ///< FNV-1aの乗数
+
+    /**
+     * @brief   0.0~1.0の色成分を8bitに量子化する
+     */
+    csmUint32 QuantizeColor(csmFloat32 value)
+    {
+        if (value <= 0.0f)
+        {
+            return 0;
+        }
+        if (value >= 1.0f)
+        {
+            return 255;
+        }
+        return static_cast<csmUint32>(value * 255.0f + 0.5f);
+    }
+}
+
+CubismCommandBuffer_Null::CubismCommandBuffer_Null()
+{
+    Clear();
+}
+
+CubismCommandBuffer_Null::~CubismCommandBuffer_Null()
+{
+}
+
+void CubismCommandBuffer_Null::Clear()
+{
+    // 毎フレーム記録しなおすため、確保済みの領域は解放しない
+    _commands.UpdateSize(0, Command(), false);
+
+    for (csmInt32 i = 0; i < CommandType_Count; ++i)
+    {
+        _commandCounts[i] = 0;
+    }
+
+    // 記録の先頭では必ずステートを記録する
+    _blendState[0] = -1;
+    _blendState[1] = -1;
+    _blendState[2] = -1;
+    _culling = -1;
+}
+
+void CubismCommandBuffer_Null::BeginTarget(csmInt32 renderTargetId, csmUint32 width, csmUint32 height, csmInt32 restoreRenderTargetId)
+{
+    PushCommand(CommandType_BeginTarget, renderTargetId, static_cast<csmInt32>(width), static_cast<csmInt32>(height), restoreRenderTargetId);
+}
+
+void CubismCommandBuffer_Null::EndTarget(csmInt32 renderTargetId, csmInt32 restoreRenderTargetId)
+{
+    PushCommand(CommandType_EndTarget, renderTargetId, restoreRenderTargetId);
+}
+
+void CubismCommandBuffer_Null::ClearTarget(csmInt32 renderTargetId, csmFloat32 r, csmFloat32 g, csmFloat32 b, csmFloat32 a)
+{
+    const csmUint32 color = (QuantizeColor(r) << 24) | (QuantizeColor(g) << 16) | (QuantizeColor(b) << 8) | QuantizeColor(a);
+    PushCommand(CommandType_ClearTarget, renderTargetId, static_cast<csmInt32>(color));
+}
+
+void CubismCommandBuffer_Null::CopyTarget(csmInt32 srcRenderTargetId, csmInt32 dstRenderTargetId)
+{
+    PushCommand(CommandType_CopyTarget, srcRenderTargetId, dstRenderTargetId);
+}
+
+void CubismCommandBuffer_Null::SetBlendState(BlendState blendState, csmInt32 colorBlendType, csmInt32 alphaBlendType)
+{
+    if (_blendState[0] == blendState && _blendState[1] == colorBlendType && _blendState[2] == alphaBlendType)
+    {
+        return;
+    }
+
+    _blendState[0] = blendState;
+    _blendState[1] = colorBlendType;
+    _blendState[2] = alphaBlendType;
+    PushCommand(CommandType_SetBlendState, blendState, colorBlendType, alphaBlendType);
+}
+
+void CubismCommandBuffer_Null::SetCulling(csmBool isCulling)
+{
+    const csmInt32 culling = isCulling ? 1 : 0;
+    if (_culling == culling)
+    {
+        return;
+    }
+
+    _culling = culling;
+    PushCommand(CommandType_SetCulling, culling);
+}
+
+void CubismCommandBuffer_Null::DrawMask(csmInt32 drawableIndex, csmInt32 indexCount, csmUint32 textureId, csmInt32 channelIndex, csmInt32 bufferIndex)
+{
+    PushCommand(CommandType_DrawMask, drawableIndex, indexCount, static_cast<csmInt32>(textureId), channelIndex | (bufferIndex << 8));
+}
+
+void CubismCommandBuffer_Null::DrawMesh(csmInt32 drawableIndex, csmInt32 indexCount, csmUint32 textureId, csmInt32 drawFlags, csmInt32 channelIndex, csmInt32 bufferIndex)
+{
+    PushCommand(CommandType_DrawMesh, drawableIndex, indexCount, static_cast<csmInt32>(textureId), drawFlags | (channelIndex << 4) | (bufferIndex << 8));
+}
+
+void CubismCommandBuffer_Null::DrawOffscreen(csmInt32 offscreenIndex, csmInt32 srcRenderTargetId, csmInt32 dstRenderTargetId, csmInt32 drawFlags, csmInt32 channelIndex, csmInt32 bufferIndex)
+{
+    PushCommand(CommandType_DrawOffscreen, offscreenIndex, srcRenderTargetId, dstRenderTargetId, drawFlags | (channelIndex << 4) | (bufferIndex << 8));
+}
+
+csmUint32 CubismCommandBuffer_Null::GetCommandCount() const
+{
+    return _commands.GetSize();
+}
+
+csmUint32 CubismCommandBuffer_Null::GetCommandCount(CommandType type) const
+{
+    if (type < 0 || type >= CommandType_Count)
+    {
+        return 0;
+    }
+
+    return _commandCounts[type];
+}
+
+const CubismCommandBuffer_Null::Command& CubismCommandBuffer_Null::GetCommand(csmUint32 index) const
+{
+    return _commands[index];
+}
+
+csmUint32 CubismCommandBuffer_Null::GetHash() const
+{
+    // 構造体のパディングやエンディアンに依存しないよう、値を1バイトずつ取り出してハッシュする
+    csmUint32 hash = HashOffsetBasis;
+    for (csmUint32 i = 0; i < _commands.GetSize(); ++i)
+    {
+        const Command& command = _commands[i];
+        const csmInt32 values[] = {
+            command.Type,
+            command.Arguments[0],
+            command.Arguments[1],
+            command.Arguments[2],
+            command.Arguments[3],
+        };
+
+        for (csmInt32 valueIndex = 0; valueIndex < 5; ++valueIndex)
+        {
+            const csmUint32 value = static_cast<csmUint32>(values[valueIndex]);
+            for (csmInt32 shift = 0; shift < 32; shift += 8)
+            {
+                hash ^= (value >> shift) & 0xFF;
+                hash *= HashPrime;
+            }
+        }
+    }
+
+    return hash;
+}
+
+void CubismCommandBuffer_Null::PushCommand(CommandType type, csmInt32 argument0, csmInt32 argument1, csmInt32 argument2, csmInt32 argument3)
+{
+    Command command;
+    command.Type = type;
+    command.Arguments[0] = argument0;
+    command.Arguments[1] = argument1;
+    command.Arguments[2] = argument2;
+    command.Arguments[3] = argument3;
+
+    _commands.PushBack(command);
+    _commandCounts[type]++;
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
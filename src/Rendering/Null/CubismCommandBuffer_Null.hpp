@@ -0,0 +1,225 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+#include "Type/csmVector.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+/**
+ * @brief   Nullレンダラが描画の代わりに記録するコマンド列<br>
+ *          グラフィックスAPIを呼ばずに描画・ステート変更・描画先の切り替えを記録し、<br>
+ *          コマンド数やハッシュ値で描画処理の結果を比較できるようにする。
+ */
+class CubismCommandBuffer_Null
+{
+public:
+    /**
+     * @brief   コマンドの種類
+     */
+    enum CommandType
+    {
+        CommandType_BeginTarget,    ///< 描画先の切り替え（id, 幅, 高さ, 戻り先のid）
+        CommandType_EndTarget,      ///< 描画先を戻す（id, 戻り先のid）
+        CommandType_ClearTarget,    ///< 描画先のクリア（id, RGBA8でパックしたクリア色）
+        CommandType_CopyTarget,     ///< 描画先のコピー（コピー元のid, コピー先のid）
+        CommandType_SetBlendState,  ///< ブレンドステートの変更（BlendState, カラーブレンドの種類, アルファブレンドの種類）
+        CommandType_SetCulling,     ///< 裏面描画の有効・無効の変更（有効なら1）
+        CommandType_DrawMask,       ///< マスクの描画（Drawableのインデックス, インデックス数, テクスチャ, チャンネル | バッファ番号 << 8）
+        CommandType_DrawMesh,       ///< メッシュの描画（Drawableのインデックス, インデックス数, テクスチャ, DrawFlag | チャンネル << 4 | バッファ番号 << 8）
+        CommandType_DrawOffscreen,  ///< オフスクリーンの合成（オフスクリーンのインデックス, 合成元のid, 合成先のid, DrawFlag | チャンネル << 4 | バッファ番号 << 8）
+        CommandType_Count,
+    };
+
+    /**
+     * @brief   ブレンドステートの種類
+     */
+    enum BlendState
+    {
+        BlendState_Normal,      ///< 通常（5.2以前の方法）
+        BlendState_Add,         ///< 加算（5.2以前の方法）
+        BlendState_Multiply,    ///< 乗算（5.2以前の方法）
+        BlendState_Mask,        ///< マスク生成
+        BlendState_Advanced,    ///< 描画先をコピーしてシェーダで合成する（5.3以降の方法）
+    };
+
+    /**
+     * @brief   描画コマンドに付加するフラグ
+     */
+    enum DrawFlag
+    {
+        DrawFlag_Masked = 1 << 0,               ///< マスクを使用する
+        DrawFlag_InvertedMask = 1 << 1,         ///< マスクを反転して使用する
+        DrawFlag_PremultipliedAlpha = 1 << 2,   ///< 乗算済みアルファとして扱う
+    };
+
+    /**
+     * @brief   記録されたコマンド
+     */
+    struct Command
+    {
+        csmInt32 Type;          ///< コマンドの種類
+        csmInt32 Arguments[4];  ///< コマンドの引数（使わないものは0）
+    };
+
+    /**
+     * @brief   コンストラクタ
+     */
+    CubismCommandBuffer_Null();
+
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~CubismCommandBuffer_Null();
+
+    /**
+     * @brief   記録したコマンドを破棄する<br>
+     *          確保済みの領域は次の記録で再利用する。
+     */
+    void Clear();
+
+    /**
+     * @brief   描画先の切り替えを記録する
+     *
+     * @param[in]   renderTargetId          ->  描画先のid
+     * @param[in]   width                   ->  描画先の幅
+     * @param[in]   height                  ->  描画先の高さ
+     * @param[in]   restoreRenderTargetId   ->  描画終了時に戻す描画先のid
+     */
+    void BeginTarget(csmInt32 renderTargetId, csmUint32 width, csmUint32 height, csmInt32 restoreRenderTargetId);
+
+    /**
+     * @brief   描画先を戻す処理を記録する
+     *
+     * @param[in]   renderTargetId          ->  描画を終了する描画先のid
+     * @param[in]   restoreRenderTargetId   ->  戻す描画先のid
+     */
+    void EndTarget(csmInt32 renderTargetId, csmInt32 restoreRenderTargetId);
+
+    /**
+     * @brief   描画先のクリアを記録する
+     *
+     * @param[in]   renderTargetId  ->  クリアする描画先のid
+     * @param[in]   r               ->  赤(0.0~1.0)
+     * @param[in]   g               ->  緑(0.0~1.0)
+     * @param[in]   b               ->  青(0.0~1.0)
+     * @param[in]   a               ->  α(0.0~1.0)
+     */
+    void ClearTarget(csmInt32 renderTargetId, csmFloat32 r, csmFloat32 g, csmFloat32 b, csmFloat32 a);
+
+    /**
+     * @brief   描画先のコピーを記録する
+     *
+     * @param[in]   srcRenderTargetId   ->  コピー元のid
+     * @param[in]   dstRenderTargetId   ->  コピー先のid
+     */
+    void CopyTarget(csmInt32 srcRenderTargetId, csmInt32 dstRenderTargetId);
+
+    /**
+     * @brief   ブレンドステートを設定する<br>
+     *          直前の設定と同じ場合は記録しない。
+     *
+     * @param[in]   blendState      ->  ブレンドステートの種類
+     * @param[in]   colorBlendType  ->  カラーブレンドの種類
+     * @param[in]   alphaBlendType  ->  アルファブレンドの種類
+     */
+    void SetBlendState(BlendState blendState, csmInt32 colorBlendType, csmInt32 alphaBlendType);
+
+    /**
+     * @brief   裏面描画の有効・無効を設定する<br>
+     *          直前の設定と同じ場合は記録しない。
+     *
+     * @param[in]   isCulling   ->  trueなら裏面描画を無効にする
+     */
+    void SetCulling(csmBool isCulling);
+
+    /**
+     * @brief   マスクの描画を記録する
+     *
+     * @param[in]   drawableIndex   ->  Drawableのインデックス
+     * @param[in]   indexCount      ->  頂点インデックスの数
+     * @param[in]   textureId       ->  バインドされているテクスチャ
+     * @param[in]   channelIndex    ->  描き込むカラーチャンネル
+     * @param[in]   bufferIndex     ->  描き込むマスク用バッファの番号
+     */
+    void DrawMask(csmInt32 drawableIndex, csmInt32 indexCount, csmUint32 textureId, csmInt32 channelIndex, csmInt32 bufferIndex);
+
+    /**
+     * @brief   メッシュの描画を記録する
+     *
+     * @param[in]   drawableIndex   ->  Drawableのインデックス
+     * @param[in]   indexCount      ->  頂点インデックスの数
+     * @param[in]   textureId       ->  バインドされているテクスチャ
+     * @param[in]   drawFlags       ->  DrawFlagの組み合わせ
+     * @param[in]   channelIndex    ->  参照するマスクのカラーチャンネル
+     * @param[in]   bufferIndex     ->  参照するマスク用バッファの番号
+     */
+    void DrawMesh(csmInt32 drawableIndex, csmInt32 indexCount, csmUint32 textureId, csmInt32 drawFlags, csmInt32 channelIndex, csmInt32 bufferIndex);
+
+    /**
+     * @brief   オフスクリーンの合成を記録する
+     *
+     * @param[in]   offscreenIndex      ->  オフスクリーンのインデックス
+     * @param[in]   srcRenderTargetId   ->  合成元の描画先のid
+     * @param[in]   dstRenderTargetId   ->  合成先の描画先のid
+     * @param[in]   drawFlags           ->  DrawFlagの組み合わせ
+     * @param[in]   channelIndex        ->  参照するマスクのカラーチャンネル
+     * @param[in]   bufferIndex         ->  参照するマスク用バッファの番号
+     */
+    void DrawOffscreen(csmInt32 offscreenIndex, csmInt32 srcRenderTargetId, csmInt32 dstRenderTargetId, csmInt32 drawFlags, csmInt32 channelIndex, csmInt32 bufferIndex);
+
+    /**
+     * @brief   記録されたコマンドの数を取得する
+     *
+     * @return  コマンドの数
+     */
+    csmUint32 GetCommandCount() const;
+
+    /**
+     * @brief   指定の種類のコマンドが記録された数を取得する
+     *
+     * @param[in]   type    ->  コマンドの種類
+     *
+     * @return  コマンドの数
+     */
+    csmUint32 GetCommandCount(CommandType type) const;
+
+    /**
+     * @brief   記録されたコマンドを取得する
+     *
+     * @param[in]   index   ->  コマンドのインデックス
+     *
+     * @return  コマンド
+     */
+    const Command& GetCommand(csmUint32 index) const;
+
+    /**
+     * @brief   記録されたコマンド列全体のハッシュ値を取得する<br>
+     *          同じモデル・同じ状態を描画した結果はコミットをまたいでも同じ値になる。
+     *
+     * @return  ハッシュ値（FNV-1a）
+     */
+    csmUint32 GetHash() const;
+
+private:
+    /**
+     * @brief   コマンドを追加する
+     */
+    void PushCommand(CommandType type, csmInt32 argument0, csmInt32 argument1 = 0, csmInt32 argument2 = 0, csmInt32 argument3 = 0);
+
+    csmVector<Command> _commands;               ///< 記録されたコマンド
+    csmUint32 _commandCounts[CommandType_Count];    ///< 種類ごとのコマンドの数
+    csmInt32 _blendState[3];                    ///< 最後に記録したブレンドステート（未記録は-1）
+    csmInt32 _culling;                          ///< 最後に記録した裏面描画の設定（未記録は-1）
+};
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
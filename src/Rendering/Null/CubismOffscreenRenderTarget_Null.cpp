@@ -0,0 +1,96 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismOffscreenRenderTarget_Null.hpp"
+#include "CubismOffscreenManager_Null.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+CubismOffscreenRenderTarget_Null::CubismOffscreenRenderTarget_Null()
+{
+    // 既定ではモデル描画先全体を覆う
+    const csmFloat32 fullRect[] = {
+        -1.0f, -1.0f,
+         1.0f, -1.0f,
+        -1.0f,  1.0f,
+         1.0f,  1.0f,
+    };
+    for (csmInt32 i = 0; i < 8; ++i)
+    {
+        _drawRectVertexArray[i] = fullRect[i];
+    }
+}
+
+CubismOffscreenRenderTarget_Null::~CubismOffscreenRenderTarget_Null()
+{
+}
+
+void CubismOffscreenRenderTarget_Null::SetOffscreenRenderTarget(csmUint32 width, csmUint32 height)
+{
+    if (GetUsingRenderTextureState())
+    {
+        // 使用中の場合はサイズだけ確認
+        if (_renderTarget->GetBufferWidth() != width || _renderTarget->GetBufferHeight() != height)
+        {
+            _renderTarget->CreateRenderTarget(width, height);
+        }
+        return;
+    }
+
+    _renderTarget = CubismOffscreenManager_Null::GetInstance()->GetOffscreenRenderTarget(width, height);
+}
+
+csmBool CubismOffscreenRenderTarget_Null::GetUsingRenderTextureState() const
+{
+    return CubismOffscreenManager_Null::GetInstance()->GetUsingRenderTextureState(_renderTarget);
+}
+
+void CubismOffscreenRenderTarget_Null::StopUsingRenderTexture()
+{
+    CubismOffscreenManager_Null::GetInstance()->StopUsingRenderTexture(_renderTarget);
+    _renderTarget = nullptr;
+}
+
+void CubismOffscreenRenderTarget_Null::SetDrawRect(csmInt32 x, csmInt32 y, csmUint32 width, csmUint32 height, csmUint32 canvasWidth, csmUint32 canvasHeight)
+{
+    // ピクセル矩形をモデル描画先のNDC座標に変換
+    const csmFloat32 left = static_cast<csmFloat32>(x) / canvasWidth * 2.0f - 1.0f;
+    const csmFloat32 bottom = static_cast<csmFloat32>(y) / canvasHeight * 2.0f - 1.0f;
+    const csmFloat32 right = static_cast<csmFloat32>(x + static_cast<csmInt32>(width)) / canvasWidth * 2.0f - 1.0f;
+    const csmFloat32 top = static_cast<csmFloat32>(y + static_cast<csmInt32>(height)) / canvasHeight * 2.0f - 1.0f;
+
+    _drawRectVertexArray[0] = left;
+    _drawRectVertexArray[1] = bottom;
+    _drawRectVertexArray[2] = right;
+    _drawRectVertexArray[3] = bottom;
+    _drawRectVertexArray[4] = left;
+    _drawRectVertexArray[5] = top;
+    _drawRectVertexArray[6] = right;
+    _drawRectVertexArray[7] = top;
+
+    // 矩形が[-1, 1]に収まるよう平行移動してから拡大する
+    _canvasToOffscreenMatrix.LoadIdentity();
+    _canvasToOffscreenMatrix.ScaleRelative(2.0f / (right - left), 2.0f / (top - bottom));
+    _canvasToOffscreenMatrix.TranslateRelative(-(left + right) * 0.5f, -(bottom + top) * 0.5f);
+
+    SetOffscreenRenderTarget(width, height);
+}
+
+const csmFloat32* CubismOffscreenRenderTarget_Null::GetDrawRectVertexArray() const
+{
+    return _drawRectVertexArray;
+}
+
+const CubismMatrix44& CubismOffscreenRenderTarget_Null::GetCanvasToOffscreenMatrix() const
+{
+    return _canvasToOffscreenMatrix;
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
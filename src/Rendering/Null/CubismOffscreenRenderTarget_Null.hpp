@@ -0,0 +1,87 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "../ICubismOffscreenRenderTarget.hpp"
+#include "CubismRenderTarget_Null.hpp"
+#include "Math/CubismMatrix44.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+/**
+ * @brief  オフスクリーン用のレンダーターゲットを管理するクラス
+ */
+class CubismOffscreenRenderTarget_Null : public ICubismOffscreenRenderTarget<CubismOffscreenRenderTarget_Null, CubismRenderTarget_Null>
+{
+public:
+    /**
+     * @brief   コンストラクタ
+     */
+    CubismOffscreenRenderTarget_Null();
+
+    /**
+     * @brief   デストラクタ
+     */
+    ~CubismOffscreenRenderTarget_Null();
+
+    /**
+     * @brief オフスクリーン描画用レンダーターゲットを設定する。
+     *
+     *  @param  width  幅
+     *  @param  height 高さ
+     */
+    void SetOffscreenRenderTarget(csmUint32 width, csmUint32 height);
+
+    /**
+     * @brief レンダーターゲットの使用状態を取得する。
+     *
+     * @return 使用中はtrue、未使用の場合はfalseを返す。
+     */
+    csmBool GetUsingRenderTextureState() const;
+
+    /**
+     * @brief オフスクリーン描画用レンダーターゲットの使用を終了する。
+     */
+    void StopUsingRenderTexture();
+
+    /**
+     * @brief オフスクリーンが描画を受け持つモデル描画先上の矩形を設定する。<br>
+     *        レンダーターゲットは矩形と同じサイズで確保される。
+     *
+     * @param  x             矩形の左端（ピクセル）
+     * @param  y             矩形の下端（ピクセル）
+     * @param  width         矩形の幅（ピクセル）
+     * @param  height        矩形の高さ（ピクセル）
+     * @param  canvasWidth   モデル描画先の幅
+     * @param  canvasHeight  モデル描画先の高さ
+     */
+    void SetDrawRect(csmInt32 x, csmInt32 y, csmUint32 width, csmUint32 height, csmUint32 canvasWidth, csmUint32 canvasHeight);
+
+    /**
+     * @brief 描画先の矩形をモデル描画先のNDC座標で表した四角形の頂点配列を取得する。
+     *
+     * @return 頂点配列（4頂点）
+     */
+    const csmFloat32* GetDrawRectVertexArray() const;
+
+    /**
+     * @brief モデル描画先のNDC座標をこのオフスクリーンのNDC座標に変換する行列を取得する。
+     *
+     * @return 変換行列
+     */
+    const CubismMatrix44& GetCanvasToOffscreenMatrix() const;
+
+private:
+    csmFloat32 _drawRectVertexArray[8];        ///< 描画先の矩形（モデル描画先のNDC座標）
+    CubismMatrix44 _canvasToOffscreenMatrix;   ///< モデル描画先のNDC座標から矩形内のNDC座標への変換行列
+};
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
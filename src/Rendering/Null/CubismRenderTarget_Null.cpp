@@ -0,0 +1,106 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismRenderTarget_Null.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+namespace {
+    csmInt32 s_nextRenderTargetId = 1;  ///< 次に割り当てる描画先の識別子（0はアプリケーション側の描画先）
+}
+
+void CubismRenderTarget_Null::CopyBuffer(CubismCommandBuffer_Null& commandBuffer, const CubismRenderTarget_Null& src, const CubismRenderTarget_Null& dst)
+{
+    commandBuffer.CopyTarget(src._renderTargetId, dst._renderTargetId);
+}
+
+CubismRenderTarget_Null::CubismRenderTarget_Null()
+    : _renderTargetId(0)
+    , _oldRenderTargetId(0)
+    , _bufferWidth(0)
+    , _bufferHeight(0)
+    , _isValid(false)
+{
+}
+
+void CubismRenderTarget_Null::BeginDraw(CubismCommandBuffer_Null& commandBuffer, csmInt32 restoreRenderTargetId)
+{
+    if (!_isValid)
+    {
+        return;
+    }
+
+    _oldRenderTargetId = restoreRenderTargetId;
+    commandBuffer.BeginTarget(_renderTargetId, _bufferWidth, _bufferHeight, _oldRenderTargetId);
+}
+
+void CubismRenderTarget_Null::EndDraw(CubismCommandBuffer_Null& commandBuffer)
+{
+    if (!_isValid)
+    {
+        return;
+    }
+
+    commandBuffer.EndTarget(_renderTargetId, _oldRenderTargetId);
+}
+
+void CubismRenderTarget_Null::Clear(CubismCommandBuffer_Null& commandBuffer, float r, float g, float b, float a)
+{
+    commandBuffer.ClearTarget(_renderTargetId, r, g, b, a);
+}
+
+csmBool CubismRenderTarget_Null::CreateRenderTarget(csmUint32 displayBufferWidth, csmUint32 displayBufferHeight)
+{
+    // 作り直しても同じ描画先として記録されるよう、識別子は最初の作成時にだけ割り当てる
+    if (_renderTargetId == 0)
+    {
+        _renderTargetId = s_nextRenderTargetId++;
+    }
+
+    _bufferWidth = displayBufferWidth;
+    _bufferHeight = displayBufferHeight;
+    _isValid = true;
+
+    return true;
+}
+
+void CubismRenderTarget_Null::DestroyRenderTarget()
+{
+    _bufferWidth = 0;
+    _bufferHeight = 0;
+    _isValid = false;
+}
+
+csmInt32 CubismRenderTarget_Null::GetRenderTargetId() const
+{
+    return _renderTargetId;
+}
+
+csmUint32 CubismRenderTarget_Null::GetBufferWidth() const
+{
+    return _bufferWidth;
+}
+
+csmUint32 CubismRenderTarget_Null::GetBufferHeight() const
+{
+    return _bufferHeight;
+}
+
+csmBool CubismRenderTarget_Null::IsValid() const
+{
+    return _isValid;
+}
+
+csmInt32 CubismRenderTarget_Null::GetOldRenderTargetId() const
+{
+    return _oldRenderTargetId;
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
@@ -0,0 +1,115 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+#include "CubismCommandBuffer_Null.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+/**
+ * @brief   Nullレンダラの描画先<br>
+ *          ピクセルは持たず、描画先の識別子とサイズだけを管理する。<br>
+ *          識別子0はアプリケーション側の描画先を表す。
+ */
+class CubismRenderTarget_Null
+{
+public:
+    /**
+     * @brief   バッファーのコピーを記録する
+     *
+     * @param   commandBuffer   記録先のコマンド列
+     * @param   src             バッファーのコピー元
+     * @param   dst             バッファーのコピー先
+     */
+    static void CopyBuffer(CubismCommandBuffer_Null& commandBuffer, const CubismRenderTarget_Null& src, const CubismRenderTarget_Null& dst);
+
+    /**
+     * @brief   コンストラクタ
+     *
+     */
+    CubismRenderTarget_Null();
+
+    /**
+     * @brief   指定の描画ターゲットに向けて描画開始
+     *
+     * @param   commandBuffer           記録先のコマンド列
+     * @param   restoreRenderTargetId   EndDrawで戻す描画先の識別子
+     */
+    void BeginDraw(CubismCommandBuffer_Null& commandBuffer, csmInt32 restoreRenderTargetId);
+
+    /**
+     * @brief   描画終了
+     *
+     * @param   commandBuffer   記録先のコマンド列
+     */
+    void EndDraw(CubismCommandBuffer_Null& commandBuffer);
+
+    /**
+     * @brief   レンダリングターゲットのクリア
+     *           呼ぶ場合はBeginDrawの後で呼ぶこと
+     *
+     * @param   commandBuffer   記録先のコマンド列
+     * @param   r   赤(0.0~1.0)
+     * @param   g   緑(0.0~1.0)
+     * @param   b   青(0.0~1.0)
+     * @param   a   α(0.0~1.0)
+     */
+    void Clear(CubismCommandBuffer_Null& commandBuffer, float r, float g, float b, float a);
+
+    /**
+     *  @brief  CubismRenderTarget作成<br>
+     *          識別子は最初の作成時に割り当て、作り直しても変わらない。
+     *
+     *  @param  displayBufferWidth     作成するバッファ幅
+     *  @param  displayBufferHeight    作成するバッファ高さ
+     */
+    csmBool CreateRenderTarget(csmUint32 displayBufferWidth, csmUint32 displayBufferHeight);
+
+    /**
+     * @brief   CubismRenderTargetの削除
+     */
+    void DestroyRenderTarget();
+
+    /**
+     * @brief   描画先の識別子を取得する
+     */
+    csmInt32 GetRenderTargetId() const;
+
+    /**
+     * @brief   バッファ幅取得
+     */
+    csmUint32 GetBufferWidth() const;
+
+    /**
+     * @brief   バッファ高さ取得
+     */
+    csmUint32 GetBufferHeight() const;
+
+    /**
+     * @brief   現在有効かどうか
+     */
+    csmBool IsValid() const;
+
+    /**
+     * @brief   旧描画先の識別子の取得
+     */
+    csmInt32 GetOldRenderTargetId() const;
+
+private:
+    csmInt32    _renderTargetId;        ///< 描画先の識別子
+    csmInt32    _oldRenderTargetId;     ///< 旧描画先の識別子
+    csmUint32   _bufferWidth;           ///< Create時に指定された幅
+    csmUint32   _bufferHeight;          ///< Create時に指定された高さ
+    csmBool     _isValid;               ///< 作成済みか
+};
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
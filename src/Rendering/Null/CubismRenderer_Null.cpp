@@ -0,0 +1,1161 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismRenderer_Null.hpp"
+#include "CubismOffscreenManager_Null.hpp"
+#include "Math/CubismMatrix44.hpp"
+#include "Type/csmVector.hpp"
+#include "Model/CubismModel.hpp"
+#include "Math/CubismMath.hpp"
+#include "Utils/CubismProfiler.hpp"
+#include <math.h>
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+/*********************************************************************************************************************
+*                                      CubismClippingManager_Null
+********************************************************************************************************************/
+void CubismClippingManager_Null::SetupClippingContext(CubismModel& model, CubismRenderer_Null* renderer, csmInt32 lastRenderTargetId, CubismRenderer::DrawableObjectType drawableObjectType)
+{
+    CSM_PROFILE_ZONE(Zone_ClippingSetup, &model);
+
+    // 全てのクリッピングを用意する
+    // 同じクリップ（複数の場合はまとめて１つのクリップ）を使う場合は１度だけ設定する
+    csmInt32 usingClipCount = 0;
+    for (csmUint32 clipIndex = 0; clipIndex < _clippingContextListForMask.GetSize(); clipIndex++)
+    {
+        // １つのクリッピングマスクに関して
+        CubismClippingContext_Null* cc = _clippingContextListForMask[clipIndex];
+
+        // このクリップを利用する描画オブジェクト群全体を囲む矩形を計算
+        CalcClippedTotalBounds(model, cc, drawableObjectType);
+
+        if (cc->_isUsing)
+        {
+            usingClipCount++; //使用中としてカウント
+        }
+    }
+
+    if (usingClipCount <= 0)
+    {
+        return;
+    }
+
+    // 後の計算のためにインデックスの最初をセット
+    switch (drawableObjectType)
+    {
+    case CubismRenderer::DrawableObjectType_Drawable:
+    default:
+        _currentMaskBuffer = renderer->GetDrawableMaskBuffer(0);
+        break;
+    case CubismRenderer::DrawableObjectType_Offscreen:
+        _currentMaskBuffer = renderer->GetOffscreenMaskBuffer(0);
+        break;
+    }
+    // ----- マスク描画処理 -----
+    _currentMaskBuffer->BeginDraw(renderer->_commandBuffer, lastRenderTargetId);
+
+    // 各マスクのレイアウトを決定していく
+    SetupLayoutBounds(usingClipCount);
+
+    // サイズがレンダーテクスチャの枚数と合わない場合は合わせる
+    if (static_cast<csmInt32>(_clearedMaskBufferFlags.GetSize()) != _renderTextureCount)
+    {
+        _clearedMaskBufferFlags.Clear();
+
+        for (csmInt32 i = 0; i < _renderTextureCount; ++i)
+        {
+            _clearedMaskBufferFlags.PushBack(false);
+        }
+    }
+    else
+    {
+        // マスクのクリアフラグを毎フレーム開始時に初期化
+        for (csmInt32 i = 0; i < _renderTextureCount; ++i)
+        {
+            _clearedMaskBufferFlags[i] = false;
+        }
+    }
+
+    // 実際にマスクを生成する
+    // 全てのマスクをどの様にレイアウトして描くかを決定し、ClipContext , ClippedDrawContext に記憶する
+    for (csmUint32 clipIndex = 0; clipIndex < _clippingContextListForMask.GetSize(); clipIndex++)
+    {
+        // --- 実際に１つのマスクを描く ---
+        CubismClippingContext_Null* clipContext = _clippingContextListForMask[clipIndex];
+        csmRectF* allClippedDrawRect = clipContext->_allClippedDrawRect; //このマスクを使う、全ての描画オブジェクトの論理座標上の囲み矩形
+        csmRectF* layoutBoundsOnTex01 = clipContext->_layoutBounds; //この中にマスクを収める
+        const csmFloat32 MARGIN = 0.05f;
+
+        // clipContextに設定したレンダーターゲットをインデックスで取得
+        CubismRenderTarget_Null* maskBuffer = NULL;
+        switch (drawableObjectType)
+        {
+        case CubismRenderer::DrawableObjectType_Drawable:
+        default:
+            maskBuffer = renderer->GetDrawableMaskBuffer(clipContext->_bufferIndex);
+            break;
+        case CubismRenderer::DrawableObjectType_Offscreen:
+            maskBuffer = renderer->GetOffscreenMaskBuffer(clipContext->_bufferIndex);
+            break;
+        }
+
+        // 現在のレンダーターゲットがclipContextのものと異なる場合
+        if (_currentMaskBuffer != maskBuffer)
+        {
+            _currentMaskBuffer->EndDraw(renderer->_commandBuffer);
+            _currentMaskBuffer = maskBuffer;
+            // マスク用RenderTextureをactiveにセット
+            _currentMaskBuffer->BeginDraw(renderer->_commandBuffer, lastRenderTargetId);
+        }
+
+        // モデル座標上の矩形を、適宜マージンを付けて使う
+        _tmpBoundsOnModel.SetRect(allClippedDrawRect);
+        _tmpBoundsOnModel.Expand(allClippedDrawRect->Width * MARGIN, allClippedDrawRect->Height * MARGIN);
+        csmFloat32 scaleX = layoutBoundsOnTex01->Width / _tmpBoundsOnModel.Width;
+        csmFloat32 scaleY = layoutBoundsOnTex01->Height / _tmpBoundsOnModel.Height;
+
+        // マスク生成時に使う行列を求める
+        CreateMatrixForMask(false, layoutBoundsOnTex01, scaleX, scaleY);
+
+        clipContext->_matrixForMask.SetMatrix(_tmpMatrixForMask.GetArray());
+        clipContext->_matrixForDraw.SetMatrix(_tmpMatrixForDraw.GetArray());
+
+        if (drawableObjectType == CubismRenderer::DrawableObjectType_Offscreen)
+        {
+            // clipContext * mvp^-1
+            CubismMatrix44 invertMvp = renderer->GetMvpMatrix().GetInvert();
+            clipContext->_matrixForDraw.MultiplyByMatrix(&invertMvp);
+        }
+
+        // 実際の描画を行う
+        const csmInt32 clipDrawCount = clipContext->_clippingIdCount;
+        for (csmInt32 i = 0; i < clipDrawCount; i++)
+        {
+            const csmInt32 clipDrawIndex = clipContext->_clippingIdList[i];
+
+            // 頂点情報が更新されておらず、信頼性がない場合は描画をパスする
+            if (!model.GetDrawableDynamicFlagVertexPositionsDidChange(clipDrawIndex))
+            {
+                continue;
+            }
+
+            renderer->IsCulling(model.GetDrawableCulling(clipDrawIndex) != 0);
+
+            // マスクがクリアされていないなら処理する
+            if (!_clearedMaskBufferFlags[clipContext->_bufferIndex])
+            {
+                // マスクをクリアする
+                // 1が無効（描かれない）領域、0が有効（描かれる）領域
+                _currentMaskBuffer->Clear(renderer->_commandBuffer, 1.0f, 1.0f, 1.0f, 1.0f);
+                _clearedMaskBufferFlags[clipContext->_bufferIndex] = true;
+            }
+
+            // 今回専用の変換を適用して描く
+            // チャンネルも切り替える必要がある(A,R,G,B)
+            renderer->SetClippingContextBufferForMask(clipContext);
+
+            renderer->DrawMeshNull(model, clipDrawIndex);
+        }
+    }
+
+    // --- 後処理 ---
+    _currentMaskBuffer->EndDraw(renderer->_commandBuffer);
+    renderer->SetClippingContextBufferForMask(NULL);
+}
+
+/*********************************************************************************************************************
+*                                      CubismClippingContext_Null
+********************************************************************************************************************/
+CubismClippingContext_Null::CubismClippingContext_Null(CubismClippingManager<CubismClippingContext_Null, CubismRenderTarget_Null>* manager, CubismModel& model, const csmInt32* clippingDrawableIndices, csmInt32 clipCount)
+    : CubismClippingContext(clippingDrawableIndices, clipCount)
+{
+    _owner = manager;
+}
+
+CubismClippingContext_Null::~CubismClippingContext_Null()
+{
+}
+
+CubismClippingManager<CubismClippingContext_Null, CubismRenderTarget_Null>* CubismClippingContext_Null::GetClippingManager()
+{
+    return _owner;
+}
+
+/*********************************************************************************************************************
+*                                      CubismRenderer_Null
+********************************************************************************************************************/
+CubismRenderer* CubismRenderer::Create(csmUint32 width, csmUint32 height)
+{
+    return CSM_NEW CubismRenderer_Null(width, height);
+}
+
+void CubismRenderer::StaticRelease()
+{
+    CubismRenderer_Null::DoStaticRelease();
+}
+
+CubismRenderer_Null::CubismRenderer_Null(csmUint32 width, csmUint32 height)
+    : CubismRenderer(width, height)
+    , _drawableClippingManager(NULL)
+    , _offscreenClippingManager(NULL)
+    , _clippingContextBufferForMask(NULL)
+    , _clippingContextBufferForDrawable(NULL)
+    , _clippingContextBufferForOffscreen(NULL)
+    , _currentRenderTargetId(0)
+    , _currentOffscreen(NULL)
+    , _modelRootRenderTargetId(0)
+    , _blendCopyRenderTarget(NULL)
+{
+    // テクスチャ対応マップの容量を確保しておく.
+    _textures.PrepareCapacity(32, true);
+}
+
+CubismRenderer_Null::~CubismRenderer_Null()
+{
+    CSM_DELETE_SELF(CubismClippingManager_Null, _drawableClippingManager);
+    CSM_DELETE_SELF(CubismClippingManager_Null, _offscreenClippingManager);
+
+    for (csmUint32 i = 0; i < _modelRenderTargets.GetSize(); ++i)
+    {
+        if (_modelRenderTargets[i].IsValid())
+        {
+            _modelRenderTargets[i].DestroyRenderTarget();
+        }
+    }
+    _modelRenderTargets.Clear();
+
+    for (csmUint32 i = 0; i < _drawableMasks.GetSize(); ++i)
+    {
+        if (_drawableMasks[i].IsValid())
+        {
+            _drawableMasks[i].DestroyRenderTarget();
+        }
+    }
+    _drawableMasks.Clear();
+
+    for (csmUint32 i = 0; i < _offscreenMasks.GetSize(); ++i)
+    {
+        if (_offscreenMasks[i].IsValid())
+        {
+            _offscreenMasks[i].DestroyRenderTarget();
+        }
+    }
+    _offscreenMasks.Clear();
+}
+
+void CubismRenderer_Null::DoStaticRelease()
+{
+    // グラフィックスAPIのリソースを持たないため解放するものはない
+}
+
+void CubismRenderer_Null::Initialize(CubismModel* model)
+{
+    Initialize(model, 1);
+}
+
+void CubismRenderer_Null::Initialize(CubismModel* model, csmInt32 maskBufferCount)
+{
+    // 1未満は1に補正する
+    if (maskBufferCount < 1)
+    {
+        maskBufferCount = 1;
+        CubismLogWarning("The number of render textures must be an integer greater than or equal to 1. Set the number of render textures to 1.");
+    }
+
+    _modelRenderTargets.Clear();
+    if (model->IsBlendModeEnabled())
+    {
+        // オフスクリーンの作成
+        // 描画先の同期を持たないため、TextureBarrierが使えない環境と同じく2枚作成する
+        // 添え字 0 は描画先となる
+        // 添え字 1 はコピー用
+        for (csmInt32 i = 0; i < 2; ++i)
+        {
+            CubismRenderTarget_Null renderTarget;
+            renderTarget.CreateRenderTarget(_modelRenderTargetWidth, _modelRenderTargetHeight);
+            _modelRenderTargets.PushBack(renderTarget);
+        }
+    }
+
+    if (model->IsUsingMasking())
+    {
+        _drawableClippingManager = CSM_NEW CubismClippingManager_Null();  //クリッピングマスク・バッファ前処理方式を初期化
+        _drawableClippingManager->Initialize(
+            *model,
+            maskBufferCount,
+            CubismRenderer::DrawableObjectType_Drawable
+        );
+
+        _drawableMasks.Clear();
+        for (csmInt32 i = 0; i < maskBufferCount; ++i)
+        {
+            CubismRenderTarget_Null masks;
+            masks.CreateRenderTarget(_drawableClippingManager->GetClippingMaskBufferSize().X, _drawableClippingManager->GetClippingMaskBufferSize().Y);
+            _drawableMasks.PushBack(masks);
+        }
+    }
+
+    if (model->IsUsingMaskingForOffscreen())
+    {
+        _offscreenClippingManager = CSM_NEW CubismClippingManager_Null();  //クリッピングマスク・バッファ前処理方式を初期化
+        _offscreenClippingManager->Initialize(
+            *model,
+            maskBufferCount,
+            CubismRenderer::DrawableObjectType_Offscreen
+        );
+
+        _offscreenMasks.Clear();
+        for (csmInt32 i = 0; i < maskBufferCount; ++i)
+        {
+            CubismRenderTarget_Null offscreenMask;
+            offscreenMask.CreateRenderTarget(_offscreenClippingManager->GetClippingMaskBufferSize().X, _offscreenClippingManager->GetClippingMaskBufferSize().Y);
+            _offscreenMasks.PushBack(offscreenMask);
+        }
+    }
+
+    _sortedObjectsIndexList.Resize(model->GetDrawableCount() + model->GetOffscreenCount(), 0);
+    _sortedObjectsTypeList.Resize(model->GetDrawableCount() + model->GetOffscreenCount(), DrawableObjectType_Drawable);
+
+    const csmInt32 offscreenCount = model->GetOffscreenCount();
+
+    // オフスクリーンの数が0の場合は何もしない
+    if (offscreenCount > 0)
+    {
+        _offscreenList = csmVector<CubismOffscreenRenderTarget_Null>(offscreenCount);
+        for (csmInt32 offscreenIndex = 0; offscreenIndex < offscreenCount; ++offscreenIndex)
+        {
+            CubismOffscreenRenderTarget_Null renderTarget;
+            renderTarget.SetOffscreenIndex(offscreenIndex);
+            _offscreenList.PushBack(renderTarget);
+        }
+
+        // 全てのオフスクリーンを登録し終わってから行う
+        SetupParentOffscreens(model, offscreenCount);
+        SetupOffscreenChildDrawables(model, offscreenCount);
+    }
+
+    CubismRenderer::Initialize(model, maskBufferCount);  //親クラスの処理を呼ぶ
+}
+
+void CubismRenderer_Null::SetupParentOffscreens(const CubismModel* model, csmInt32 offscreenCount)
+{
+    CubismOffscreenRenderTarget_Null* parentOffscreen;
+    for (csmInt32 offscreenIndex = 0; offscreenIndex < offscreenCount; ++offscreenIndex)
+    {
+        parentOffscreen = NULL;
+        const csmInt32 ownerIndex = model->GetOffscreenOwnerIndices()[offscreenIndex];
+        csmInt32 parentIndex = model->GetPartParentPartIndex(ownerIndex);
+
+        // 親のオフスクリーンを探す
+        while (parentIndex != CubismModel::CubismNoIndex_Parent)
+        {
+            for (csmInt32 i = 0; i < offscreenCount; ++i)
+            {
+                if (model->GetOffscreenOwnerIndices()[_offscreenList.At(i).GetOffscreenIndex()] != parentIndex)
+                {
+                    continue;  //オフスクリーンのインデックスが親と一致しなければスキップ
+                }
+
+                parentOffscreen = &_offscreenList.At(i);
+                break;
+            }
+
+            if (parentOffscreen != NULL)
+            {
+                break;  // 親のオフスクリーンが見つかった場合はループを抜ける
+            }
+
+            parentIndex = model->GetPartParentPartIndex(parentIndex);
+        }
+
+        // 親のオフスクリーンを設定
+        _offscreenList.At(offscreenIndex).SetParentPartOffscreen(parentOffscreen);
+    }
+}
+
+void CubismRenderer_Null::SetupOffscreenChildDrawables(const CubismModel* model, csmInt32 offscreenCount)
+{
+    // 階層情報は値で返るため一度だけ取得する
+    const csmVector<CubismModelPartInfo> partsHierarchy = model->GetPartsHierarchy();
+
+    _offscreenChildDrawableIndices.Clear();
+    _offscreenChildDrawableOffsets.Clear();
+
+    csmVector<csmInt32> offscreenStack;
+    for (csmInt32 offscreenIndex = 0; offscreenIndex < offscreenCount; ++offscreenIndex)
+    {
+        _offscreenChildDrawableOffsets.PushBack(_offscreenChildDrawableIndices.GetSize());
+
+        // 子孫のオフスクリーンも辿ってDrawableを集める
+        offscreenStack.Clear();
+        offscreenStack.PushBack(offscreenIndex);
+        while (offscreenStack.GetSize() > 0)
+        {
+            const csmInt32 targetOffscreenIndex = offscreenStack[offscreenStack.GetSize() - 1];
+            offscreenStack.Remove(offscreenStack.GetSize() - 1);
+
+            const PartChildDrawObjects& childDrawObjects = partsHierarchy[model->GetOffscreenOwnerIndices()[targetOffscreenIndex]].ChildDrawObjects;
+            for (csmUint32 i = 0; i < childDrawObjects.DrawableIndices.GetSize(); ++i)
+            {
+                _offscreenChildDrawableIndices.PushBack(childDrawObjects.DrawableIndices[i]);
+            }
+            for (csmUint32 i = 0; i < childDrawObjects.OffscreenIndices.GetSize(); ++i)
+            {
+                offscreenStack.PushBack(childDrawObjects.OffscreenIndices[i]);
+            }
+        }
+    }
+    _offscreenChildDrawableOffsets.PushBack(_offscreenChildDrawableIndices.GetSize());
+}
+
+void CubismRenderer_Null::DoDrawModel()
+{
+    // コマンド列は描画ごとに記録しなおす
+    _commandBuffer.Clear();
+    _currentRenderTargetId = 0;
+
+    BeforeDrawModelRenderTarget();
+    // モデル描画直前の描画先を保存
+    const csmInt32 lastRenderTargetId = _currentRenderTargetId;
+
+    //------------ クリッピングマスク・バッファ前処理方式の場合 ------------
+    if (_drawableClippingManager != NULL)
+    {
+        // サイズが違う場合はここで作成しなおし
+        for (csmInt32 i = 0; i < _drawableClippingManager->GetRenderTextureCount(); ++i)
+        {
+            if (_drawableMasks[i].GetBufferWidth() != static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().X) ||
+                _drawableMasks[i].GetBufferHeight() != static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().Y))
+            {
+                _drawableMasks[i].CreateRenderTarget(
+                    static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().X), static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().Y));
+            }
+        }
+
+        if (IsUsingHighPrecisionMask())
+        {
+            _drawableClippingManager->SetupMatrixForHighPrecision(*GetModel(), false, DrawableObjectType_Drawable);
+        }
+        else
+        {
+            _drawableClippingManager->SetupClippingContext(*GetModel(), this, lastRenderTargetId, DrawableObjectType_Drawable);
+        }
+    }
+
+    if (_offscreenClippingManager != NULL)
+    {
+        // サイズが違う場合はここで作成しなおし
+        for (csmInt32 i = 0; i < _offscreenClippingManager->GetRenderTextureCount(); ++i)
+        {
+            if (_offscreenMasks[i].GetBufferWidth() != static_cast<csmUint32>(_offscreenClippingManager->GetClippingMaskBufferSize().X) ||
+                _offscreenMasks[i].GetBufferHeight() != static_cast<csmUint32>(_offscreenClippingManager->GetClippingMaskBufferSize().Y))
+            {
+                _offscreenMasks[i].CreateRenderTarget(
+                    static_cast<csmUint32>(_offscreenClippingManager->GetClippingMaskBufferSize().X), static_cast<csmUint32>(_offscreenClippingManager->GetClippingMaskBufferSize().Y));
+            }
+        }
+
+        if (IsUsingHighPrecisionMask())
+        {
+            _offscreenClippingManager->SetupMatrixForHighPrecision(*GetModel(), false, DrawableObjectType_Offscreen, GetMvpMatrix());
+        }
+        else
+        {
+            _offscreenClippingManager->SetupClippingContext(*GetModel(), this, lastRenderTargetId, DrawableObjectType_Offscreen);
+        }
+    }
+
+    // モデルの描画順に従って描画する
+    DrawObjectLoop(lastRenderTargetId);
+
+    AfterDrawModelRenderTarget();
+}
+
+void CubismRenderer_Null::DrawObjectLoop(csmInt32 lastRenderTargetId)
+{
+    const csmInt32 drawableCount = GetModel()->GetDrawableCount();
+    const csmInt32 offscreenCount = GetModel()->GetOffscreenCount();
+    const csmInt32 totalCount = drawableCount + offscreenCount;
+    const csmInt32* renderOrder = GetModel()->GetRenderOrders();
+
+    _currentOffscreen = NULL;
+    _currentRenderTargetId = lastRenderTargetId;
+    _modelRootRenderTargetId = lastRenderTargetId;
+
+    // インデックスを描画順でソート
+    for (csmInt32 i = 0; i < totalCount; ++i)
+    {
+        const csmInt32 order = renderOrder[i];
+
+        if (i < drawableCount)
+        {
+            _sortedObjectsIndexList[order] = i;
+            _sortedObjectsTypeList[order] = DrawableObjectType_Drawable;
+        }
+        else if (i < totalCount)
+        {
+            _sortedObjectsIndexList[order] = i - drawableCount;
+            _sortedObjectsTypeList[order] = DrawableObjectType_Offscreen;
+        }
+    }
+
+    // 描画
+    for (csmInt32 i = 0; i < totalCount; ++i)
+    {
+        const csmInt32 objectIndex = _sortedObjectsIndexList[i];
+        const csmInt32 objectType = _sortedObjectsTypeList[i];
+
+        RenderObject(objectIndex, objectType);
+    }
+
+    while (_currentOffscreen != NULL)
+    {
+        // オフスクリーンが残っている場合は親オフスクリーンへの伝搬を行う
+        SubmitDrawToParentOffscreen(_currentOffscreen->GetOffscreenIndex(), DrawableObjectType_Offscreen);
+    }
+
+    // コピー用に借りていたレンダーターゲットを返却する
+    if (_blendCopyRenderTarget != NULL)
+    {
+        CubismOffscreenManager_Null::GetInstance()->StopUsingRenderTexture(_blendCopyRenderTarget);
+        _blendCopyRenderTarget = NULL;
+    }
+}
+
+void CubismRenderer_Null::RenderObject(const csmInt32 objectIndex, const csmInt32 objectType)
+{
+    switch (objectType)
+    {
+    case DrawableObjectType_Drawable:
+        // Drawable
+        DrawDrawable(objectIndex);
+        break;
+    case DrawableObjectType_Offscreen:
+        // Offscreen
+        AddOffscreen(objectIndex);
+        break;
+    default:
+        // 不明なタイプはエラーログを出す
+        CubismLogError("Unknown drawable type: %d", objectType);
+        break;
+    }
+}
+
+void CubismRenderer_Null::DrawDrawable(csmInt32 drawableIndex)
+{
+    // Drawableが表示状態でなければ処理をパスする
+    if (!GetModel()->GetDrawableDynamicFlagIsVisible(drawableIndex))
+    {
+        return;
+    }
+
+    SubmitDrawToParentOffscreen(drawableIndex, DrawableObjectType_Drawable);
+
+    // クリッピングマスク
+    CubismClippingContext_Null* clipContext = (_drawableClippingManager != NULL) ?
+        (*_drawableClippingManager->GetClippingContextListForDraw())[drawableIndex] :
+        NULL;
+
+    if (clipContext != NULL && IsUsingHighPrecisionMask()) // マスクを書く必要がある
+    {
+        DrawHighPrecisionMask(clipContext, GetDrawableMaskBuffer(clipContext->_bufferIndex));
+    }
+
+    // クリッピングマスクをセットする
+    SetClippingContextBufferForDrawable(clipContext);
+
+    IsCulling(GetModel()->GetDrawableCulling(drawableIndex) != 0);
+
+    DrawMeshNull(*GetModel(), drawableIndex);
+}
+
+void CubismRenderer_Null::SubmitDrawToParentOffscreen(const csmInt32 objectIndex, const DrawableObjectType objectType)
+{
+    if (_currentOffscreen == NULL ||
+        objectIndex == CubismModel::CubismNoIndex_Offscreen)
+    {
+        return;
+    }
+
+    csmInt32 currentOwnerIndex = GetModel()->GetOffscreenOwnerIndices()[_currentOffscreen->GetOffscreenIndex()];
+
+    // オーナーが不明な場合は処理を終了
+    if (currentOwnerIndex == CubismModel::CubismNoIndex_Offscreen)
+    {
+        return;
+    }
+
+    csmInt32 targetParentIndex = CubismModel::CubismNoIndex_Parent;
+    // 描画オブジェクトのタイプ別に親パーツのインデックスを取得
+    switch (objectType)
+    {
+    case DrawableObjectType_Drawable:
+        targetParentIndex = GetModel()->GetDrawableParentPartIndex(objectIndex);
+        break;
+    case DrawableObjectType_Offscreen:
+        targetParentIndex = GetModel()->GetPartParentPartIndex(GetModel()->GetOffscreenOwnerIndices()[objectIndex]);
+        break;
+    default:
+        // 不明なタイプだった場合は処理を終了
+        return;
+    }
+
+    // 階層を辿って現在のオフスクリーンのオーナーのパーツがいたら処理を終了する。
+    while (targetParentIndex != CubismModel::CubismNoIndex_Parent)
+    {
+        // オブジェクトの親が現在のオーナーと同じ場合は処理を終了
+        if (targetParentIndex == currentOwnerIndex)
+        {
+            return;
+        }
+
+        targetParentIndex = GetModel()->GetPartParentPartIndex(targetParentIndex);
+    }
+
+    /**
+     * 呼び出し元の描画オブジェクトは現オフスクリーンの描画対象でない。
+     * つまり描画順グループの仕様により、現オフスクリーンの描画対象は全て描画完了しているので
+     * 現オフスクリーンを描画する。
+     */
+    DrawOffscreen(_currentOffscreen);
+
+    // さらに親のオフスクリーンに伝搬可能なら伝搬する。
+    SubmitDrawToParentOffscreen(objectIndex, objectType);
+}
+
+void CubismRenderer_Null::AddOffscreen(csmInt32 offscreenIndex)
+{
+    // 以前のオフスクリーンレンダリングターゲットを親に伝搬する処理を追加する
+    if (_currentOffscreen != NULL && _currentOffscreen->GetOffscreenIndex() != offscreenIndex)
+    {
+        csmBool isParent = false;
+        csmInt32 ownerIndex = GetModel()->GetOffscreenOwnerIndices()[offscreenIndex];
+        csmInt32 parentIndex = GetModel()->GetPartParentPartIndex(ownerIndex);
+
+        csmInt32 currentOffscreenIndex = _currentOffscreen->GetOffscreenIndex();
+        csmInt32 currentOffscreenOwnerIndex = GetModel()->GetOffscreenOwnerIndices()[currentOffscreenIndex];
+        while (parentIndex != CubismModel::CubismNoIndex_Parent)
+        {
+            if (parentIndex == currentOffscreenOwnerIndex)
+            {
+                isParent = true;
+                break;
+            }
+            parentIndex = GetModel()->GetPartParentPartIndex(parentIndex);
+        }
+
+        if (!isParent)
+        {
+            // 現在のオフスクリーンレンダリングターゲットがあるなら、親に伝搬する
+            SubmitDrawToParentOffscreen(offscreenIndex, DrawableObjectType_Offscreen);
+        }
+    }
+
+    CubismOffscreenRenderTarget_Null* offscreen = &_offscreenList.At(offscreenIndex);
+
+    // 子孫Drawableを囲む範囲だけのレンダーターゲットを確保する
+    UpdateOffscreenDrawRect(offscreen);
+
+    // 以前のオフスクリーンレンダリングターゲットを取得
+    CubismOffscreenRenderTarget_Null* oldOffscreen = offscreen->GetParentPartOffscreen();
+
+    offscreen->SetOldOffscreen(oldOffscreen);
+
+    csmInt32 oldRenderTargetId = 0;
+    if (oldOffscreen != NULL)
+    {
+        oldRenderTargetId = oldOffscreen->GetRenderTarget()->GetRenderTargetId();
+    }
+
+    if (oldRenderTargetId == 0)
+    {
+        oldRenderTargetId = _modelRootRenderTargetId; // ルートの描画先を使用する
+    }
+
+    // 別バッファに描画を開始
+    offscreen->GetRenderTarget()->BeginDraw(_commandBuffer, oldRenderTargetId);
+    offscreen->GetRenderTarget()->Clear(_commandBuffer, 0.0f, 0.0f, 0.0f, 0.0f);
+
+    // 現在のオフスクリーンレンダリングターゲットを設定
+    _currentOffscreen = offscreen;
+    _currentRenderTargetId = offscreen->GetRenderTarget()->GetRenderTargetId();
+}
+
+void CubismRenderer_Null::UpdateOffscreenDrawRect(CubismOffscreenRenderTarget_Null* offscreen)
+{
+    const csmInt32 canvasWidth = static_cast<csmInt32>(_modelRenderTargetWidth);
+    const csmInt32 canvasHeight = static_cast<csmInt32>(_modelRenderTargetHeight);
+    const csmInt32 offscreenIndex = offscreen->GetOffscreenIndex();
+    CubismMatrix44 mvp = GetMvpMatrix();
+    const csmFloat32* m = mvp.GetArray();
+
+    // 表示中の子孫Drawableの頂点をモデル描画先のピクセル座標に変換して範囲を求める
+    csmFloat32 minX = FLT_MAX, minY = FLT_MAX;
+    csmFloat32 maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (csmInt32 i = _offscreenChildDrawableOffsets[offscreenIndex]; i < _offscreenChildDrawableOffsets[offscreenIndex + 1]; ++i)
+    {
+        const csmInt32 drawableIndex = _offscreenChildDrawableIndices[i];
+        if (!GetModel()->GetDrawableDynamicFlagIsVisible(drawableIndex))
+        {
+            continue;
+        }
+
+        const csmInt32 vertexCount = GetModel()->GetDrawableVertexCount(drawableIndex);
+        const csmFloat32* vertices = GetModel()->GetDrawableVertices(drawableIndex);
+        const csmInt32 loop = vertexCount * Constant::VertexStep;
+        for (csmInt32 pi = Constant::VertexOffset; pi < loop; pi += Constant::VertexStep)
+        {
+            const csmFloat32 x = vertices[pi];
+            const csmFloat32 y = vertices[pi + 1];
+            csmFloat32 w = m[3] * x + m[7] * y + m[15];
+            if (w == 0.0f)
+            {
+                w = 1.0f;
+            }
+            const csmFloat32 pixelX = ((m[0] * x + m[4] * y + m[12]) / w * 0.5f + 0.5f) * canvasWidth;
+            const csmFloat32 pixelY = ((m[1] * x + m[5] * y + m[13]) / w * 0.5f + 0.5f) * canvasHeight;
+
+            minX = (pixelX < minX) ? pixelX : minX;
+            minY = (pixelY < minY) ? pixelY : minY;
+            maxX = (pixelX > maxX) ? pixelX : maxX;
+            maxY = (pixelY > maxY) ? pixelY : maxY;
+        }
+    }
+
+    csmInt32 left = 0;
+    csmInt32 bottom = 0;
+    csmInt32 right = 0;
+    csmInt32 top = 0;
+    if (minX <= maxX && minY <= maxY)
+    {
+        // 外側に丸めた上で1ピクセルの余白を取り、モデル描画先の範囲に収める
+        left = static_cast<csmInt32>(CubismMath::Max(floorf(minX) - 1.0f, 0.0f));
+        bottom = static_cast<csmInt32>(CubismMath::Max(floorf(minY) - 1.0f, 0.0f));
+        right = static_cast<csmInt32>(CubismMath::Min(ceilf(maxX) + 1.0f, static_cast<csmFloat32>(canvasWidth)));
+        top = static_cast<csmInt32>(CubismMath::Min(ceilf(maxY) + 1.0f, static_cast<csmFloat32>(canvasHeight)));
+    }
+
+    // 描画範囲が毎フレーム僅かに変化してもレンダーターゲットを再利用できるよう、幅・高さをプールの単位に切り上げる
+    // モデル描画先を超える場合はその軸全体を使用する
+    const CubismOffscreenManager_Null* offscreenManager = CubismOffscreenManager_Null::GetInstance();
+    csmInt32 width = static_cast<csmInt32>(offscreenManager->GetBucketedSize((right - left > 1) ? right - left : 1));
+    csmInt32 height = static_cast<csmInt32>(offscreenManager->GetBucketedSize((top - bottom > 1) ? top - bottom : 1));
+    if (width >= canvasWidth)
+    {
+        left = 0;
+        width = canvasWidth;
+    }
+    else if (left + width > canvasWidth)
+    {
+        left = canvasWidth - width;
+    }
+    if (height >= canvasHeight)
+    {
+        bottom = 0;
+        height = canvasHeight;
+    }
+    else if (bottom + height > canvasHeight)
+    {
+        bottom = canvasHeight - height;
+    }
+
+    offscreen->SetDrawRect(left, bottom, width, height, _modelRenderTargetWidth, _modelRenderTargetHeight);
+}
+
+void CubismRenderer_Null::DrawOffscreen(CubismOffscreenRenderTarget_Null* currentOffscreen)
+{
+    csmInt32 offscreenIndex = currentOffscreen->GetOffscreenIndex();
+    // クリッピングマスク
+    CubismClippingContext_Null* clipContext = (_offscreenClippingManager != NULL) ?
+        (*_offscreenClippingManager->GetClippingContextListForOffscreen())[offscreenIndex] :
+        NULL;
+
+    if (clipContext != NULL && IsUsingHighPrecisionMask()) // マスクを書く必要がある
+    {
+        DrawHighPrecisionMask(clipContext, GetOffscreenMaskBuffer(clipContext->_bufferIndex));
+    }
+
+    // クリッピングマスクをセットする
+    SetClippingContextBufferForOffscreen(clipContext);
+
+    IsCulling(GetModel()->GetOffscreenCulling(offscreenIndex) != 0);
+
+    DrawOffscreenNull(*GetModel(), currentOffscreen);
+}
+
+void CubismRenderer_Null::DrawHighPrecisionMask(CubismClippingContext_Null* clipContext, CubismRenderTarget_Null* maskBuffer)
+{
+    if (clipContext->_isUsing) // 書くことになっていた
+    {
+        // ---------- マスク描画処理 ----------
+        // マスク用RenderTextureをactiveにセット
+        maskBuffer->BeginDraw(_commandBuffer, _currentRenderTargetId);
+
+        // マスクをクリアする
+        // 1が無効（描かれない）領域、0が有効（描かれる）領域
+        maskBuffer->Clear(_commandBuffer, 1.0f, 1.0f, 1.0f, 1.0f);
+    }
+
+    const csmInt32 clipDrawCount = clipContext->_clippingIdCount;
+    for (csmInt32 index = 0; index < clipDrawCount; ++index)
+    {
+        const csmInt32 clipDrawIndex = clipContext->_clippingIdList[index];
+
+        // 頂点情報が更新されておらず、信頼性がない場合は描画をパスする
+        if (!GetModel()->GetDrawableDynamicFlagVertexPositionsDidChange(clipDrawIndex))
+        {
+            continue;
+        }
+
+        IsCulling(GetModel()->GetDrawableCulling(clipDrawIndex) != 0);
+
+        // 今回専用の変換を適用して描く
+        // チャンネルも切り替える必要がある(A,R,G,B)
+        SetClippingContextBufferForMask(clipContext);
+
+        DrawMeshNull(*GetModel(), clipDrawIndex);
+    }
+
+    // --- 後処理 ---
+    if (clipContext->_isUsing)
+    {
+        maskBuffer->EndDraw(_commandBuffer);
+    }
+    SetClippingContextBufferForMask(NULL);
+}
+
+void CubismRenderer_Null::DrawMeshNull(const CubismModel& model, const csmInt32 index)
+{
+    // 裏面描画の有効・無効
+    _commandBuffer.SetCulling(IsCulling());
+
+    const csmUint32 textureId = _textures[model.GetDrawableTextureIndex(index)];
+    const csmInt32 indexCount = model.GetDrawableVertexIndexCount(index);
+
+    if (IsGeneratingMask())  // マスク生成時
+    {
+        CubismClippingContext_Null* clipContext = GetClippingContextBufferForMask();
+        _commandBuffer.SetBlendState(CubismCommandBuffer_Null::BlendState_Mask, 0, 0);
+        _commandBuffer.DrawMask(index, indexCount, textureId, clipContext->_layoutChannelIndex, clipContext->_bufferIndex);
+    }
+    else
+    {
+        // オフスクリーンに描画中であれば、その内容をブレンドの合成先とする
+        SetupBlendState(model.GetDrawableBlendModeType(index), (_currentOffscreen != NULL) ? _currentOffscreen->GetRenderTarget() : NULL);
+
+        CubismClippingContext_Null* clipContext = GetClippingContextBufferForDrawable();
+        csmInt32 drawFlags = IsPremultipliedAlpha() ? CubismCommandBuffer_Null::DrawFlag_PremultipliedAlpha : 0;
+        csmInt32 channelIndex = 0;
+        csmInt32 bufferIndex = 0;
+        if (clipContext != NULL)
+        {
+            drawFlags |= CubismCommandBuffer_Null::DrawFlag_Masked;
+            drawFlags |= model.GetDrawableInvertedMask(index) ? CubismCommandBuffer_Null::DrawFlag_InvertedMask : 0;
+            channelIndex = clipContext->_layoutChannelIndex;
+            bufferIndex = clipContext->_bufferIndex;
+        }
+        _commandBuffer.DrawMesh(index, indexCount, textureId, drawFlags, channelIndex, bufferIndex);
+    }
+
+    // 後処理
+    SetClippingContextBufferForDrawable(NULL);
+    SetClippingContextBufferForMask(NULL);
+}
+
+void CubismRenderer_Null::DrawOffscreenNull(const CubismModel& model, CubismOffscreenRenderTarget_Null* offscreen)
+{
+    CSM_PROFILE_ZONE(Zone_OffscreenComposite, &model);
+
+    // 裏面描画の有効・無効
+    _commandBuffer.SetCulling(IsCulling());
+
+    const csmInt32 offscreenIndex = offscreen->GetOffscreenIndex();
+    const csmInt32 srcRenderTargetId = offscreen->GetRenderTarget()->GetRenderTargetId();
+
+    offscreen->GetRenderTarget()->EndDraw(_commandBuffer);
+    _currentOffscreen = _currentOffscreen->GetOldOffscreen();
+    _currentRenderTargetId = offscreen->GetRenderTarget()->GetOldRenderTargetId();
+
+    SetupBlendState(model.GetOffscreenBlendModeType(offscreenIndex), (offscreen->GetOldOffscreen() != NULL) ? offscreen->GetOldOffscreen()->GetRenderTarget() : NULL);
+
+    // オフスクリーンはPremultipliedAlphaを利用する
+    CubismClippingContext_Null* clipContext = GetClippingContextBufferForOffscreen();
+    csmInt32 drawFlags = CubismCommandBuffer_Null::DrawFlag_PremultipliedAlpha;
+    csmInt32 channelIndex = 0;
+    csmInt32 bufferIndex = 0;
+    if (clipContext != NULL)
+    {
+        drawFlags |= CubismCommandBuffer_Null::DrawFlag_Masked;
+        drawFlags |= model.GetOffscreenInvertedMask(offscreenIndex) ? CubismCommandBuffer_Null::DrawFlag_InvertedMask : 0;
+        channelIndex = clipContext->_layoutChannelIndex;
+        bufferIndex = clipContext->_bufferIndex;
+    }
+    _commandBuffer.DrawOffscreen(offscreenIndex, srcRenderTargetId, _currentRenderTargetId, drawFlags, channelIndex, bufferIndex);
+
+    // 後処理
+    offscreen->StopUsingRenderTexture();
+    SetClippingContextBufferForOffscreen(NULL);
+    SetClippingContextBufferForMask(NULL);
+}
+
+void CubismRenderer_Null::SetupBlendState(const csmBlendMode& blendMode, const CubismRenderTarget_Null* dstBuffer)
+{
+    const csmInt32 colorBlendType = blendMode.GetColorBlendType();
+    const csmInt32 alphaBlendType = blendMode.GetAlphaBlendType();
+
+    switch (colorBlendType)
+    {
+    case Core::csmColorBlendType_Normal:
+        // Normal Over　のときは5.2以前の描画方法を利用する
+        if (alphaBlendType == Core::csmAlphaBlendType_Over)
+        {
+            _commandBuffer.SetBlendState(CubismCommandBuffer_Null::BlendState_Normal, colorBlendType, alphaBlendType);
+            return;
+        }
+        break;
+    case Core::csmColorBlendType_AddCompatible:
+        // AddCompatible は5.2以前の描画方法を利用する
+        _commandBuffer.SetBlendState(CubismCommandBuffer_Null::BlendState_Add, colorBlendType, alphaBlendType);
+        return;
+    case Core::csmColorBlendType_MultiplyCompatible:
+        // MultCompatible は5.2以前の描画方法を利用する
+        _commandBuffer.SetBlendState(CubismCommandBuffer_Null::BlendState_Multiply, colorBlendType, alphaBlendType);
+        return;
+    default:
+        break;
+    }
+
+    // 5.3以降
+    // 合成先の内容をコピーしてシェーダで合成する
+    if (dstBuffer != NULL)
+    {
+        CopyRenderTarget(*dstBuffer);
+    }
+    else if (_modelRenderTargets.GetSize() > 0)
+    {
+        CopyOffscreenRenderTarget();
+    }
+    _commandBuffer.SetBlendState(CubismCommandBuffer_Null::BlendState_Advanced, colorBlendType, alphaBlendType);
+}
+
+void CubismRenderer_Null::SaveProfile()
+{
+}
+
+void CubismRenderer_Null::RestoreProfile()
+{
+}
+
+void CubismRenderer_Null::BeforeDrawModelRenderTarget()
+{
+    if (_modelRenderTargets.GetSize() == 0)
+    {
+        return;
+    }
+
+    // オフスクリーンのバッファのサイズが違う場合は作り直し
+    for (csmUint32 i = 0; i < _modelRenderTargets.GetSize(); ++i)
+    {
+        if (_modelRenderTargets[i].GetBufferWidth() != _modelRenderTargetWidth || _modelRenderTargets[i].GetBufferHeight() != _modelRenderTargetHeight)
+        {
+            _modelRenderTargets[i].CreateRenderTarget(_modelRenderTargetWidth, _modelRenderTargetHeight);
+        }
+    }
+
+    // 別バッファに描画を開始
+    _modelRenderTargets[0].BeginDraw(_commandBuffer, _currentRenderTargetId);
+    _modelRenderTargets[0].Clear(_commandBuffer, 0.0f, 0.0f, 0.0f, 0.0f);
+    _currentRenderTargetId = _modelRenderTargets[0].GetRenderTargetId();
+}
+
+void CubismRenderer_Null::AfterDrawModelRenderTarget()
+{
+    if (_modelRenderTargets.GetSize() == 0)
+    {
+        return;
+    }
+
+    // 元のバッファに描画する
+    _modelRenderTargets[0].EndDraw(_commandBuffer);
+    _currentRenderTargetId = _modelRenderTargets[0].GetOldRenderTargetId();
+
+    // この時点の内容はPMAになっているため、通常の合成で描画先に重ねる
+    const CubismRenderTarget_Null* srcBuffer = CopyOffscreenRenderTarget();
+    _commandBuffer.SetBlendState(CubismCommandBuffer_Null::BlendState_Normal, Core::csmColorBlendType_Normal, Core::csmAlphaBlendType_Over);
+    _commandBuffer.DrawOffscreen(CubismModel::CubismNoIndex_Offscreen, srcBuffer->GetRenderTargetId(), _currentRenderTargetId, CubismCommandBuffer_Null::DrawFlag_PremultipliedAlpha, 0, 0);
+}
+
+void CubismRenderer_Null::BindTexture(csmUint32 modelTextureIndex, csmUint32 textureId)
+{
+    _textures[modelTextureIndex] = textureId;
+}
+
+const csmMap<csmInt32, csmUint32>& CubismRenderer_Null::GetBindedTextures() const
+{
+    return _textures;
+}
+
+void CubismRenderer_Null::SetDrawableClippingMaskBufferSize(csmFloat32 width, csmFloat32 height)
+{
+    if (_drawableClippingManager == NULL)
+    {
+        return;
+    }
+
+    // インスタンス破棄前にレンダーテクスチャの数を保存
+    const csmInt32 renderTextureCount = _drawableClippingManager->GetRenderTextureCount();
+
+    // RenderTargetのサイズを変更するためにインスタンスを破棄・再作成する
+    CSM_DELETE_SELF(CubismClippingManager_Null, _drawableClippingManager);
+
+    _drawableClippingManager = CSM_NEW CubismClippingManager_Null();
+
+    _drawableClippingManager->SetClippingMaskBufferSize(width, height);
+
+    _drawableClippingManager->Initialize(
+        *GetModel(),
+        renderTextureCount,
+        CubismRenderer::DrawableObjectType_Drawable
+    );
+}
+
+void CubismRenderer_Null::SetOffscreenClippingMaskBufferSize(csmFloat32 width, csmFloat32 height)
+{
+    if (_offscreenClippingManager == NULL)
+    {
+        return;
+    }
+
+    // インスタンス破棄前にレンダーテクスチャの数を保存
+    const csmInt32 renderTextureCount = _offscreenClippingManager->GetRenderTextureCount();
+
+    // RenderTargetのサイズを変更するためにインスタンスを破棄・再作成する
+    CSM_DELETE_SELF(CubismClippingManager_Null, _offscreenClippingManager);
+
+    _offscreenClippingManager = CSM_NEW CubismClippingManager_Null();
+
+    _offscreenClippingManager->SetClippingMaskBufferSize(width, height);
+
+    _offscreenClippingManager->Initialize(
+        *GetModel(),
+        renderTextureCount,
+        CubismRenderer::DrawableObjectType_Offscreen
+    );
+}
+
+csmInt32 CubismRenderer_Null::GetDrawableRenderTextureCount() const
+{
+    return _drawableClippingManager->GetRenderTextureCount();
+}
+
+csmInt32 CubismRenderer_Null::GetOffscreenRenderTextureCount() const
+{
+    return _offscreenClippingManager->GetRenderTextureCount();
+}
+
+CubismVector2 CubismRenderer_Null::GetDrawableClippingMaskBufferSize() const
+{
+    return _drawableClippingManager->GetClippingMaskBufferSize();
+}
+
+CubismVector2 CubismRenderer_Null::GetOffscreenClippingMaskBufferSize() const
+{
+    return _offscreenClippingManager->GetClippingMaskBufferSize();
+}
+
+const CubismRenderTarget_Null* CubismRenderer_Null::CopyOffscreenRenderTarget()
+{
+    return CopyRenderTarget(_modelRenderTargets[0]);
+}
+
+const CubismRenderTarget_Null* CubismRenderer_Null::CopyRenderTarget(const CubismRenderTarget_Null& srcBuffer)
+{
+    // テクスチャバリアに相当する同期はないため、常にコピーを記録する
+    // オフスクリーンは描画範囲に合わせたサイズのため、同じサイズのコピー先を借りて等倍でコピーする
+    CubismRenderTarget_Null* dstBuffer = &_modelRenderTargets[1];
+    if (srcBuffer.GetBufferWidth() != dstBuffer->GetBufferWidth() || srcBuffer.GetBufferHeight() != dstBuffer->GetBufferHeight())
+    {
+        if (_blendCopyRenderTarget != NULL &&
+            (_blendCopyRenderTarget->GetBufferWidth() != srcBuffer.GetBufferWidth() || _blendCopyRenderTarget->GetBufferHeight() != srcBuffer.GetBufferHeight()))
+        {
+            CubismOffscreenManager_Null::GetInstance()->StopUsingRenderTexture(_blendCopyRenderTarget);
+            _blendCopyRenderTarget = NULL;
+        }
+
+        if (_blendCopyRenderTarget == NULL)
+        {
+            _blendCopyRenderTarget = CubismOffscreenManager_Null::GetInstance()->GetOffscreenRenderTarget(srcBuffer.GetBufferWidth(), srcBuffer.GetBufferHeight());
+        }
+
+        dstBuffer = _blendCopyRenderTarget;
+    }
+
+    CubismRenderTarget_Null::CopyBuffer(_commandBuffer, srcBuffer, *dstBuffer);
+
+    return dstBuffer;
+}
+
+CubismRenderTarget_Null* CubismRenderer_Null::GetDrawableMaskBuffer(csmInt32 index)
+{
+    return &_drawableMasks[index];
+}
+
+CubismRenderTarget_Null* CubismRenderer_Null::GetOffscreenMaskBuffer(csmInt32 index)
+{
+    return &_offscreenMasks[index];
+}
+
+CubismOffscreenRenderTarget_Null* CubismRenderer_Null::GetCurrentOffscreen() const
+{
+    return _currentOffscreen;
+}
+
+const CubismCommandBuffer_Null& CubismRenderer_Null::GetCommandBuffer() const
+{
+    return _commandBuffer;
+}
+
+void CubismRenderer_Null::SetClippingContextBufferForMask(CubismClippingContext_Null* clip)
+{
+    _clippingContextBufferForMask = clip;
+}
+
+CubismClippingContext_Null* CubismRenderer_Null::GetClippingContextBufferForMask() const
+{
+    return _clippingContextBufferForMask;
+}
+
+void CubismRenderer_Null::SetClippingContextBufferForDrawable(CubismClippingContext_Null* clip)
+{
+    _clippingContextBufferForDrawable = clip;
+}
+
+CubismClippingContext_Null* CubismRenderer_Null::GetClippingContextBufferForDrawable() const
+{
+    return _clippingContextBufferForDrawable;
+}
+
+void CubismRenderer_Null::SetClippingContextBufferForOffscreen(CubismClippingContext_Null* clip)
+{
+    _clippingContextBufferForOffscreen = clip;
+}
+
+CubismClippingContext_Null* CubismRenderer_Null::GetClippingContextBufferForOffscreen() const
+{
+    return _clippingContextBufferForOffscreen;
+}
+
+const csmBool inline CubismRenderer_Null::IsGeneratingMask() const
+{
+    return (GetClippingContextBufferForMask() != NULL);
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
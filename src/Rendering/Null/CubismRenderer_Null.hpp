@@ -0,0 +1,442 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "../CubismRenderer.hpp"
+#include "../CubismClippingManager.hpp"
+#include "CubismFramework.hpp"
+#include "CubismCommandBuffer_Null.hpp"
+#include "CubismRenderTarget_Null.hpp"
+#include "CubismOffscreenRenderTarget_Null.hpp"
+#include "Type/csmVector.hpp"
+#include "Type/csmRectF.hpp"
+#include "Math/CubismVector2.hpp"
+#include "Type/csmMap.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+//  前方宣言
+class CubismRenderer_Null;
+class CubismClippingContext_Null;
+
+/**
+ * @brief  クリッピングマスクの処理を実行するクラス
+ *
+ */
+class CubismClippingManager_Null : public CubismClippingManager<CubismClippingContext_Null, CubismRenderTarget_Null>
+{
+public:
+
+    /**
+     * @brief   クリッピングコンテキストを作成する。モデル描画時に実行する。
+     *
+     * @param[in]   model              ->  モデルのインスタンス
+     * @param[in]   renderer           ->  レンダラのインスタンス
+     * @param[in]   lastRenderTargetId ->  マスク描画後に戻す描画先の識別子
+     * @param[in]   drawableObjectType ->  描画オブジェクトのタイプ
+     */
+    void SetupClippingContext(CubismModel& model, CubismRenderer_Null* renderer, csmInt32 lastRenderTargetId, CubismRenderer::DrawableObjectType drawableObjectType);
+};
+
+/**
+ * @brief   クリッピングマスクのコンテキスト
+ */
+class CubismClippingContext_Null : public CubismClippingContext
+{
+    friend class CubismClippingManager_Null;
+    friend class CubismRenderer_Null;
+
+public:
+    /**
+     * @brief   引数付きコンストラクタ
+     *
+     * @param[in]   manager                  ->  マスクを管理しているマネージャのインスタンス
+     * @param[in]   model                    ->  モデルのインスタンス
+     * @param[in]   clippingDrawableIndices  ->  クリップしているDrawableのインデックスリスト
+     * @param[in]   clipCount                ->  クリップしているDrawableの個数
+     */
+    CubismClippingContext_Null(CubismClippingManager<CubismClippingContext_Null, CubismRenderTarget_Null>* manager, CubismModel& model, const csmInt32* clippingDrawableIndices, csmInt32 clipCount);
+
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~CubismClippingContext_Null();
+
+    /**
+     * @brief   このマスクを管理するマネージャのインスタンスを取得する。
+     *
+     * @return  クリッピングマネージャのインスタンス
+     */
+    CubismClippingManager<CubismClippingContext_Null, CubismRenderTarget_Null>* GetClippingManager();
+
+    CubismClippingManager<CubismClippingContext_Null, CubismRenderTarget_Null>* _owner;        ///< このマスクを管理しているマネージャのインスタンス
+};
+
+/**
+ * @brief   グラフィックスAPIを呼ばずに描画命令をコマンド列として記録するレンダラ<br>
+ *          クリッピングマスクの生成、オフスクリーンの伝搬、描画順のソート、ブレンドの選択は他のレンダラと同じ処理を行い、<br>
+ *          GPUのないCI環境でのベンチマークや、描画結果のコミット間の比較に使用する。
+ */
+class CubismRenderer_Null : public CubismRenderer
+{
+    friend class CubismRenderer;
+    friend class CubismClippingManager_Null;
+
+public:
+    /**
+     * @brief    レンダラの初期化処理を実行する
+     *           引数に渡したモデルからレンダラの初期化処理に必要な情報を取り出すことができる
+     *
+     * @param[in]  model -> モデルのインスタンス
+     */
+    void Initialize(Framework::CubismModel* model) override;
+
+    /**
+     * @brief   レンダラの初期化処理を実行する
+     *           引数に渡したモデルからレンダラの初期化処理に必要な情報を取り出すことができる
+     *
+     * @param[in]  model           -> モデルのインスタンス
+     * @param[in]  maskBufferCount -> マスクの分割数
+     */
+    void Initialize(Framework::CubismModel* model, csmInt32 maskBufferCount) override;
+
+    /**
+     * @bref オフスクリーンの親を探して設定する
+     *
+     * @param model -> モデルのインスタンス
+     * @param offscreenCount -> オフスクリーンの数
+     */
+    void SetupParentOffscreens(const CubismModel* model, csmInt32 offscreenCount);
+
+    /**
+     * @brief   オフスクリーンごとに、描画対象となる子孫Drawableのインデックスを収集する。<br>
+     *           オフスクリーンの描画範囲の計算に使用する。
+     *
+     * @param[in]   model           ->  モデルのインスタンス
+     * @param[in]   offscreenCount  ->  オフスクリーンの数
+     */
+    void SetupOffscreenChildDrawables(const CubismModel* model, csmInt32 offscreenCount);
+
+    /**
+     * @brief   テクスチャのバインド処理<br>
+     *          記録されるコマンドには、ここで設定したテクスチャの番号がそのまま記録される
+     *
+     * @param[in]   modelTextureIndex  ->  セットするモデルテクスチャの番号
+     * @param[in]   textureId          ->  コマンドに記録するテクスチャの番号
+     */
+    void BindTexture(csmUint32 modelTextureIndex, csmUint32 textureId);
+
+    /**
+     * @brief   バインドされたテクスチャのリストを取得する
+     *
+     * @return  テクスチャのリスト
+     */
+    const csmMap<csmInt32, csmUint32>& GetBindedTextures() const;
+
+    /**
+     * @brief  クリッピングマスクバッファのサイズを設定する
+     *
+     * @param[in]  width  -> クリッピングマスクバッファの幅
+     * @param[in]  height -> クリッピングマスクバッファの高さ
+     */
+    void SetDrawableClippingMaskBufferSize(csmFloat32 width, csmFloat32 height);
+
+    /**
+     * @brief  オフスクリーン用クリッピングマスクバッファのサイズを設定する
+     *
+     * @param[in]  width  -> クリッピングマスクバッファの幅
+     * @param[in]  height -> クリッピングマスクバッファの高さ
+     */
+    void SetOffscreenClippingMaskBufferSize(csmFloat32 width, csmFloat32 height);
+
+    /**
+     * @brief  描画オブジェクトのレンダーテクスチャの枚数を取得する。
+     *
+     * @return  描画オブジェクトのレンダーテクスチャの枚数
+     */
+    csmInt32 GetDrawableRenderTextureCount() const;
+
+    /**
+     * @brief  オフスクリーンのレンダーテクスチャの枚数を取得する。
+     *
+     * @return  オフスクリーンのレンダーテクスチャの枚数
+     */
+    csmInt32 GetOffscreenRenderTextureCount() const;
+
+    /**
+     * @brief  描画オブジェクトのクリッピングマスクバッファのサイズを取得する
+     *
+     * @return 描画オブジェクトのクリッピングマスクバッファのサイズ
+     */
+    CubismVector2 GetDrawableClippingMaskBufferSize() const;
+
+    /**
+     * @brief  オフスクリーンのクリッピングマスクバッファのサイズを取得する
+     *
+     * @return オフスクリーンのクリッピングマスクバッファのサイズ
+     */
+    CubismVector2 GetOffscreenClippingMaskBufferSize() const;
+
+    /**
+     * @brief  オフスクリーンのバッファをコピーする
+     *
+     * @return オフスクリーンのバッファへのポインタ
+     */
+    const CubismRenderTarget_Null* CopyOffscreenRenderTarget();
+
+    /**
+     * @brief  任意のバッファをコピーする
+     *
+     * @param srcBuffer コピー元のバッファ
+     *
+     * @return コピー後のバッファへのポインタ
+     */
+    const CubismRenderTarget_Null* CopyRenderTarget(const CubismRenderTarget_Null& srcBuffer);
+
+    /**
+     * @brief  描画オブジェクトのクリッピングマスクのバッファを取得する
+     *
+     * @return 描画オブジェクトのクリッピングマスクのバッファへのポインタ
+     */
+    CubismRenderTarget_Null* GetDrawableMaskBuffer(csmInt32 index);
+
+    /**
+     * @brief  オフスクリーンのクリッピングマスクのバッファを取得する
+     *
+     * @return オフスクリーンのクリッピングマスクのバッファへのポインタ
+     */
+    CubismRenderTarget_Null* GetOffscreenMaskBuffer(csmInt32 index);
+
+    /**
+     * @brief  現在のオフスクリーンのフレームバッファを取得する
+     *
+     * @return 現在のオフスクリーンのフレームバッファを返す
+     */
+    CubismOffscreenRenderTarget_Null* GetCurrentOffscreen() const;
+
+    /**
+     * @brief  直前のDrawModelで記録されたコマンド列を取得する
+     *
+     * @return コマンド列
+     */
+    const CubismCommandBuffer_Null& GetCommandBuffer() const;
+
+protected:
+    /**
+     * @brief   コンストラクタ
+     *
+     * @param[in] width -> モデルを描画したバッファの幅
+     * @param[in] height -> モデルを描画したバッファの高さ
+     */
+    CubismRenderer_Null(csmUint32 width, csmUint32 height);
+
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~CubismRenderer_Null();
+
+    /**
+     * @brief   モデルを描画する実際の処理
+     *
+     */
+    virtual void DoDrawModel() override;
+
+    /**
+     * @brief   描画オブジェクト（アートメッシュ、オフスクリーン）を描画するループ処理
+     *
+     * @param[in]   lastRenderTargetId ->  モデル描画直前の描画先の識別子
+     */
+    void DrawObjectLoop(csmInt32 lastRenderTargetId);
+
+    /**
+     * @brief 各オブジェクトの描画処理を呼ぶ。
+     *
+     * @param[in]   objectIndex  ->  描画対象のオブジェクトのインデックス
+     * @param[in]   objectType  ->  描画対象のオブジェクトのタイプ
+     */
+    void RenderObject(csmInt32 objectIndex, csmInt32 objectType);
+
+    /**
+     * @brief   描画オブジェクト（アートメッシュ）を描画する。
+     *
+     * @param[in]   drawableIndex ->  描画対象のメッシュのインデックス
+     */
+    void DrawDrawable(csmInt32 drawableIndex);
+
+    /**
+     * @brief   親オフスクリーンへオフスクリーンの描画結果の伝搬を試みる。
+     *
+     * @param[in] objectIndex 処理をするオブジェクトのインデックス
+     * @param objectType 処理をするオブジェクトのタイプ
+     */
+    void SubmitDrawToParentOffscreen(csmInt32 objectIndex, DrawableObjectType objectType);
+
+    /**
+     * @brief   描画オブジェクト（オフスクリーン）を追加する。
+     *
+     * @param[in]   offscreenIndex ->  描画対象のオフスクリーンのインデックス
+     */
+    void AddOffscreen(csmInt32 offscreenIndex);
+
+    /**
+     * @brief   オフスクリーンの子孫Drawableを囲む矩形を計算し、オフスクリーンの描画範囲として設定する。
+     *
+     * @param[in]   offscreen   ->  描画範囲を設定するオフスクリーン
+     */
+    void UpdateOffscreenDrawRect(CubismOffscreenRenderTarget_Null* offscreen);
+
+    /**
+     * @brief   描画オブジェクト（オフスクリーン）を描画する。
+     *
+     * @param[in]   currentOffscreen ->  描画対象のオフスクリーン
+     */
+    void DrawOffscreen(CubismOffscreenRenderTarget_Null* currentOffscreen);
+
+    /**
+     * @brief   高精細マスクを描画オブジェクトの描画直前に生成する。
+     *
+     * @param[in]   clipContext     ->  生成するクリッピングコンテキスト
+     * @param[in]   maskBuffer      ->  マスクを描くバッファ
+     */
+    void DrawHighPrecisionMask(CubismClippingContext_Null* clipContext, CubismRenderTarget_Null* maskBuffer);
+
+    /**
+     * @brief    描画オブジェクト（アートメッシュ）の描画を記録する。
+     *
+     * @param[in]   model       ->  描画対象のモデル
+     * @param[in]   index       ->  描画対象のメッシュのインデックス
+     */
+    void DrawMeshNull(const CubismModel& model, const csmInt32 index);
+
+    /**
+     * @brief   オフスクリーンの合成を記録する。
+     *
+     * @param[in]   model       ->  描画対象のモデル
+     * @param[in]   offscreen ->  描画対象のオフスクリーン
+     */
+    void DrawOffscreenNull(const CubismModel& model, CubismOffscreenRenderTarget_Null* offscreen);
+
+private:
+    // Prevention of copy Constructor
+    CubismRenderer_Null(const CubismRenderer_Null&);
+    CubismRenderer_Null& operator=(const CubismRenderer_Null&);
+
+    /**
+     * @brief   レンダラが保持する静的なリソースを解放する
+     */
+    static void DoStaticRelease();
+
+    /**
+     * @brief   ブレンドモードに対応するブレンドステートを記録する。<br>
+     *          描画先のコピーが必要な場合はコピーも記録する。
+     *
+     * @param[in]   blendMode   ->  描画オブジェクトのブレンドモード
+     * @param[in]   dstBuffer   ->  合成先のバッファ。NULLの場合はモデル描画先
+     */
+    void SetupBlendState(const csmBlendMode& blendMode, const CubismRenderTarget_Null* dstBuffer);
+
+    /**
+     * @brief   モデル描画直前のステートを保持する<br>
+     *          記録するステートは持たないため何もしない
+     */
+    void SaveProfile() override;
+
+    /**
+     * @brief   モデル描画直前のステートを復帰させる<br>
+     *          記録するステートは持たないため何もしない
+     */
+    void RestoreProfile() override;
+
+    /**
+     * @brief   モデル描画直前のオフスクリーン設定
+     */
+    virtual void BeforeDrawModelRenderTarget();
+
+    /**
+     * @brief   モデル描画後のオフスクリーン設定
+     */
+    virtual void AfterDrawModelRenderTarget();
+
+    /**
+     * @brief   マスクテクスチャに描画するクリッピングコンテキストをセットする。
+     *
+     * @param[in]   clip     ->  マスクテクスチャに描画するクリッピングコンテキスト
+     */
+    void SetClippingContextBufferForMask(CubismClippingContext_Null* clip);
+
+    /**
+     * @brief   マスクテクスチャに描画するクリッピングコンテキストを取得する。
+     *
+     * @return  マスクテクスチャに描画するクリッピングコンテキスト
+     */
+    CubismClippingContext_Null* GetClippingContextBufferForMask() const;
+
+    /**
+     * @brief   drawableで画面上に描画するクリッピングコンテキストをセットする。
+     *
+     * @param[in]   clip     ->  drawableで画面上に描画するクリッピングコンテキスト
+     */
+    void SetClippingContextBufferForDrawable(CubismClippingContext_Null* clip);
+
+    /**
+     * @brief   drawableで画面上に描画するクリッピングコンテキストを取得する。
+     *
+     * @return  drawableで画面上に描画するクリッピングコンテキスト
+     */
+    CubismClippingContext_Null* GetClippingContextBufferForDrawable() const;
+
+    /**
+     * @brief   offscreenで画面上に描画するクリッピングコンテキストをセットする。
+     *
+     * @param[in]   clip     ->  offscreenで画面上に描画するクリッピングコンテキスト
+     */
+    void SetClippingContextBufferForOffscreen(CubismClippingContext_Null* clip);
+
+    /**
+     * @brief   offscreenで画面上に描画するクリッピングコンテキストを取得する。
+     *
+     * @return  offscreenで画面上に描画するクリッピングコンテキスト
+     */
+    CubismClippingContext_Null* GetClippingContextBufferForOffscreen() const;
+
+    /**
+     * @brief   マスク生成時かを判定する
+     *
+     * @return  判定値
+     */
+    const csmBool inline IsGeneratingMask() const;
+
+    CubismCommandBuffer_Null _commandBuffer;                  ///< 描画の代わりに記録するコマンド列
+    csmMap<csmInt32, csmUint32> _textures;                    ///< モデルが参照するテクスチャとレンダラでバインドしているテクスチャとのマップ
+    csmVector<csmInt32> _sortedObjectsIndexList;       ///< 描画オブジェクトのインデックスを描画順に並べたリスト
+    csmVector<DrawableObjectType> _sortedObjectsTypeList;       ///< 描画オブジェクトの種別を描画順に並べたリスト
+    CubismClippingManager_Null* _drawableClippingManager;               ///< クリッピングマスク管理オブジェクト
+    CubismClippingManager_Null* _offscreenClippingManager;               ///< クリッピングマスク管理オブジェクト
+    CubismClippingContext_Null* _clippingContextBufferForMask;  ///< マスクテクスチャに描画するためのクリッピングコンテキスト
+    CubismClippingContext_Null* _clippingContextBufferForDrawable;  ///< 画面上描画するためのクリッピングコンテキスト
+    CubismClippingContext_Null* _clippingContextBufferForOffscreen;  ///< 画面上描画するためのクリッピングコンテキスト
+
+    csmVector<CubismRenderTarget_Null> _modelRenderTargets; ///< モデル全体を描画する先のバッファ（添え字 1 はコピー用）
+
+    csmVector<CubismRenderTarget_Null> _drawableMasks; ///< Drawableのマスク描画用のバッファ
+    csmVector<CubismRenderTarget_Null> _offscreenMasks; ///< オフスクリーン機能マスク描画用のバッファ
+
+    csmVector<CubismOffscreenRenderTarget_Null> _offscreenList; ///< モデルのオフスクリーン
+    csmInt32 _currentRenderTargetId; ///< 現在の描画先の識別子
+    CubismOffscreenRenderTarget_Null* _currentOffscreen; ///< 現在のオフスクリーンのフレームバッファ
+
+    csmInt32 _modelRootRenderTargetId; ///< モデル描画のルートの描画先の識別子
+
+    csmVector<csmInt32> _offscreenChildDrawableIndices; ///< オフスクリーンごとの子孫Drawableのインデックスを連結したリスト
+    csmVector<csmInt32> _offscreenChildDrawableOffsets; ///< _offscreenChildDrawableIndices内での各オフスクリーンの開始位置
+    CubismRenderTarget_Null* _blendCopyRenderTarget; ///< モデル描画先と異なるサイズのオフスクリーンをコピーする際に借りるレンダーターゲット
+};
+
+}}}}
+//------------ LIVE2D NAMESPACE ------------
@@ -0,0 +1,197 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismGpuTimer_OpenGLES2.hpp"
+#include <string.h>
+
+#if defined(CSM_TARGET_ANDROID_ES2) || defined(CSM_TARGET_HARMONYOS_ES3)
+#include <EGL/egl.h>
+#define CSM_GPU_TIMER_DISJOINT_TIMER_QUERY
+#elif defined(GLEW_ARB_timer_query)
+#define CSM_GPU_TIMER_ARB_TIMER_QUERY
+#endif
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+namespace {
+#ifdef CSM_GPU_TIMER_DISJOINT_TIMER_QUERY
+    PFNGLGENQUERIESEXTPROC s_glGenQueriesEXT = NULL;
+    PFNGLDELETEQUERIESEXTPROC s_glDeleteQueriesEXT = NULL;
+    PFNGLQUERYCOUNTEREXTPROC s_glQueryCounterEXT = NULL;
+    PFNGLGETQUERYOBJECTUIVEXTPROC s_glGetQueryObjectuivEXT = NULL;
+    PFNGLGETQUERYOBJECTUI64VEXTPROC s_glGetQueryObjectui64vEXT = NULL;
+
+    /**
+     * @brief   拡張の一覧に指定の拡張が含まれるか
+     */
+    csmBool IsExtensionSupported(const csmChar* extensions, const csmChar* name)
+    {
+        const csmSizeInt nameLength = strlen(name);
+        for (const csmChar* p = strstr(extensions, name); p != NULL; p = strstr(p + nameLength, name))
+        {
+            const csmBool isHead = (p == extensions || p[-1] == ' ');
+            const csmBool isTail = (p[nameLength] == ' ' || p[nameLength] == '\0');
+            if (isHead && isTail)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief   GL_EXT_disjoint_timer_query の関数を取得する
+     *
+     * @return  使える場合はtrue
+     */
+    csmBool LoadDisjointTimerQuery()
+    {
+        if (s_glQueryCounterEXT != NULL)
+        {
+            return true;
+        }
+
+        const csmChar* extensions = reinterpret_cast<const csmChar*>(glGetString(GL_EXTENSIONS));
+        if (extensions == NULL || !IsExtensionSupported(extensions, "GL_EXT_disjoint_timer_query"))
+        {
+            return false;
+        }
+
+        s_glGenQueriesEXT = reinterpret_cast<PFNGLGENQUERIESEXTPROC>(eglGetProcAddress("glGenQueriesEXT"));
+        s_glDeleteQueriesEXT = reinterpret_cast<PFNGLDELETEQUERIESEXTPROC>(eglGetProcAddress("glDeleteQueriesEXT"));
+        s_glGetQueryObjectuivEXT = reinterpret_cast<PFNGLGETQUERYOBJECTUIVEXTPROC>(eglGetProcAddress("glGetQueryObjectuivEXT"));
+        s_glGetQueryObjectui64vEXT = reinterpret_cast<PFNGLGETQUERYOBJECTUI64VEXTPROC>(eglGetProcAddress("glGetQueryObjectui64vEXT"));
+        if (s_glGenQueriesEXT == NULL || s_glDeleteQueriesEXT == NULL || s_glGetQueryObjectuivEXT == NULL || s_glGetQueryObjectui64vEXT == NULL)
+        {
+            return false;
+        }
+
+        // 全ての関数が揃ってから使える状態にする
+        s_glQueryCounterEXT = reinterpret_cast<PFNGLQUERYCOUNTEREXTPROC>(eglGetProcAddress("glQueryCounterEXT"));
+        return s_glQueryCounterEXT != NULL;
+    }
+#endif
+}
+
+CubismGpuTimer_OpenGLES2::CubismGpuTimer_OpenGLES2()
+{
+}
+
+CubismGpuTimer_OpenGLES2::~CubismGpuTimer_OpenGLES2()
+{
+    Release();
+}
+
+csmBool CubismGpuTimer_OpenGLES2::CreateQueries(csmUint32 queryCount)
+{
+#if defined(CSM_GPU_TIMER_DISJOINT_TIMER_QUERY)
+    if (!LoadDisjointTimerQuery())
+    {
+        return false;
+    }
+
+    _queries.Resize(queryCount);
+    s_glGenQueriesEXT(static_cast<GLsizei>(queryCount), _queries.GetPtr());
+
+    // 以前の計時の途切れを読み捨てておく
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    return true;
+#elif defined(CSM_GPU_TIMER_ARB_TIMER_QUERY)
+    if (!GLEW_ARB_timer_query)
+    {
+        return false;
+    }
+
+    _queries.Resize(queryCount);
+    glGenQueries(static_cast<GLsizei>(queryCount), _queries.GetPtr());
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CubismGpuTimer_OpenGLES2::DestroyQueries()
+{
+    if (_queries.GetSize() == 0)
+    {
+        return;
+    }
+
+#if defined(CSM_GPU_TIMER_DISJOINT_TIMER_QUERY)
+    s_glDeleteQueriesEXT(static_cast<GLsizei>(_queries.GetSize()), _queries.GetPtr());
+#elif defined(CSM_GPU_TIMER_ARB_TIMER_QUERY)
+    glDeleteQueries(static_cast<GLsizei>(_queries.GetSize()), _queries.GetPtr());
+#endif
+    _queries.Clear();
+}
+
+void CubismGpuTimer_OpenGLES2::WriteTimestamp(csmUint32 query)
+{
+#if defined(CSM_GPU_TIMER_DISJOINT_TIMER_QUERY)
+    s_glQueryCounterEXT(_queries[query], GL_TIMESTAMP_EXT);
+#elif defined(CSM_GPU_TIMER_ARB_TIMER_QUERY)
+    glQueryCounter(_queries[query], GL_TIMESTAMP);
+#endif
+}
+
+CubismGpuTimer::ReadResult CubismGpuTimer_OpenGLES2::ReadTimestamps(csmUint32 firstQuery, csmUint32 queryCount, csmUint64* nanoseconds)
+{
+#if defined(CSM_GPU_TIMER_DISJOINT_TIMER_QUERY)
+    // 最後に記録したクエリから確かめ、まだ終わっていなければ待たずに戻る
+    for (csmInt32 i = static_cast<csmInt32>(queryCount) - 1; i >= 0; --i)
+    {
+        GLuint available = GL_FALSE;
+        s_glGetQueryObjectuivEXT(_queries[firstQuery + i], GL_QUERY_RESULT_AVAILABLE_EXT, &available);
+        if (available == GL_FALSE)
+        {
+            return ReadResult_NotReady;
+        }
+    }
+
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    if (disjoint)
+    {
+        return ReadResult_Invalid;
+    }
+
+    for (csmUint32 i = 0; i < queryCount; ++i)
+    {
+        GLuint64 value = 0;
+        s_glGetQueryObjectui64vEXT(_queries[firstQuery + i], GL_QUERY_RESULT_EXT, &value);
+        nanoseconds[i] = static_cast<csmUint64>(value);
+    }
+    return ReadResult_Ready;
+#elif defined(CSM_GPU_TIMER_ARB_TIMER_QUERY)
+    // 最後に記録したクエリから確かめ、まだ終わっていなければ待たずに戻る
+    for (csmInt32 i = static_cast<csmInt32>(queryCount) - 1; i >= 0; --i)
+    {
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(_queries[firstQuery + i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE)
+        {
+            return ReadResult_NotReady;
+        }
+    }
+
+    for (csmUint32 i = 0; i < queryCount; ++i)
+    {
+        GLuint64 value = 0;
+        glGetQueryObjectui64v(_queries[firstQuery + i], GL_QUERY_RESULT, &value);
+        nanoseconds[i] = static_cast<csmUint64>(value);
+    }
+    return ReadResult_Ready;
+#else
+    return ReadResult_Invalid;
+#endif
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
@@ -0,0 +1,104 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "../CubismGpuTimer.hpp"
+#include "CubismFramework.hpp"
+#include "Type/csmVector.hpp"
+
+#ifdef CSM_TARGET_ANDROID_ES2
+#include <jni.h>
+#include <errno.h>
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#endif
+
+#ifdef CSM_TARGET_IPHONE_ES2
+#include <OpenGLES/ES2/gl.h>
+#include <OpenGLES/ES2/glext.h>
+#endif
+
+#if defined(CSM_TARGET_WIN_GL) || defined(CSM_TARGET_LINUX_GL)
+#include <GL/glew.h>
+#include <GL/gl.h>
+#endif
+
+#ifdef CSM_TARGET_MAC_GL
+#ifndef CSM_TARGET_COCOS
+#include <GL/glew.h>
+#endif
+#include <OpenGL/gl.h>
+#endif
+
+#ifdef CSM_TARGET_HARMONYOS_ES3
+#include <GLES3/gl3.h>
+#include <GLES2/gl2ext.h>
+#endif
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+/**
+ * @brief   OpenGLのタイムスタンプクエリで描画時間を計測するクラス<br>
+ *          デスクトップのOpenGLでは GL_ARB_timer_query、OpenGL ESでは GL_EXT_disjoint_timer_query を使用する。<br>
+ *          どちらも使えない環境では計測しない。iOSのOpenGL ESはどちらの拡張も持たないため、iOSでは常に計測しない。
+ */
+class CubismGpuTimer_OpenGLES2 : public CubismGpuTimer
+{
+public:
+    /**
+     * @brief   コンストラクタ
+     */
+    CubismGpuTimer_OpenGLES2();
+
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~CubismGpuTimer_OpenGLES2();
+
+protected:
+    /**
+     * @brief   タイムスタンプを記録するクエリを作成する
+     *
+     * @param[in]   queryCount  ->  クエリの数
+     *
+     * @return  作成できた場合はtrue。タイマークエリの拡張がない場合はfalse
+     */
+    csmBool CreateQueries(csmUint32 queryCount) override;
+
+    /**
+     * @brief   作成したクエリを破棄する
+     */
+    void DestroyQueries() override;
+
+    /**
+     * @brief   クエリにGPUのタイムスタンプを記録する
+     *
+     * @param[in]   query   ->  クエリ
+     */
+    void WriteTimestamp(csmUint32 query) override;
+
+    /**
+     * @brief   記録したタイムスタンプをGPUの処理を待たずに読み出す<br>
+     *           OpenGL ESでGPUの計時が途切れた(GL_GPU_DISJOINT_EXT)場合は値を使わない
+     *
+     * @param[in]   firstQuery  ->  最初のクエリ
+     * @param[in]   queryCount  ->  クエリの数
+     * @param[out]  nanoseconds ->  ナノ秒のタイムスタンプ
+     *
+     * @return  読み出しの結果
+     */
+    ReadResult ReadTimestamps(csmUint32 firstQuery, csmUint32 queryCount, csmUint64* nanoseconds) override;
+
+private:
+    csmVector<GLuint>   _queries;   ///< タイムスタンプを記録するクエリ
+};
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
@@ -0,0 +1,358 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismInstancedRenderer_OpenGLES2.hpp"
+#include "CubismShader_OpenGLES2.hpp"
+#include "Model/CubismModel.hpp"
+#include "Utils/CubismProfiler.hpp"
+#include <string.h>
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+namespace {
+    const csmInt32 MaxInstanceCount = 16;       ///< 1回の描画で扱うインスタンスの上限。シェーダのユニフォーム配列の要素数と合わせる
+    const csmInt32 MaxVertexCount = 65536;      ///< 1回の描画で扱う頂点数の上限。頂点インデックスが16bitのため
+}
+
+CubismInstancedRenderer_OpenGLES2::CubismInstancedRenderer_OpenGLES2()
+{
+}
+
+CubismInstancedRenderer_OpenGLES2::~CubismInstancedRenderer_OpenGLES2()
+{
+}
+
+void CubismInstancedRenderer_OpenGLES2::AddInstance(CubismRenderer_OpenGLES2* renderer)
+{
+    if (renderer == NULL || renderer->GetModel() == NULL)
+    {
+        return;
+    }
+
+    _instances.PushBack(renderer);
+}
+
+void CubismInstancedRenderer_OpenGLES2::Render()
+{
+    if (_instances.GetSize() == 0)
+    {
+        return;
+    }
+
+    _rendererProfile.Save();
+
+    GLint lastFBO;
+    GLint lastViewport[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &lastFBO);
+    glGetIntegerv(GL_VIEWPORT, lastViewport);
+
+    const csmInt32 instanceCount = static_cast<csmInt32>(_instances.GetSize());
+    csmInt32 begin = 0;
+    while (begin < instanceCount)
+    {
+        CubismRenderer_OpenGLES2* first = _instances[begin];
+
+        // 対象にできないモデルは通常の描画を行う
+        if (!IsBatchable(first))
+        {
+            first->DrawModel();
+            ++begin;
+            continue;
+        }
+
+        // アートメッシュ単位で交互に描くため、描画順が同じで互いに重ならないモデルだけを続けてまとめる
+        _bounds.Clear();
+        csmRectF bounds;
+        CalculateBounds(first, bounds);
+        _bounds.PushBack(bounds);
+
+        const csmInt32 drawableCount = first->GetModel()->GetDrawableCount();
+        csmInt32 end = begin + 1;
+        while (end < instanceCount && end - begin < MaxInstanceCount)
+        {
+            CubismRenderer_OpenGLES2* candidate = _instances[end];
+            if (!IsBatchable(candidate) || !IsCompatible(first, candidate) ||
+                memcmp(first->GetModel()->GetRenderOrders(), candidate->GetModel()->GetRenderOrders(), sizeof(csmInt32) * drawableCount) != 0)
+            {
+                break;
+            }
+
+            CalculateBounds(candidate, bounds);
+            csmBool isOverlapped = false;
+            for (csmUint32 i = 0; i < _bounds.GetSize(); ++i)
+            {
+                if (bounds.X < _bounds[i].GetRight() && _bounds[i].X < bounds.GetRight() &&
+                    bounds.Y < _bounds[i].GetBottom() && _bounds[i].Y < bounds.GetBottom())
+                {
+                    isOverlapped = true;
+                    break;
+                }
+            }
+            if (isOverlapped)
+            {
+                break;
+            }
+
+            _bounds.PushBack(bounds);
+            ++end;
+        }
+
+        DrawBatch(begin, end, lastFBO, lastViewport);
+        begin = end;
+    }
+
+    _instances.Clear();
+
+    _rendererProfile.Restore();
+}
+
+csmBool CubismInstancedRenderer_OpenGLES2::IsBatchable(CubismRenderer_OpenGLES2* renderer) const
+{
+    const CubismModel* model = renderer->GetModel();
+
+    // モデル単位の合成やマスクの描き直しが必要な場合はアートメッシュを交互に描けない
+    return !model->IsBlendModeEnabled() &&
+           model->GetOffscreenCount() == 0 &&
+           !renderer->IsUsingHighPrecisionMask() &&
+           !renderer->IsUsingImpostor();
+}
+
+csmBool CubismInstancedRenderer_OpenGLES2::IsCompatible(CubismRenderer_OpenGLES2* a, CubismRenderer_OpenGLES2* b) const
+{
+    const CubismModel* modelA = a->GetModel();
+    const CubismModel* modelB = b->GetModel();
+
+    if (modelA->GetDrawableCount() != modelB->GetDrawableCount() ||
+        a->IsPremultipliedAlpha() != b->IsPremultipliedAlpha())
+    {
+        return false;
+    }
+
+    for (csmInt32 i = 0; i < modelA->GetDrawableCount(); ++i)
+    {
+        // 頂点インデックスとテクスチャ座標は先頭のモデルのものを共有する
+        if (modelA->GetDrawableId(i) != modelB->GetDrawableId(i) ||
+            modelA->GetDrawableVertexCount(i) != modelB->GetDrawableVertexCount(i) ||
+            modelA->GetDrawableVertexIndexCount(i) != modelB->GetDrawableVertexIndexCount(i) ||
+            a->GetBindedTextureId(modelA->GetDrawableTextureIndex(i)) != b->GetBindedTextureId(modelB->GetDrawableTextureIndex(i)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void CubismInstancedRenderer_OpenGLES2::CalculateBounds(CubismRenderer_OpenGLES2* renderer, csmRectF& bounds) const
+{
+    const CubismModel* model = renderer->GetModel();
+    CubismMatrix44 mvpMatrix = renderer->GetMvpMatrix();
+    const csmFloat32* m = mvpMatrix.GetArray();
+
+    csmFloat32 left = 1.0f;
+    csmFloat32 bottom = 1.0f;
+    csmFloat32 right = -1.0f;
+    csmFloat32 top = -1.0f;
+    csmBool isEmpty = true;
+
+    for (csmInt32 i = 0; i < model->GetDrawableCount(); ++i)
+    {
+        if (!model->GetDrawableDynamicFlagIsVisible(i))
+        {
+            continue;
+        }
+
+        const csmFloat32* vertices = model->GetDrawableVertices(i);
+        const csmInt32 vertexCount = model->GetDrawableVertexCount(i);
+        for (csmInt32 j = 0; j < vertexCount; ++j)
+        {
+            const csmFloat32 x = m[0] * vertices[j * 2] + m[4] * vertices[j * 2 + 1] + m[12];
+            const csmFloat32 y = m[1] * vertices[j * 2] + m[5] * vertices[j * 2 + 1] + m[13];
+
+            if (isEmpty)
+            {
+                left = right = x;
+                bottom = top = y;
+                isEmpty = false;
+                continue;
+            }
+
+            left = (x < left) ? x : left;
+            right = (x > right) ? x : right;
+            bottom = (y < bottom) ? y : bottom;
+            top = (y > top) ? y : top;
+        }
+    }
+
+    if (isEmpty)
+    {
+        // 何も描かないモデルは他と重ならない
+        bounds = csmRectF(0.0f, 0.0f, 0.0f, 0.0f);
+        return;
+    }
+
+    bounds = csmRectF(left, bottom, right - left, top - bottom);
+}
+
+void CubismInstancedRenderer_OpenGLES2::DrawBatch(const csmInt32 begin, const csmInt32 end, GLint lastFBO, GLint lastViewport[4])
+{
+    // マスクはモデルごとのレンダーテクスチャに描くため、アートメッシュを描く前に全てのモデルの分を生成しておく
+    for (csmInt32 i = begin; i < end; ++i)
+    {
+        CubismRenderer_OpenGLES2* renderer = _instances[i];
+        renderer->SetupDrawableMasks(lastFBO, lastViewport);
+        renderer->_currentOffscreen = NULL;
+        renderer->_currentFBO = lastFBO;
+        renderer->_modelRootFBO = lastFBO;
+    }
+
+    CubismRenderer_OpenGLES2* first = _instances[begin];
+    const CubismModel* model = first->GetModel();
+    const csmInt32 drawableCount = model->GetDrawableCount();
+    const csmInt32* renderOrder = model->GetRenderOrders();
+
+    // 上記クリッピング処理内でもPreDrawを呼ぶので、描画直前にもう一度呼ぶ
+    first->PreDraw();
+
+    // インデックスを描画順でソート
+    _sortedDrawableIndices.Resize(drawableCount);
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        _sortedDrawableIndices[renderOrder[i]] = i;
+    }
+
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        const csmInt32 drawableIndex = _sortedDrawableIndices[i];
+
+        _drawInstances.Clear();
+        for (csmInt32 j = begin; j < end; ++j)
+        {
+            CubismRenderer_OpenGLES2* renderer = _instances[j];
+            if (!renderer->GetModel()->GetDrawableDynamicFlagIsVisible(drawableIndex))
+            {
+                continue;
+            }
+
+            // マスクを使うアートメッシュはモデルごとのマスクを参照するため、通常の描画を行う
+            if (renderer->_drawableClippingManager != NULL &&
+                (*renderer->_drawableClippingManager->GetClippingContextListForDraw())[drawableIndex] != NULL)
+            {
+                renderer->DrawDrawable(drawableIndex);
+                continue;
+            }
+
+            _drawInstances.PushBack(renderer);
+        }
+
+        // 頂点インデックスが16bitに収まる数ずつまとめて描画する
+        const csmInt32 vertexCount = model->GetDrawableVertexCount(drawableIndex);
+        const csmInt32 capacity = (vertexCount > 0 && MaxVertexCount / vertexCount < MaxInstanceCount) ? MaxVertexCount / vertexCount : MaxInstanceCount;
+        const csmInt32 drawInstanceCount = static_cast<csmInt32>(_drawInstances.GetSize());
+        for (csmInt32 j = 0; j < drawInstanceCount; j += capacity)
+        {
+            const csmInt32 count = (drawInstanceCount - j < capacity) ? drawInstanceCount - j : capacity;
+            DrawInstancedDrawable(_drawInstances.GetPtr() + j, count, drawableIndex);
+        }
+    }
+}
+
+void CubismInstancedRenderer_OpenGLES2::DrawInstancedDrawable(CubismRenderer_OpenGLES2* const* instances, const csmInt32 instanceCount, const csmInt32 drawableIndex)
+{
+    CubismRenderer_OpenGLES2* first = instances[0];
+    const CubismModel* model = first->GetModel();
+
+#ifndef CSM_DEBUG
+    if (first->GetBindedTextureId(model->GetDrawableTextureIndex(drawableIndex)) == 0)
+    {
+        return; // モデルが参照するテクスチャがバインドされていない場合は描画をスキップする
+    }
+#endif
+
+    const csmInt32 vertexCount = model->GetDrawableVertexCount(drawableIndex);
+    const csmInt32 indexCount = model->GetDrawableVertexIndexCount(drawableIndex);
+    const csmFloat32* uvs = reinterpret_cast<const csmFloat32*>(model->GetDrawableVertexUvs(drawableIndex));
+    const csmUint16* indices = model->GetDrawableVertexIndices(drawableIndex);
+
+    _positions.Resize(vertexCount * 2 * instanceCount);
+    _uvs.Resize(vertexCount * 2 * instanceCount);
+    _instanceIndices.Resize(vertexCount * instanceCount);
+    _indices.Resize(indexCount * instanceCount);
+    _matrices.Resize(16 * instanceCount);
+    _baseColors.Resize(4 * instanceCount);
+    _multiplyColors.Resize(4 * instanceCount);
+    _screenColors.Resize(4 * instanceCount);
+
+    for (csmInt32 i = 0; i < instanceCount; ++i)
+    {
+        const CubismModel* instanceModel = instances[i]->GetModel();
+
+        // 頂点は全インスタンス分を連結し、インデックスはインスタンスの先頭頂点の分だけずらす
+        memcpy(_positions.GetPtr() + vertexCount * 2 * i, instanceModel->GetDrawableVertices(drawableIndex), sizeof(csmFloat32) * 2 * vertexCount);
+        memcpy(_uvs.GetPtr() + vertexCount * 2 * i, uvs, sizeof(csmFloat32) * 2 * vertexCount);
+        for (csmInt32 j = 0; j < vertexCount; ++j)
+        {
+            _instanceIndices[vertexCount * i + j] = static_cast<csmFloat32>(i);
+        }
+        const csmUint16 indexOffset = static_cast<csmUint16>(vertexCount * i);
+        for (csmInt32 j = 0; j < indexCount; ++j)
+        {
+            _indices[indexCount * i + j] = static_cast<csmUint16>(indices[j] + indexOffset);
+        }
+
+        memcpy(_matrices.GetPtr() + 16 * i, instances[i]->GetMvpMatrix().GetArray(), sizeof(csmFloat32) * 16);
+
+        const CubismRenderer::CubismTextureColor baseColor = instances[i]->GetModelColorWithOpacity(instanceModel->GetDrawableOpacity(drawableIndex));
+        const CubismModelMultiplyAndScreenColor& overrideMultiplyAndScreenColor = instanceModel->GetOverrideMultiplyAndScreenColor();
+        const CubismRenderer::CubismTextureColor multiplyColor = overrideMultiplyAndScreenColor.GetDrawableMultiplyColor(drawableIndex);
+        const CubismRenderer::CubismTextureColor screenColor = overrideMultiplyAndScreenColor.GetDrawableScreenColor(drawableIndex);
+        const CubismRenderer::CubismTextureColor* colors[] = { &baseColor, &multiplyColor, &screenColor };
+        csmFloat32* destinations[] = { _baseColors.GetPtr() + 4 * i, _multiplyColors.GetPtr() + 4 * i, _screenColors.GetPtr() + 4 * i };
+        for (csmInt32 j = 0; j < 3; ++j)
+        {
+            destinations[j][0] = colors[j]->R;
+            destinations[j][1] = colors[j]->G;
+            destinations[j][2] = colors[j]->B;
+            destinations[j][3] = colors[j]->A;
+        }
+    }
+
+    // 裏面描画の有効・無効
+    if (model->GetDrawableCulling(drawableIndex) != 0)
+    {
+        glEnable(GL_CULL_FACE);
+    }
+    else
+    {
+        glDisable(GL_CULL_FACE);
+    }
+
+    glFrontFace(GL_CCW);    // Cubism SDK OpenGLはマスク・アートメッシュ共にCCWが表面
+
+    CubismShader_OpenGLES2::GetInstance()->SetupShaderProgramForInstancedDrawable(first, *model, drawableIndex,
+        _positions.GetPtr(), _uvs.GetPtr(), _instanceIndices.GetPtr(), instanceCount,
+        _matrices.GetPtr(), _baseColors.GetPtr(), _multiplyColors.GetPtr(), _screenColors.GetPtr());
+
+    // ポリゴンメッシュを描画する
+    GLint currentProgram = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
+    if (currentProgram != 0)
+    {
+        glDrawElements(GL_TRIANGLES, indexCount * instanceCount, GL_UNSIGNED_SHORT, _indices.GetPtr());
+
+        CSM_PROFILE_COUNT(Counter_DrawCalls, 1);
+        CSM_PROFILE_COUNT(Counter_VertexBytes, (_positions.GetSize() + _uvs.GetSize() + _instanceIndices.GetSize()) * sizeof(csmFloat32) + _indices.GetSize() * sizeof(csmUint16));
+    }
+
+    // 後処理
+    glUseProgram(0);
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
@@ -0,0 +1,113 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+#include "CubismRenderer_OpenGLES2.hpp"
+#include "Type/csmVector.hpp"
+#include "Type/csmRectF.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+/**
+ * @brief   同じmocから作られた複数のモデルをインスタンス描画でまとめて描くクラス<br>
+ *          描画順が同じで画面上で重ならないモデルを1つのまとまりとし、アートメッシュごとに全モデル分を1回で描画する。<br>
+ *          マスクを使うアートメッシュと、ブレンドモード・オフスクリーン・高精細マスク・インポスターを使うモデルは通常の描画を行う。<br>
+ *          使用する場合は全てのモデルの更新後、奥から手前の順に AddInstance() で登録して Render() を呼ぶこと。
+ */
+class CubismInstancedRenderer_OpenGLES2
+{
+public:
+    /**
+     * @brief   コンストラクタ
+     */
+    CubismInstancedRenderer_OpenGLES2();
+
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~CubismInstancedRenderer_OpenGLES2();
+
+    /**
+     * @brief   描画するモデルのレンダラを追加する<br>
+     *          登録は Render() の呼び出しで解除される
+     *
+     * @param[in]   renderer    ->  レンダラのインスタンス。奥に描くものから順に追加する
+     */
+    void AddInstance(CubismRenderer_OpenGLES2* renderer);
+
+    /**
+     * @brief   追加されたモデルを描画し、登録を解除する
+     */
+    void Render();
+
+private:
+    /**
+     * @brief   インスタンス描画の対象にできるモデルか
+     *
+     * @param[in]   renderer    ->  レンダラのインスタンス
+     *
+     * @return  対象にできる場合はtrue
+     */
+    csmBool IsBatchable(CubismRenderer_OpenGLES2* renderer) const;
+
+    /**
+     * @brief   2つのモデルのアートメッシュとテクスチャが同じか
+     *
+     * @param[in]   a   ->  レンダラのインスタンス
+     * @param[in]   b   ->  レンダラのインスタンス
+     *
+     * @return  同じ場合はtrue
+     */
+    csmBool IsCompatible(CubismRenderer_OpenGLES2* a, CubismRenderer_OpenGLES2* b) const;
+
+    /**
+     * @brief   表示中のアートメッシュが描かれる範囲をNDCで求める
+     *
+     * @param[in]   renderer    ->  レンダラのインスタンス
+     * @param[out]  bounds      ->  描画範囲
+     */
+    void CalculateBounds(CubismRenderer_OpenGLES2* renderer, csmRectF& bounds) const;
+
+    /**
+     * @brief   _instancesの[begin, end)のモデルをまとめて描画する
+     *
+     * @param[in]   begin           ->  先頭のインデックス
+     * @param[in]   end             ->  終端のインデックス
+     * @param[in]   lastFBO         ->  描画直前のフレームバッファ
+     * @param[in]   lastViewport    ->  描画直前のビューポート
+     */
+    void DrawBatch(csmInt32 begin, csmInt32 end, GLint lastFBO, GLint lastViewport[4]);
+
+    /**
+     * @brief   アートメッシュを指定したモデルの分まとめて描画する
+     *
+     * @param[in]   instances       ->  描画するモデルのレンダラの配列
+     * @param[in]   instanceCount   ->  モデルの数
+     * @param[in]   drawableIndex   ->  描画対象のメッシュのインデックス
+     */
+    void DrawInstancedDrawable(CubismRenderer_OpenGLES2* const* instances, csmInt32 instanceCount, csmInt32 drawableIndex);
+
+    csmVector<CubismRenderer_OpenGLES2*> _instances;   ///< 描画するモデルのレンダラ（奥から手前の順）
+    csmVector<csmRectF> _bounds;                        ///< まとまり内のモデルの描画範囲
+    csmVector<csmInt32> _sortedDrawableIndices;         ///< 描画順に並べたアートメッシュのインデックス
+    csmVector<CubismRenderer_OpenGLES2*> _drawInstances;///< 1回の描画で対象にするモデル
+    csmVector<csmFloat32> _positions;                   ///< 全インスタンスの頂点座標
+    csmVector<csmFloat32> _uvs;                         ///< 全インスタンスのテクスチャ座標
+    csmVector<csmFloat32> _instanceIndices;             ///< 頂点ごとのインスタンス番号
+    csmVector<csmUint16> _indices;                      ///< 全インスタンスの頂点インデックス
+    csmVector<csmFloat32> _matrices;                    ///< インスタンスごとの座標変換行列
+    csmVector<csmFloat32> _baseColors;                  ///< インスタンスごとの基本色
+    csmVector<csmFloat32> _multiplyColors;              ///< インスタンスごとの乗算色
+    csmVector<csmFloat32> _screenColors;                ///< インスタンスごとのスクリーン色
+    CubismRendererProfile_OpenGLES2 _rendererProfile;   ///< OpenGLのステートを保持するオブジェクト
+};
+
+}}}}
+//------------ LIVE2D NAMESPACE ------------
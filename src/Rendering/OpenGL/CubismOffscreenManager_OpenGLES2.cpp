@@ -40,7 +40,8 @@ CubismRenderTarget_OpenGLES2* CubismOffscreenManager_OpenGLES2::GetOffscreenRend
     UpdateRenderTargetCount();
 
     // 使われていないリソースコンテナがあればそれを返す
-    CubismRenderTarget_OpenGLES2* offscreenRenderTarget = GetUnusedOffscreenRenderTarget();
+    // オフスクリーンごとにサイズが異なるため、同じサイズのものを優先して再作成を避ける
+    CubismRenderTarget_OpenGLES2* offscreenRenderTarget = GetUnusedOffscreenRenderTarget(width, height);
     if (offscreenRenderTarget != nullptr)
     {
         // サイズが違う場合は再作成する
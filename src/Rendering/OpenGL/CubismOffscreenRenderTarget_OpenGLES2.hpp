@@ -9,6 +9,7 @@
 
 #include "../ICubismOffscreenRenderTarget.hpp"
 #include "CubismRenderTarget_OpenGLES2.hpp"
+#include "Math/CubismMatrix44.hpp"
 
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
@@ -49,6 +50,36 @@ public:
      */
     void StopUsingRenderTexture();
 
+    /**
+     * @brief オフスクリーンが描画を受け持つモデル描画先上の矩形を設定する。<br>
+     *        レンダーターゲットは矩形と同じサイズで確保される。
+     *
+     * @param  x             矩形の左端（ピクセル）
+     * @param  y             矩形の下端（ピクセル）
+     * @param  width         矩形の幅（ピクセル）
+     * @param  height        矩形の高さ（ピクセル）
+     * @param  canvasWidth   モデル描画先の幅
+     * @param  canvasHeight  モデル描画先の高さ
+     */
+    void SetDrawRect(csmInt32 x, csmInt32 y, csmUint32 width, csmUint32 height, csmUint32 canvasWidth, csmUint32 canvasHeight);
+
+    /**
+     * @brief 描画先の矩形をモデル描画先のNDC座標で表した四角形の頂点配列を取得する。
+     *
+     * @return 頂点配列（4頂点）
+     */
+    const csmFloat32* GetDrawRectVertexArray() const;
+
+    /**
+     * @brief モデル描画先のNDC座標をこのオフスクリーンのNDC座標に変換する行列を取得する。
+     *
+     * @return 変換行列
+     */
+    const CubismMatrix44& GetCanvasToOffscreenMatrix() const;
+
+private:
+    csmFloat32 _drawRectVertexArray[8];        ///< 描画先の矩形（モデル描画先のNDC座標）
+    CubismMatrix44 _canvasToOffscreenMatrix;   ///< モデル描画先のNDC座標から矩形内のNDC座標への変換行列
 };
 
 }}}}
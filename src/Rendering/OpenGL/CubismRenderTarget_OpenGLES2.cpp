@@ -6,6 +6,7 @@
  */
 
 #include "CubismRenderTarget_OpenGLES2.hpp"
+#include "Utils/CubismProfiler.hpp"
 
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
@@ -23,6 +24,19 @@ void CubismRenderTarget_OpenGLES2::CopyBuffer(const CubismRenderTarget_OpenGLES2
 
     glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
 }
+
+void CubismRenderTarget_OpenGLES2::CopyBuffer(const CubismRenderTarget_OpenGLES2& src, const CubismRenderTarget_OpenGLES2& dst, GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    GLint framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebuffer);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, src._renderTexture);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, dst._renderTexture);
+
+    glBlitFramebuffer(x, y, x + width, y + height, x, y, x + width, y + height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+}
 #endif
 
 CubismRenderTarget_OpenGLES2::CubismRenderTarget_OpenGLES2()
@@ -58,6 +72,7 @@ void CubismRenderTarget_OpenGLES2::BeginDraw(GLint restoreFBO)
 
     // マスク用RenderTextureをactiveにセット
     glBindFramebuffer(GL_FRAMEBUFFER, _renderTexture);
+    CSM_PROFILE_COUNT(Counter_StateChanges, 1);
 }
 
 void CubismRenderTarget_OpenGLES2::EndDraw()
@@ -70,6 +85,7 @@ void CubismRenderTarget_OpenGLES2::EndDraw()
     // 描画対象を戻す
     glBindFramebuffer(GL_FRAMEBUFFER, _oldFBO);
     glViewport(_oldViewport[0], _oldViewport[1], _oldViewport[2], _oldViewport[3]);
+    CSM_PROFILE_COUNT(Counter_StateChanges, 1);
 }
 
 void CubismRenderTarget_OpenGLES2::Clear(float r, float g, float b, float a)
@@ -56,6 +56,18 @@ public:
      * @param   dst   バッファーのコピー先
      */
     static void CopyBuffer(const CubismRenderTarget_OpenGLES2& src, const CubismRenderTarget_OpenGLES2& dst);
+
+    /**
+     * @brief   バッファーの指定範囲の内容を同じ位置にコピーする
+     *
+     * @param   src     バッファーのコピー元
+     * @param   dst     バッファーのコピー先
+     * @param   x       範囲の左端
+     * @param   y       範囲の下端
+     * @param   width   範囲の幅
+     * @param   height  範囲の高さ
+     */
+    static void CopyBuffer(const CubismRenderTarget_OpenGLES2& src, const CubismRenderTarget_OpenGLES2& dst, GLint x, GLint y, GLsizei width, GLsizei height);
 #endif
 
     /**
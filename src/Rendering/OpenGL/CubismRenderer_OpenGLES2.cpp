@@ -7,10 +7,15 @@
 
 #include "CubismRenderer_OpenGLES2.hpp"
 #include "CubismOffscreenManager_OpenGLES2.hpp"
+#include "CubismSceneMaskAtlas_OpenGLES2.hpp"
+#include "CubismGpuTimer_OpenGLES2.hpp"
 #include "Math/CubismMatrix44.hpp"
 #include "Type/csmVector.hpp"
 #include "Type/csmVectorSort.hpp"
 #include "Model/CubismModel.hpp"
+#include "Math/CubismMath.hpp"
+#include "Utils/CubismProfiler.hpp"
+#include <math.h>
 
 #ifdef CSM_TARGET_WIN_GL
 #include <Windows.h>
@@ -32,8 +37,10 @@ namespace {
 /*********************************************************************************************************************
 *                                      CubismClippingManager_OpenGLES2
 ********************************************************************************************************************/
-void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, CubismRenderer_OpenGLES2* renderer, GLint lastFBO, GLint lastViewport[4], CubismRenderer::DrawableObjectType drawableObjectType)
+void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, CubismRenderer_OpenGLES2* renderer, GLint lastFBO, GLint lastViewport[4], CubismRenderer::DrawableObjectType drawableObjectType, CubismSceneMaskAtlas_OpenGLES2* atlas)
 {
+    CSM_PROFILE_ZONE(Zone_ClippingSetup, &model);
+
     // 全てのクリッピングを用意する
     // 同じクリップ（複数の場合はまとめて１つのクリップ）を使う場合は１度だけ設定する
     csmInt32 usingClipCount = 0;
@@ -56,29 +63,53 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
         return;
     }
 
-    // マスク作成処理
-    // 生成したRenderTargetと同じサイズでビューポートを設定
-    glViewport(0, 0, _clippingMaskBufferSize.X, _clippingMaskBufferSize.Y);
-
-    // 後の計算のためにインデックスの最初をセット
-    switch (drawableObjectType)
+    // アトラスに描く場合、レンダーターゲットの切り替えとクリアはアトラス側で済んでいる
+    if (atlas == NULL)
     {
-    case CubismRenderer::DrawableObjectType_Drawable:
-    default:
-        _currentMaskBuffer = renderer->GetDrawableMaskBuffer(0);
-        break;
-    case CubismRenderer::DrawableObjectType_Offscreen:
-        _currentMaskBuffer = renderer->GetOffscreenMaskBuffer(0);
-        break;
+        // マスク作成処理
+        // 生成したRenderTargetと同じサイズでビューポートを設定
+        glViewport(0, 0, _clippingMaskBufferSize.X, _clippingMaskBufferSize.Y);
+
+        // 後の計算のためにインデックスの最初をセット
+        switch (drawableObjectType)
+        {
+        case CubismRenderer::DrawableObjectType_Drawable:
+        default:
+            _currentMaskBuffer = renderer->GetDrawableMaskBuffer(0);
+            break;
+        case CubismRenderer::DrawableObjectType_Offscreen:
+            _currentMaskBuffer = renderer->GetOffscreenMaskBuffer(0);
+            break;
+        }
+        // ----- マスク描画処理 -----
+        _currentMaskBuffer->BeginDraw(lastFBO);
     }
-    // ----- マスク描画処理 -----
-    _currentMaskBuffer->BeginDraw(lastFBO);
 
     renderer->PreDraw(); // バッファをクリアする
 
     // 各マスクのレイアウトを決定していく
     SetupLayoutBounds(usingClipCount);
 
+    if (atlas != NULL)
+    {
+        // マスク用バッファ内のレイアウトを、アトラス内でそのバッファに割り当てられた領域に収める
+        csmRectF region;
+        for (csmUint32 clipIndex = 0; clipIndex < _clippingContextListForMask.GetSize(); clipIndex++)
+        {
+            csmRectF* layoutBounds = _clippingContextListForMask[clipIndex]->_layoutBounds;
+            if (!atlas->GetRegion(renderer, _clippingContextListForMask[clipIndex]->_bufferIndex, region))
+            {
+                continue;
+            }
+
+            layoutBounds->X = region.X + layoutBounds->X * region.Width;
+            layoutBounds->Y = region.Y + layoutBounds->Y * region.Height;
+            layoutBounds->Width *= region.Width;
+            layoutBounds->Height *= region.Height;
+        }
+        _currentMaskBuffer = atlas->GetRenderTarget();
+    }
+
     // サイズがレンダーテクスチャの枚数と合わない場合は合わせる
     if (_clearedMaskBufferFlags.GetSize() != _renderTextureCount)
     {
@@ -98,6 +129,15 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
         }
     }
 
+    // アトラスは全体をクリア済みなので、他のモデルのマスクを消さないよう個別のクリアは行わない
+    if (atlas != NULL)
+    {
+        for (csmInt32 i = 0; i < _renderTextureCount; ++i)
+        {
+            _clearedMaskBufferFlags[i] = true;
+        }
+    }
+
     // 実際にマスクを生成する
     // 全てのマスクをどの様にレイアウトして描くかを決定し、ClipContext , ClippedDrawContext に記憶する
     for (csmUint32 clipIndex = 0; clipIndex < _clippingContextListForMask.GetSize(); clipIndex++)
@@ -110,15 +150,22 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
 
         // clipContextに設定したレンダーターゲットをインデックスで取得
         CubismRenderTarget_OpenGLES2* maskBuffer = NULL;
-        switch (drawableObjectType)
+        if (atlas != NULL)
         {
-        case CubismRenderer::DrawableObjectType_Drawable:
-        default:
-            maskBuffer = renderer->GetDrawableMaskBuffer(clipContext->_bufferIndex);
-            break;
-        case CubismRenderer::DrawableObjectType_Offscreen:
-            maskBuffer = renderer->GetOffscreenMaskBuffer(clipContext->_bufferIndex);
-            break;
+            maskBuffer = atlas->GetRenderTarget();
+        }
+        else
+        {
+            switch (drawableObjectType)
+            {
+            case CubismRenderer::DrawableObjectType_Drawable:
+            default:
+                maskBuffer = renderer->GetDrawableMaskBuffer(clipContext->_bufferIndex);
+                break;
+            case CubismRenderer::DrawableObjectType_Offscreen:
+                maskBuffer = renderer->GetOffscreenMaskBuffer(clipContext->_bufferIndex);
+                break;
+            }
         }
 
         // 現在のレンダーターゲットがclipContextのものと異なる場合
@@ -188,9 +235,12 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
     }
 
     // --- 後処理 ---
-    _currentMaskBuffer->EndDraw();
     renderer->SetClippingContextBufferForMask(NULL);
-    glViewport(lastViewport[0], lastViewport[1], lastViewport[2], lastViewport[3]);
+    if (atlas == NULL)
+    {
+        _currentMaskBuffer->EndDraw();
+        glViewport(lastViewport[0], lastViewport[1], lastViewport[2], lastViewport[3]);
+    }
 }
 
 /*********************************************************************************************************************
@@ -343,6 +393,7 @@ PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer;
 PFNGLUNIFORMMATRIX4FVPROC glUniformMatrix4fv;
 PFNGLUNIFORM1FPROC glUniform1f;
 PFNGLUNIFORM4FPROC glUniform4f;
+PFNGLUNIFORM4FVPROC glUniform4fv;
 
 PFNGLLINKPROGRAMPROC glLinkProgram;
 PFNGLGETPROGRAMIVPROC glGetProgramiv;
@@ -410,6 +461,7 @@ void CubismRenderer_OpenGLES2::InitializeGlFunctions()
     glUniformMatrix4fv = (PFNGLUNIFORMMATRIX4FVPROC)WinGlGetProcAddress("glUniformMatrix4fv");
     glUniform1f = (PFNGLUNIFORM1FPROC)WinGlGetProcAddress("glUniform1f");
     glUniform4f = (PFNGLUNIFORM4FPROC)WinGlGetProcAddress("glUniform4f");
+    glUniform4fv = (PFNGLUNIFORM4FVPROC)WinGlGetProcAddress("glUniform4fv");
     glLinkProgram = (PFNGLLINKPROGRAMPROC)WinGlGetProcAddress("glLinkProgram");
 
     glGetProgramiv = (PFNGLGETPROGRAMIVPROC)WinGlGetProcAddress("glGetProgramiv");
@@ -486,6 +538,10 @@ CubismRenderer_OpenGLES2::CubismRenderer_OpenGLES2(csmUint32 width, csmUint32 he
     , _clippingContextBufferForMask(NULL)
     , _clippingContextBufferForDrawable(NULL)
     , _clippingContextBufferForOffscreen(NULL)
+    , _blendCopyRenderTarget(NULL)
+    , _sceneMaskAtlas(NULL)
+    , _isSceneMaskAtlasRegionAssigned(false)
+    , _gpuTimer(NULL)
 {
     // テクスチャ対応マップの容量を確保しておく.
     _textures.PrepareCapacity(32, true);
@@ -493,8 +549,11 @@ CubismRenderer_OpenGLES2::CubismRenderer_OpenGLES2(csmUint32 width, csmUint32 he
 
 CubismRenderer_OpenGLES2::~CubismRenderer_OpenGLES2()
 {
+    SetSceneMaskAtlas(NULL);
+
     CSM_DELETE_SELF(CubismClippingManager_OpenGLES2, _drawableClippingManager);
     CSM_DELETE_SELF(CubismClippingManager_OpenGLES2, _offscreenClippingManager);
+    CSM_DELETE(_gpuTimer);
 
     for (csmInt32 i = 0; i < _modelRenderTargets.GetSize(); ++i)
     {
@@ -514,6 +573,15 @@ CubismRenderer_OpenGLES2::~CubismRenderer_OpenGLES2()
     }
     _drawableMasks.Clear();
 
+    for (csmUint32 i = 0; i < _spareDrawableMasks.GetSize(); ++i)
+    {
+        if (_spareDrawableMasks[i].IsValid())
+        {
+            _spareDrawableMasks[i].DestroyRenderTarget();
+        }
+    }
+    _spareDrawableMasks.Clear();
+
     for (csmInt32 i = 0; i < _offscreenMasks.GetSize(); ++i)
     {
         if (_offscreenMasks[i].IsValid())
@@ -591,8 +659,12 @@ void CubismRenderer_OpenGLES2::Initialize(CubismModel* model, csmInt32 maskBuffe
         _drawableMasks.Clear();
         for (csmInt32 i = 0; i < maskBufferCount; ++i)
         {
+            // アトラスを使う場合は必要になるまで作成しない
             CubismRenderTarget_OpenGLES2 masks;
-            masks.CreateRenderTarget(_drawableClippingManager->GetClippingMaskBufferSize().X, _drawableClippingManager->GetClippingMaskBufferSize().Y);
+            if (_sceneMaskAtlas == NULL)
+            {
+                masks.CreateRenderTarget(_drawableClippingManager->GetClippingMaskBufferSize().X, _drawableClippingManager->GetClippingMaskBufferSize().Y);
+            }
             _drawableMasks.PushBack(masks);
         }
     }
@@ -633,6 +705,7 @@ void CubismRenderer_OpenGLES2::Initialize(CubismModel* model, csmInt32 maskBuffe
 
         // 全てのオフスクリーンを登録し終わってから行う
         SetupParentOffscreens(model, offscreenCount);
+        SetupOffscreenChildDrawables(model, offscreenCount);
     }
 
     CubismRenderer::Initialize(model, maskBufferCount);  //親クラスの処理を呼ぶ
@@ -677,6 +750,41 @@ void CubismRenderer_OpenGLES2::SetupParentOffscreens(const CubismModel* model, c
     }
 }
 
+void CubismRenderer_OpenGLES2::SetupOffscreenChildDrawables(const CubismModel* model, csmInt32 offscreenCount)
+{
+    // 階層情報は値で返るため一度だけ取得する
+    const csmVector<CubismModelPartInfo> partsHierarchy = model->GetPartsHierarchy();
+
+    _offscreenChildDrawableIndices.Clear();
+    _offscreenChildDrawableOffsets.Clear();
+
+    csmVector<csmInt32> offscreenStack;
+    for (csmInt32 offscreenIndex = 0; offscreenIndex < offscreenCount; ++offscreenIndex)
+    {
+        _offscreenChildDrawableOffsets.PushBack(_offscreenChildDrawableIndices.GetSize());
+
+        // 子孫のオフスクリーンも辿ってDrawableを集める
+        offscreenStack.Clear();
+        offscreenStack.PushBack(offscreenIndex);
+        while (offscreenStack.GetSize() > 0)
+        {
+            const csmInt32 targetOffscreenIndex = offscreenStack[offscreenStack.GetSize() - 1];
+            offscreenStack.Remove(offscreenStack.GetSize() - 1);
+
+            const PartChildDrawObjects& childDrawObjects = partsHierarchy[model->GetOffscreenOwnerIndices()[targetOffscreenIndex]].ChildDrawObjects;
+            for (csmUint32 i = 0; i < childDrawObjects.DrawableIndices.GetSize(); ++i)
+            {
+                _offscreenChildDrawableIndices.PushBack(childDrawObjects.DrawableIndices[i]);
+            }
+            for (csmUint32 i = 0; i < childDrawObjects.OffscreenIndices.GetSize(); ++i)
+            {
+                offscreenStack.PushBack(childDrawObjects.OffscreenIndices[i]);
+            }
+        }
+    }
+    _offscreenChildDrawableOffsets.PushBack(_offscreenChildDrawableIndices.GetSize());
+}
+
 void CubismRenderer_OpenGLES2::PreDraw()
 {
 #ifdef CSM_TARGET_WIN_GL
@@ -721,36 +829,17 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
     GLint lastFBO;
     GLint lastViewport[4];
 
+    BeginGpuTiming();
+
     BeforeDrawModelRenderTarget();
     // モデル描画直前のFBOとビューポートを保存
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &lastFBO);
     glGetIntegerv(GL_VIEWPORT, lastViewport);
 
-    //------------ クリッピングマスク・バッファ前処理方式の場合 ------------
-    if (_drawableClippingManager != NULL)
-    {
-        PreDraw();
-
-        // サイズが違う場合はここで作成しなおし
-        for (csmInt32 i = 0; i < _drawableClippingManager->GetRenderTextureCount(); ++i)
-        {
-            if (_drawableMasks[i].GetBufferWidth() != static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().X) ||
-                _drawableMasks[i].GetBufferHeight() != static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().Y))
-            {
-                _drawableMasks[i].CreateRenderTarget(
-                    static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().X), static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().Y));
-            }
-        }
+    const csmInt32 maskSection = BeginGpuTimingSection(CubismGpuTimer::SectionType_Mask, 0);
 
-        if (IsUsingHighPrecisionMask())
-        {
-            _drawableClippingManager->SetupMatrixForHighPrecision(*GetModel(), false, DrawableObjectType_Drawable);
-        }
-        else
-        {
-            _drawableClippingManager->SetupClippingContext(*GetModel(), this, lastFBO, lastViewport, DrawableObjectType_Drawable);
-        }
-    }
+    //------------ クリッピングマスク・バッファ前処理方式の場合 ------------
+    SetupDrawableMasks(lastFBO, lastViewport);
 
     if (_offscreenClippingManager != NULL)
     {
@@ -777,15 +866,108 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
         }
     }
 
+    EndGpuTimingSection(maskSection);
+
     // 上記クリッピング処理内でも一度PreDrawを呼ぶので注意!!
     PreDraw();
 
     // モデルの描画順に従って描画する
+    const csmInt32 drawLoopSection = BeginGpuTimingSection(CubismGpuTimer::SectionType_DrawLoop, 0);
     DrawObjectLoop(lastFBO, lastViewport);
+    EndGpuTimingSection(drawLoopSection);
 
     PostDraw();
 
     AfterDrawModelRenderTarget();
+
+    EndGpuTiming();
+}
+
+void CubismRenderer_OpenGLES2::BeginGpuTiming()
+{
+    if (!IsUsingGpuTiming())
+    {
+        // 計測をやめたらクエリも解放する
+        if (_gpuTimer != NULL)
+        {
+            CSM_DELETE(_gpuTimer);
+            _gpuTimer = NULL;
+        }
+        return;
+    }
+
+    if (_gpuTimer == NULL)
+    {
+        _gpuTimer = CSM_NEW CubismGpuTimer_OpenGLES2();
+    }
+
+    _gpuTimer->BeginFrame(GetModel()->GetOffscreenCount());
+}
+
+void CubismRenderer_OpenGLES2::EndGpuTiming()
+{
+    if (_gpuTimer != NULL)
+    {
+        _gpuTimer->EndFrame();
+    }
+}
+
+csmInt32 CubismRenderer_OpenGLES2::BeginGpuTimingSection(CubismGpuTimer::SectionType type, csmInt32 index)
+{
+    if (_gpuTimer == NULL)
+    {
+        return -1;
+    }
+
+    return _gpuTimer->BeginSection(type, index);
+}
+
+void CubismRenderer_OpenGLES2::EndGpuTimingSection(csmInt32 section)
+{
+    if (_gpuTimer != NULL)
+    {
+        _gpuTimer->EndSection(section);
+    }
+}
+
+const CubismRenderer::CubismGpuTimingStats& CubismRenderer_OpenGLES2::GetGpuTimingStats() const
+{
+    if (_gpuTimer == NULL)
+    {
+        return CubismRenderer::GetGpuTimingStats();
+    }
+
+    return _gpuTimer->GetStats();
+}
+
+void CubismRenderer_OpenGLES2::SetupDrawableMasks(GLint lastFBO, GLint lastViewport[4])
+{
+    // シーン共有のアトラスを使う場合、マスクはアトラスの描画時に生成済み
+    if (_drawableClippingManager != NULL && !IsUsingSceneMaskAtlas())
+    {
+        PreDraw();
+
+        // 未作成かサイズが違う場合はここで作成しなおし
+        for (csmInt32 i = 0; i < _drawableClippingManager->GetRenderTextureCount(); ++i)
+        {
+            if (!_drawableMasks[i].IsValid() ||
+                _drawableMasks[i].GetBufferWidth() != static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().X) ||
+                _drawableMasks[i].GetBufferHeight() != static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().Y))
+            {
+                _drawableMasks[i].CreateRenderTarget(
+                    static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().X), static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().Y));
+            }
+        }
+
+        if (IsUsingHighPrecisionMask())
+        {
+            _drawableClippingManager->SetupMatrixForHighPrecision(*GetModel(), false, DrawableObjectType_Drawable);
+        }
+        else
+        {
+            _drawableClippingManager->SetupClippingContext(*GetModel(), this, lastFBO, lastViewport, DrawableObjectType_Drawable);
+        }
+    }
 }
 
 void CubismRenderer_OpenGLES2::DrawObjectLoop(GLint lastFBO, GLint lastViewport[4])
@@ -830,6 +1012,13 @@ void CubismRenderer_OpenGLES2::DrawObjectLoop(GLint lastFBO, GLint lastViewport[
         // オフスクリーンが残っている場合は親オフスクリーンへの伝搬を行う
         SubmitDrawToParentOffscreen(_currentOffscreen->GetOffscreenIndex(), DrawableObjectType_Offscreen);
     }
+
+    // コピー用に借りていたレンダーターゲットを返却する
+    if (_blendCopyRenderTarget != NULL)
+    {
+        CubismOffscreenManager_OpenGLES2::GetInstance()->StopUsingRenderTexture(_blendCopyRenderTarget);
+        _blendCopyRenderTarget = NULL;
+    }
 }
 
 void CubismRenderer_OpenGLES2::RenderObject(const csmInt32 objectIndex, const csmInt32 objectType)
@@ -1012,7 +1201,9 @@ void CubismRenderer_OpenGLES2::AddOffscreen(csmInt32 offscreenIndex)
     }
 
     CubismOffscreenRenderTarget_OpenGLES2* offscreen = &_offscreenList.At(offscreenIndex);
-    offscreen->SetOffscreenRenderTarget(_modelRenderTargetWidth, _modelRenderTargetHeight);
+
+    // 子孫Drawableを囲む範囲だけのレンダーターゲットを確保する
+    UpdateOffscreenDrawRect(offscreen);
 
     // 以前のオフスクリーンレンダリングターゲットを取得
     CubismOffscreenRenderTarget_OpenGLES2* oldOffscreen = offscreen->GetParentPartOffscreen();
@@ -1032,7 +1223,7 @@ void CubismRenderer_OpenGLES2::AddOffscreen(csmInt32 offscreenIndex)
 
     // 別バッファに描画を開始
     offscreen->GetRenderTarget()->BeginDraw(oldFBO);
-    glViewport(0, 0, _modelRenderTargetWidth, _modelRenderTargetHeight);
+    glViewport(0, 0, offscreen->GetRenderTarget()->GetBufferWidth(), offscreen->GetRenderTarget()->GetBufferHeight());
     offscreen->GetRenderTarget()->Clear(0.0f, 0.0f, 0.0f, 0.0f);
 
     // 現在のオフスクリーンレンダリングターゲットを設定
@@ -1040,9 +1231,91 @@ void CubismRenderer_OpenGLES2::AddOffscreen(csmInt32 offscreenIndex)
     _currentFBO = offscreen->GetRenderTarget()->GetRenderTexture();
 }
 
+void CubismRenderer_OpenGLES2::UpdateOffscreenDrawRect(CubismOffscreenRenderTarget_OpenGLES2* offscreen)
+{
+    const csmInt32 canvasWidth = static_cast<csmInt32>(_modelRenderTargetWidth);
+    const csmInt32 canvasHeight = static_cast<csmInt32>(_modelRenderTargetHeight);
+    const csmInt32 offscreenIndex = offscreen->GetOffscreenIndex();
+    CubismMatrix44 mvp = GetMvpMatrix();
+    const csmFloat32* m = mvp.GetArray();
+
+    // 表示中の子孫Drawableの頂点をモデル描画先のピクセル座標に変換して範囲を求める
+    csmFloat32 minX = FLT_MAX, minY = FLT_MAX;
+    csmFloat32 maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (csmInt32 i = _offscreenChildDrawableOffsets[offscreenIndex]; i < _offscreenChildDrawableOffsets[offscreenIndex + 1]; ++i)
+    {
+        const csmInt32 drawableIndex = _offscreenChildDrawableIndices[i];
+        if (!GetModel()->GetDrawableDynamicFlagIsVisible(drawableIndex))
+        {
+            continue;
+        }
+
+        const csmInt32 vertexCount = GetModel()->GetDrawableVertexCount(drawableIndex);
+        const csmFloat32* vertices = GetModel()->GetDrawableVertices(drawableIndex);
+        const csmInt32 loop = vertexCount * Constant::VertexStep;
+        for (csmInt32 pi = Constant::VertexOffset; pi < loop; pi += Constant::VertexStep)
+        {
+            const csmFloat32 x = vertices[pi];
+            const csmFloat32 y = vertices[pi + 1];
+            csmFloat32 w = m[3] * x + m[7] * y + m[15];
+            if (w == 0.0f)
+            {
+                w = 1.0f;
+            }
+            const csmFloat32 pixelX = ((m[0] * x + m[4] * y + m[12]) / w * 0.5f + 0.5f) * canvasWidth;
+            const csmFloat32 pixelY = ((m[1] * x + m[5] * y + m[13]) / w * 0.5f + 0.5f) * canvasHeight;
+
+            minX = (pixelX < minX) ? pixelX : minX;
+            minY = (pixelY < minY) ? pixelY : minY;
+            maxX = (pixelX > maxX) ? pixelX : maxX;
+            maxY = (pixelY > maxY) ? pixelY : maxY;
+        }
+    }
+
+    csmInt32 left = 0;
+    csmInt32 bottom = 0;
+    csmInt32 right = 0;
+    csmInt32 top = 0;
+    if (minX <= maxX && minY <= maxY)
+    {
+        // 外側に丸めた上で1ピクセルの余白を取り、モデル描画先の範囲に収める
+        left = static_cast<csmInt32>(CubismMath::Max(floorf(minX) - 1.0f, 0.0f));
+        bottom = static_cast<csmInt32>(CubismMath::Max(floorf(minY) - 1.0f, 0.0f));
+        right = static_cast<csmInt32>(CubismMath::Min(ceilf(maxX) + 1.0f, static_cast<csmFloat32>(canvasWidth)));
+        top = static_cast<csmInt32>(CubismMath::Min(ceilf(maxY) + 1.0f, static_cast<csmFloat32>(canvasHeight)));
+    }
+
+    // 描画範囲が毎フレーム僅かに変化してもレンダーターゲットを再利用できるよう、幅・高さをプールの単位に切り上げる
+    // モデル描画先を超える場合はその軸全体を使用する
+    const CubismOffscreenManager_OpenGLES2* offscreenManager = CubismOffscreenManager_OpenGLES2::GetInstance();
+    csmInt32 width = static_cast<csmInt32>(offscreenManager->GetBucketedSize((right - left > 1) ? right - left : 1));
+    csmInt32 height = static_cast<csmInt32>(offscreenManager->GetBucketedSize((top - bottom > 1) ? top - bottom : 1));
+    if (width >= canvasWidth)
+    {
+        left = 0;
+        width = canvasWidth;
+    }
+    else if (left + width > canvasWidth)
+    {
+        left = canvasWidth - width;
+    }
+    if (height >= canvasHeight)
+    {
+        bottom = 0;
+        height = canvasHeight;
+    }
+    else if (bottom + height > canvasHeight)
+    {
+        bottom = canvasHeight - height;
+    }
+
+    offscreen->SetDrawRect(left, bottom, width, height, _modelRenderTargetWidth, _modelRenderTargetHeight);
+}
+
 void CubismRenderer_OpenGLES2::DrawOffscreen(CubismOffscreenRenderTarget_OpenGLES2* currentOffscreen)
 {
     csmInt32 offscreenIndex = currentOffscreen->GetOffscreenIndex();
+    const csmInt32 offscreenSection = BeginGpuTimingSection(CubismGpuTimer::SectionType_Offscreen, offscreenIndex);
     // クリッピングマスク
     CubismClippingContext_OpenGLES2* clipContext = (_offscreenClippingManager != NULL) ?
         (*_offscreenClippingManager->GetClippingContextListForOffscreen())[offscreenIndex] :
@@ -1109,6 +1382,8 @@ void CubismRenderer_OpenGLES2::DrawOffscreen(CubismOffscreenRenderTarget_OpenGLE
     IsCulling(GetModel()->GetOffscreenCulling(offscreenIndex) != 0);
 
     DrawOffscreenOpenGL(*GetModel(), currentOffscreen);
+
+    EndGpuTimingSection(offscreenSection);
 }
 
 void CubismRenderer_OpenGLES2::DrawMeshOpenGL(const CubismModel& model, const csmInt32 index)
@@ -1155,6 +1430,9 @@ void CubismRenderer_OpenGLES2::DrawMeshOpenGL(const CubismModel& model, const cs
         csmInt32 indexCount = model.GetDrawableVertexIndexCount(index);
         csmUint16* indexArray = const_cast<csmUint16*>(model.GetDrawableVertexIndices(index));
         glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, indexArray);
+
+        CSM_PROFILE_COUNT(Counter_DrawCalls, 1);
+        CSM_PROFILE_COUNT(Counter_VertexBytes, model.GetDrawableVertexCount(index) * sizeof(csmFloat32) * 4 + indexCount * sizeof(csmUint16));
     }
 
     // 後処理
@@ -1165,6 +1443,8 @@ void CubismRenderer_OpenGLES2::DrawMeshOpenGL(const CubismModel& model, const cs
 
 void CubismRenderer_OpenGLES2::DrawOffscreenOpenGL(const CubismModel& model, CubismOffscreenRenderTarget_OpenGLES2* offscreen)
 {
+    CSM_PROFILE_ZONE(Zone_OffscreenComposite, &model);
+
 
 #ifdef CSM_TARGET_WIN_GL
     if (s_isFirstInitializeGlFunctions)
@@ -1193,6 +1473,7 @@ void CubismRenderer_OpenGLES2::DrawOffscreenOpenGL(const CubismModel& model, Cub
 
     // ポリゴンメッシュを描画する
     glDrawElements(GL_TRIANGLES, sizeof(ModelRenderTargetIndexArray) / sizeof(csmUint16), GL_UNSIGNED_SHORT, ModelRenderTargetIndexArray);
+    CSM_PROFILE_COUNT(Counter_DrawCalls, 1);
 
     // 後処理
     offscreen->StopUsingRenderTexture();
@@ -1213,6 +1494,28 @@ void CubismRenderer_OpenGLES2::RestoreProfile()
 
 void CubismRenderer_OpenGLES2::BeforeDrawModelRenderTarget()
 {
+    if (!GetModel()->IsBlendModeEnabled())
+    {
+        // インポスター描画ではモデル描画先の内容をキャッシュとして使うため、ブレンドモードを使わないモデルでも作成する
+        if (IsUsingImpostor() && _modelRenderTargets.GetSize() == 0)
+        {
+            // サイズは下で設定する
+            const csmInt32 createSize = CanUseTextureBarrier() ? 1 : 2;
+            for (csmInt32 i = 0; i < createSize; ++i)
+            {
+                _modelRenderTargets.PushBack(CubismRenderTarget_OpenGLES2());
+            }
+        }
+        else if (!IsUsingImpostor() && _modelRenderTargets.GetSize() > 0)
+        {
+            for (csmUint32 i = 0; i < _modelRenderTargets.GetSize(); ++i)
+            {
+                _modelRenderTargets[i].DestroyRenderTarget();
+            }
+            _modelRenderTargets.Clear();
+        }
+    }
+
     if (_modelRenderTargets.GetSize() == 0)
     {
         return;
@@ -1246,12 +1549,140 @@ void CubismRenderer_OpenGLES2::AfterDrawModelRenderTarget()
     CubismShader_OpenGLES2::GetInstance()->SetupShaderProgramForOffscreenRenderTarget(this);
 
     glDrawElements(GL_TRIANGLES, sizeof(ModelRenderTargetIndexArray) / sizeof(csmUint16), GL_UNSIGNED_SHORT, ModelRenderTargetIndexArray);
+    CSM_PROFILE_COUNT(Counter_DrawCalls, 1);
+
+    glUseProgram(0);
+}
+
+csmBool CubismRenderer_OpenGLES2::DrawImpostor()
+{
+    if (_modelRenderTargets.GetSize() == 0 || !_modelRenderTargets[0].IsValid())
+    {
+        return false;
+    }
+
+    PreDraw();
+    glViewport(0, 0, _modelRenderTargetWidth, _modelRenderTargetHeight);
+
+    // モデル描画先には描画しないため、コピーせずに直接参照する
+    CubismShader_OpenGLES2::GetInstance()->SetupShaderProgramForOffscreenRenderTarget(this, _modelRenderTargets[0].GetColorBuffer());
+
+    glDrawElements(GL_TRIANGLES, sizeof(ModelRenderTargetIndexArray) / sizeof(csmUint16), GL_UNSIGNED_SHORT, ModelRenderTargetIndexArray);
+    CSM_PROFILE_COUNT(Counter_DrawCalls, 1);
 
     glUseProgram(0);
+
+    return true;
+}
+
+csmBool CubismRenderer_OpenGLES2::DrawDirtyRect(const csmRectF& dirtyRect)
+{
+    // 高精細マスクはアートメッシュごとにPreDrawを呼ぶため、シザーが外れてしまう
+    if (_modelRenderTargets.GetSize() == 0 || !_modelRenderTargets[0].IsValid() || IsUsingHighPrecisionMask())
+    {
+        return false;
+    }
+
+    // NDCからピクセルに変換し、補間でにじむ分として1ピクセル広げる
+    const csmFloat32 width = static_cast<csmFloat32>(_modelRenderTargetWidth);
+    const csmFloat32 height = static_cast<csmFloat32>(_modelRenderTargetHeight);
+    csmInt32 left = static_cast<csmInt32>(floorf((dirtyRect.X * 0.5f + 0.5f) * width)) - 1;
+    csmInt32 bottom = static_cast<csmInt32>(floorf((dirtyRect.Y * 0.5f + 0.5f) * height)) - 1;
+    csmInt32 right = static_cast<csmInt32>(ceilf((dirtyRect.GetRight() * 0.5f + 0.5f) * width)) + 1;
+    csmInt32 top = static_cast<csmInt32>(ceilf((dirtyRect.GetBottom() * 0.5f + 0.5f) * height)) + 1;
+    left = (left < 0) ? 0 : left;
+    bottom = (bottom < 0) ? 0 : bottom;
+    right = (right > static_cast<csmInt32>(_modelRenderTargetWidth)) ? static_cast<csmInt32>(_modelRenderTargetWidth) : right;
+    top = (top > static_cast<csmInt32>(_modelRenderTargetHeight)) ? static_cast<csmInt32>(_modelRenderTargetHeight) : top;
+
+    // モデル描画先に描画を開始
+    _modelRenderTargets[0].BeginDraw();
+    glViewport(0, 0, _modelRenderTargetWidth, _modelRenderTargetHeight);
+
+    GLint lastFBO;
+    GLint lastViewport[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &lastFBO);
+    glGetIntegerv(GL_VIEWPORT, lastViewport);
+
+    // マスクは範囲外のアートメッシュの分も含めて生成しなおす
+    SetupDrawableMasks(lastFBO, lastViewport);
+
+    // 上記クリッピング処理内でもPreDrawを呼ぶので、シザーはその後で設定する
+    PreDraw();
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(left, bottom, right - left, top - bottom);
+    _modelRenderTargets[0].Clear(0.0f, 0.0f, 0.0f, 0.0f);
+
+    _currentOffscreen = NULL;
+    _currentFBO = lastFBO;
+    _modelRootFBO = lastFBO;
+
+    // 範囲にかかるアートメッシュだけをモデルの描画順に従って描画する
+    const csmInt32 drawableCount = GetModel()->GetDrawableCount();
+    const csmInt32* renderOrder = GetModel()->GetRenderOrders();
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        _sortedObjectsIndexList[renderOrder[i]] = i;
+    }
+
+    for (csmInt32 i = 0; i < drawableCount; ++i)
+    {
+        const csmInt32 drawableIndex = _sortedObjectsIndexList[i];
+        if (IsDrawableInDirtyRect(drawableIndex))
+        {
+            DrawDrawable(drawableIndex);
+        }
+    }
+
+    glDisable(GL_SCISSOR_TEST);
+    _modelRenderTargets[0].EndDraw();
+
+    return DrawImpostor();
+}
+
+void CubismRenderer_OpenGLES2::ApplyAdaptiveClippingMaskSize(csmUint32 size)
+{
+    if (_drawableClippingManager != NULL &&
+        _drawableClippingManager->GetClippingMaskBufferSize().X != static_cast<csmFloat32>(size))
+    {
+        // 保持していたフレームバッファが新しいサイズのものであれば入れ替え、そうでなければ今のものを保持して作り直させる
+        const csmBool isSpareReusable = _spareDrawableMasks.GetSize() == _drawableMasks.GetSize() &&
+                                        _spareDrawableMasks.GetSize() > 0 &&
+                                        _spareDrawableMasks[0].GetBufferWidth() == size;
+        for (csmUint32 i = 0; i < _drawableMasks.GetSize(); ++i)
+        {
+            if (!isSpareReusable && i < _spareDrawableMasks.GetSize() && _spareDrawableMasks[i].IsValid())
+            {
+                _spareDrawableMasks[i].DestroyRenderTarget();
+            }
+            if (i >= _spareDrawableMasks.GetSize())
+            {
+                _spareDrawableMasks.PushBack(CubismRenderTarget_OpenGLES2());
+            }
+
+            const CubismRenderTarget_OpenGLES2 current = _drawableMasks[i];
+            _drawableMasks[i] = isSpareReusable ? _spareDrawableMasks[i] : CubismRenderTarget_OpenGLES2();
+            _spareDrawableMasks[i] = current;
+        }
+
+        // フレームバッファはマスクの生成時にサイズを確認して作成する
+        _drawableClippingManager->SetClippingMaskBufferSize(static_cast<csmFloat32>(size), static_cast<csmFloat32>(size));
+    }
+
+    if (_offscreenClippingManager != NULL)
+    {
+        _offscreenClippingManager->SetClippingMaskBufferSize(static_cast<csmFloat32>(size), static_cast<csmFloat32>(size));
+    }
 }
 
 void CubismRenderer_OpenGLES2::BindTexture(csmUint32 modelTextureIndex, GLuint glTextureIndex)
 {
+    // 差し替えたテクスチャはインポスターのキャッシュに反映されていない
+    if (!_textures.IsExist(modelTextureIndex) || _textures[modelTextureIndex] != glTextureIndex)
+    {
+        InvalidateImpostor();
+    }
+
     _textures[modelTextureIndex] = glTextureIndex;
 }
 
@@ -1333,7 +1764,17 @@ const CubismRenderTarget_OpenGLES2* CubismRenderer_OpenGLES2::CopyOffscreenRende
     return CopyRenderTarget(_modelRenderTargets[0]);
 }
 
+const CubismRenderTarget_OpenGLES2* CubismRenderer_OpenGLES2::CopyOffscreenRenderTarget(const csmRectF& bounds)
+{
+    return CopyRenderTarget(_modelRenderTargets[0], bounds);
+}
+
 const CubismRenderTarget_OpenGLES2* CubismRenderer_OpenGLES2::CopyRenderTarget(const CubismRenderTarget_OpenGLES2& srcBuffer)
+{
+    return CopyRenderTarget(srcBuffer, csmRectF(-1.0f, -1.0f, 2.0f, 2.0f));
+}
+
+const CubismRenderTarget_OpenGLES2* CubismRenderer_OpenGLES2::CopyRenderTarget(const CubismRenderTarget_OpenGLES2& srcBuffer, const csmRectF& bounds)
 {
 #if defined(GLEW_ARB_texture_barrier)
     if (GLEW_ARB_texture_barrier)
@@ -1350,25 +1791,81 @@ const CubismRenderTarget_OpenGLES2* CubismRenderer_OpenGLES2::CopyRenderTarget(c
 #endif
 
     // textureBarrierが無効な場合は、オフスクリーンの内容をコピーしてから描画する
+    // オフスクリーンは描画範囲に合わせたサイズのため、同じサイズのコピー先を借りて等倍でコピーする
+    CubismRenderTarget_OpenGLES2* dstBuffer = &_modelRenderTargets[1];
+    if (srcBuffer.GetBufferWidth() != dstBuffer->GetBufferWidth() || srcBuffer.GetBufferHeight() != dstBuffer->GetBufferHeight())
+    {
+        if (_blendCopyRenderTarget != NULL &&
+            (_blendCopyRenderTarget->GetBufferWidth() != srcBuffer.GetBufferWidth() || _blendCopyRenderTarget->GetBufferHeight() != srcBuffer.GetBufferHeight()))
+        {
+            CubismOffscreenManager_OpenGLES2::GetInstance()->StopUsingRenderTexture(_blendCopyRenderTarget);
+            _blendCopyRenderTarget = NULL;
+        }
+
+        if (_blendCopyRenderTarget == NULL)
+        {
+            _blendCopyRenderTarget = CubismOffscreenManager_OpenGLES2::GetInstance()->GetOffscreenRenderTarget(srcBuffer.GetBufferWidth(), srcBuffer.GetBufferHeight());
+        }
+
+        dstBuffer = _blendCopyRenderTarget;
+    }
+
+    // ブレンドで参照されるのは描画オブジェクトが覆う画素だけなので、その矩形だけをコピーする
+    // NDCからピクセルに変換し、補間でにじむ分として1ピクセル広げる
+    const csmInt32 width = static_cast<csmInt32>(srcBuffer.GetBufferWidth());
+    const csmInt32 height = static_cast<csmInt32>(srcBuffer.GetBufferHeight());
+    csmInt32 left = static_cast<csmInt32>(floorf((bounds.X * 0.5f + 0.5f) * width)) - 1;
+    csmInt32 bottom = static_cast<csmInt32>(floorf((bounds.Y * 0.5f + 0.5f) * height)) - 1;
+    csmInt32 right = static_cast<csmInt32>(ceilf((bounds.GetRight() * 0.5f + 0.5f) * width)) + 1;
+    csmInt32 top = static_cast<csmInt32>(ceilf((bounds.GetBottom() * 0.5f + 0.5f) * height)) + 1;
+    left = (left < 0) ? 0 : left;
+    bottom = (bottom < 0) ? 0 : bottom;
+    right = (right > width) ? width : right;
+    top = (top > height) ? height : top;
+
+    if (right <= left || top <= bottom)
+    {
+        return dstBuffer;
+    }
+
 #if defined(CSM_TARGET_ANDROID_ES2) || defined(CSM_TARGET_IPHONE_ES2)
-    _modelRenderTargets[1].BeginDraw();
-    glViewport(0, 0, _modelRenderTargetWidth, _modelRenderTargetHeight);
+    // 描画中のシザーを上書きしないよう退避しておく
+    const GLboolean isScissorEnabled = glIsEnabled(GL_SCISSOR_TEST);
+    GLint lastScissorBox[4];
+    glGetIntegerv(GL_SCISSOR_BOX, lastScissorBox);
+
+    dstBuffer->BeginDraw();
+    glViewport(0, 0, dstBuffer->GetBufferWidth(), dstBuffer->GetBufferHeight());
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(left, bottom, right - left, top - bottom);
 
     CubismShader_OpenGLES2::GetInstance()->CopyTexture(srcBuffer.GetColorBuffer());
     glDrawElements(GL_TRIANGLES, sizeof(ModelRenderTargetIndexArray) / sizeof(csmUint16), GL_UNSIGNED_SHORT, ModelRenderTargetIndexArray);
+    CSM_PROFILE_COUNT(Counter_DrawCalls, 1);
 
-    _modelRenderTargets[1].EndDraw();
+    glScissor(lastScissorBox[0], lastScissorBox[1], lastScissorBox[2], lastScissorBox[3]);
+    if (!isScissorEnabled)
+    {
+        glDisable(GL_SCISSOR_TEST);
+    }
+
+    dstBuffer->EndDraw();
 
-    return &_modelRenderTargets[1];
+    return dstBuffer;
 #else
-    CubismRenderTarget_OpenGLES2::CopyBuffer(srcBuffer, _modelRenderTargets[1]);
+    CubismRenderTarget_OpenGLES2::CopyBuffer(srcBuffer, *dstBuffer, left, bottom, right - left, top - bottom);
 
-    return &_modelRenderTargets[1];
+    return dstBuffer;
 #endif
 }
 
 CubismRenderTarget_OpenGLES2* CubismRenderer_OpenGLES2::GetDrawableMaskBuffer(csmInt32 index)
 {
+    if (IsUsingSceneMaskAtlas())
+    {
+        return _sceneMaskAtlas->GetRenderTarget();
+    }
+
     return &_drawableMasks[index];
 }
 
@@ -1382,6 +1879,58 @@ CubismOffscreenRenderTarget_OpenGLES2* CubismRenderer_OpenGLES2::GetCurrentOffsc
     return _currentOffscreen;
 }
 
+void CubismRenderer_OpenGLES2::SetSceneMaskAtlas(CubismSceneMaskAtlas_OpenGLES2* atlas)
+{
+    if (_sceneMaskAtlas == atlas)
+    {
+        return;
+    }
+
+    if (_sceneMaskAtlas != NULL)
+    {
+        _sceneMaskAtlas->UnregisterRenderer(this);
+    }
+
+    _sceneMaskAtlas = atlas;
+    _isSceneMaskAtlasRegionAssigned = false;
+
+    if (_sceneMaskAtlas == NULL)
+    {
+        return;
+    }
+
+    _sceneMaskAtlas->RegisterRenderer(this);
+
+    // 個別のマスク用バッファは解放しておき、アトラスに収まらなかった場合にだけ描画時に作成しなおす
+    for (csmUint32 i = 0; i < _drawableMasks.GetSize(); ++i)
+    {
+        if (_drawableMasks[i].IsValid())
+        {
+            _drawableMasks[i].DestroyRenderTarget();
+        }
+    }
+}
+
+CubismSceneMaskAtlas_OpenGLES2* CubismRenderer_OpenGLES2::GetSceneMaskAtlas() const
+{
+    return _sceneMaskAtlas;
+}
+
+void CubismRenderer_OpenGLES2::DrawSceneMaskAtlas(GLint lastFBO, GLint lastViewport[4])
+{
+    if (GetModel() == NULL || _drawableClippingManager == NULL)
+    {
+        return;
+    }
+
+    _drawableClippingManager->SetupClippingContext(*GetModel(), this, lastFBO, lastViewport, DrawableObjectType_Drawable, _sceneMaskAtlas);
+}
+
+csmBool CubismRenderer_OpenGLES2::IsUsingSceneMaskAtlas()
+{
+    return _sceneMaskAtlas != NULL && _isSceneMaskAtlasRegionAssigned && !IsUsingHighPrecisionMask();
+}
+
 void CubismRenderer_OpenGLES2::SetClippingContextBufferForMask(CubismClippingContext_OpenGLES2* clip)
 {
     _clippingContextBufferForMask = clip;
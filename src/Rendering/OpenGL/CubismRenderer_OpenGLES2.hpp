@@ -9,6 +9,7 @@
 
 #include "../CubismRenderer.hpp"
 #include "../CubismClippingManager.hpp"
+#include "../CubismGpuTimer.hpp"
 #include "CubismFramework.hpp"
 #include "CubismRenderTarget_OpenGLES2.hpp"
 #include "CubismOffscreenRenderTarget_OpenGLES2.hpp"
@@ -54,6 +55,9 @@ namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering
 class CubismRenderer_OpenGLES2;
 class CubismClippingContext_OpenGLES2;
 class CubismShader_OpenGLES2;
+class CubismSceneMaskAtlas_OpenGLES2;
+class CubismInstancedRenderer_OpenGLES2;
+class CubismGpuTimer_OpenGLES2;
 
 /**
  * @brief  クリッピングマスクの処理を実行するクラス
@@ -71,8 +75,9 @@ public:
      * @param[in]   lastFBO            ->  フレームバッファ
      * @param[in]   lastViewport       ->  ビューポート
      * @param[in]   drawableObjectType ->  描画オブジェクトのタイプ
+     * @param[in]   atlas              ->  マスクを描き込むシーン共有のアトラス。NULLの場合はレンダラのマスク用バッファに描く
      */
-    void SetupClippingContext(CubismModel& model, CubismRenderer_OpenGLES2* renderer, GLint lastFBO, GLint lastViewport[4], CubismRenderer::DrawableObjectType drawableObjectType);
+    void SetupClippingContext(CubismModel& model, CubismRenderer_OpenGLES2* renderer, GLint lastFBO, GLint lastViewport[4], CubismRenderer::DrawableObjectType drawableObjectType, CubismSceneMaskAtlas_OpenGLES2* atlas = NULL);
 };
 
 /**
@@ -116,6 +121,8 @@ public:
 class CubismRendererProfile_OpenGLES2
 {
     friend class CubismRenderer_OpenGLES2;
+    friend class CubismSceneMaskAtlas_OpenGLES2;
+    friend class CubismInstancedRenderer_OpenGLES2;
 
 private:
     /**
@@ -181,6 +188,8 @@ class CubismRenderer_OpenGLES2 : public CubismRenderer
     friend class CubismRenderer;
     friend class CubismClippingManager_OpenGLES2;
     friend class CubismShader_OpenGLES2;
+    friend class CubismSceneMaskAtlas_OpenGLES2;
+    friend class CubismInstancedRenderer_OpenGLES2;
 
 public:
     /**
@@ -208,6 +217,15 @@ public:
      */
     void SetupParentOffscreens(const CubismModel* model, csmInt32 offscreenCount);
 
+    /**
+     * @brief   オフスクリーンごとに、描画対象となる子孫Drawableのインデックスを収集する。<br>
+     *           オフスクリーンの描画範囲の計算に使用する。
+     *
+     * @param[in]   model           ->  モデルのインスタンス
+     * @param[in]   offscreenCount  ->  オフスクリーンの数
+     */
+    void SetupOffscreenChildDrawables(const CubismModel* model, csmInt32 offscreenCount);
+
     /**
      * @brief   OpenGLテクスチャのバインド処理<br>
      *           CubismRendererにテクスチャを設定し、CubismRenderer中でその画像を参照するためのIndex値を戻り値とする
@@ -278,6 +296,15 @@ public:
      */
     const CubismRenderTarget_OpenGLES2* CopyOffscreenRenderTarget();
 
+    /**
+     * @brief  オフスクリーンのバッファの指定範囲をコピーする
+     *
+     * @param bounds    コピーする範囲（モデル描画先のNDC座標）
+     *
+     * @return オフスクリーンのバッファへのポインタ。範囲外の内容は不定
+     */
+    const CubismRenderTarget_OpenGLES2* CopyOffscreenRenderTarget(const csmRectF& bounds);
+
     /**
      * @brief  任意のバッファをコピーする
      *
@@ -287,6 +314,17 @@ public:
      */
     const CubismRenderTarget_OpenGLES2* CopyRenderTarget(const CubismRenderTarget_OpenGLES2& srcBuffer);
 
+    /**
+     * @brief  任意のバッファの指定範囲をコピーする<br>
+     *          テクスチャバリアが使える場合はコピーせずにコピー元を返す
+     *
+     * @param srcBuffer コピー元のバッファ
+     * @param bounds    コピーする範囲（コピー元のNDC座標）
+     *
+     * @return コピー後のバッファへのポインタ。範囲外の内容は不定
+     */
+    const CubismRenderTarget_OpenGLES2* CopyRenderTarget(const CubismRenderTarget_OpenGLES2& srcBuffer, const csmRectF& bounds);
+
     /**
      * @brief  描画オブジェクトのクリッピングマスクのバッファを取得する
      *
@@ -308,6 +346,29 @@ public:
      */
     CubismOffscreenRenderTarget_OpenGLES2* GetCurrentOffscreen() const;
 
+    /**
+     * @brief  描画オブジェクトのクリッピングマスクをシーン共有のアトラスに描くように設定する<br>
+     *         アトラスを使う間はレンダラ個別のマスク用バッファを解放する。NULLを渡すと個別のマスクに戻す
+     *
+     * @param[in]   atlas   ->  シーン共有のマスクのアトラス
+     */
+    void SetSceneMaskAtlas(CubismSceneMaskAtlas_OpenGLES2* atlas);
+
+    /**
+     * @brief  描画オブジェクトのクリッピングマスクを描くシーン共有のアトラスを取得する
+     *
+     * @return シーン共有のマスクのアトラス。設定されていなければNULL
+     */
+    CubismSceneMaskAtlas_OpenGLES2* GetSceneMaskAtlas() const;
+
+    /**
+     * @brief   GPUでの描画時間の最新の計測結果を取得する。<br>
+     *           タイマークエリの拡張がない環境では結果は得られない。
+     *
+     * @return  計測結果。まだ結果がない場合は IsValid がfalse
+     */
+    const CubismGpuTimingStats& GetGpuTimingStats() const override;
+
 protected:
     /**
      * @brief   コンストラクタ
@@ -328,6 +389,15 @@ protected:
      */
     virtual void DoDrawModel() override;
 
+    /**
+     * @brief   描画オブジェクト（アートメッシュ）のクリッピングマスクを生成する<br>
+     *          シーン共有のアトラスを使う場合、マスクはアトラスの描画時に生成済みのため何もしない
+     *
+     * @param[in]   lastFBO        ->  モデル描画直前のフレームバッファ
+     * @param[in]   lastViewport   ->  モデル描画直前のビューポート
+     */
+    void SetupDrawableMasks(GLint lastFBO, GLint lastViewport[4]);
+
     /**
      * @brief   描画オブジェクト（アートメッシュ、オフスクリーン）を描画するループ処理
      *
@@ -336,6 +406,21 @@ protected:
      */
     void DrawObjectLoop(GLint lastFBO, GLint lastViewport[4]);
 
+    /**
+     * @brief   描画オブジェクトのクリッピングマスクをシーン共有のアトラスに描く
+     *
+     * @param[in]   lastFBO        ->  アトラス描画直前のフレームバッファ
+     * @param[in]   lastViewport   ->  アトラス描画直前のビューポート
+     */
+    void DrawSceneMaskAtlas(GLint lastFBO, GLint lastViewport[4]);
+
+    /**
+     * @brief   描画オブジェクトのクリッピングマスクにシーン共有のアトラスを使っているか
+     *
+     * @return  アトラスに領域が割り当てられていて、高精細マスクを使っていなければtrue
+     */
+    csmBool IsUsingSceneMaskAtlas();
+
     /**
      * @brief 各オブジェクトの描画処理を呼ぶ。
      *
@@ -366,6 +451,13 @@ protected:
      */
     void AddOffscreen(csmInt32 offscreenIndex);
 
+    /**
+     * @brief   オフスクリーンの子孫Drawableを囲む矩形を計算し、オフスクリーンの描画範囲として設定する。
+     *
+     * @param[in]   offscreen   ->  描画範囲を設定するオフスクリーン
+     */
+    void UpdateOffscreenDrawRect(CubismOffscreenRenderTarget_OpenGLES2* offscreen);
+
     /**
      * @brief   描画オブジェクト（オフスクリーン）を描画する。
      *
@@ -455,6 +547,32 @@ private:
      */
     virtual void AfterDrawModelRenderTarget();
 
+    /**
+     * @brief   前回モデル描画先に描画した内容をインポスターとして描画する
+     *
+     * @retval  true    ->  インポスターを描画した
+     * @retval  false   ->  モデル描画先が作成されていない
+     */
+    virtual csmBool DrawImpostor();
+
+    /**
+     * @brief   モデル描画先の変化した範囲をシザーでクリアして、範囲にかかるアートメッシュだけを描き直す
+     *
+     * @param[in]   dirtyRect   ->  描き直す範囲（NDC）
+     *
+     * @retval  true    ->  描き直して描画した
+     * @retval  false   ->  モデル描画先が作成されていないか、高精細マスクを使っている
+     */
+    virtual csmBool DrawDirtyRect(const csmRectF& dirtyRect);
+
+    /**
+     * @brief   自動で選んだクリッピングマスク用バッファのサイズを反映する<br>
+     *          直前のサイズのマスク用バッファは1組だけ保持しておき、サイズが戻った場合は作り直さずに使う
+     *
+     * @param[in]   size    ->  マスク用バッファの一辺のサイズ（ピクセル）
+     */
+    virtual void ApplyAdaptiveClippingMaskSize(csmUint32 size);
+
     /**
      * @brief   マスクテクスチャに描画するクリッピングコンテキストをセットする。
      *
@@ -504,6 +622,34 @@ private:
      */
     const csmBool inline IsGeneratingMask() const;
 
+    /**
+     * @brief   GPUでの描画時間の計測を始める。<br>
+     *           計測が有効ならタイマーを用意し、無効になっていればタイマーを破棄する。
+     */
+    void BeginGpuTiming();
+
+    /**
+     * @brief   GPUでの描画時間の計測を終える。
+     */
+    void EndGpuTiming();
+
+    /**
+     * @brief   GPUでの描画時間を計測する区間を開始する。
+     *
+     * @param[in]   type    ->  区間の種類
+     * @param[in]   index   ->  オフスクリーンのインデックス。それ以外の区間では0
+     *
+     * @return  区間の番号。計測しない場合は-1
+     */
+    csmInt32 BeginGpuTimingSection(CubismGpuTimer::SectionType type, csmInt32 index);
+
+    /**
+     * @brief   GPUでの描画時間を計測する区間を終了する。
+     *
+     * @param[in]   section ->  BeginGpuTimingSection() が返した区間の番号
+     */
+    void EndGpuTimingSection(csmInt32 section);
+
     /**
      * @brief   テクスチャマップにバインドされたテクスチャIDを取得する。<br>
      *          バインドされていなければダミーとして-1が返される。
@@ -549,6 +695,7 @@ private:
     csmVector<CubismRenderTarget_OpenGLES2> _modelRenderTargets; ///< モデル全体を描画する先のフレームバッファ
 
     csmVector<CubismRenderTarget_OpenGLES2> _drawableMasks; ///< Drawableのマスク描画用のフレームバッファ
+    csmVector<CubismRenderTarget_OpenGLES2> _spareDrawableMasks; ///< マスク用バッファのサイズを自動で選ぶ場合に保持しておく直前のサイズのフレームバッファ
     csmVector<CubismRenderTarget_OpenGLES2> _offscreenMasks; ///< オフスクリーン機能マスク描画用のフレームバッファ
 
     csmVector<CubismOffscreenRenderTarget_OpenGLES2> _offscreenList; ///< モデルのオフスクリーン
@@ -556,6 +703,15 @@ private:
     CubismOffscreenRenderTarget_OpenGLES2* _currentOffscreen; ///< 現在のオフスクリーンのフレームバッファ
 
     GLint _modelRootFBO; ///< モデル描画のルートフレームバッファ
+
+    csmVector<csmInt32> _offscreenChildDrawableIndices; ///< オフスクリーンごとの子孫Drawableのインデックスを連結したリスト
+    csmVector<csmInt32> _offscreenChildDrawableOffsets; ///< _offscreenChildDrawableIndices内での各オフスクリーンの開始位置
+    CubismRenderTarget_OpenGLES2* _blendCopyRenderTarget; ///< モデル描画先と異なるサイズのオフスクリーンをコピーする際に借りるレンダーターゲット
+
+    CubismSceneMaskAtlas_OpenGLES2* _sceneMaskAtlas; ///< 描画オブジェクトのマスクを描くシーン共有のアトラス
+    csmBool _isSceneMaskAtlasRegionAssigned; ///< アトラス内にマスクの領域が割り当てられているか
+
+    CubismGpuTimer_OpenGLES2* _gpuTimer; ///< GPUでの描画時間を計測するタイマー。計測していなければNULL
 };
 
 }}}}
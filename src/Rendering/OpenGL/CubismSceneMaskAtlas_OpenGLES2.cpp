@@ -0,0 +1,247 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismSceneMaskAtlas_OpenGLES2.hpp"
+#include <math.h>
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+namespace {
+    const csmUint32 DefaultAtlasSize = 2048;       ///< アトラスの既定のサイズ
+    const csmFloat32 MinimumRegionScale = 0.125f;  ///< 要求サイズに対する縮小率の下限
+}
+
+CubismSceneMaskAtlas_OpenGLES2::CubismSceneMaskAtlas_OpenGLES2()
+    : _atlasSize(static_cast<csmFloat32>(DefaultAtlasSize), static_cast<csmFloat32>(DefaultAtlasSize))
+{
+}
+
+CubismSceneMaskAtlas_OpenGLES2::~CubismSceneMaskAtlas_OpenGLES2()
+{
+    // 登録されたままのレンダラは個別のマスクに戻す
+    for (csmUint32 i = 0; i < _renderers.GetSize(); ++i)
+    {
+        _renderers[i]->_sceneMaskAtlas = NULL;
+        _renderers[i]->_isSceneMaskAtlasRegionAssigned = false;
+    }
+    _renderers.Clear();
+
+    if (_renderTarget.IsValid())
+    {
+        _renderTarget.DestroyRenderTarget();
+    }
+}
+
+void CubismSceneMaskAtlas_OpenGLES2::SetAtlasSize(csmUint32 width, csmUint32 height)
+{
+    _atlasSize.X = static_cast<csmFloat32>(width);
+    _atlasSize.Y = static_cast<csmFloat32>(height);
+}
+
+CubismVector2 CubismSceneMaskAtlas_OpenGLES2::GetAtlasSize() const
+{
+    return _atlasSize;
+}
+
+void CubismSceneMaskAtlas_OpenGLES2::Render()
+{
+    PackRegions();
+
+    if (_regions.GetSize() == 0)
+    {
+        return;
+    }
+
+    const csmUint32 width = static_cast<csmUint32>(_atlasSize.X);
+    const csmUint32 height = static_cast<csmUint32>(_atlasSize.Y);
+
+    // サイズが違う場合はここで作成しなおし
+    if (_renderTarget.GetBufferWidth() != width || _renderTarget.GetBufferHeight() != height)
+    {
+        _renderTarget.CreateRenderTarget(width, height);
+    }
+
+    _rendererProfile.Save();
+
+    GLint lastFBO;
+    GLint lastViewport[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &lastFBO);
+    glGetIntegerv(GL_VIEWPORT, lastViewport);
+
+    // ----- マスク描画処理 -----
+    // 全てのモデルのマスクを同じレンダーターゲットに続けて描くため、切り替えとクリアはここで1度だけ行う
+    _renderTarget.BeginDraw(lastFBO);
+    glViewport(0, 0, width, height);
+
+    // 1が無効（描かれない）領域、0が有効（描かれる）領域
+    glDisable(GL_SCISSOR_TEST);
+    glColorMask(1, 1, 1, 1);
+    _renderTarget.Clear(1.0f, 1.0f, 1.0f, 1.0f);
+
+    for (csmUint32 i = 0; i < _renderers.GetSize(); ++i)
+    {
+        if (_regionOffsets[i] < 0)
+        {
+            continue;
+        }
+
+        _renderers[i]->DrawSceneMaskAtlas(lastFBO, lastViewport);
+    }
+
+    // --- 後処理 ---
+    _renderTarget.EndDraw();
+
+    _rendererProfile.Restore();
+}
+
+CubismRenderTarget_OpenGLES2* CubismSceneMaskAtlas_OpenGLES2::GetRenderTarget()
+{
+    return &_renderTarget;
+}
+
+csmBool CubismSceneMaskAtlas_OpenGLES2::GetRegion(const CubismRenderer_OpenGLES2* renderer, csmInt32 bufferIndex, csmRectF& region) const
+{
+    for (csmUint32 i = 0; i < _renderers.GetSize(); ++i)
+    {
+        if (_renderers[i] != renderer)
+        {
+            continue;
+        }
+
+        if (_regionOffsets[i] < 0)
+        {
+            return false;
+        }
+
+        region = _regions[_regionOffsets[i] + bufferIndex];
+        return true;
+    }
+
+    return false;
+}
+
+void CubismSceneMaskAtlas_OpenGLES2::RegisterRenderer(CubismRenderer_OpenGLES2* renderer)
+{
+    for (csmUint32 i = 0; i < _renderers.GetSize(); ++i)
+    {
+        if (_renderers[i] == renderer)
+        {
+            return;
+        }
+    }
+
+    // 次の Render() で配置されるまでは未配置として扱う
+    _renderers.PushBack(renderer);
+    _regionOffsets.PushBack(-1);
+}
+
+void CubismSceneMaskAtlas_OpenGLES2::UnregisterRenderer(CubismRenderer_OpenGLES2* renderer)
+{
+    for (csmUint32 i = 0; i < _renderers.GetSize(); ++i)
+    {
+        if (_renderers[i] == renderer)
+        {
+            _renderers.Remove(i);
+            _regionOffsets.Remove(i);
+            return;
+        }
+    }
+}
+
+void CubismSceneMaskAtlas_OpenGLES2::PackRegions()
+{
+    // 要求サイズのままで収まらなければ半分ずつ縮小して配置しなおす
+    csmFloat32 scale = 1.0f;
+    while (!TryPackRegions(scale) && scale > MinimumRegionScale)
+    {
+        scale *= 0.5f;
+    }
+
+    // 下限まで縮小しても収まらなかったレンダラは個別のマスクを使う
+    for (csmUint32 i = 0; i < _renderers.GetSize(); ++i)
+    {
+        _renderers[i]->_isSceneMaskAtlasRegionAssigned = (_regionOffsets[i] >= 0);
+    }
+}
+
+csmBool CubismSceneMaskAtlas_OpenGLES2::TryPackRegions(csmFloat32 scale)
+{
+    csmBool isAllPacked = true;
+    csmFloat32 cursorX = 0.0f;
+    csmFloat32 cursorY = 0.0f;
+    csmFloat32 shelfHeight = 0.0f;
+
+    _regions.Clear();
+    _regionOffsets.Clear();
+
+    for (csmUint32 i = 0; i < _renderers.GetSize(); ++i)
+    {
+        CubismRenderer_OpenGLES2* renderer = _renderers[i];
+        CubismClippingManager_OpenGLES2* manager = renderer->_drawableClippingManager;
+
+        // 高精細マスクは描画の都度マスクを生成するのでアトラスを使わない
+        if (manager == NULL || renderer->IsUsingHighPrecisionMask())
+        {
+            _regionOffsets.PushBack(-1);
+            continue;
+        }
+
+        const csmFloat32 regionWidth = floorf(manager->GetClippingMaskBufferSize().X * scale);
+        const csmFloat32 regionHeight = floorf(manager->GetClippingMaskBufferSize().Y * scale);
+        const csmInt32 regionCount = renderer->_drawableMasks.GetSize();
+        const csmInt32 regionOffset = _regions.GetSize();
+
+        // 収まらなかった場合は配置前の状態に戻す
+        const csmFloat32 lastCursorX = cursorX;
+        const csmFloat32 lastCursorY = cursorY;
+        const csmFloat32 lastShelfHeight = shelfHeight;
+        csmBool isPacked = true;
+
+        for (csmInt32 regionIndex = 0; regionIndex < regionCount; ++regionIndex)
+        {
+            // 棚の右端を越える場合は次の棚へ
+            if (cursorX + regionWidth > _atlasSize.X)
+            {
+                cursorX = 0.0f;
+                cursorY += shelfHeight;
+                shelfHeight = 0.0f;
+            }
+
+            if (regionWidth > _atlasSize.X || cursorY + regionHeight > _atlasSize.Y)
+            {
+                isPacked = false;
+                break;
+            }
+
+            _regions.PushBack(csmRectF(cursorX / _atlasSize.X, cursorY / _atlasSize.Y, regionWidth / _atlasSize.X, regionHeight / _atlasSize.Y));
+            cursorX += regionWidth;
+            shelfHeight = (shelfHeight < regionHeight) ? regionHeight : shelfHeight;
+        }
+
+        if (!isPacked)
+        {
+            // 末尾に追加した分を切り詰めるだけなので、要素をずらす Remove() は使わない
+            _regions.Resize(regionOffset);
+            cursorX = lastCursorX;
+            cursorY = lastCursorY;
+            shelfHeight = lastShelfHeight;
+
+            _regionOffsets.PushBack(-1);
+            isAllPacked = false;
+            continue;
+        }
+
+        _regionOffsets.PushBack(regionOffset);
+    }
+
+    return isAllPacked;
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
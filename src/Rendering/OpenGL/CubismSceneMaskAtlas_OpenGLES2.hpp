@@ -0,0 +1,117 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+#include "CubismRenderer_OpenGLES2.hpp"
+#include "CubismRenderTarget_OpenGLES2.hpp"
+#include "Type/csmVector.hpp"
+#include "Type/csmRectF.hpp"
+#include "Math/CubismVector2.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+/**
+ * @brief   シーン内の複数のモデルでクリッピングマスクを共有するアトラス<br>
+ *          登録されたレンダラのマスクを1枚のレンダーテクスチャに詰めて配置し、1回の描画パスでまとめて生成する。<br>
+ *          使用する場合は全てのモデルの更新後、モデルを描画する前に毎フレーム Render() を呼ぶこと。
+ */
+class CubismSceneMaskAtlas_OpenGLES2
+{
+    friend class CubismRenderer_OpenGLES2;
+
+public:
+    /**
+     * @brief   コンストラクタ
+     */
+    CubismSceneMaskAtlas_OpenGLES2();
+
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~CubismSceneMaskAtlas_OpenGLES2();
+
+    /**
+     * @brief   アトラスのサイズを設定する
+     *
+     * @param[in]   width   ->  アトラスの幅
+     * @param[in]   height  ->  アトラスの高さ
+     */
+    void SetAtlasSize(csmUint32 width, csmUint32 height);
+
+    /**
+     * @brief   アトラスのサイズを取得する
+     *
+     * @return  アトラスのサイズ
+     */
+    CubismVector2 GetAtlasSize() const;
+
+    /**
+     * @brief   登録されている全てのレンダラの領域を配置し、マスクを1回の描画パスで生成する
+     */
+    void Render();
+
+    /**
+     * @brief   アトラスのレンダーターゲットを取得する
+     *
+     * @return  アトラスのレンダーターゲット
+     */
+    CubismRenderTarget_OpenGLES2* GetRenderTarget();
+
+    /**
+     * @brief   レンダラのマスクに割り当てた領域を取得する
+     *
+     * @param[in]   renderer    ->  レンダラのインスタンス
+     * @param[in]   bufferIndex ->  レンダラ側のマスク用レンダーテクスチャの番号
+     * @param[out]  region      ->  割り当てた領域（0..1）
+     *
+     * @return  領域が割り当てられていればtrue
+     */
+    csmBool GetRegion(const CubismRenderer_OpenGLES2* renderer, csmInt32 bufferIndex, csmRectF& region) const;
+
+private:
+    /**
+     * @brief   レンダラを登録する
+     *
+     * @param[in]   renderer    ->  レンダラのインスタンス
+     */
+    void RegisterRenderer(CubismRenderer_OpenGLES2* renderer);
+
+    /**
+     * @brief   レンダラの登録を解除する
+     *
+     * @param[in]   renderer    ->  レンダラのインスタンス
+     */
+    void UnregisterRenderer(CubismRenderer_OpenGLES2* renderer);
+
+    /**
+     * @brief   登録されているレンダラのマスク用レンダーテクスチャをアトラス内に棚詰めで配置する<br>
+     *          全てが収まらない場合は要求サイズを縮小して配置しなおす
+     */
+    void PackRegions();
+
+    /**
+     * @brief   指定の縮小率でアトラス内に領域を配置する
+     *
+     * @param[in]   scale   ->  要求サイズに掛ける縮小率
+     *
+     * @return  全ての領域が収まればtrue
+     */
+    csmBool TryPackRegions(csmFloat32 scale);
+
+    csmVector<CubismRenderer_OpenGLES2*> _renderers;   ///< 登録されているレンダラ
+    csmVector<csmInt32> _regionOffsets;                 ///< レンダラごとの_regions内の先頭インデックス（-1は未配置）
+    csmVector<csmRectF> _regions;                       ///< マスク用レンダーテクスチャごとに割り当てた領域（0..1）
+    CubismVector2 _atlasSize;                           ///< アトラスのサイズ
+    CubismRenderTarget_OpenGLES2 _renderTarget;         ///< アトラスのレンダーターゲット
+    CubismRendererProfile_OpenGLES2 _rendererProfile;   ///< OpenGLのステートを保持するオブジェクト
+};
+
+}}}}
+//------------ LIVE2D NAMESPACE ------------
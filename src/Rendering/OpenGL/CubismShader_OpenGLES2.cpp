@@ -6,8 +6,22 @@
  */
 
 #include "CubismShader_OpenGLES2.hpp"
+#include <cstdio>
 #include <float.h>
+#include <stdio.h>
+#include <string.h>
 #include "Type/csmRectF.hpp"
+#include "Utils/CubismProfiler.hpp"
+
+// プログラムバイナリの保存・読み込みはOpenGL 4.1 / OpenGL ES 3.0 以降のAPIを使う
+#if defined(GL_PROGRAM_BINARY_LENGTH) && defined(GL_NUM_PROGRAM_BINARY_FORMATS)
+#define CSM_GL_PROGRAM_BINARY_SUPPORTED
+#endif
+
+// 描画ごとの変数のユニフォームバッファはOpenGL 3.1 / OpenGL ES 3.0 以降のAPIを使う
+#if defined(GL_UNIFORM_BUFFER) && defined(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT)
+#define CSM_GL_UNIFORM_BUFFER_SUPPORTED
+#endif
 
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
@@ -18,12 +32,202 @@ namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering
 namespace {
     CubismShader_OpenGLES2* s_instance;
 #ifdef CSM_TARGET_ANDROID_ES2
+    const csmChar* ShaderDirectory = "";
     const csmChar* ColorBlendShaderPath = "FragShaderSrcColorBlend.frag";
     const csmChar* AlphaBlendShaderPath = "FragShaderSrcAlphaBlend.frag";
 #else
+    const csmChar* ShaderDirectory = "FrameworkShaders/";
     const csmChar* ColorBlendShaderPath = "FrameworkShaders/FragShaderSrcColorBlend.frag";
     const csmChar* AlphaBlendShaderPath = "FrameworkShaders/FragShaderSrcAlphaBlend.frag";
 #endif
+
+    // ブレンドモード用の頂点シェーダのファイル名（MaskType順）
+    const csmChar* BlendVertShaderFileNames[] = {
+        "VertShaderSrcBlend.vert",
+        "VertShaderSrcMaskedBlend.vert",
+        "VertShaderSrcMaskedBlend.vert",
+        "VertShaderSrcBlend.vert",
+        "VertShaderSrcMaskedBlend.vert",
+        "VertShaderSrcMaskedBlend.vert",
+    };
+
+    // ブレンドモード用のフラグメントシェーダのファイル名から拡張子を除いたもの（MaskType順）
+    const csmChar* BlendFragShaderFileNames[] = {
+        "FragShaderSrcBlend",
+        "FragShaderSrcMaskBlend",
+        "FragShaderSrcMaskInvertedBlend",
+        "FragShaderSrcPremultipliedAlphaBlend",
+        "FragShaderSrcMaskPremultipliedAlphaBlend",
+        "FragShaderSrcMaskInvertedPremultipliedAlphaBlend",
+    };
+
+    const csmInt32 ProgramBinaryCacheDirectoryMaxLength = 1024;     ///< プログラムバイナリの保存先のパスの最大長
+    csmChar s_programBinaryCacheDirectory[ProgramBinaryCacheDirectoryMaxLength];  ///< プログラムバイナリの保存先
+    const csmUint32 ProgramBinaryCacheMagic = 0x42505343;           ///< プログラムバイナリのファイルの識別子 ("CSPB")
+    const csmUint32 ProgramBinaryCacheVersion = 2;                  ///< プログラムバイナリのファイルの形式のバージョン
+    const csmInt32 ProgramBinaryCacheHeaderCount = 7;               ///< ファイル先頭の値の数（識別子・バージョン・ドライバとソースの長さ・形式・サイズ）
+    const csmSizeInt ProgramBinaryCacheCompareChunkSize = 1024;     ///< 保存されたドライバとソースを比較する単位
+
+    /**
+     * @brief   文字列をFNV-1aでハッシュ値に加える
+     *
+     * @param[in]   hash    ->  これまでのハッシュ値
+     * @param[in]   str     ->  加える文字列
+     * @param[in]   length  ->  文字列の長さ
+     *
+     * @return  ハッシュ値
+     */
+    csmUint32 AccumulateHash(csmUint32 hash, const csmChar* str, csmSizeInt length)
+    {
+        for (csmSizeInt i = 0; str != NULL && i < length; ++i)
+        {
+            hash ^= static_cast<csmUint8>(str[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief   ファイルから読んだ文字列が指定の文字列と一致するかを判定する
+     *
+     * @param[in]   file    ->  読み込むファイル
+     * @param[in]   str     ->  比較する文字列
+     * @param[in]   length  ->  文字列の長さ
+     *
+     * @return  true    ->  一致する
+     *          false   ->  一致しないか読み込めない
+     */
+    csmBool ReadAndCompare(FILE* file, const csmChar* str, csmSizeInt length)
+    {
+        csmChar buffer[ProgramBinaryCacheCompareChunkSize];
+        for (csmSizeInt offset = 0; offset < length;)
+        {
+            const csmSizeInt readSize = (length - offset < ProgramBinaryCacheCompareChunkSize) ? length - offset : ProgramBinaryCacheCompareChunkSize;
+            if (fread(buffer, 1, readSize, file) != readSize || memcmp(buffer, str + offset, readSize) != 0)
+            {
+                return false;
+            }
+            offset += readSize;
+        }
+        return true;
+    }
+
+    const csmChar* DrawUniformBlockName = "CubismDrawUniforms";     ///< 描画ごとの変数のユニフォームブロック名
+    const GLuint DrawUniformBlockBinding = 0;                       ///< 描画ごとの変数のユニフォームブロックのバインドポイント
+    const csmUint32 UniformBufferRingCount = 1024;                  ///< リングバッファに確保する描画の数
+
+    // 描画ごとの変数をユニフォームブロックで受け取るシェーダのファイル名に付ける接尾辞
+    const csmChar* UniformBufferShaderSuffix = "UniformBuffer";
+
+    const csmChar* FramebufferFetchExtensionName = "GL_EXT_shader_framebuffer_fetch";
+
+    // ブレンドモードのシェーダで描画先をテクスチャの代わりにgl_LastFragDataから読むための記述
+    const csmChar* FramebufferFetchSource =
+        "#extension GL_EXT_shader_framebuffer_fetch : require\n"
+        "#define CSM_FRAMEBUFFER_FETCH\n";
+
+    /**
+     * @brief   拡張機能の一覧に指定の拡張機能が含まれるか<br>
+     *          名前の先頭だけが一致する別の拡張機能は含めない
+     *
+     * @param[in]   extensions  ->  空白区切りの拡張機能の一覧
+     * @param[in]   name        ->  拡張機能の名前
+     */
+    csmBool IsExtensionSupported(const csmChar* extensions, const csmChar* name)
+    {
+        const csmSizeInt nameLength = strlen(name);
+        for (const csmChar* p = strstr(extensions, name); p != NULL; p = strstr(p + nameLength, name))
+        {
+            const csmBool isHead = (p == extensions || p[-1] == ' ');
+            const csmBool isTail = (p[nameLength] == ' ' || p[nameLength] == '\0');
+            if (isHead && isTail)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief   #versionの行の直後に記述を挿入する<br>
+     *          #versionの行がない場合は先頭に挿入する
+     *
+     * @param[in]   source  ->  シェーダのソース
+     * @param[in]   text    ->  挿入する記述
+     */
+    csmString InsertAfterVersionDirective(const csmString& source, const csmChar* text)
+    {
+        const csmChar* src = source.GetRawString();
+        const csmChar* version = strstr(src, "#version");
+        csmInt32 insertPosition = 0;
+        if (version != NULL)
+        {
+            const csmChar* lineEnd = strchr(version, '\n');
+            insertPosition = (lineEnd != NULL) ? static_cast<csmInt32>(lineEnd - src) + 1 : source.GetLength();
+        }
+
+        csmString result(src, insertPosition);
+        if (version != NULL && (insertPosition == 0 || src[insertPosition - 1] != '\n'))
+        {
+            result += "\n";
+        }
+        result += text;
+        result += csmString(src + insertPosition, source.GetLength() - insertPosition);
+        return result;
+    }
+
+    /**
+     * @brief   頂点を行列で変換した後の外接矩形を求める
+     *
+     * @param[in]   positions   ->  頂点座標(x, y)の配列
+     * @param[in]   vertexCount ->  頂点数
+     * @param[in]   matrix      ->  変換行列
+     */
+    csmRectF CalculateTransformedBounds(const csmFloat32* positions, const csmInt32 vertexCount, CubismMatrix44& matrix)
+    {
+        if (positions == NULL || vertexCount <= 0)
+        {
+            return csmRectF(0.0f, 0.0f, 0.0f, 0.0f);
+        }
+
+        csmFloat32 minX = FLT_MAX;
+        csmFloat32 minY = FLT_MAX;
+        csmFloat32 maxX = -FLT_MAX;
+        csmFloat32 maxY = -FLT_MAX;
+        for (csmInt32 i = 0; i < vertexCount; ++i)
+        {
+            const csmFloat32 x = matrix.TransformX(positions[i * 2 + 0]);
+            const csmFloat32 y = matrix.TransformY(positions[i * 2 + 1]);
+            minX = (x < minX) ? x : minX;
+            minY = (y < minY) ? y : minY;
+            maxX = (x > maxX) ? x : maxX;
+            maxY = (y > maxY) ? y : maxY;
+        }
+
+        return csmRectF(minX, minY, maxX - minX, maxY - minY);
+    }
+
+    /**
+     * @brief   ユニフォームブロックを使うシェーダのファイルパスを作る<br>
+     *          拡張子の前に接尾辞を付ける（VertShaderSrc.vert -> VertShaderSrcUniformBuffer.vert）
+     *
+     * @param[in]   path    ->  ユニフォームブロックを使わないシェーダのファイルパス
+     */
+    csmString MakeUniformBufferShaderPath(const csmChar* path)
+    {
+        const csmChar* extension = strrchr(path, '.');
+        const csmChar* directoryEnd = strrchr(path, '/');
+        if (extension == NULL || (directoryEnd != NULL && extension < directoryEnd))
+        {
+            extension = path + strlen(path);
+        }
+
+        csmString result(path, static_cast<csmInt32>(extension - path));
+        result += UniformBufferShaderSuffix;
+        result += extension;
+        return result;
+    }
+
     const csmFloat32 renderTargetVertexArray[] = {
         -1.0f, -1.0f,
          1.0f, -1.0f,
@@ -108,8 +312,13 @@ enum ShaderNames
     // カラー
     CSM_CREATE_BLEND_OVERLAP_SHADER_NAMES(Color),
 
+    // インスタンス描画用
+    ShaderNames_Instanced,
+    ShaderNames_InstancedPremultipliedAlpha,
+
     // ブレンドモードの組み合わせ数 = 加算(5.2以前) + 乗算(5.2以前) + (通常 + 加算 + 加算(発光) + 比較(暗) + 乗算 + 焼き込みカラー + 焼き込み(リニア) + 比較(明) + スクリーン + 覆い焼きカラー + オーバーレイ + ソフトライト + ハードライト + リニアライト + 色相 + カラー) * (over + atop + out + conjoint over + disjoint over)
     // シェーダの数 = コピー用 + マスク生成用 + (通常 + 加算 + 乗算 + ブレンドモードの組み合わせ数) * (マスク無 + マスク有 + マスク有反転 + マスク無の乗算済アルファ対応版 + マスク有の乗算済アルファ対応版 + マスク有反転の乗算済アルファ対応版)
+    //             + インスタンス描画用(通常 + 乗算済アルファ対応版)
     ShaderNames_ShaderCount,
 
 #undef CSM_CREATE_BLEND_OVERLAP_SHADER_NAMES
@@ -124,9 +333,20 @@ void CubismShader_OpenGLES2::ReleaseShaderProgram()
         {
             glDeleteProgram(_shaderSets[i]->ShaderProgram);
             _shaderSets[i]->ShaderProgram = 0;
-            CSM_DELETE(_shaderSets[i]);
         }
+
+        // 一度も使われなかったブレンドモード用のシェーダーセットはプログラムを持たないため、ここで解放する
+        CSM_DELETE(_shaderSets[i]);
     }
+    _shaderSets.Clear();
+
+#ifdef CSM_GL_UNIFORM_BUFFER_SUPPORTED
+    if (_uniformBuffer != 0)
+    {
+        glDeleteBuffers(1, &_uniformBuffer);
+        _uniformBuffer = 0;
+    }
+#endif
 }
 
 void CubismShader_OpenGLES2::ReleaseInvalidShaderProgram()
@@ -136,11 +356,15 @@ void CubismShader_OpenGLES2::ReleaseInvalidShaderProgram()
         CSM_DELETE(_shaderSets[i]);
     }
     _shaderSets.Clear();
+
+    // バッファもコンテキストと共に破棄されている
+    _uniformBuffer = 0;
 }
 
 
 void CubismShader_OpenGLES2::SetShaderSet(CubismShaderSet& shaderSets, const MaskType maskType, csmBool isBlendMode)
 {
+    SetupUniformBlock(shaderSets);
     shaderSets.AttributePositionLocation = glGetAttribLocation(shaderSets.ShaderProgram, "a_position");
     shaderSets.AttributeTexCoordLocation = glGetAttribLocation(shaderSets.ShaderProgram, "a_texCoord");
     shaderSets.SamplerTexture0Location = glGetUniformLocation(shaderSets.ShaderProgram, "s_texture0");
@@ -285,7 +509,17 @@ csmInt32 CubismShader_OpenGLES2::GetShaderNamesBegin(const csmBlendMode blendMod
 }
 
 CubismShader_OpenGLES2::CubismShader_OpenGLES2()
-{ }
+    : _isProgramBinarySupported(false)
+    , _programBinaryDriverName()
+    , _isUniformBufferSupported(false)
+    , _isFramebufferFetchSupported(false)
+    , _uniformBuffer(0)
+    , _uniformBufferStride(0)
+    , _uniformBufferOffset(0)
+    , _drawUniformFlags(0)
+{
+    memset(&_drawUniforms, 0, sizeof(_drawUniforms));
+}
 
 CubismShader_OpenGLES2::~CubismShader_OpenGLES2()
 {
@@ -311,6 +545,24 @@ void CubismShader_OpenGLES2::DeleteInstance()
     }
 }
 
+void CubismShader_OpenGLES2::SetProgramBinaryCacheDirectory(const csmChar* directoryPath)
+{
+    s_programBinaryCacheDirectory[0] = '\0';
+
+    if (directoryPath == NULL)
+    {
+        return;
+    }
+
+    if (strlen(directoryPath) >= static_cast<csmSizeInt>(ProgramBinaryCacheDirectoryMaxLength))
+    {
+        CubismLogWarning("Program binary cache directory path is too long. Program binaries will not be cached.");
+        return;
+    }
+
+    strcpy(s_programBinaryCacheDirectory, directoryPath);
+}
+
 #ifdef CSM_TARGET_ANDROID_ES2
 csmBool CubismShader_OpenGLES2::s_extMode = false;
 csmBool CubismShader_OpenGLES2::s_extPAMode = false;
@@ -333,6 +585,69 @@ void CubismShader_OpenGLES2::GenerateShaders()
         _shaderSets.PushBack(CSM_NEW CubismShaderSet());
     }
 
+    // 保存先が設定されていて、プログラムバイナリに対応した環境であれば保存済みのバイナリを使う
+    _isProgramBinarySupported = false;
+    _programBinaryDriverName = "";
+#ifdef CSM_GL_PROGRAM_BINARY_SUPPORTED
+    GLint binaryFormatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+    _isProgramBinarySupported = (binaryFormatCount > 0 && s_programBinaryCacheDirectory[0] != '\0');
+
+    if (_isProgramBinarySupported)
+    {
+        // ドライバが変わるとバイナリの互換性がなくなるため、ドライバの識別情報をバイナリと一緒に保存して比較する
+        const GLenum driverNames[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+        for (csmInt32 i = 0; i < 3; ++i)
+        {
+            const csmChar* driverName = reinterpret_cast<const csmChar*>(glGetString(driverNames[i]));
+            _programBinaryDriverName += (driverName != NULL) ? driverName : "";
+            _programBinaryDriverName += "\n";
+        }
+    }
+#endif
+
+    // OpenGL 3.1 / OpenGL ES 3.0 以降であれば描画ごとの変数をユニフォームバッファのリングで渡す
+    _isUniformBufferSupported = false;
+#ifdef CSM_GL_UNIFORM_BUFFER_SUPPORTED
+    const csmChar* glVersion = reinterpret_cast<const csmChar*>(glGetString(GL_VERSION));
+    if (glVersion != NULL)
+    {
+        const csmChar* esPrefix = "OpenGL ES ";
+        const csmBool isEs = (strncmp(glVersion, esPrefix, strlen(esPrefix)) == 0);
+        csmInt32 majorVersion = 0;
+        csmInt32 minorVersion = 0;
+        sscanf(isEs ? glVersion + strlen(esPrefix) : glVersion, "%d.%d", &majorVersion, &minorVersion);
+        _isUniformBufferSupported = isEs ? (majorVersion >= 3) : (majorVersion > 3 || (majorVersion == 3 && minorVersion >= 1));
+    }
+
+    if (_isUniformBufferSupported)
+    {
+        // 1描画分の領域はオフセットのアラインメントに揃える
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        alignment = (alignment > 0) ? alignment : 256;
+        _uniformBufferStride = ((sizeof(CubismDrawUniforms) + alignment - 1) / alignment) * alignment;
+        _uniformBufferOffset = 0;
+
+        glGenBuffers(1, &_uniformBuffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, _uniformBuffer);
+        glBufferData(GL_UNIFORM_BUFFER, _uniformBufferStride * UniformBufferRingCount, NULL, GL_STREAM_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+#endif
+
+    // OpenGL ES でフレームバッファフェッチが使える場合は、ブレンドモードの描画先をコピーせずにシェーダで直接読む
+    _isFramebufferFetchSupported = false;
+    {
+        const csmChar* glVersion = reinterpret_cast<const csmChar*>(glGetString(GL_VERSION));
+        const csmChar* extensions = reinterpret_cast<const csmChar*>(glGetString(GL_EXTENSIONS));
+        const csmChar* esPrefix = "OpenGL ES ";
+        if (glVersion != NULL && extensions != NULL && strncmp(glVersion, esPrefix, strlen(esPrefix)) == 0)
+        {
+            _isFramebufferFetchSupported = IsExtensionSupported(extensions, FramebufferFetchExtensionName);
+        }
+    }
+
 #ifdef CSM_TARGET_ANDROID_ES2
     if (s_extMode)
     {
@@ -346,24 +661,6 @@ void CubismShader_OpenGLES2::GenerateShaders()
         _shaderSets[ShaderNames_NormalMaskedPremultipliedAlpha]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMasked.vert", "FragShaderSrcMaskPremultipliedAlphaTegra.frag");
         _shaderSets[ShaderNames_NormalMaskedInvertedPremultipliedAlpha]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMasked.vert", "FragShaderSrcMaskInvertedPremultipliedAlphaTegra.frag");
 
-        // ブレンドモードの組み合わせ分作成
-        {
-            csmUint32 offset = ShaderNames_NormalAtop;
-            for (csmInt32 i = 0; i < ColorBlendMode_Count; ++i)
-            {
-                // Normal Overはシェーダを作る必要がないため 1 から始める
-                const csmInt32 start = (i == 0 ? 1 : 0);
-                for (csmInt32 j = start; j < AlphaBlendMode_Count; ++j)
-                {
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcBlend.vert", "FragShaderSrcBlendTegra.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskBlendTegra.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskInvertedBlendTegra.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcBlend.vert", "FragShaderSrcPremultipliedAlphaBlendTegra.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskPremultipliedAlphaBlendTegra.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskInvertedPremultipliedAlphaBlendTegra.frag", i, j);
-                }
-            }
-        }
     }
     else
     {
@@ -377,24 +674,6 @@ void CubismShader_OpenGLES2::GenerateShaders()
         _shaderSets[ShaderNames_NormalMaskedPremultipliedAlpha]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMasked.vert", "FragShaderSrcMaskPremultipliedAlpha.frag");
         _shaderSets[ShaderNames_NormalMaskedInvertedPremultipliedAlpha]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMasked.vert", "FragShaderSrcMaskInvertedPremultipliedAlpha.frag");
 
-        // ブレンドモードの組み合わせ分作成
-        {
-            csmUint32 offset = ShaderNames_NormalAtop;
-            for (csmInt32 i = 0; i < ColorBlendMode_Count; ++i)
-            {
-                // Normal Overはシェーダを作る必要がないため 1 から始める
-                const csmInt32 start = (i == 0 ? 1 : 0);
-                for (csmInt32 j = start; j < AlphaBlendMode_Count; ++j)
-                {
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcBlend.vert", "FragShaderSrcBlend.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskBlend.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskInvertedBlend.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcBlend.vert", "FragShaderSrcPremultipliedAlphaBlend.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskPremultipliedAlphaBlend.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskInvertedPremultipliedAlphaBlend.frag", i, j);
-                }
-            }
-        }
     }
 
     // 加算も通常と同じシェーダーを利用する
@@ -442,33 +721,17 @@ void CubismShader_OpenGLES2::GenerateShaders()
     _shaderSets[ShaderNames_MultMaskedPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedPremultipliedAlpha]->ShaderProgram;
     _shaderSets[ShaderNames_MultMaskedInvertedPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedInvertedPremultipliedAlpha]->ShaderProgram;
 
-    // ブレンドモードの組み合わせ分作成
-    {
-        csmUint32 offset = ShaderNames_NormalAtop;
-        for (csmInt32 i = 0; i < ColorBlendMode_Count; ++i)
-        {
-            // Normal Overはシェーダを作る必要がないため 1 から始める
-            const csmInt32 start = (i == 0 ? 1 : 0);
-            for (csmInt32 j = start; j < AlphaBlendMode_Count; ++j)
-            {
-                _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcBlend.vert", "FrameworkShaders/FragShaderSrcBlend.frag", i, j);
-                _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcMaskedBlend.vert", "FrameworkShaders/FragShaderSrcMaskBlend.frag", i, j);
-                _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcMaskedBlend.vert", "FrameworkShaders/FragShaderSrcMaskInvertedBlend.frag", i, j);
-                _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcBlend.vert", "FrameworkShaders/FragShaderSrcPremultipliedAlphaBlend.frag", i, j);
-                _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcMaskedBlend.vert", "FrameworkShaders/FragShaderSrcMaskPremultipliedAlphaBlend.frag", i, j);
-                _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcMaskedBlend.vert", "FrameworkShaders/FragShaderSrcMaskInvertedPremultipliedAlphaBlend.frag", i, j);
-            }
-        }
-    }
 #endif
 
     // Copy
+    SetupUniformBlock(*_shaderSets[ShaderNames_Copy]);
     _shaderSets[ShaderNames_Copy]->AttributePositionLocation = glGetAttribLocation(_shaderSets[ShaderNames_Copy]->ShaderProgram, "a_position");
     _shaderSets[ShaderNames_Copy]->AttributeTexCoordLocation = glGetAttribLocation(_shaderSets[ShaderNames_Copy]->ShaderProgram, "a_texCoord");
     _shaderSets[ShaderNames_Copy]->SamplerTexture0Location = glGetUniformLocation(_shaderSets[ShaderNames_Copy]->ShaderProgram, "s_texture0");
     _shaderSets[ShaderNames_Copy]->UniformBaseColorLocation = glGetUniformLocation(_shaderSets[ShaderNames_Copy]->ShaderProgram, "u_baseColor");
 
     // SetupMask
+    SetupUniformBlock(*_shaderSets[ShaderNames_SetupMask]);
     _shaderSets[ShaderNames_SetupMask]->AttributePositionLocation = glGetAttribLocation(_shaderSets[ShaderNames_SetupMask]->ShaderProgram, "a_position");
     _shaderSets[ShaderNames_SetupMask]->AttributeTexCoordLocation = glGetAttribLocation(_shaderSets[ShaderNames_SetupMask]->ShaderProgram, "a_texCoord");
     _shaderSets[ShaderNames_SetupMask]->SamplerTexture0Location = glGetUniformLocation(_shaderSets[ShaderNames_SetupMask]->ShaderProgram, "s_texture0");
@@ -515,34 +778,97 @@ void CubismShader_OpenGLES2::GenerateShaders()
     // 乗算（クリッピング・反転、PremultipliedAlpha）
     SetShaderSet(*_shaderSets[ShaderNames_MultMaskedInvertedPremultipliedAlpha], MaskType_MaskedInvertedPremultipliedAlpha);
 
-    // ブレンドモードの組み合わせ分作成
+    // ブレンドモード用のシェーダは初めて使われるときに生成する (GetShaderSet)
+}
+
+CubismShader_OpenGLES2::CubismShaderSet* CubismShader_OpenGLES2::GetShaderSet(const csmInt32 shaderName)
+{
+    CubismShaderSet* shaderSet = _shaderSets[shaderName];
+
+    if (!shaderSet->IsLoaded && shaderName >= ShaderNames_Instanced)
     {
-        csmUint32 offset = ShaderNames_NormalAtop;
-        for (csmInt32 i = 0; i < ColorBlendMode_Count; ++i)
-        {
-            // Normal Overはシェーダを作る必要がないため 1 から始める
-            const csmInt32 start = (i == 0 ? 1 : 0);
-            for (csmInt32 j = start; j < AlphaBlendMode_Count; ++j)
-            {
-                //
-                SetShaderSet(*_shaderSets[offset++], MaskType_None, true);
-                // クリッピング
-                SetShaderSet(*_shaderSets[offset++], MaskType_Masked, true);
-                // クリッピング・反転
-                SetShaderSet(*_shaderSets[offset++], MaskType_MaskedInverted, true);
-                // PremultipliedAlpha
-                SetShaderSet(*_shaderSets[offset++], MaskType_PremultipliedAlpha, true);
-                // クリッピング、PremultipliedAlpha
-                SetShaderSet(*_shaderSets[offset++], MaskType_MaskedPremultipliedAlpha, true);
-                // クリッピング・反転、PremultipliedAlpha
-                SetShaderSet(*_shaderSets[offset++], MaskType_MaskedInvertedPremultipliedAlpha, true);
-            }
-        }
+        GenerateInstancedShader(shaderName);
+    }
+    else if (!shaderSet->IsLoaded && shaderName >= ShaderNames_NormalAtop)
+    {
+        GenerateBlendShader(shaderName);
+    }
+
+    return shaderSet;
+}
+
+void CubismShader_OpenGLES2::GenerateBlendShader(const csmInt32 shaderName)
+{
+    CubismShaderSet* shaderSet = _shaderSets[shaderName];
+
+    // 失敗した場合も毎回コンパイルしなおさないようにする
+    shaderSet->IsLoaded = true;
+
+    // シェーダの番号からマスクの種類とブレンドモードを求める
+    // Normal Overはシェーダを作らないため、通常のカラーブレンドだけアルファブレンドの組み合わせが1つ少ない
+    const csmInt32 maskType = (shaderName - ShaderNames_NormalAtop) % MaskType_Count;
+    const csmInt32 blendIndex = (shaderName - ShaderNames_NormalAtop) / MaskType_Count;
+    const csmInt32 normalBlendCount = AlphaBlendMode_Count - 1;
+    csmInt32 colorBlendMode;
+    csmInt32 alphaBlendMode;
+    if (blendIndex < normalBlendCount)
+    {
+        colorBlendMode = ColorBlendMode_Nomal;
+        alphaBlendMode = blendIndex + 1;
+    }
+    else
+    {
+        colorBlendMode = (blendIndex - normalBlendCount) / AlphaBlendMode_Count + 1;
+        alphaBlendMode = (blendIndex - normalBlendCount) % AlphaBlendMode_Count;
     }
+
+    csmString vertShaderPath = ShaderDirectory;
+    vertShaderPath += BlendVertShaderFileNames[maskType];
+
+    csmString fragShaderPath = ShaderDirectory;
+    fragShaderPath += BlendFragShaderFileNames[maskType];
+#ifdef CSM_TARGET_ANDROID_ES2
+    if (s_extMode)
+    {
+        fragShaderPath += "Tegra";
+    }
+#endif
+    fragShaderPath += ".frag";
+
+    shaderSet->ShaderProgram = LoadShaderProgramFromFile(vertShaderPath.GetRawString(), fragShaderPath.GetRawString(), colorBlendMode, alphaBlendMode);
+    SetShaderSet(*shaderSet, static_cast<MaskType>(maskType), true);
+}
+
+void CubismShader_OpenGLES2::GenerateInstancedShader(const csmInt32 shaderName)
+{
+    CubismShaderSet* shaderSet = _shaderSets[shaderName];
+
+    // 失敗した場合も毎回コンパイルしなおさないようにする
+    shaderSet->IsLoaded = true;
+
+    csmString vertShaderPath = ShaderDirectory;
+    vertShaderPath += "VertShaderSrcInstanced.vert";
+
+    csmString fragShaderPath = ShaderDirectory;
+    fragShaderPath += (shaderName == ShaderNames_InstancedPremultipliedAlpha) ? "FragShaderSrcInstancedPremultipliedAlpha.frag" : "FragShaderSrcInstanced.frag";
+
+    // インスタンスごとの変数は配列で渡すため、ユニフォームブロックを使うシェーダは使わない
+    shaderSet->ShaderProgram = LoadShaderProgramFromFile(vertShaderPath.GetRawString(), fragShaderPath.GetRawString(), ColorBlendMode_None, AlphaBlendMode_None, false);
+    shaderSet->IsUniformBufferEnabled = false;
+    shaderSet->AttributePositionLocation = glGetAttribLocation(shaderSet->ShaderProgram, "a_position");
+    shaderSet->AttributeTexCoordLocation = glGetAttribLocation(shaderSet->ShaderProgram, "a_texCoord");
+    shaderSet->AttributeInstanceIndexLocation = glGetAttribLocation(shaderSet->ShaderProgram, "a_instanceIndex");
+    shaderSet->SamplerTexture0Location = glGetUniformLocation(shaderSet->ShaderProgram, "s_texture0");
+    shaderSet->UniformInstanceMatricesLocation = glGetUniformLocation(shaderSet->ShaderProgram, "u_instanceMatrices");
+    shaderSet->UniformInstanceBaseColorsLocation = glGetUniformLocation(shaderSet->ShaderProgram, "u_instanceBaseColors");
+    shaderSet->UniformInstanceMultiplyColorsLocation = glGetUniformLocation(shaderSet->ShaderProgram, "u_instanceMultiplyColors");
+    shaderSet->UniformInstanceScreenColorsLocation = glGetUniformLocation(shaderSet->ShaderProgram, "u_instanceScreenColors");
 }
 
 void CubismShader_OpenGLES2::SetupShaderProgramForDrawable(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index)
 {
+    CSM_PROFILE_COUNT(Counter_StateChanges, 1);
+
     // Blending
     csmInt32 SRC_COLOR;
     csmInt32 DST_COLOR;
@@ -557,10 +883,20 @@ void CubismShader_OpenGLES2::SetupShaderProgramForDrawable(CubismRenderer_OpenGL
 
     // シェーダーセット
     const csmInt32 shaderNameBegin = GetShaderNamesBegin(model.GetDrawableBlendModeType(index));
-    CubismShaderSet* shaderSet = _shaderSets[shaderNameBegin + offset];
+    CubismShaderSet* shaderSet = GetShaderSet(shaderNameBegin + offset);
     csmBool isBlendMode = false;
     GLuint blendTexture = 0;
 
+    //座標変換
+    CubismMatrix44 mvpMatrix = renderer->GetMvpMatrix();
+    if (renderer->GetCurrentOffscreen() != NULL)
+    {
+        // オフスクリーンは描画範囲だけを確保しているため、その範囲がNDC全体になるよう変換する
+        CubismMatrix44 canvasToOffscreen = renderer->GetCurrentOffscreen()->GetCanvasToOffscreenMatrix();
+        canvasToOffscreen.MultiplyByMatrix(&mvpMatrix);
+        mvpMatrix = canvasToOffscreen;
+    }
+
     switch (shaderNameBegin)
     {
     default:
@@ -571,10 +907,15 @@ void CubismShader_OpenGLES2::SetupShaderProgramForDrawable(CubismRenderer_OpenGL
         SRC_ALPHA = GL_ONE;
         DST_ALPHA = GL_ZERO;
         // 以前のオフスクリーンのテクスチャを取得
+        // フレームバッファフェッチを使う場合はシェーダが描画先を直接読むためコピーしない
         // HACK: ES でCopy用の ShaderProgram に切り替わるのでここで処理を行う。
-        blendTexture = renderer->GetCurrentOffscreen() != NULL ?
-            renderer->CopyRenderTarget(*renderer->GetCurrentOffscreen()->GetRenderTarget())->GetColorBuffer() :
-            renderer->CopyOffscreenRenderTarget()->GetColorBuffer();
+        if (!_isFramebufferFetchSupported)
+        {
+            const csmRectF bounds = CalculateTransformedBounds(model.GetDrawableVertices(index), model.GetDrawableVertexCount(index), mvpMatrix);
+            blendTexture = renderer->GetCurrentOffscreen() != NULL ?
+                renderer->CopyRenderTarget(*renderer->GetCurrentOffscreen()->GetRenderTarget(), bounds)->GetColorBuffer() :
+                renderer->CopyOffscreenRenderTarget(bounds)->GetColorBuffer();
+        }
         break;
     case ShaderNames_Normal:
         // 5.2以前
@@ -618,14 +959,14 @@ void CubismShader_OpenGLES2::SetupShaderProgramForDrawable(CubismRenderer_OpenGL
         glUniform1i(shaderSet->SamplerTexture1Location, 1);
 
         // View座標をClippingContextの座標に変換するための行列を設定
-        glUniformMatrix4fv(shaderSet->UniformClipMatrixLocation, 1, 0, renderer->GetClippingContextBufferForDrawable()->_matrixForDraw.GetArray());
+        SetDrawUniformMatrix(DrawUniformFlag_ClipMatrix, renderer->GetClippingContextBufferForDrawable()->_matrixForDraw.GetArray());
 
         // 使用するカラーチャンネルを設定
         SetColorChannelUniformVariables(shaderSet, renderer->GetClippingContextBufferForDrawable());
     }
 
     // ブレンド設定
-    if (isBlendMode)
+    if (isBlendMode && !_isFramebufferFetchSupported)
     {
         glActiveTexture(GL_TEXTURE2);
 
@@ -633,8 +974,7 @@ void CubismShader_OpenGLES2::SetupShaderProgramForDrawable(CubismRenderer_OpenGL
         glUniform1i(shaderSet->SamplerBlendTextureLocation, 2);
     }
 
-    //座標変換
-    glUniformMatrix4fv(shaderSet->UniformMatrixLocation, 1, 0, renderer->GetMvpMatrix().GetArray()); //
+    SetDrawUniformMatrix(DrawUniformFlag_Matrix, mvpMatrix.GetArray());
 
     // ユニフォーム変数設定
     CubismRenderer::CubismTextureColor baseColor;
@@ -660,11 +1000,77 @@ void CubismShader_OpenGLES2::SetupShaderProgramForDrawable(CubismRenderer_OpenGL
     CubismRenderer::CubismTextureColor screenColor = overrideMultiplyAndScreenColor.GetDrawableScreenColor(index);
     SetColorUniformVariables(renderer, model, index, shaderSet, baseColor, multiplyColor, screenColor);
 
+    FlushDrawUniforms(shaderSet);
+
+    glBlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
+}
+
+void CubismShader_OpenGLES2::SetupShaderProgramForInstancedDrawable(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index,
+                                                                     const csmFloat32* positions, const csmFloat32* uvs, const csmFloat32* instanceIndices, const csmInt32 instanceCount,
+                                                                     const csmFloat32* matrices, const csmFloat32* baseColors, const csmFloat32* multiplyColors, const csmFloat32* screenColors)
+{
+    CSM_PROFILE_COUNT(Counter_StateChanges, 1);
+
+    // Blending
+    csmInt32 SRC_COLOR;
+    csmInt32 DST_COLOR;
+    csmInt32 SRC_ALPHA;
+    csmInt32 DST_ALPHA;
+
+    // インスタンス描画はマスクと5.3以降のブレンドモードを使わないDrawableだけを対象とする
+    switch (GetShaderNamesBegin(model.GetDrawableBlendModeType(index)))
+    {
+    case ShaderNames_Add:
+        // 5.2以前
+        SRC_COLOR = GL_ONE;
+        DST_COLOR = GL_ONE;
+        SRC_ALPHA = GL_ZERO;
+        DST_ALPHA = GL_ONE;
+        break;
+    case ShaderNames_Mult:
+        // 5.2以前
+        SRC_COLOR = GL_DST_COLOR;
+        DST_COLOR = GL_ONE_MINUS_SRC_ALPHA;
+        SRC_ALPHA = GL_ZERO;
+        DST_ALPHA = GL_ONE;
+        break;
+    case ShaderNames_Normal:
+    default:
+        // 5.2以前
+        SRC_COLOR = GL_ONE;
+        DST_COLOR = GL_ONE_MINUS_SRC_ALPHA;
+        SRC_ALPHA = GL_ONE;
+        DST_ALPHA = GL_ONE_MINUS_SRC_ALPHA;
+        break;
+    }
+
+    CubismShaderSet* shaderSet = GetShaderSet(renderer->IsPremultipliedAlpha() ? ShaderNames_InstancedPremultipliedAlpha : ShaderNames_Instanced);
+    glUseProgram(shaderSet->ShaderProgram);
+
+    //テクスチャ設定
+    SetupTexture(renderer, model, index, shaderSet);
+
+    // 頂点属性設定
+    glEnableVertexAttribArray(shaderSet->AttributePositionLocation);
+    glVertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, positions);
+    glEnableVertexAttribArray(shaderSet->AttributeTexCoordLocation);
+    glVertexAttribPointer(shaderSet->AttributeTexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, uvs);
+    glEnableVertexAttribArray(shaderSet->AttributeInstanceIndexLocation);
+    glVertexAttribPointer(shaderSet->AttributeInstanceIndexLocation, 1, GL_FLOAT, GL_FALSE, sizeof(csmFloat32), instanceIndices);
+
+    // インスタンスごとの座標変換と色
+    glUniformMatrix4fv(shaderSet->UniformInstanceMatricesLocation, instanceCount, GL_FALSE, matrices);
+    glUniform4fv(shaderSet->UniformInstanceBaseColorsLocation, instanceCount, baseColors);
+    glUniform4fv(shaderSet->UniformInstanceMultiplyColorsLocation, instanceCount, multiplyColors);
+    glUniform4fv(shaderSet->UniformInstanceScreenColorsLocation, instanceCount, screenColors);
+
     glBlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
 }
 
 void CubismShader_OpenGLES2::SetupShaderProgramForMask(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index)
 {
+    CSM_PROFILE_COUNT(Counter_StateChanges, 1);
+
     // Blending
     csmInt32 SRC_COLOR = GL_ZERO;
     csmInt32 DST_COLOR = GL_ONE_MINUS_SRC_COLOR;
@@ -683,29 +1089,44 @@ void CubismShader_OpenGLES2::SetupShaderProgramForMask(CubismRenderer_OpenGLES2*
     // 使用するカラーチャンネルを設定
     SetColorChannelUniformVariables(shaderSet, renderer->GetClippingContextBufferForMask());
 
-    glUniformMatrix4fv(shaderSet->UniformClipMatrixLocation, 1, GL_FALSE, renderer->GetClippingContextBufferForMask()->_matrixForMask.GetArray());
+    SetDrawUniformMatrix(DrawUniformFlag_ClipMatrix, renderer->GetClippingContextBufferForMask()->_matrixForMask.GetArray());
 
     // ユニフォーム変数設定
     csmRectF* rect = renderer->GetClippingContextBufferForMask()->_layoutBounds;
     CubismRenderer::CubismTextureColor baseColor = {rect->X * 2.0f - 1.0f, rect->Y * 2.0f - 1.0f, rect->GetRight() * 2.0f - 1.0f, rect->GetBottom() * 2.0f - 1.0f};
-    glUniform4f(shaderSet->UniformBaseColorLocation, baseColor.R, baseColor.G, baseColor.B, baseColor.A);
+    SetDrawUniformColor(DrawUniformFlag_BaseColor, baseColor);
+
+    FlushDrawUniforms(shaderSet);
 
     glBlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
 }
 
 void CubismShader_OpenGLES2::SetupShaderProgramForOffscreenRenderTarget(CubismRenderer_OpenGLES2* renderer)
 {
-    GLuint texture = renderer->CopyOffscreenRenderTarget()->GetColorBuffer();
-    // この時点のテクスチャはPMAになっているはずなので計算を行う
-    CubismRenderer::CubismTextureColor baseColor = renderer->GetModelColor();
-    baseColor.R *= baseColor.A;
-    baseColor.G *= baseColor.A;
-    baseColor.B *= baseColor.A;
+    SetupShaderProgramForOffscreenRenderTarget(renderer, renderer->CopyOffscreenRenderTarget()->GetColorBuffer());
+}
+
+void CubismShader_OpenGLES2::SetupShaderProgramForOffscreenRenderTarget(CubismRenderer_OpenGLES2* renderer, GLuint texture)
+{
+    CSM_PROFILE_COUNT(Counter_StateChanges, 1);
+
+    // ブレンドモードを使わないモデルはDrawable単位でモデルカラーを処理済み
+    CubismRenderer::CubismTextureColor baseColor;
+    if (renderer->GetModel()->IsBlendModeEnabled())
+    {
+        // この時点のテクスチャはPMAになっているはずなので計算を行う
+        baseColor = renderer->GetModelColor();
+        baseColor.R *= baseColor.A;
+        baseColor.G *= baseColor.A;
+        baseColor.B *= baseColor.A;
+    }
     CopyTexture(texture, GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA, baseColor);
 }
 
 void CubismShader_OpenGLES2::CopyTexture(GLint texture, csmInt32 srcColor, csmInt32 dstColor, csmInt32 srcAlpha, csmInt32 dstAlpha, CubismRenderer::CubismTextureColor baseColor)
 {
+    CSM_PROFILE_COUNT(Counter_StateChanges, 1);
+
     CubismShaderSet* shaderSet = _shaderSets[ShaderNames_Copy];
     glUseProgram(shaderSet->ShaderProgram);
 
@@ -723,13 +1144,17 @@ void CubismShader_OpenGLES2::CopyTexture(GLint texture, csmInt32 srcColor, csmIn
     glVertexAttribPointer(shaderSet->AttributeTexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, renderTargetUvArray);
 
     // ベースカラーの設定
-    glUniform4f(shaderSet->UniformBaseColorLocation, baseColor.R, baseColor.G, baseColor.B, baseColor.A);
+    SetDrawUniformColor(DrawUniformFlag_BaseColor, baseColor);
+
+    FlushDrawUniforms(shaderSet);
 
     glBlendFuncSeparate(srcColor, dstColor, srcAlpha, dstAlpha);
 }
 
 void CubismShader_OpenGLES2::SetupShaderProgramForOffscreen(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const CubismOffscreenRenderTarget_OpenGLES2* offscreen)
 {
+    CSM_PROFILE_COUNT(Counter_StateChanges, 1);
+
     // Blending
     csmInt32 SRC_COLOR;
     csmInt32 DST_COLOR;
@@ -746,10 +1171,19 @@ void CubismShader_OpenGLES2::SetupShaderProgramForOffscreen(CubismRenderer_OpenG
 
     // シェーダーセット
     const csmInt32 shaderNameBegin = GetShaderNamesBegin(model.GetOffscreenBlendModeType(offscreenIndex));
-    CubismShaderSet* shaderSet = _shaderSets[shaderNameBegin + offset];
+    CubismShaderSet* shaderSet = GetShaderSet(shaderNameBegin + offset);
     csmBool isBlendMode = false;
     GLuint blendTexture = 0;
 
+    //座標変換
+    // 親オフスクリーンへ描画する場合は親の描画範囲に合わせて変換する
+    CubismMatrix44 mvpMatrix;
+    mvpMatrix.LoadIdentity();
+    if (offscreen->GetOldOffscreen() != NULL)
+    {
+        mvpMatrix = offscreen->GetOldOffscreen()->GetCanvasToOffscreenMatrix();
+    }
+
     switch (shaderNameBegin)
     {
     default:
@@ -760,10 +1194,15 @@ void CubismShader_OpenGLES2::SetupShaderProgramForOffscreen(CubismRenderer_OpenG
         SRC_ALPHA = GL_ONE;
         DST_ALPHA = GL_ZERO;
         // 以前のオフスクリーンのテクスチャを取得
+        // フレームバッファフェッチを使う場合はシェーダが描画先を直接読むためコピーしない
         // HACK: ES でCopy用の ShaderProgram に切り替わるのでここで処理を行う。
-        blendTexture = offscreen->GetOldOffscreen() != NULL ?
-            renderer->CopyRenderTarget(*offscreen->GetOldOffscreen()->GetRenderTarget())->GetColorBuffer() :
-            renderer->CopyOffscreenRenderTarget()->GetColorBuffer();
+        if (!_isFramebufferFetchSupported)
+        {
+            const csmRectF bounds = CalculateTransformedBounds(offscreen->GetDrawRectVertexArray(), 4, mvpMatrix);
+            blendTexture = offscreen->GetOldOffscreen() != NULL ?
+                renderer->CopyRenderTarget(*offscreen->GetOldOffscreen()->GetRenderTarget(), bounds)->GetColorBuffer() :
+                renderer->CopyOffscreenRenderTarget(bounds)->GetColorBuffer();
+        }
         break;
     case ShaderNames_Normal:
         // 5.2以前
@@ -795,8 +1234,9 @@ void CubismShader_OpenGLES2::SetupShaderProgramForOffscreen(CubismRenderer_OpenG
     glUniform1i(shaderSet->SamplerTexture0Location, 0);
 
     // 頂点位置属性の設定
+    // オフスクリーンの描画範囲をモデル描画先のNDC座標で指定する（マスクの座標系と一致させるため）
     glEnableVertexAttribArray(shaderSet->AttributePositionLocation);
-    glVertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, renderTargetVertexArray);
+    glVertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, offscreen->GetDrawRectVertexArray());
 
     // テクスチャ座標属性の設定
     glEnableVertexAttribArray(shaderSet->AttributeTexCoordLocation);
@@ -812,24 +1252,21 @@ void CubismShader_OpenGLES2::SetupShaderProgramForOffscreen(CubismRenderer_OpenG
         glUniform1i(shaderSet->SamplerTexture1Location, 1);
 
         // View座標をClippingContextの座標に変換するための行列を設定
-        glUniformMatrix4fv(shaderSet->UniformClipMatrixLocation, 1, 0, renderer->GetClippingContextBufferForOffscreen()->_matrixForDraw.GetArray());
+        SetDrawUniformMatrix(DrawUniformFlag_ClipMatrix, renderer->GetClippingContextBufferForOffscreen()->_matrixForDraw.GetArray());
 
         // 使用するカラーチャンネルを設定
         SetColorChannelUniformVariables(shaderSet, renderer->GetClippingContextBufferForOffscreen());
     }
 
     // ブレンド設定
-    if (isBlendMode)
+    if (isBlendMode && !_isFramebufferFetchSupported)
     {
         glActiveTexture(GL_TEXTURE2);
         glBindTexture(GL_TEXTURE_2D, blendTexture);
         glUniform1i(shaderSet->SamplerBlendTextureLocation, 2);
     }
 
-    //座標変換
-    CubismMatrix44 mvpMatrix;
-    mvpMatrix.LoadIdentity();
-    glUniformMatrix4fv(shaderSet->UniformMatrixLocation, 1, 0, mvpMatrix.GetArray());
+    SetDrawUniformMatrix(DrawUniformFlag_Matrix, mvpMatrix.GetArray());
 
     // ユニフォーム変数設定
     csmFloat32 offscreenOpacity = model.GetOffscreenOpacity(offscreenIndex);
@@ -840,6 +1277,8 @@ void CubismShader_OpenGLES2::SetupShaderProgramForOffscreen(CubismRenderer_OpenG
     CubismRenderer::CubismTextureColor screenColor = overrideMultiplyAndScreenColor.GetOffscreenScreenColor(offscreenIndex);
     SetColorUniformVariables(renderer, model, offscreenIndex, shaderSet, baseColor, multiplyColor, screenColor);
 
+    FlushDrawUniforms(shaderSet);
+
     glBlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
 }
 
@@ -875,6 +1314,15 @@ csmBool CubismShader_OpenGLES2::CompileShaderSource(GLuint* outShader, GLenum sh
 csmBool CubismShader_OpenGLES2::LinkProgram(GLuint shaderProgram)
 {
     GLint status;
+
+#ifdef CSM_GL_PROGRAM_BINARY_SUPPORTED
+    // ヒントを設定しないとバイナリの長さが0になるドライバがあるため、リンクの前に設定する
+    if (_isProgramBinarySupported)
+    {
+        glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+#endif
+
     glLinkProgram(shaderProgram);
 
     GLint logLength;
@@ -919,8 +1367,24 @@ csmBool CubismShader_OpenGLES2::ValidateProgram(GLuint shaderProgram)
     return true;
 }
 
-GLuint CubismShader_OpenGLES2::LoadShaderProgramFromFile(const csmChar* vertShaderPath, const csmChar* fragShaderPath, const csmInt32 colorBlendMode, const csmInt32 alphaBlendMode)
+GLuint CubismShader_OpenGLES2::LoadShaderProgramFromFile(const csmChar* vertShaderPath, const csmChar* fragShaderPath, const csmInt32 colorBlendMode, const csmInt32 alphaBlendMode, const csmBool useUniformBuffer)
 {
+    // 描画ごとの変数をユニフォームブロックで受け取るシェーダがあれば優先して使う
+    // gl_LastFragDataはGLSL ES 3.00では使えないため、フレームバッファフェッチを使う場合は従来のシェーダを使う
+    const csmBool isFramebufferFetchUsed = _isFramebufferFetchSupported && ColorBlendMode_None != colorBlendMode;
+    if (_isUniformBufferSupported && useUniformBuffer && !isFramebufferFetchUsed)
+    {
+        const csmString uniformBufferVertShaderPath = MakeUniformBufferShaderPath(vertShaderPath);
+        const csmString uniformBufferFragShaderPath = MakeUniformBufferShaderPath(fragShaderPath);
+        const GLuint shaderProgram = LoadShaderProgramFromFile(uniformBufferVertShaderPath.GetRawString(), uniformBufferFragShaderPath.GetRawString(), colorBlendMode, alphaBlendMode, false);
+        if (shaderProgram != 0)
+        {
+            return shaderProgram;
+        }
+
+        CubismLogWarning("Uniform buffer is not available for %s. Uniform variables are used instead.", fragShaderPath);
+    }
+
     csmLoadFileFunction fileLoader = Csm::CubismFramework::GetLoadFileFunction();
     csmReleaseBytesFunction bytesReleaser = Csm::CubismFramework::GetReleaseBytesFunction();
 
@@ -1001,14 +1465,144 @@ GLuint CubismShader_OpenGLES2::LoadShaderProgramFromFile(const csmChar* vertShad
 
         bytesReleaser(colorBlendSrc);
         bytesReleaser(alphaBlendSrc);
+
+        // 描画先をフレームバッファから直接読めるなら、描画先のコピーを参照しないようにする
+        if (_isFramebufferFetchSupported)
+        {
+            fragString = InsertAfterVersionDirective(fragString, FramebufferFetchSource);
+        }
     }
 
     // ファイル読み込みで確保したバイト列を開放
     bytesReleaser(vertSrc);
     bytesReleaser(fragSrc);
 
+    return LoadShaderProgramWithCache(vertString, fragString);
+}
+
+GLuint CubismShader_OpenGLES2::LoadShaderProgramWithCache(const csmString& vertShaderSrc, const csmString& fragShaderSrc)
+{
+    // 保存済みのプログラムバイナリがあればコンパイルせずに使う
+    GLuint shaderProgram = LoadProgramBinaryCache(vertShaderSrc, fragShaderSrc);
+    if (shaderProgram != 0)
+    {
+        return shaderProgram;
+    }
+
     // シェーダーオブジェクトを作成
-    return LoadShaderProgram(vertString.GetRawString(), fragString.GetRawString());
+    shaderProgram = LoadShaderProgram(vertShaderSrc.GetRawString(), fragShaderSrc.GetRawString());
+    SaveProgramBinaryCache(shaderProgram, vertShaderSrc, fragShaderSrc);
+
+    return shaderProgram;
+}
+
+void CubismShader_OpenGLES2::SetupUniformBlock(CubismShaderSet& shaderSet)
+{
+    shaderSet.IsUniformBufferEnabled = false;
+
+#ifdef CSM_GL_UNIFORM_BUFFER_SUPPORTED
+    if (!_isUniformBufferSupported || shaderSet.ShaderProgram == 0)
+    {
+        return;
+    }
+
+    // ユニフォームブロックを使わないシェーダで生成されたプログラムはブロックを持たない
+    const GLuint blockIndex = glGetUniformBlockIndex(shaderSet.ShaderProgram, DrawUniformBlockName);
+    if (blockIndex == GL_INVALID_INDEX)
+    {
+        return;
+    }
+
+    glUniformBlockBinding(shaderSet.ShaderProgram, blockIndex, DrawUniformBlockBinding);
+    shaderSet.IsUniformBufferEnabled = true;
+#endif
+}
+
+void CubismShader_OpenGLES2::SetDrawUniformMatrix(const DrawUniformFlag flag, const csmFloat32* matrix)
+{
+    csmFloat32* destination = (flag == DrawUniformFlag_Matrix) ? _drawUniforms.Matrix : _drawUniforms.ClipMatrix;
+    memcpy(destination, matrix, sizeof(csmFloat32) * 16);
+    _drawUniformFlags |= flag;
+}
+
+void CubismShader_OpenGLES2::SetDrawUniformColor(const DrawUniformFlag flag, const CubismRenderer::CubismTextureColor& color)
+{
+    csmFloat32* destination;
+    switch (flag)
+    {
+    case DrawUniformFlag_BaseColor:
+        destination = _drawUniforms.BaseColor;
+        break;
+    case DrawUniformFlag_MultiplyColor:
+        destination = _drawUniforms.MultiplyColor;
+        break;
+    case DrawUniformFlag_ScreenColor:
+        destination = _drawUniforms.ScreenColor;
+        break;
+    case DrawUniformFlag_ChannelFlag:
+    default:
+        destination = _drawUniforms.ChannelFlag;
+        break;
+    }
+
+    destination[0] = color.R;
+    destination[1] = color.G;
+    destination[2] = color.B;
+    destination[3] = color.A;
+    _drawUniformFlags |= flag;
+}
+
+void CubismShader_OpenGLES2::FlushDrawUniforms(CubismShaderSet* shaderSet)
+{
+#ifdef CSM_GL_UNIFORM_BUFFER_SUPPORTED
+    if (shaderSet->IsUniformBufferEnabled)
+    {
+        // 使い切ったら領域を確保しなおし、GPUが参照中の領域への書き込みで待たされないようにする
+        const csmUint32 bufferSize = _uniformBufferStride * UniformBufferRingCount;
+        glBindBuffer(GL_UNIFORM_BUFFER, _uniformBuffer);
+        if (_uniformBufferOffset + _uniformBufferStride > bufferSize)
+        {
+            glBufferData(GL_UNIFORM_BUFFER, bufferSize, NULL, GL_STREAM_DRAW);
+            _uniformBufferOffset = 0;
+        }
+
+        // 1描画分の変数をまとめて書き込み、その範囲をバインドする
+        glBufferSubData(GL_UNIFORM_BUFFER, _uniformBufferOffset, sizeof(CubismDrawUniforms), &_drawUniforms);
+        glBindBufferRange(GL_UNIFORM_BUFFER, DrawUniformBlockBinding, _uniformBuffer, _uniformBufferOffset, sizeof(CubismDrawUniforms));
+        _uniformBufferOffset += _uniformBufferStride;
+
+        _drawUniformFlags = 0;
+        return;
+    }
+#endif
+
+    // ユニフォームバッファを使えない場合は設定された変数だけを個別に渡す
+    if (_drawUniformFlags & DrawUniformFlag_Matrix)
+    {
+        glUniformMatrix4fv(shaderSet->UniformMatrixLocation, 1, GL_FALSE, _drawUniforms.Matrix);
+    }
+    if (_drawUniformFlags & DrawUniformFlag_ClipMatrix)
+    {
+        glUniformMatrix4fv(shaderSet->UniformClipMatrixLocation, 1, GL_FALSE, _drawUniforms.ClipMatrix);
+    }
+    if (_drawUniformFlags & DrawUniformFlag_BaseColor)
+    {
+        glUniform4fv(shaderSet->UniformBaseColorLocation, 1, _drawUniforms.BaseColor);
+    }
+    if (_drawUniformFlags & DrawUniformFlag_MultiplyColor)
+    {
+        glUniform4fv(shaderSet->UniformMultiplyColorLocation, 1, _drawUniforms.MultiplyColor);
+    }
+    if (_drawUniformFlags & DrawUniformFlag_ScreenColor)
+    {
+        glUniform4fv(shaderSet->UniformScreenColorLocation, 1, _drawUniforms.ScreenColor);
+    }
+    if (_drawUniformFlags & DrawUniformFlag_ChannelFlag)
+    {
+        glUniform4fv(shaderSet->UnifromChannelFlagLocation, 1, _drawUniforms.ChannelFlag);
+    }
+
+    _drawUniformFlags = 0;
 }
 
 GLuint CubismShader_OpenGLES2::LoadShaderProgram(const csmChar* vertShaderSrc, const csmChar* fragShaderSrc)
@@ -1077,6 +1671,127 @@ GLuint CubismShader_OpenGLES2::LoadShaderProgram(const csmChar* vertShaderSrc, c
     return shaderProgram;
 }
 
+void CubismShader_OpenGLES2::MakeProgramBinaryCachePath(const csmString& vertShaderSrc, const csmString& fragShaderSrc, csmChar* path, csmSizeInt pathSize) const
+{
+    // ファイル名はハッシュ値から作る。衝突しても読み込み時にドライバとソースの全体を比較するため誤って使われることはない
+    csmUint32 hash = AccumulateHash(2166136261u, _programBinaryDriverName.GetRawString(), _programBinaryDriverName.GetLength());
+    hash = AccumulateHash(hash, vertShaderSrc.GetRawString(), vertShaderSrc.GetLength());
+    hash = AccumulateHash(hash, fragShaderSrc.GetRawString(), fragShaderSrc.GetLength());
+
+    std::snprintf(path, pathSize, "%s/CubismProgram_%08X.bin", s_programBinaryCacheDirectory, hash);
+}
+
+GLuint CubismShader_OpenGLES2::LoadProgramBinaryCache(const csmString& vertShaderSrc, const csmString& fragShaderSrc)
+{
+#ifdef CSM_GL_PROGRAM_BINARY_SUPPORTED
+    if (!_isProgramBinarySupported)
+    {
+        return 0;
+    }
+
+    csmChar path[ProgramBinaryCacheDirectoryMaxLength + 32];
+    MakeProgramBinaryCachePath(vertShaderSrc, fragShaderSrc, path, sizeof(path));
+
+    FILE* file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return 0;
+    }
+
+    GLuint shaderProgram = 0;
+    csmUint32 header[ProgramBinaryCacheHeaderCount];
+
+    // ドライバかソースが保存時と1文字でも異なる場合は使わない
+    if (fread(header, sizeof(csmUint32), ProgramBinaryCacheHeaderCount, file) == static_cast<csmSizeInt>(ProgramBinaryCacheHeaderCount) &&
+        header[0] == ProgramBinaryCacheMagic &&
+        header[1] == ProgramBinaryCacheVersion &&
+        header[2] == static_cast<csmUint32>(_programBinaryDriverName.GetLength()) &&
+        header[3] == static_cast<csmUint32>(vertShaderSrc.GetLength()) &&
+        header[4] == static_cast<csmUint32>(fragShaderSrc.GetLength()) &&
+        header[6] > 0 &&
+        ReadAndCompare(file, _programBinaryDriverName.GetRawString(), header[2]) &&
+        ReadAndCompare(file, vertShaderSrc.GetRawString(), header[3]) &&
+        ReadAndCompare(file, fragShaderSrc.GetRawString(), header[4]))
+    {
+        void* binary = CSM_MALLOC(header[6]);
+        if (fread(binary, 1, header[6], file) == header[6])
+        {
+            shaderProgram = glCreateProgram();
+            glProgramBinary(shaderProgram, static_cast<GLenum>(header[5]), binary, static_cast<GLsizei>(header[6]));
+
+            // ドライバの更新などで受け付けられなかった場合はコンパイルしなおす
+            GLint status = GL_FALSE;
+            glGetProgramiv(shaderProgram, GL_LINK_STATUS, &status);
+            if (status == GL_FALSE)
+            {
+                glDeleteProgram(shaderProgram);
+                shaderProgram = 0;
+            }
+        }
+        CSM_FREE(binary);
+    }
+
+    fclose(file);
+
+    return shaderProgram;
+#else
+    return 0;
+#endif
+}
+
+void CubismShader_OpenGLES2::SaveProgramBinaryCache(const GLuint shaderProgram, const csmString& vertShaderSrc, const csmString& fragShaderSrc)
+{
+#ifdef CSM_GL_PROGRAM_BINARY_SUPPORTED
+    if (!_isProgramBinarySupported || shaderProgram == 0)
+    {
+        return;
+    }
+
+    GLint binaryLength = 0;
+    glGetProgramiv(shaderProgram, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength <= 0)
+    {
+        return;
+    }
+
+    void* binary = CSM_MALLOC(binaryLength);
+    GLenum binaryFormat = 0;
+    GLsizei writtenLength = 0;
+    glGetProgramBinary(shaderProgram, binaryLength, &writtenLength, &binaryFormat, binary);
+
+    csmChar path[ProgramBinaryCacheDirectoryMaxLength + 32];
+    MakeProgramBinaryCachePath(vertShaderSrc, fragShaderSrc, path, sizeof(path));
+
+    FILE* file = (writtenLength > 0) ? fopen(path, "wb") : NULL;
+    if (file != NULL)
+    {
+        const csmUint32 header[ProgramBinaryCacheHeaderCount] = {
+            ProgramBinaryCacheMagic,
+            ProgramBinaryCacheVersion,
+            static_cast<csmUint32>(_programBinaryDriverName.GetLength()),
+            static_cast<csmUint32>(vertShaderSrc.GetLength()),
+            static_cast<csmUint32>(fragShaderSrc.GetLength()),
+            static_cast<csmUint32>(binaryFormat),
+            static_cast<csmUint32>(writtenLength),
+        };
+
+        // 読み込み時に比較するため、ドライバの識別情報とソースの全体をバイナリの前に保存する
+        if (fwrite(header, sizeof(csmUint32), ProgramBinaryCacheHeaderCount, file) != static_cast<csmSizeInt>(ProgramBinaryCacheHeaderCount) ||
+            fwrite(_programBinaryDriverName.GetRawString(), 1, _programBinaryDriverName.GetLength(), file) != static_cast<csmSizeInt>(_programBinaryDriverName.GetLength()) ||
+            fwrite(vertShaderSrc.GetRawString(), 1, vertShaderSrc.GetLength(), file) != static_cast<csmSizeInt>(vertShaderSrc.GetLength()) ||
+            fwrite(fragShaderSrc.GetRawString(), 1, fragShaderSrc.GetLength(), file) != static_cast<csmSizeInt>(fragShaderSrc.GetLength()) ||
+            fwrite(binary, 1, writtenLength, file) != static_cast<csmSizeInt>(writtenLength))
+        {
+            CubismLogWarning("Failed to write program binary cache: %s", path);
+        }
+
+        fclose(file);
+    }
+
+    CSM_FREE(binary);
+#endif
+}
+
 void CubismShader_OpenGLES2::SetVertexAttributes(const CubismModel& model, const csmInt32 index, CubismShaderSet* shaderSet)
 {
     // 頂点位置属性の設定
@@ -1103,19 +1818,19 @@ void CubismShader_OpenGLES2::SetupTexture(CubismRenderer_OpenGLES2* renderer, co
     glUniform1i(shaderSet->SamplerTexture0Location, 0);
 }
 
-void CubismShader_OpenGLES2::SetColorUniformVariables(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index, CubismShaderSet* shaderSet,
+void CubismShader_OpenGLES2::SetColorUniformVariables(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index, CubismShaderSet*,
                                                       CubismRenderer::CubismTextureColor& baseColor, CubismRenderer::CubismTextureColor& multiplyColor, CubismRenderer::CubismTextureColor& screenColor)
 {
-    glUniform4f(shaderSet->UniformBaseColorLocation, baseColor.R, baseColor.G, baseColor.B, baseColor.A);
-    glUniform4f(shaderSet->UniformMultiplyColorLocation, multiplyColor.R, multiplyColor.G, multiplyColor.B, multiplyColor.A);
-    glUniform4f(shaderSet->UniformScreenColorLocation, screenColor.R, screenColor.G, screenColor.B, screenColor.A);
+    SetDrawUniformColor(DrawUniformFlag_BaseColor, baseColor);
+    SetDrawUniformColor(DrawUniformFlag_MultiplyColor, multiplyColor);
+    SetDrawUniformColor(DrawUniformFlag_ScreenColor, screenColor);
 }
 
-void CubismShader_OpenGLES2::SetColorChannelUniformVariables(CubismShaderSet* shaderSet, CubismClippingContext_OpenGLES2* contextBuffer)
+void CubismShader_OpenGLES2::SetColorChannelUniformVariables(CubismShaderSet*, CubismClippingContext_OpenGLES2* contextBuffer)
 {
     const csmInt32 channelIndex = contextBuffer->_layoutChannelIndex;
     CubismRenderer::CubismTextureColor* colorChannel = contextBuffer->GetClippingManager()->GetChannelFlagAsColor(channelIndex);
-    glUniform4f(shaderSet->UnifromChannelFlagLocation, colorChannel->R, colorChannel->G, colorChannel->B, colorChannel->A);
+    SetDrawUniformColor(DrawUniformFlag_ChannelFlag, *colorChannel);
 }
 
 }}}}
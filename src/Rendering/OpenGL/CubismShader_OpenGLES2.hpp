@@ -66,6 +66,16 @@ public:
      */
     static void DeleteInstance();
 
+    /**
+     * @brief   リンク済みのシェーダプログラムのバイナリを保存するディレクトリを設定する。<br>
+     *          設定されている場合、プログラムバイナリに対応した環境ではコンパイルの代わりに保存済みのバイナリを読み込む。<br>
+     *          ドライバやシェーダのソースが変わった場合、保存済みのバイナリは使われない。<br>
+     *          インスタンスの生成前に呼ぶこと。
+     *
+     * @param[in]   directoryPath   ->  保存先のディレクトリのパス。NULLまたは空文字列の場合は保存しない
+     */
+    static void SetProgramBinaryCacheDirectory(const csmChar* directoryPath);
+
     /**
      * @brief   一部の環境でこのインスタンスが管理するリソースが破棄される場合があります。
      *          このような場合に二重解放を避け無効になったリソースを破棄します。
@@ -97,6 +107,14 @@ public:
      */
     void SetupShaderProgramForOffscreenRenderTarget(CubismRenderer_OpenGLES2* renderer);
 
+    /**
+     * @brief   モデル描画先のテクスチャを描画するシェーダプログラムの一連のセットアップを実行する
+     *
+     * @param[in]   renderer              ->  レンダラー
+     * @param[in]   texture               ->  モデル全体を描画したテクスチャ
+     */
+    void SetupShaderProgramForOffscreenRenderTarget(CubismRenderer_OpenGLES2* renderer, GLuint texture);
+
     /**
      * @brief   オフスクリーンからのシェーダプログラムの一連のセットアップを実行する
      *
@@ -106,6 +124,26 @@ public:
      */
     void SetupShaderProgramForOffscreen(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const CubismOffscreenRenderTarget_OpenGLES2* offscreen);
 
+    /**
+     * @brief   インスタンス描画用のシェーダプログラムの一連のセットアップを実行する<br>
+     *          同じメッシュを複数のモデルの分まとめて描画するため、頂点は全インスタンス分を連結した配列で渡す
+     *
+     * @param[in]   renderer          ->  先頭のインスタンスのレンダラー
+     * @param[in]   model             ->  先頭のインスタンスのモデル
+     * @param[in]   index             ->  描画対象のメッシュのインデックス
+     * @param[in]   positions         ->  全インスタンスの頂点座標を連結した配列
+     * @param[in]   uvs               ->  全インスタンスのテクスチャ座標を連結した配列
+     * @param[in]   instanceIndices   ->  頂点ごとのインスタンス番号
+     * @param[in]   instanceCount     ->  インスタンス数
+     * @param[in]   matrices          ->  インスタンスごとの座標変換行列（16要素ずつ）
+     * @param[in]   baseColors        ->  インスタンスごとの基本色（4要素ずつ）
+     * @param[in]   multiplyColors    ->  インスタンスごとの乗算色（4要素ずつ）
+     * @param[in]   screenColors      ->  インスタンスごとのスクリーン色（4要素ずつ）
+     */
+    void SetupShaderProgramForInstancedDrawable(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, csmInt32 index,
+                                                const csmFloat32* positions, const csmFloat32* uvs, const csmFloat32* instanceIndices, csmInt32 instanceCount,
+                                                const csmFloat32* matrices, const csmFloat32* baseColors, const csmFloat32* multiplyColors, const csmFloat32* screenColors);
+
     /**
      * @brief   シェーダを使って描画対象をコピーする
      *
@@ -133,6 +171,7 @@ private:
         MaskType_PremultipliedAlpha,
         MaskType_MaskedPremultipliedAlpha,
         MaskType_MaskedInvertedPremultipliedAlpha,
+        MaskType_Count,
     };
 
     enum ColorBlendMode
@@ -186,7 +225,43 @@ private:
         GLint UniformMultiplyColorLocation; ///< シェーダプログラムに渡す変数のアドレス(MultiplyColor)
         GLint UniformScreenColorLocation;   ///< シェーダプログラムに渡す変数のアドレス(ScreenColor)
         GLint UnifromChannelFlagLocation;   ///< シェーダプログラムに渡す変数のアドレス(ChannelFlag)
+        GLuint AttributeInstanceIndexLocation;      ///< シェーダプログラムに渡す変数のアドレス(InstanceIndex)
+        GLint UniformInstanceMatricesLocation;      ///< シェーダプログラムに渡す変数のアドレス(InstanceMatrices)
+        GLint UniformInstanceBaseColorsLocation;    ///< シェーダプログラムに渡す変数のアドレス(InstanceBaseColors)
+        GLint UniformInstanceMultiplyColorsLocation;///< シェーダプログラムに渡す変数のアドレス(InstanceMultiplyColors)
+        GLint UniformInstanceScreenColorsLocation;  ///< シェーダプログラムに渡す変数のアドレス(InstanceScreenColors)
+        csmBool IsLoaded;                   ///< シェーダプログラムの生成を試みたか
+        csmBool IsUniformBufferEnabled;     ///< 描画ごとの変数をユニフォームバッファで受け取るか
+    };
+
+    /**
+     * @brief   描画ごとに更新する変数のフラグ
+     */
+    enum DrawUniformFlag
+    {
+        DrawUniformFlag_Matrix = 1 << 0,
+        DrawUniformFlag_ClipMatrix = 1 << 1,
+        DrawUniformFlag_BaseColor = 1 << 2,
+        DrawUniformFlag_MultiplyColor = 1 << 3,
+        DrawUniformFlag_ScreenColor = 1 << 4,
+        DrawUniformFlag_ChannelFlag = 1 << 5,
     };
+
+    /**
+     * @brief   描画ごとに更新する変数<br>
+     *          ユニフォームバッファではstd140のレイアウトでそのまま転送する<br>
+     *          並びは各シェーダのUniformBuffer版で宣言するCubismDrawUniformsブロックと一致させる
+     */
+    struct CubismDrawUniforms
+    {
+        csmFloat32 Matrix[16];          ///< u_matrix
+        csmFloat32 ClipMatrix[16];      ///< u_clipMatrix
+        csmFloat32 BaseColor[4];        ///< u_baseColor
+        csmFloat32 MultiplyColor[4];    ///< u_multiplyColor
+        csmFloat32 ScreenColor[4];      ///< u_screenColor
+        csmFloat32 ChannelFlag[4];      ///< u_channelFlag
+    };
+
     /**
      * @brief   CubismShaderSetを設定する
      *
@@ -194,7 +269,7 @@ private:
      * @param[in]   maskType     ->  マスクの種類
      * @param[in]   isBlendMode  ->  ブレンドモードを使用するか
      */
-    static void SetShaderSet(CubismShaderSet& shaderSets, MaskType maskType, csmBool isBlendMode = false);
+    void SetShaderSet(CubismShaderSet& shaderSets, MaskType maskType, csmBool isBlendMode = false);
 
     /**
      * @brief   どのシェーダーを利用するかを取得する
@@ -205,6 +280,30 @@ private:
      */
     static csmInt32 GetShaderNamesBegin(const csmBlendMode blendMode);
 
+    /**
+     * @brief   シェーダーセットを取得する<br>
+     *          ブレンドモード用のシェーダは初めて使われるときに生成する
+     *
+     * @param[in]   shaderName  ->  シェーダの番号
+     *
+     * @return  シェーダーセット
+     */
+    CubismShaderSet* GetShaderSet(csmInt32 shaderName);
+
+    /**
+     * @brief   ブレンドモード用のシェーダプログラムを生成する
+     *
+     * @param[in]   shaderName  ->  シェーダの番号
+     */
+    void GenerateBlendShader(csmInt32 shaderName);
+
+    /**
+     * @brief   インスタンス描画用のシェーダプログラムを生成する
+     *
+     * @param[in]   shaderName  ->  シェーダの番号
+     */
+    void GenerateInstancedShader(csmInt32 shaderName);
+
     /**
      * @brief   privateなコンストラクタ
      */
@@ -232,10 +331,11 @@ private:
      * @param[in]   fragShaderSrc    ->  フラグメントシェーダのファイルパス
      * @param[in]   colorBlendMode   ->  ブレンドカラーモード
      * @param[in]   alphaBlendMode ->  オーバーラップカラーモード
+     * @param[in]   useUniformBuffer ->  描画ごとの変数をユニフォームブロックで受け取るシェーダ（ファイル名の拡張子の前にUniformBufferを付けたもの）を優先するか
      *
      * @return  シェーダーオブジェクトの番号
      */
-    GLuint LoadShaderProgramFromFile(const csmChar* vertShaderPath, const csmChar* fragShaderPath, csmInt32 colorBlendMode = ColorBlendMode_None, csmInt32 alphaBlendMode = AlphaBlendMode_None);
+    GLuint LoadShaderProgramFromFile(const csmChar* vertShaderPath, const csmChar* fragShaderPath, csmInt32 colorBlendMode = ColorBlendMode_None, csmInt32 alphaBlendMode = AlphaBlendMode_None, csmBool useUniformBuffer = true);
 
     /**
      * @brief   シェーダプログラムをロードしてアドレス返す。
@@ -247,6 +347,78 @@ private:
      */
     GLuint LoadShaderProgram(const csmChar* vertShaderSrc, const csmChar* fragShaderSrc);
 
+    /**
+     * @brief   保存済みのプログラムバイナリがあれば読み込み、なければコンパイルしてバイナリを保存する
+     *
+     * @param[in]   vertShaderSrc   ->  頂点シェーダのソース
+     * @param[in]   fragShaderSrc   ->  フラグメントシェーダのソース
+     *
+     * @return  シェーダプログラムのアドレス
+     */
+    GLuint LoadShaderProgramWithCache(const csmString& vertShaderSrc, const csmString& fragShaderSrc);
+
+    /**
+     * @brief   シェーダプログラムのユニフォームブロックをバインドポイントに結び付ける
+     *
+     * @param[in]   shaderSet   ->  シェーダープログラムのセット
+     */
+    void SetupUniformBlock(CubismShaderSet& shaderSet);
+
+    /**
+     * @brief   描画ごとの行列を設定する。値は FlushDrawUniforms() でまとめてGPUに渡す
+     *
+     * @param[in]   flag    ->  設定する変数のフラグ
+     * @param[in]   matrix  ->  行列
+     */
+    void SetDrawUniformMatrix(DrawUniformFlag flag, const csmFloat32* matrix);
+
+    /**
+     * @brief   描画ごとの色を設定する。値は FlushDrawUniforms() でまとめてGPUに渡す
+     *
+     * @param[in]   flag    ->  設定する変数のフラグ
+     * @param[in]   color   ->  色
+     */
+    void SetDrawUniformColor(DrawUniformFlag flag, const CubismRenderer::CubismTextureColor& color);
+
+    /**
+     * @brief   設定された描画ごとの変数をGPUに渡す<br>
+     *          ユニフォームバッファが使える場合はリングバッファの次の領域に書き込んでバインドし、使えない場合はユニフォーム変数を個別に設定する
+     *
+     * @param[in]   shaderSet   ->  シェーダープログラムのセット
+     */
+    void FlushDrawUniforms(CubismShaderSet* shaderSet);
+
+    /**
+     * @brief   プログラムバイナリの保存先のパスを作る
+     *
+     * @param[in]   vertShaderSrc   ->  頂点シェーダのソース
+     * @param[in]   fragShaderSrc   ->  フラグメントシェーダのソース
+     * @param[out]  path            ->  保存先のパス
+     * @param[in]   pathSize        ->  pathのバッファのサイズ
+     */
+    void MakeProgramBinaryCachePath(const csmString& vertShaderSrc, const csmString& fragShaderSrc, csmChar* path, csmSizeInt pathSize) const;
+
+    /**
+     * @brief   保存済みのプログラムバイナリからシェーダプログラムを生成する
+     *
+     * 保存時とドライバの識別情報かソースの全体が一致しない場合や、ドライバがバイナリを受け付けない場合は使わない。
+     *
+     * @param[in]   vertShaderSrc   ->  頂点シェーダのソース
+     * @param[in]   fragShaderSrc   ->  フラグメントシェーダのソース
+     *
+     * @return  シェーダプログラムのアドレス。保存済みのバイナリが使えない場合は0
+     */
+    GLuint LoadProgramBinaryCache(const csmString& vertShaderSrc, const csmString& fragShaderSrc);
+
+    /**
+     * @brief   シェーダプログラムのバイナリを保存する
+     *
+     * @param[in]   shaderProgram   ->  保存するシェーダプログラムのアドレス
+     * @param[in]   vertShaderSrc   ->  頂点シェーダのソース
+     * @param[in]   fragShaderSrc   ->  フラグメントシェーダのソース
+     */
+    void SaveProgramBinaryCache(GLuint shaderProgram, const csmString& vertShaderSrc, const csmString& fragShaderSrc);
+
     /**
      * @brief   シェーダプログラムをコンパイルする
      *
@@ -336,6 +508,15 @@ private:
 #endif
 
     csmVector<CubismShaderSet*> _shaderSets;   ///< ロードしたシェーダプログラムを保持する変数
+    csmBool _isProgramBinarySupported;          ///< プログラムバイナリの保存・読み込みに対応しているか
+    csmString _programBinaryDriverName;         ///< 保存したプログラムバイナリを使えるドライバか判定するための識別情報（ベンダ・レンダラ・バージョン）
+    csmBool _isUniformBufferSupported;          ///< 描画ごとの変数をユニフォームバッファで渡せるか
+    csmBool _isFramebufferFetchSupported;       ///< ブレンドモードの描画先をフレームバッファフェッチで読めるか
+    GLuint _uniformBuffer;                      ///< 描画ごとの変数のリングバッファ
+    csmUint32 _uniformBufferStride;             ///< リングバッファの1描画分の間隔
+    csmUint32 _uniformBufferOffset;             ///< リングバッファの次に書き込む位置
+    CubismDrawUniforms _drawUniforms;           ///< 次の描画で使う変数
+    csmUint32 _drawUniformFlags;                ///< 次の描画で設定された変数のフラグ
 
 };
 
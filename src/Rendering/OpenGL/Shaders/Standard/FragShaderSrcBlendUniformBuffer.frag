@@ -0,0 +1,38 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#version 140
+
+in vec2 v_texCoord; //v2f.texcoord
+in vec2 v_blendCoord;
+uniform sampler2D s_texture0; //_MainTex
+uniform sampler2D s_blendTexture;
+layout(std140) uniform CubismDrawUniforms
+{
+    mat4 u_matrix;
+    mat4 u_clipMatrix;
+    vec4 u_baseColor;
+    vec4 u_multiplyColor;
+    vec4 u_screenColor;
+    vec4 u_channelFlag;
+};
+out vec4 fragColor;
+
+vec4 ConvertPremultipliedToStraight(vec4 source);
+vec3 ColorBlend(vec3 colorSource, vec3 colorDestination);
+vec4 AlphaBlend(vec3 color, vec4 colorSource, vec4 colorDestination);
+
+void main()
+{
+    vec4 texColor = texture(s_texture0, v_texCoord);
+    texColor.rgb = texColor.rgb * u_multiplyColor.rgb;
+    texColor.rgb = texColor.rgb + u_screenColor.rgb - (texColor.rgb * u_screenColor.rgb);
+    vec4 colorSource = texColor * u_baseColor;
+    vec4 colorDestination = ConvertPremultipliedToStraight(texture(s_blendTexture, v_blendCoord));
+    fragColor = AlphaBlend(ColorBlend(colorSource.rgb, colorDestination.rgb), colorSource, colorDestination);
+}
+
@@ -0,0 +1,23 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#version 120
+
+varying vec2 v_texCoord; //v2f.texcoord
+varying vec4 v_baseColor;
+varying vec4 v_multiplyColor;
+varying vec4 v_screenColor;
+uniform sampler2D s_texture0; //_MainTex
+
+void main()
+{
+    vec4 texColor = texture2D(s_texture0, v_texCoord);
+    texColor.rgb = texColor.rgb * v_multiplyColor.rgb;
+    texColor.rgb = texColor.rgb + v_screenColor.rgb - (texColor.rgb * v_screenColor.rgb);
+    vec4 color = texColor * v_baseColor;
+    gl_FragColor = vec4(color.rgb * color.a, color.a);
+}
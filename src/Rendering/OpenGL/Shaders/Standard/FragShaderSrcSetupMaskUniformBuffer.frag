@@ -0,0 +1,33 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#version 140
+
+in vec2 v_texCoord;
+in vec4 v_myPos;
+uniform sampler2D s_texture0;
+layout(std140) uniform CubismDrawUniforms
+{
+    mat4 u_matrix;
+    mat4 u_clipMatrix;
+    vec4 u_baseColor;
+    vec4 u_multiplyColor;
+    vec4 u_screenColor;
+    vec4 u_channelFlag;
+};
+out vec4 fragColor;
+
+void main()
+{
+    float isInside =
+        step(u_baseColor.x, v_myPos.x/v_myPos.w)
+        * step(u_baseColor.y, v_myPos.y/v_myPos.w)
+        * step(v_myPos.x/v_myPos.w, u_baseColor.z)
+        * step(v_myPos.y/v_myPos.w, u_baseColor.w);
+
+    fragColor = u_channelFlag * texture(s_texture0, v_texCoord).a * isInside;
+}
@@ -0,0 +1,31 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#version 120
+
+attribute vec4 a_position; //v.vertex
+attribute vec2 a_texCoord; //v.texcoord
+attribute float a_instanceIndex; //インスタンスの番号
+varying vec2 v_texCoord; //v2f.texcoord
+varying vec4 v_baseColor;
+varying vec4 v_multiplyColor;
+varying vec4 v_screenColor;
+uniform mat4 u_instanceMatrices[16];
+uniform vec4 u_instanceBaseColors[16];
+uniform vec4 u_instanceMultiplyColors[16];
+uniform vec4 u_instanceScreenColors[16];
+
+void main()
+{
+    int instanceIndex = int(a_instanceIndex + 0.5);
+    gl_Position = u_instanceMatrices[instanceIndex] * a_position;
+    v_texCoord = a_texCoord;
+    v_texCoord.y = 1.0 - v_texCoord.y;
+    v_baseColor = u_instanceBaseColors[instanceIndex];
+    v_multiplyColor = u_instanceMultiplyColors[instanceIndex];
+    v_screenColor = u_instanceScreenColors[instanceIndex];
+}
@@ -0,0 +1,33 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#version 140
+
+in vec4 a_position;
+in vec2 a_texCoord;
+out vec2 v_texCoord;
+out vec2 v_blendCoord;
+out vec4 v_clipPos;
+layout(std140) uniform CubismDrawUniforms
+{
+    mat4 u_matrix;
+    mat4 u_clipMatrix;
+    vec4 u_baseColor;
+    vec4 u_multiplyColor;
+    vec4 u_screenColor;
+    vec4 u_channelFlag;
+};
+
+void main()
+{
+    gl_Position = u_matrix * a_position;
+    v_clipPos = u_clipMatrix * a_position;
+    v_texCoord = a_texCoord;
+    v_texCoord.y = 1.0 - v_texCoord.y;
+    vec2 ndcPos = gl_Position.xy / gl_Position.w;
+    v_blendCoord = ndcPos * 0.5 + 0.5;
+}
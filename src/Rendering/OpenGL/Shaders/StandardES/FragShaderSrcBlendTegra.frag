@@ -28,7 +28,11 @@ void main()
     texColor.rgb = texColor.rgb * u_multiplyColor.rgb;
     texColor.rgb = texColor.rgb + u_screenColor.rgb - (texColor.rgb * u_screenColor.rgb);
     vec4 colorSource = texColor * u_baseColor;
+#ifdef CSM_FRAMEBUFFER_FETCH
+    vec4 colorDestination = ConvertPremultipliedToStraight(gl_LastFragData[0]);
+#else
     vec4 colorDestination = ConvertPremultipliedToStraight(texture2D(s_blendTexture, v_blendCoord));
+#endif
     gl_FragColor = AlphaBlend(ColorBlend(colorSource.rgb, colorDestination.rgb), colorSource, colorDestination);
 }
 
@@ -0,0 +1,28 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#version 300 es
+
+precision highp float;
+
+in vec2 v_texCoord;
+uniform sampler2D s_texture0;
+layout(std140) uniform CubismDrawUniforms
+{
+    highp mat4 u_matrix;
+    highp mat4 u_clipMatrix;
+    highp vec4 u_baseColor;
+    highp vec4 u_multiplyColor;
+    highp vec4 u_screenColor;
+    highp vec4 u_channelFlag;
+};
+out vec4 fragColor;
+
+void main()
+{
+    fragColor = texture(s_texture0, v_texCoord) * u_baseColor;
+}
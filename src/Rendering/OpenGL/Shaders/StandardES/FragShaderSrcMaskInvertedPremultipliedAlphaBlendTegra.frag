@@ -34,6 +34,10 @@ void main()
     vec4 clipMask = (1.0 - texture2D(s_texture1, v_clipPos.xy / v_clipPos.w)) * u_channelFlag;
     float maskVal = clipMask.r + clipMask.g + clipMask.b + clipMask.a;
     vec4 colorSource = vec4(col_formask.rgb, col_formask.a * (1.0 - maskVal));
+#ifdef CSM_FRAMEBUFFER_FETCH
+    vec4 colorDestination = ConvertPremultipliedToStraight(gl_LastFragData[0]);
+#else
     vec4 colorDestination = ConvertPremultipliedToStraight(texture2D(s_blendTexture, v_blendCoord));
+#endif
     gl_FragColor = AlphaBlend(ColorBlend(colorSource.rgb, colorDestination.rgb), colorSource, colorDestination);
 }
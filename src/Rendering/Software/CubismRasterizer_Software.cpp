@@ -0,0 +1,1071 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismRasterizer_Software.hpp"
+#include "Math/CubismMath.hpp"
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CSM_SOFTWARE_RASTERIZER_SSE2
+#include <emmintrin.h>
+#endif
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+namespace {
+    const csmInt32 TileSize = 64;           ///< タイルの幅・高さ（ピクセル）
+    const csmInt32 VertexStride = 6;        ///< 変換済み頂点の要素数（x, y, s, t, マスクのs, t）
+    const csmFloat32 Epsilon = 0.00001f;    ///< PremultipliedAlphaを解除する際に0とみなすアルファ
+
+    /*****************************************************************************************************************
+    *                                      RGBAを1つにまとめて扱うベクトル演算
+    *****************************************************************************************************************/
+#ifdef CSM_SOFTWARE_RASTERIZER_SSE2
+    typedef __m128 Vector4;
+
+    inline Vector4 VectorSet(csmFloat32 r, csmFloat32 g, csmFloat32 b, csmFloat32 a)
+    {
+        return _mm_setr_ps(r, g, b, a);
+    }
+
+    inline Vector4 VectorSplat(csmFloat32 value)
+    {
+        return _mm_set1_ps(value);
+    }
+
+    inline Vector4 VectorLoad(const csmFloat32* src)
+    {
+        return _mm_loadu_ps(src);
+    }
+
+    inline void VectorStore(csmFloat32* dst, Vector4 value)
+    {
+        _mm_storeu_ps(dst, value);
+    }
+
+    inline Vector4 VectorAdd(Vector4 a, Vector4 b)
+    {
+        return _mm_add_ps(a, b);
+    }
+
+    inline Vector4 VectorSub(Vector4 a, Vector4 b)
+    {
+        return _mm_sub_ps(a, b);
+    }
+
+    inline Vector4 VectorMul(Vector4 a, Vector4 b)
+    {
+        return _mm_mul_ps(a, b);
+    }
+
+    inline Vector4 VectorSaturate(Vector4 value)
+    {
+        return _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    }
+
+    inline Vector4 VectorSplatAlpha(Vector4 value)
+    {
+        return _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    inline csmFloat32 VectorGetAlpha(Vector4 value)
+    {
+        return _mm_cvtss_f32(VectorSplatAlpha(value));
+    }
+
+    inline csmFloat32 VectorSum(Vector4 value)
+    {
+        const __m128 high = _mm_movehl_ps(value, value);
+        const __m128 pair = _mm_add_ps(value, high);
+        return _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+
+    inline csmBool VectorIsZero(Vector4 value)
+    {
+        return _mm_movemask_ps(_mm_cmpneq_ps(value, _mm_setzero_ps())) == 0;
+    }
+
+    /**
+     * @brief   RGBにアルファを乗算する。アルファはそのまま
+     */
+    inline Vector4 VectorPremultiply(Vector4 value)
+    {
+        const __m128 rgbMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+        const __m128 scaled = _mm_mul_ps(value, VectorSplatAlpha(value));
+        return _mm_or_ps(_mm_and_ps(rgbMask, scaled), _mm_andnot_ps(rgbMask, value));
+    }
+
+    /**
+     * @brief   RGBA8の1ピクセルを0~255の浮動小数点に展開する
+     */
+    inline Vector4 VectorLoadTexel(const csmUint8* src)
+    {
+        csmInt32 packed;
+        memcpy(&packed, src, sizeof(packed));
+        const __m128i zero = _mm_setzero_si128();
+        __m128i texel = _mm_cvtsi32_si128(packed);
+        texel = _mm_unpacklo_epi8(texel, zero);
+        texel = _mm_unpacklo_epi16(texel, zero);
+        return _mm_cvtepi32_ps(texel);
+    }
+
+    inline void VectorToArray(Vector4 value, csmFloat32* dst)
+    {
+        _mm_storeu_ps(dst, value);
+    }
+#else
+    struct Vector4
+    {
+        csmFloat32 V[4];
+    };
+
+    inline Vector4 VectorSet(csmFloat32 r, csmFloat32 g, csmFloat32 b, csmFloat32 a)
+    {
+        Vector4 result = { { r, g, b, a } };
+        return result;
+    }
+
+    inline Vector4 VectorSplat(csmFloat32 value)
+    {
+        return VectorSet(value, value, value, value);
+    }
+
+    inline Vector4 VectorLoad(const csmFloat32* src)
+    {
+        return VectorSet(src[0], src[1], src[2], src[3]);
+    }
+
+    inline void VectorStore(csmFloat32* dst, Vector4 value)
+    {
+        dst[0] = value.V[0];
+        dst[1] = value.V[1];
+        dst[2] = value.V[2];
+        dst[3] = value.V[3];
+    }
+
+    inline Vector4 VectorAdd(Vector4 a, Vector4 b)
+    {
+        return VectorSet(a.V[0] + b.V[0], a.V[1] + b.V[1], a.V[2] + b.V[2], a.V[3] + b.V[3]);
+    }
+
+    inline Vector4 VectorSub(Vector4 a, Vector4 b)
+    {
+        return VectorSet(a.V[0] - b.V[0], a.V[1] - b.V[1], a.V[2] - b.V[2], a.V[3] - b.V[3]);
+    }
+
+    inline Vector4 VectorMul(Vector4 a, Vector4 b)
+    {
+        return VectorSet(a.V[0] * b.V[0], a.V[1] * b.V[1], a.V[2] * b.V[2], a.V[3] * b.V[3]);
+    }
+
+    inline csmFloat32 Saturate(csmFloat32 value)
+    {
+        return (value < 0.0f) ? 0.0f : ((value > 1.0f) ? 1.0f : value);
+    }
+
+    inline Vector4 VectorSaturate(Vector4 value)
+    {
+        return VectorSet(Saturate(value.V[0]), Saturate(value.V[1]), Saturate(value.V[2]), Saturate(value.V[3]));
+    }
+
+    inline Vector4 VectorSplatAlpha(Vector4 value)
+    {
+        return VectorSplat(value.V[3]);
+    }
+
+    inline csmFloat32 VectorGetAlpha(Vector4 value)
+    {
+        return value.V[3];
+    }
+
+    inline csmFloat32 VectorSum(Vector4 value)
+    {
+        return value.V[0] + value.V[1] + value.V[2] + value.V[3];
+    }
+
+    inline csmBool VectorIsZero(Vector4 value)
+    {
+        return value.V[0] == 0.0f && value.V[1] == 0.0f && value.V[2] == 0.0f && value.V[3] == 0.0f;
+    }
+
+    inline Vector4 VectorPremultiply(Vector4 value)
+    {
+        return VectorSet(value.V[0] * value.V[3], value.V[1] * value.V[3], value.V[2] * value.V[3], value.V[3]);
+    }
+
+    inline Vector4 VectorLoadTexel(const csmUint8* src)
+    {
+        return VectorSet(src[0], src[1], src[2], src[3]);
+    }
+
+    inline void VectorToArray(Vector4 value, csmFloat32* dst)
+    {
+        VectorStore(dst, value);
+    }
+#endif
+
+    inline Vector4 VectorFromColor(const CubismRenderer::CubismTextureColor& color)
+    {
+        return VectorSet(color.R, color.G, color.B, color.A);
+    }
+
+    /*****************************************************************************************************************
+    *                                      サンプリング
+    *****************************************************************************************************************/
+    inline csmInt32 ClampIndex(csmInt32 index, csmInt32 size)
+    {
+        return (index < 0) ? 0 : ((index >= size) ? size - 1 : index);
+    }
+
+    inline csmFloat32 ClampCoordinate(csmFloat32 value, csmFloat32 size)
+    {
+        // 範囲外やNaNを整数に変換しないよう先に丸める
+        return (value > -1.0f) ? ((value < size) ? value : size) : -1.0f;
+    }
+
+    /**
+     * @brief   RGBA8のテクスチャをバイリニアでサンプリングする（GL_LINEAR, GL_CLAMP_TO_EDGE相当）
+     */
+    Vector4 SampleTexture(const CubismTexture_Software* texture, csmFloat32 s, csmFloat32 t)
+    {
+        const csmInt32 width = static_cast<csmInt32>(texture->Width);
+        const csmInt32 height = static_cast<csmInt32>(texture->Height);
+        const csmFloat32 x = ClampCoordinate(s * width - 0.5f, static_cast<csmFloat32>(width));
+        const csmFloat32 y = ClampCoordinate(t * height - 0.5f, static_cast<csmFloat32>(height));
+        const csmFloat32 floorX = floorf(x);
+        const csmFloat32 floorY = floorf(y);
+        const csmFloat32 fractionX = x - floorX;
+        const csmFloat32 fractionY = y - floorY;
+
+        const csmInt32 x0 = ClampIndex(static_cast<csmInt32>(floorX), width);
+        const csmInt32 x1 = ClampIndex(static_cast<csmInt32>(floorX) + 1, width);
+        const csmUint8* row0 = texture->Pixels + static_cast<csmSizeInt>(ClampIndex(static_cast<csmInt32>(floorY), height)) * width * 4;
+        const csmUint8* row1 = texture->Pixels + static_cast<csmSizeInt>(ClampIndex(static_cast<csmInt32>(floorY) + 1, height)) * width * 4;
+
+        const Vector4 texel00 = VectorLoadTexel(row0 + x0 * 4);
+        const Vector4 texel10 = VectorLoadTexel(row0 + x1 * 4);
+        const Vector4 texel01 = VectorLoadTexel(row1 + x0 * 4);
+        const Vector4 texel11 = VectorLoadTexel(row1 + x1 * 4);
+
+        const Vector4 weightX = VectorSplat(fractionX);
+        const Vector4 top = VectorAdd(texel00, VectorMul(VectorSub(texel10, texel00), weightX));
+        const Vector4 bottom = VectorAdd(texel01, VectorMul(VectorSub(texel11, texel01), weightX));
+        const Vector4 texel = VectorAdd(top, VectorMul(VectorSub(bottom, top), VectorSplat(fractionY)));
+
+        return VectorMul(texel, VectorSplat(1.0f / 255.0f));
+    }
+
+    /**
+     * @brief   描画先の内容を最近傍でサンプリングする（GL_NEAREST相当）
+     */
+    inline Vector4 SampleRenderTarget(const CubismRenderTarget_Software* renderTarget, csmFloat32 s, csmFloat32 t)
+    {
+        const csmInt32 width = static_cast<csmInt32>(renderTarget->GetBufferWidth());
+        const csmInt32 height = static_cast<csmInt32>(renderTarget->GetBufferHeight());
+        const csmInt32 x = ClampIndex(static_cast<csmInt32>(ClampCoordinate(s * width, static_cast<csmFloat32>(width))), width);
+        const csmInt32 y = ClampIndex(static_cast<csmInt32>(ClampCoordinate(t * height, static_cast<csmFloat32>(height))), height);
+        return VectorLoad(renderTarget->GetColorBuffer() + (static_cast<csmSizeInt>(y) * width + x) * 4);
+    }
+
+    /*****************************************************************************************************************
+    *                                      5.3以降のブレンドモード
+    *****************************************************************************************************************/
+    inline csmFloat32 BlendColorChannel(csmInt32 colorBlendType, csmFloat32 cs, csmFloat32 cd)
+    {
+        switch (colorBlendType)
+        {
+        case Core::csmColorBlendType_Add:
+            return CubismMath::Min(cs + cd, 1.0f);
+        case Core::csmColorBlendType_AddGlow:
+            return cs + cd;
+        case Core::csmColorBlendType_Darken:
+            return CubismMath::Min(cs, cd);
+        case Core::csmColorBlendType_Multiply:
+            return cs * cd;
+        case Core::csmColorBlendType_ColorBurn:
+            if (fabsf(cd - 1.0f) < 0.000001f)
+            {
+                return 1.0f;
+            }
+            if (fabsf(cs) < 0.000001f)
+            {
+                return 0.0f;
+            }
+            return 1.0f - CubismMath::Min(1.0f, (1.0f - cd) / cs);
+        case Core::csmColorBlendType_LinearBurn:
+            return CubismMath::Max(0.0f, cs + cd - 1.0f);
+        case Core::csmColorBlendType_Lighten:
+            return CubismMath::Max(cs, cd);
+        case Core::csmColorBlendType_Screen:
+            return cs + cd - cs * cd;
+        case Core::csmColorBlendType_ColorDodge:
+            if (cd <= 0.0f)
+            {
+                return 0.0f;
+            }
+            if (cs == 1.0f)
+            {
+                return 1.0f;
+            }
+            return CubismMath::Min(1.0f, cd / (1.0f - cs));
+        case Core::csmColorBlendType_Overlay:
+            return (cd < 0.5f) ? 2.0f * cs * cd : 1.0f - 2.0f * (1.0f - cs) * (1.0f - cd);
+        case Core::csmColorBlendType_SoftLight:
+            if (cs <= 0.5f)
+            {
+                return cd - (1.0f - 2.0f * cs) * cd * (1.0f - cd);
+            }
+            if (cd <= 0.25f)
+            {
+                return cd + (2.0f * cs - 1.0f) * cd * ((16.0f * cd - 12.0f) * cd + 3.0f);
+            }
+            return cd + (2.0f * cs - 1.0f) * (sqrtf(cd) - cd);
+        case Core::csmColorBlendType_HardLight:
+            return (cs < 0.5f) ? 2.0f * cs * cd : 1.0f - 2.0f * (1.0f - cs) * (1.0f - cd);
+        case Core::csmColorBlendType_LinearLight:
+            return (cs < 0.5f) ? CubismMath::Max(0.0f, 2.0f * cs + cd - 1.0f) : CubismMath::Min(1.0f, 2.0f * (cs - 0.5f) + cd);
+        case Core::csmColorBlendType_Normal:
+        default:
+            return cs;
+        }
+    }
+
+    inline csmFloat32 Luma(const csmFloat32* rgb)
+    {
+        return 0.30f * rgb[0] + 0.59f * rgb[1] + 0.11f * rgb[2];
+    }
+
+    void SetLuma(csmFloat32* rgb, csmFloat32 luma)
+    {
+        const csmFloat32 delta = luma - Luma(rgb);
+        rgb[0] += delta;
+        rgb[1] += delta;
+        rgb[2] += delta;
+
+        // ClipColor
+        const csmFloat32 l = Luma(rgb);
+        const csmFloat32 maxValue = CubismMath::Max(rgb[0], CubismMath::Max(rgb[1], rgb[2]));
+        const csmFloat32 minValue = CubismMath::Min(rgb[0], CubismMath::Min(rgb[1], rgb[2]));
+        for (csmInt32 i = 0; i < 3; ++i)
+        {
+            if (minValue < 0.0f)
+            {
+                rgb[i] = l + (rgb[i] - l) * l / (l - minValue);
+            }
+            if (maxValue > 1.0f)
+            {
+                rgb[i] = l + (rgb[i] - l) * (1.0f - l) / (maxValue - l);
+            }
+        }
+    }
+
+    void SetSaturation(csmFloat32* rgb, csmFloat32 saturation)
+    {
+        const csmFloat32 maxValue = CubismMath::Max(rgb[0], CubismMath::Max(rgb[1], rgb[2]));
+        const csmFloat32 minValue = CubismMath::Min(rgb[0], CubismMath::Min(rgb[1], rgb[2]));
+        const csmFloat32 medValue = rgb[0] + rgb[1] + rgb[2] - maxValue - minValue;
+        const csmFloat32 outputMax = (minValue < maxValue) ? saturation : 0.0f;
+        const csmFloat32 outputMed = (minValue < maxValue) ? (medValue - minValue) * saturation / (maxValue - minValue) : 0.0f;
+        const csmFloat32 outputMin = 0.0f;
+
+        csmFloat32 r, g, b;
+        if (rgb[0] == maxValue)
+        {
+            r = outputMax;
+            g = (rgb[2] < rgb[1]) ? outputMed : outputMin;
+            b = (rgb[2] < rgb[1]) ? outputMin : outputMed;
+        }
+        else if (rgb[1] == maxValue)
+        {
+            r = (rgb[0] < rgb[2]) ? outputMin : outputMed;
+            g = outputMax;
+            b = (rgb[0] < rgb[2]) ? outputMed : outputMin;
+        }
+        else
+        {
+            r = (rgb[1] < rgb[0]) ? outputMed : outputMin;
+            g = (rgb[1] < rgb[0]) ? outputMin : outputMed;
+            b = outputMax;
+        }
+        rgb[0] = r;
+        rgb[1] = g;
+        rgb[2] = b;
+    }
+
+    /**
+     * @brief   ストレートアルファの合成元と合成先から、PremultipliedAlphaの合成結果を求める
+     */
+    Vector4 BlendAdvanced(csmInt32 colorBlendType, csmInt32 alphaBlendType, Vector4 source, Vector4 destination)
+    {
+        csmFloat32 cs[4];
+        csmFloat32 cd[4];
+        VectorToArray(source, cs);
+        VectorToArray(destination, cd);
+
+        // 合成先はPremultipliedAlphaのため解除する
+        if (fabsf(cd[3]) < Epsilon)
+        {
+            cd[0] = cd[1] = cd[2] = 0.0f;
+        }
+        else
+        {
+            cd[0] /= cd[3];
+            cd[1] /= cd[3];
+            cd[2] /= cd[3];
+        }
+
+        csmFloat32 color[3];
+        switch (colorBlendType)
+        {
+        case Core::csmColorBlendType_Hue:
+        {
+            const csmFloat32 saturation = CubismMath::Max(cd[0], CubismMath::Max(cd[1], cd[2])) - CubismMath::Min(cd[0], CubismMath::Min(cd[1], cd[2]));
+            color[0] = cs[0];
+            color[1] = cs[1];
+            color[2] = cs[2];
+            SetSaturation(color, saturation);
+            SetLuma(color, Luma(cd));
+            break;
+        }
+        case Core::csmColorBlendType_Color:
+            color[0] = cs[0];
+            color[1] = cs[1];
+            color[2] = cs[2];
+            SetLuma(color, Luma(cd));
+            break;
+        default:
+            color[0] = BlendColorChannel(colorBlendType, cs[0], cd[0]);
+            color[1] = BlendColorChannel(colorBlendType, cs[1], cd[1]);
+            color[2] = BlendColorChannel(colorBlendType, cs[2], cd[2]);
+            break;
+        }
+
+        const csmFloat32 sa = cs[3];
+        const csmFloat32 da = cd[3];
+        csmFloat32 p0, p1, p2;
+        switch (alphaBlendType)
+        {
+        case Core::csmAlphaBlendType_Atop:
+            p0 = sa * da;
+            p1 = 0.0f;
+            p2 = da * (1.0f - sa);
+            break;
+        case Core::csmAlphaBlendType_Out:
+            p0 = 0.0f;
+            p1 = 0.0f;
+            p2 = da * (1.0f - sa);
+            break;
+        case Core::csmAlphaBlendType_ConjointOver:
+            p0 = CubismMath::Min(sa, da);
+            p1 = CubismMath::Max(sa - da, 0.0f);
+            p2 = CubismMath::Max(da - sa, 0.0f);
+            break;
+        case Core::csmAlphaBlendType_DisjointOver:
+            p0 = CubismMath::Max(sa + da - 1.0f, 0.0f);
+            p1 = CubismMath::Min(sa, 1.0f - da);
+            p2 = CubismMath::Min(da, 1.0f - sa);
+            break;
+        case Core::csmAlphaBlendType_Over:
+        default:
+            p0 = sa * da;
+            p1 = sa * (1.0f - da);
+            p2 = da * (1.0f - sa);
+            break;
+        }
+
+        return VectorSet(
+            color[0] * p0 + cs[0] * p1 + cd[0] * p2,
+            color[1] * p0 + cs[1] * p1 + cd[1] * p2,
+            color[2] * p0 + cs[2] * p1 + cd[2] * p2,
+            p0 + p1 + p2
+        );
+    }
+
+    /**
+     * @brief   PremultipliedAlphaをストレートアルファに変換する
+     */
+    inline Vector4 ConvertPremultipliedToStraight(Vector4 value)
+    {
+        const csmFloat32 alpha = VectorGetAlpha(value);
+        if (fabsf(alpha) < Epsilon)
+        {
+            return VectorSet(0.0f, 0.0f, 0.0f, alpha);
+        }
+
+        const csmFloat32 inverse = 1.0f / alpha;
+        return VectorMul(value, VectorSet(inverse, inverse, inverse, 1.0f));
+    }
+}
+
+/*********************************************************************************************************************
+*                                      CubismRasterizer_Software
+********************************************************************************************************************/
+CubismRasterizer_Software::DrawState::DrawState()
+    : Type(DrawType_Mesh)
+    , Blend(BlendType_Normal)
+    , ColorBlendType(Core::csmColorBlendType_Normal)
+    , AlphaBlendType(Core::csmAlphaBlendType_Over)
+    , Texture(NULL)
+    , SourceRenderTarget(NULL)
+    , MaskRenderTarget(NULL)
+    , IsInvertedMask(false)
+    , IsPremultipliedAlpha(false)
+    , IsCulling(false)
+    , MultiplyColor(1.0f, 1.0f, 1.0f, 1.0f)
+    , ScreenColor(0.0f, 0.0f, 0.0f, 1.0f)
+{
+    MaskBounds[0] = -1.0f;
+    MaskBounds[1] = -1.0f;
+    MaskBounds[2] = 1.0f;
+    MaskBounds[3] = 1.0f;
+}
+
+CubismRasterizer_Software::CubismRasterizer_Software()
+    : _renderTarget(NULL)
+    , _tileCountX(0)
+    , _tileCount(0)
+    , _nextTile(0)
+    , _generation(0)
+    , _runningWorkers(0)
+    , _isStopping(false)
+{
+    // 既定ではワーカースレッドを作らない。並列化はアプリケーションが SetThreadCount で選ぶ
+}
+
+CubismRasterizer_Software::~CubismRasterizer_Software()
+{
+    StopWorkers();
+}
+
+void CubismRasterizer_Software::SetThreadCount(csmUint32 threadCount)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0)
+        {
+            threadCount = 1;
+        }
+    }
+
+    if (threadCount == GetThreadCount())
+    {
+        return;
+    }
+
+    // 作り直す前に記録済みの描画を確定させておく
+    Flush();
+    StopWorkers();
+    StartWorkers(threadCount - 1);
+}
+
+csmUint32 CubismRasterizer_Software::GetThreadCount() const
+{
+    return _workers.GetSize() + 1;
+}
+
+void CubismRasterizer_Software::SetRenderTarget(CubismRenderTarget_Software* renderTarget)
+{
+    if (_renderTarget == renderTarget)
+    {
+        return;
+    }
+
+    Flush();
+    _renderTarget = renderTarget;
+}
+
+CubismRenderTarget_Software* CubismRasterizer_Software::GetRenderTarget() const
+{
+    return _renderTarget;
+}
+
+void CubismRasterizer_Software::DrawTriangles(const DrawState& state, const csmFloat32* positions, const csmFloat32* uvs, csmInt32 vertexCount,
+                                              const csmUint16* indices, csmInt32 indexCount, const CubismMatrix44& matrix, const CubismMatrix44* clipMatrix)
+{
+    if (_renderTarget == NULL || !_renderTarget->IsValid() || vertexCount <= 0 || indexCount < 3)
+    {
+        return;
+    }
+
+    const csmFloat32 width = static_cast<csmFloat32>(_renderTarget->GetBufferWidth());
+    const csmFloat32 height = static_cast<csmFloat32>(_renderTarget->GetBufferHeight());
+
+    // 頂点を描画先のピクセル座標に変換する
+    // テクスチャ座標はOpenGLの頂点シェーダと同じくvを反転して、メモリ上の行の並びに合わせる
+    _vertices.UpdateSize(vertexCount * VertexStride, 0.0f, false);
+    CubismMatrix44 transform = matrix;
+    CubismMatrix44 clipTransform = (clipMatrix != NULL) ? *clipMatrix : CubismMatrix44();
+    const csmFloat32* m = transform.GetArray();
+    const csmFloat32* c = (clipMatrix != NULL) ? clipTransform.GetArray() : NULL;
+    for (csmInt32 i = 0; i < vertexCount; ++i)
+    {
+        const csmFloat32 x = positions[i * 2];
+        const csmFloat32 y = positions[i * 2 + 1];
+        csmFloat32* vertex = &_vertices[i * VertexStride];
+
+        csmFloat32 w = m[3] * x + m[7] * y + m[15];
+        if (w == 0.0f)
+        {
+            w = 1.0f;
+        }
+        vertex[0] = ((m[0] * x + m[4] * y + m[12]) / w * 0.5f + 0.5f) * width;
+        vertex[1] = ((m[1] * x + m[5] * y + m[13]) / w * 0.5f + 0.5f) * height;
+        vertex[2] = uvs[i * 2];
+        vertex[3] = 1.0f - uvs[i * 2 + 1];
+
+        if (c != NULL)
+        {
+            csmFloat32 clipW = c[3] * x + c[7] * y + c[15];
+            if (clipW == 0.0f)
+            {
+                clipW = 1.0f;
+            }
+            vertex[4] = (c[0] * x + c[4] * y + c[12]) / clipW;
+            vertex[5] = (c[1] * x + c[5] * y + c[13]) / clipW;
+        }
+        else
+        {
+            vertex[4] = 0.0f;
+            vertex[5] = 0.0f;
+        }
+    }
+
+    DrawCommand command;
+    command.State = state;
+    command.Bounds[0] = static_cast<csmInt32>(width);
+    command.Bounds[1] = static_cast<csmInt32>(height);
+    command.Bounds[2] = 0;
+    command.Bounds[3] = 0;
+    command.TriangleBegin = _triangles.GetSize();
+
+    for (csmInt32 i = 0; i + 2 < indexCount; i += 3)
+    {
+        if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount)
+        {
+            continue;
+        }
+
+        const csmFloat32* v0 = &_vertices[indices[i] * VertexStride];
+        const csmFloat32* v1 = &_vertices[indices[i + 1] * VertexStride];
+        const csmFloat32* v2 = &_vertices[indices[i + 2] * VertexStride];
+
+        csmFloat32 area = (v1[0] - v0[0]) * (v2[1] - v0[1]) - (v2[0] - v0[0]) * (v1[1] - v0[1]);
+        if (area == 0.0f || area != area)
+        {
+            continue;
+        }
+
+        // 描画先は下から上の行の並びのため、反時計回りが表面（glFrontFace(GL_CCW)と同じ）
+        if (area < 0.0f)
+        {
+            if (state.IsCulling)
+            {
+                continue;
+            }
+
+            const csmFloat32* swap = v1;
+            v1 = v2;
+            v2 = swap;
+            area = -area;
+        }
+
+        const csmFloat32 minX = CubismMath::Min(v0[0], CubismMath::Min(v1[0], v2[0]));
+        const csmFloat32 minY = CubismMath::Min(v0[1], CubismMath::Min(v1[1], v2[1]));
+        const csmFloat32 maxX = CubismMath::Max(v0[0], CubismMath::Max(v1[0], v2[0]));
+        const csmFloat32 maxY = CubismMath::Max(v0[1], CubismMath::Max(v1[1], v2[1]));
+        if (maxX <= 0.0f || maxY <= 0.0f || minX >= width || minY >= height)
+        {
+            continue;
+        }
+
+        Triangle triangle;
+        triangle.Bounds[0] = static_cast<csmInt32>(CubismMath::Max(floorf(minX), 0.0f));
+        triangle.Bounds[1] = static_cast<csmInt32>(CubismMath::Max(floorf(minY), 0.0f));
+        triangle.Bounds[2] = static_cast<csmInt32>(CubismMath::Min(ceilf(maxX), width));
+        triangle.Bounds[3] = static_cast<csmInt32>(CubismMath::Min(ceilf(maxY), height));
+
+        const csmFloat32* vertices[3] = { v0, v1, v2 };
+        for (csmInt32 edge = 0; edge < 3; ++edge)
+        {
+            const csmFloat32* a = vertices[edge];
+            const csmFloat32* b = vertices[(edge + 1) % 3];
+
+            // 隣接する三角形と共有する辺で同じ値になるよう、定数項は辺の向きによらず同じ端点から求める
+            const csmFloat32* origin = (a[0] < b[0] || (a[0] == b[0] && a[1] < b[1])) ? a : b;
+            triangle.EdgeA[edge] = a[1] - b[1];
+            triangle.EdgeB[edge] = b[0] - a[0];
+            triangle.EdgeC[edge] = -(triangle.EdgeA[edge] * origin[0] + triangle.EdgeB[edge] * origin[1]);
+            triangle.EdgeInvA[edge] = (triangle.EdgeA[edge] != 0.0f) ? 1.0f / triangle.EdgeA[edge] : 0.0f;
+        }
+
+        // 属性を画面上で線形に補間するための平面の式を求める
+        const csmFloat32 inverseArea = 1.0f / area;
+        const csmFloat32 x10 = v1[0] - v0[0];
+        const csmFloat32 y10 = v1[1] - v0[1];
+        const csmFloat32 x20 = v2[0] - v0[0];
+        const csmFloat32 y20 = v2[1] - v0[1];
+        for (csmInt32 attribute = 0; attribute < 4; ++attribute)
+        {
+            const csmFloat32 a0 = v0[2 + attribute];
+            const csmFloat32 a10 = v1[2 + attribute] - a0;
+            const csmFloat32 a20 = v2[2 + attribute] - a0;
+            const csmFloat32 dx = (a10 * y20 - a20 * y10) * inverseArea;
+            const csmFloat32 dy = (a20 * x10 - a10 * x20) * inverseArea;
+            triangle.Attributes[attribute][0] = dx;
+            triangle.Attributes[attribute][1] = dy;
+            triangle.Attributes[attribute][2] = a0 - dx * v0[0] - dy * v0[1];
+        }
+
+        _triangles.PushBack(triangle);
+
+        command.Bounds[0] = CubismMath::Min(command.Bounds[0], triangle.Bounds[0]);
+        command.Bounds[1] = CubismMath::Min(command.Bounds[1], triangle.Bounds[1]);
+        command.Bounds[2] = CubismMath::Max(command.Bounds[2], triangle.Bounds[2]);
+        command.Bounds[3] = CubismMath::Max(command.Bounds[3], triangle.Bounds[3]);
+    }
+
+    command.TriangleEnd = _triangles.GetSize();
+    if (command.TriangleBegin == command.TriangleEnd)
+    {
+        return;
+    }
+
+    _commands.PushBack(command);
+}
+
+void CubismRasterizer_Software::Flush()
+{
+    if (_commands.GetSize() == 0)
+    {
+        return;
+    }
+
+    if (_renderTarget != NULL && _renderTarget->IsValid())
+    {
+        const csmInt32 width = static_cast<csmInt32>(_renderTarget->GetBufferWidth());
+        const csmInt32 height = static_cast<csmInt32>(_renderTarget->GetBufferHeight());
+        _tileCountX = (width + TileSize - 1) / TileSize;
+        _tileCount = _tileCountX * ((height + TileSize - 1) / TileSize);
+        _nextTile.store(0);
+
+        if (_workers.GetSize() > 0 && _tileCount > 1)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _generation++;
+                _runningWorkers = _workers.GetSize();
+            }
+            _startCondition.notify_all();
+
+            // 呼び出し元のスレッドもタイルの処理に加わる
+            RasterizeTiles();
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (_runningWorkers > 0)
+            {
+                _finishCondition.wait(lock);
+            }
+        }
+        else
+        {
+            RasterizeTiles();
+        }
+    }
+
+    // 毎フレーム記録しなおすため、確保済みの領域は解放しない
+    _commands.UpdateSize(0, DrawCommand(), false);
+    _triangles.UpdateSize(0, Triangle(), false);
+}
+
+void CubismRasterizer_Software::StartWorkers(csmUint32 workerCount)
+{
+    _isStopping = false;
+    for (csmUint32 i = 0; i < workerCount; ++i)
+    {
+        _workers.PushBack(CSM_NEW std::thread(&CubismRasterizer_Software::WorkerLoop, this, _generation));
+    }
+}
+
+void CubismRasterizer_Software::StopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _startCondition.notify_all();
+
+    for (csmUint32 i = 0; i < _workers.GetSize(); ++i)
+    {
+        _workers[i]->join();
+        CSM_DELETE(_workers[i]);
+    }
+    _workers.Clear();
+}
+
+void CubismRasterizer_Software::WorkerLoop(csmUint32 generation)
+{
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (!_isStopping && _generation == generation)
+            {
+                _startCondition.wait(lock);
+            }
+
+            if (_isStopping)
+            {
+                return;
+            }
+
+            generation = _generation;
+        }
+
+        RasterizeTiles();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _runningWorkers--;
+            if (_runningWorkers == 0)
+            {
+                _finishCondition.notify_one();
+            }
+        }
+    }
+}
+
+void CubismRasterizer_Software::RasterizeTiles()
+{
+    for (;;)
+    {
+        const csmInt32 tileIndex = _nextTile.fetch_add(1);
+        if (tileIndex >= _tileCount)
+        {
+            return;
+        }
+
+        RasterizeTile(tileIndex);
+    }
+}
+
+void CubismRasterizer_Software::RasterizeTile(csmInt32 tileIndex)
+{
+    const csmInt32 width = static_cast<csmInt32>(_renderTarget->GetBufferWidth());
+    const csmInt32 height = static_cast<csmInt32>(_renderTarget->GetBufferHeight());
+
+    csmInt32 tileBounds[4];
+    tileBounds[0] = (tileIndex % _tileCountX) * TileSize;
+    tileBounds[1] = (tileIndex / _tileCountX) * TileSize;
+    tileBounds[2] = CubismMath::Min(tileBounds[0] + TileSize, width);
+    tileBounds[3] = CubismMath::Min(tileBounds[1] + TileSize, height);
+
+    // タイル内では記録した順に描画するため、ブレンドの順序は保たれる
+    for (csmUint32 commandIndex = 0; commandIndex < _commands.GetSize(); ++commandIndex)
+    {
+        const DrawCommand& command = _commands[commandIndex];
+        if (command.Bounds[0] >= tileBounds[2] || command.Bounds[2] <= tileBounds[0] ||
+            command.Bounds[1] >= tileBounds[3] || command.Bounds[3] <= tileBounds[1])
+        {
+            continue;
+        }
+
+        for (csmUint32 triangleIndex = command.TriangleBegin; triangleIndex < command.TriangleEnd; ++triangleIndex)
+        {
+            const Triangle& triangle = _triangles[triangleIndex];
+            if (triangle.Bounds[0] >= tileBounds[2] || triangle.Bounds[2] <= tileBounds[0] ||
+                triangle.Bounds[1] >= tileBounds[3] || triangle.Bounds[3] <= tileBounds[1])
+            {
+                continue;
+            }
+
+            RasterizeTriangle(command, triangle, tileBounds);
+        }
+    }
+}
+
+void CubismRasterizer_Software::RasterizeTriangle(const DrawCommand& command, const Triangle& triangle, const csmInt32* tileBounds)
+{
+    const DrawState& state = command.State;
+    const csmInt32 width = static_cast<csmInt32>(_renderTarget->GetBufferWidth());
+    const csmInt32 height = static_cast<csmInt32>(_renderTarget->GetBufferHeight());
+    csmFloat32* colorBuffer = _renderTarget->GetColorBuffer();
+
+    const csmInt32 left = CubismMath::Max(tileBounds[0], triangle.Bounds[0]);
+    const csmInt32 bottom = CubismMath::Max(tileBounds[1], triangle.Bounds[1]);
+    const csmInt32 right = CubismMath::Min(tileBounds[2], triangle.Bounds[2]);
+    const csmInt32 top = CubismMath::Min(tileBounds[3], triangle.Bounds[3]);
+
+    // スパンの外で決まる値
+    const Vector4 multiplyColor = VectorSet(state.MultiplyColor.R, state.MultiplyColor.G, state.MultiplyColor.B, 1.0f);
+    const Vector4 screenColor = VectorSet(state.ScreenColor.R, state.ScreenColor.G, state.ScreenColor.B, 0.0f);
+    const Vector4 baseColor = VectorFromColor(state.BaseColor);
+    const Vector4 channelFlag = VectorFromColor(state.ChannelFlag);
+    const Vector4 one = VectorSplat(1.0f);
+    const Vector4 rgbOne = VectorSet(1.0f, 1.0f, 1.0f, 0.0f);
+    const Vector4 alphaOne = VectorSet(0.0f, 0.0f, 0.0f, 1.0f);
+    const CubismRenderTarget_Software* maskRenderTarget = state.MaskRenderTarget;
+
+    for (csmInt32 y = bottom; y < top; ++y)
+    {
+        const csmFloat32 centerY = static_cast<csmFloat32>(y) + 0.5f;
+
+        // 各辺の内側となるピクセル中心の範囲を求める
+        // 共有する辺の上のピクセルは、左側の辺(A > 0)の三角形だけが塗る
+        csmInt32 begin = left;
+        csmInt32 end = right;
+        csmBool isEmpty = false;
+        for (csmInt32 edge = 0; edge < 3; ++edge)
+        {
+            const csmFloat32 a = triangle.EdgeA[edge];
+            const csmFloat32 value = triangle.EdgeB[edge] * centerY + triangle.EdgeC[edge];
+            if (a == 0.0f)
+            {
+                if (value < 0.0f || (value == 0.0f && triangle.EdgeB[edge] <= 0.0f))
+                {
+                    isEmpty = true;
+                    break;
+                }
+                continue;
+            }
+
+            const csmFloat32 bound = ceilf(-value * triangle.EdgeInvA[edge] - 0.5f);
+            if (a > 0.0f)
+            {
+                if (bound > static_cast<csmFloat32>(begin))
+                {
+                    begin = (bound >= static_cast<csmFloat32>(end)) ? end : static_cast<csmInt32>(bound);
+                }
+            }
+            else if (bound < static_cast<csmFloat32>(end))
+            {
+                end = (bound <= static_cast<csmFloat32>(begin)) ? begin : static_cast<csmInt32>(bound);
+            }
+        }
+
+        if (isEmpty || begin >= end)
+        {
+            continue;
+        }
+
+        csmFloat32* dst = colorBuffer + (static_cast<csmSizeInt>(y) * width + begin) * 4;
+        const csmFloat32 centerX = static_cast<csmFloat32>(begin) + 0.5f;
+
+        if (state.Type == DrawType_Mask)
+        {
+            // マスクのレイアウト範囲の外には描かない
+            const csmFloat32 ndcY = centerY / height * 2.0f - 1.0f;
+            if (ndcY < state.MaskBounds[1] || ndcY > state.MaskBounds[3])
+            {
+                continue;
+            }
+
+            csmFloat32 s = triangle.Attributes[0][0] * centerX + triangle.Attributes[0][1] * centerY + triangle.Attributes[0][2];
+            csmFloat32 t = triangle.Attributes[1][0] * centerX + triangle.Attributes[1][1] * centerY + triangle.Attributes[1][2];
+            for (csmInt32 x = begin; x < end; ++x, dst += 4, s += triangle.Attributes[0][0], t += triangle.Attributes[1][0])
+            {
+                const csmFloat32 ndcX = (static_cast<csmFloat32>(x) + 0.5f) / width * 2.0f - 1.0f;
+                if (ndcX < state.MaskBounds[0] || ndcX > state.MaskBounds[2])
+                {
+                    continue;
+                }
+
+                // 1が無効（描かれない）領域、0が有効（描かれる）領域
+                const Vector4 texel = SampleTexture(state.Texture, s, t);
+                const Vector4 source = VectorMul(channelFlag, VectorSplatAlpha(texel));
+                VectorStore(dst, VectorMul(VectorLoad(dst), VectorSub(one, source)));
+            }
+            continue;
+        }
+
+        csmFloat32 s = triangle.Attributes[0][0] * centerX + triangle.Attributes[0][1] * centerY + triangle.Attributes[0][2];
+        csmFloat32 t = triangle.Attributes[1][0] * centerX + triangle.Attributes[1][1] * centerY + triangle.Attributes[1][2];
+        csmFloat32 maskS = triangle.Attributes[2][0] * centerX + triangle.Attributes[2][1] * centerY + triangle.Attributes[2][2];
+        csmFloat32 maskT = triangle.Attributes[3][0] * centerX + triangle.Attributes[3][1] * centerY + triangle.Attributes[3][2];
+        for (csmInt32 x = begin; x < end; ++x, dst += 4,
+             s += triangle.Attributes[0][0], t += triangle.Attributes[1][0], maskS += triangle.Attributes[2][0], maskT += triangle.Attributes[3][0])
+        {
+            Vector4 color = (state.Type == DrawType_Mesh) ? SampleTexture(state.Texture, s, t) : SampleRenderTarget(state.SourceRenderTarget, s, t);
+
+            // 乗算色・スクリーン色を適用する
+            color = VectorMul(color, multiplyColor);
+            if (state.IsPremultipliedAlpha)
+            {
+                color = VectorSub(VectorAdd(color, VectorMul(screenColor, VectorSplatAlpha(color))), VectorMul(color, screenColor));
+            }
+            else
+            {
+                color = VectorSub(VectorAdd(color, screenColor), VectorMul(color, screenColor));
+            }
+            color = VectorMul(color, baseColor);
+
+            csmFloat32 maskValue = 1.0f;
+            if (maskRenderTarget != NULL)
+            {
+                const Vector4 mask = VectorMul(VectorSub(one, SampleRenderTarget(maskRenderTarget, maskS, maskT)), channelFlag);
+                maskValue = VectorSum(mask);
+                if (state.IsInvertedMask)
+                {
+                    maskValue = 1.0f - maskValue;
+                }
+            }
+
+            const Vector4 destination = VectorLoad(dst);
+            Vector4 result;
+            if (state.Blend == BlendType_Advanced)
+            {
+                Vector4 source = state.IsPremultipliedAlpha ? ConvertPremultipliedToStraight(color) : color;
+                source = VectorMul(source, VectorSet(1.0f, 1.0f, 1.0f, maskValue));
+                if (VectorGetAlpha(source) == 0.0f)
+                {
+                    // どのアルファのブレンドでも合成先がそのまま残る
+                    continue;
+                }
+                result = BlendAdvanced(state.ColorBlendType, state.AlphaBlendType, source, destination);
+            }
+            else
+            {
+                if (!state.IsPremultipliedAlpha)
+                {
+                    color = VectorPremultiply(color);
+                }
+                color = VectorMul(color, VectorSplat(maskValue));
+                if (VectorIsZero(color))
+                {
+                    // 5.2以前の合成は合成元が0であれば合成先を変えない
+                    continue;
+                }
+
+                switch (state.Blend)
+                {
+                case BlendType_Add:
+                    // (GL_ONE, GL_ONE), (GL_ZERO, GL_ONE)
+                    result = VectorAdd(destination, VectorMul(color, rgbOne));
+                    break;
+                case BlendType_Multiply:
+                    // (GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA), (GL_ZERO, GL_ONE)
+                    result = VectorMul(destination, VectorAdd(VectorAdd(VectorMul(color, rgbOne), VectorMul(VectorSub(one, VectorSplatAlpha(color)), rgbOne)), alphaOne));
+                    break;
+                case BlendType_Normal:
+                default:
+                    // (GL_ONE, GL_ONE_MINUS_SRC_ALPHA)
+                    result = VectorAdd(color, VectorMul(destination, VectorSub(one, VectorSplatAlpha(color))));
+                    break;
+                }
+            }
+
+            // 8bitの描画先と同じく0~1に収める
+            VectorStore(dst, VectorSaturate(result));
+        }
+    }
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
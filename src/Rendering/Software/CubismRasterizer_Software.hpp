@@ -0,0 +1,243 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "../CubismRenderer.hpp"
+#include "CubismFramework.hpp"
+#include "CubismRenderTarget_Software.hpp"
+#include "Math/CubismMatrix44.hpp"
+#include "Type/csmVector.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+/**
+ * @brief   ソフトウェアレンダラが参照するRGBA8のテクスチャ<br>
+ *          ピクセルは上の行から順に並び、アプリケーション側が所有する。
+ */
+struct CubismTexture_Software
+{
+    const csmUint8* Pixels;     ///< RGBA8のピクセル
+    csmUint32       Width;      ///< 幅
+    csmUint32       Height;     ///< 高さ
+};
+
+/**
+ * @brief   三角形をタイル単位で並列にラスタライズするクラス<br>
+ *          同じ描画先への描画をまとめて記録しておき、描画先の切り替えやクリアの直前に<br>
+ *          描画先をタイルに分割して、各タイルを記録順にワーカースレッドで塗りつぶす。<br>
+ *          タイルごとに記録順が守られるため、ブレンドの結果はシングルスレッドで描いた場合と一致する。
+ */
+class CubismRasterizer_Software
+{
+public:
+    /**
+     * @brief   描画の種類
+     */
+    enum DrawType
+    {
+        DrawType_Mask,          ///< クリッピングマスクの生成
+        DrawType_Mesh,          ///< アートメッシュの描画
+        DrawType_RenderTarget,  ///< 描画先の内容の合成
+    };
+
+    /**
+     * @brief   合成方法
+     */
+    enum BlendType
+    {
+        BlendType_Normal,       ///< 5.2以前の通常合成
+        BlendType_Add,          ///< 5.2以前の加算合成
+        BlendType_Multiply,     ///< 5.2以前の乗算合成
+        BlendType_Advanced,     ///< 5.3以降の色・アルファのブレンドモード
+    };
+
+    /**
+     * @brief   1回の描画で使用するステート
+     */
+    struct DrawState
+    {
+        DrawType                                Type;                   ///< 描画の種類
+        BlendType                               Blend;                  ///< 合成方法
+        csmInt32                                ColorBlendType;         ///< BlendType_Advanced時の色のブレンド
+        csmInt32                                AlphaBlendType;         ///< BlendType_Advanced時のアルファのブレンド
+        const CubismTexture_Software*           Texture;                ///< DrawType_Mask, DrawType_Meshで参照するテクスチャ
+        const CubismRenderTarget_Software*      SourceRenderTarget;     ///< DrawType_RenderTargetで合成する描画先
+        const CubismRenderTarget_Software*      MaskRenderTarget;       ///< クリッピングマスク。NULLの場合はマスクなし
+        csmBool                                 IsInvertedMask;         ///< マスクを反転して使用するか
+        csmBool                                 IsPremultipliedAlpha;   ///< テクスチャがPremultipliedAlphaか
+        csmBool                                 IsCulling;              ///< 裏面を描画しないか
+        CubismRenderer::CubismTextureColor      BaseColor;              ///< 基本色
+        CubismRenderer::CubismTextureColor      MultiplyColor;          ///< 乗算色
+        CubismRenderer::CubismTextureColor      ScreenColor;            ///< スクリーン色
+        CubismRenderer::CubismTextureColor      ChannelFlag;            ///< マスクのチャンネル
+        csmFloat32                              MaskBounds[4];          ///< DrawType_Mask時に描画を許す範囲（描画先のNDCでの左, 下, 右, 上）
+
+        /**
+         * @brief   コンストラクタ
+         */
+        DrawState();
+    };
+
+    /**
+     * @brief   コンストラクタ
+     */
+    CubismRasterizer_Software();
+
+    /**
+     * @brief   デストラクタ
+     */
+    ~CubismRasterizer_Software();
+
+    /**
+     * @brief   ラスタライズに使用するスレッド数を設定する<br>
+     *          呼び出したスレッドも処理に加わるため、ワーカースレッドは threadCount - 1 個作成する<br>
+     *          既定は1でワーカースレッドを作らない。ワーカースレッドはインスタンスごとに作られるため、<br>
+     *          複数のモデルを描画する場合は合計がハードウェアのスレッド数を超えないように設定する
+     *
+     * @param[in]   threadCount ->  スレッド数。0の場合はハードウェアのスレッド数
+     */
+    void SetThreadCount(csmUint32 threadCount);
+
+    /**
+     * @brief   ラスタライズに使用するスレッド数を取得する
+     *
+     * @return  スレッド数
+     */
+    csmUint32 GetThreadCount() const;
+
+    /**
+     * @brief   描画先を切り替える<br>
+     *          切り替え前の描画先に記録された描画はここで確定する
+     *
+     * @param[in]   renderTarget    ->  描画先。NULLの場合は描画しない
+     */
+    void SetRenderTarget(CubismRenderTarget_Software* renderTarget);
+
+    /**
+     * @brief   現在の描画先を取得する
+     *
+     * @return  描画先
+     */
+    CubismRenderTarget_Software* GetRenderTarget() const;
+
+    /**
+     * @brief   三角形リストの描画を記録する<br>
+     *          頂点は記録時に変換するため、呼び出し後に頂点配列を書き換えてもよい
+     *
+     * @param[in]   state       ->  描画ステート
+     * @param[in]   positions   ->  頂点座標(x, y)の配列
+     * @param[in]   uvs         ->  テクスチャ座標(u, v)の配列
+     * @param[in]   vertexCount ->  頂点数
+     * @param[in]   indices     ->  頂点インデックスの配列
+     * @param[in]   indexCount  ->  頂点インデックスの数
+     * @param[in]   matrix      ->  頂点座標を描画先のNDCに変換する行列
+     * @param[in]   clipMatrix  ->  頂点座標をマスクのテクスチャ座標に変換する行列。マスクを使わない場合はNULL
+     */
+    void DrawTriangles(const DrawState& state, const csmFloat32* positions, const csmFloat32* uvs, csmInt32 vertexCount,
+                       const csmUint16* indices, csmInt32 indexCount, const CubismMatrix44& matrix, const CubismMatrix44* clipMatrix);
+
+    /**
+     * @brief   記録済みの描画を現在の描画先に確定させる
+     */
+    void Flush();
+
+private:
+    /**
+     * @brief   1回の描画の記録
+     */
+    struct DrawCommand
+    {
+        DrawState   State;              ///< 描画ステート
+        csmInt32    Bounds[4];          ///< 描画範囲のピクセル矩形（左, 下, 右, 上）。右と上は含まない
+        csmUint32   TriangleBegin;      ///< _triangles内の開始位置
+        csmUint32   TriangleEnd;        ///< _triangles内の終了位置
+    };
+
+    /**
+     * @brief   セットアップ済みの三角形
+     */
+    struct Triangle
+    {
+        csmInt32    Bounds[4];          ///< 描画範囲のピクセル矩形（左, 下, 右, 上）。右と上は含まない
+        csmFloat32  EdgeA[3];           ///< 辺の方程式 A * x + B * y + C のA
+        csmFloat32  EdgeB[3];           ///< 辺の方程式のB
+        csmFloat32  EdgeC[3];           ///< 辺の方程式のC
+        csmFloat32  EdgeInvA[3];        ///< Aの逆数
+        csmFloat32  Attributes[4][3];   ///< 補間する属性(s, t, マスクのs, t)の x, y についての傾きと定数項
+    };
+
+    // Prevention of copy Constructor
+    CubismRasterizer_Software(const CubismRasterizer_Software&);
+    CubismRasterizer_Software& operator=(const CubismRasterizer_Software&);
+
+    /**
+     * @brief   ワーカースレッドを開始する
+     *
+     * @param[in]   workerCount ->  ワーカースレッドの数
+     */
+    void StartWorkers(csmUint32 workerCount);
+
+    /**
+     * @brief   ワーカースレッドを終了する
+     */
+    void StopWorkers();
+
+    /**
+     * @brief   ワーカースレッドの処理
+     *
+     * @param[in]   generation  ->  スレッド作成時点の世代番号
+     */
+    void WorkerLoop(csmUint32 generation);
+
+    /**
+     * @brief   未処理のタイルがなくなるまでタイルを取得して塗りつぶす
+     */
+    void RasterizeTiles();
+
+    /**
+     * @brief   1つのタイルについて、記録済みの描画を順に塗りつぶす
+     *
+     * @param[in]   tileIndex   ->  タイルのインデックス
+     */
+    void RasterizeTile(csmInt32 tileIndex);
+
+    /**
+     * @brief   三角形のタイル内の部分を塗りつぶす
+     *
+     * @param[in]   command     ->  描画の記録
+     * @param[in]   triangle    ->  三角形
+     * @param[in]   tileBounds  ->  タイルのピクセル矩形（左, 下, 右, 上）
+     */
+    void RasterizeTriangle(const DrawCommand& command, const Triangle& triangle, const csmInt32* tileBounds);
+
+    CubismRenderTarget_Software*    _renderTarget;      ///< 現在の描画先
+    csmVector<DrawCommand>          _commands;          ///< 確定していない描画の記録
+    csmVector<Triangle>             _triangles;         ///< 確定していない描画の三角形
+    csmVector<csmFloat32>           _vertices;          ///< 変換済み頂点の作業領域
+
+    csmInt32                        _tileCountX;        ///< 処理中の描画先の横方向のタイル数
+    csmInt32                        _tileCount;         ///< 処理中の描画先のタイル数
+    std::atomic<csmInt32>           _nextTile;          ///< 次に処理するタイルのインデックス
+
+    csmVector<std::thread*>         _workers;           ///< ワーカースレッド
+    std::mutex                      _mutex;             ///< ワーカースレッドとの同期用
+    std::condition_variable         _startCondition;    ///< タイル処理の開始通知
+    std::condition_variable         _finishCondition;   ///< タイル処理の完了通知
+    csmUint32                       _generation;        ///< 開始通知のたびに増える世代番号
+    csmUint32                       _runningWorkers;    ///< タイル処理中のワーカースレッドの数
+    csmBool                         _isStopping;        ///< ワーカースレッドを終了させるか
+};
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
@@ -0,0 +1,187 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismRenderTarget_Software.hpp"
+#include "CubismRasterizer_Software.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+namespace {
+    const csmUint32 ColorBufferAlignment = 16;  ///< SIMDで読み書きするためのカラーバッファのアライメント
+
+    /**
+     * @brief   0.0~1.0の色成分を8bitに量子化する
+     */
+    csmUint8 QuantizeColor(csmFloat32 value)
+    {
+        if (value <= 0.0f)
+        {
+            return 0;
+        }
+        if (value >= 1.0f)
+        {
+            return 255;
+        }
+        return static_cast<csmUint8>(value * 255.0f + 0.5f);
+    }
+}
+
+CubismRenderTarget_Software::CubismRenderTarget_Software()
+    : _colorBuffer(NULL)
+    , _oldRenderTarget(NULL)
+    , _bufferWidth(0)
+    , _bufferHeight(0)
+{
+}
+
+void CubismRenderTarget_Software::BeginDraw(CubismRasterizer_Software& rasterizer, CubismRenderTarget_Software* restoreRenderTarget)
+{
+    if (_colorBuffer == NULL)
+    {
+        return;
+    }
+
+    _oldRenderTarget = restoreRenderTarget;
+    rasterizer.SetRenderTarget(this);
+}
+
+void CubismRenderTarget_Software::EndDraw(CubismRasterizer_Software& rasterizer)
+{
+    if (_colorBuffer == NULL)
+    {
+        return;
+    }
+
+    rasterizer.SetRenderTarget(_oldRenderTarget);
+}
+
+void CubismRenderTarget_Software::Clear(CubismRasterizer_Software& rasterizer, float r, float g, float b, float a)
+{
+    if (_colorBuffer == NULL)
+    {
+        return;
+    }
+
+    // 描画途中の内容を上書きしないよう、記録済みの描画を先に確定させる
+    rasterizer.Flush();
+
+    const csmUint32 pixelCount = _bufferWidth * _bufferHeight;
+    for (csmUint32 i = 0; i < pixelCount; ++i)
+    {
+        _colorBuffer[i * 4 + 0] = r;
+        _colorBuffer[i * 4 + 1] = g;
+        _colorBuffer[i * 4 + 2] = b;
+        _colorBuffer[i * 4 + 3] = a;
+    }
+}
+
+csmBool CubismRenderTarget_Software::CreateRenderTarget(csmUint32 displayBufferWidth, csmUint32 displayBufferHeight)
+{
+    DestroyRenderTarget();
+
+    if (displayBufferWidth == 0 || displayBufferHeight == 0)
+    {
+        return false;
+    }
+
+    const csmSizeType bufferSize = static_cast<csmSizeType>(displayBufferWidth) * displayBufferHeight * 4 * sizeof(csmFloat32);
+    _colorBuffer = static_cast<csmFloat32*>(CSM_MALLOC_ALIGNED(bufferSize, ColorBufferAlignment));
+    if (_colorBuffer == NULL)
+    {
+        CubismLogError("Failed to allocate the software render target. width: %d, height: %d", displayBufferWidth, displayBufferHeight);
+        return false;
+    }
+
+    _bufferWidth = displayBufferWidth;
+    _bufferHeight = displayBufferHeight;
+
+    // 作成直後は透明で埋めておく
+    const csmUint32 valueCount = _bufferWidth * _bufferHeight * 4;
+    for (csmUint32 i = 0; i < valueCount; ++i)
+    {
+        _colorBuffer[i] = 0.0f;
+    }
+
+    return true;
+}
+
+void CubismRenderTarget_Software::DestroyRenderTarget()
+{
+    if (_colorBuffer != NULL)
+    {
+        CSM_FREE_ALIGNED(_colorBuffer);
+        _colorBuffer = NULL;
+    }
+
+    _bufferWidth = 0;
+    _bufferHeight = 0;
+}
+
+void CubismRenderTarget_Software::ReadPixels(csmUint8* dst, csmUint32 stride, csmBool straightAlpha) const
+{
+    if (_colorBuffer == NULL || dst == NULL)
+    {
+        return;
+    }
+
+    if (stride == 0)
+    {
+        stride = _bufferWidth * 4;
+    }
+
+    for (csmUint32 y = 0; y < _bufferHeight; ++y)
+    {
+        // バッファは下の行から並んでいるため、上下を反転して書き込む
+        const csmFloat32* src = _colorBuffer + static_cast<csmSizeInt>(_bufferHeight - 1 - y) * _bufferWidth * 4;
+        csmUint8* dstRow = dst + static_cast<csmSizeInt>(y) * stride;
+
+        for (csmUint32 x = 0; x < _bufferWidth; ++x)
+        {
+            const csmFloat32 alpha = src[x * 4 + 3];
+            csmFloat32 scale = 1.0f;
+            if (straightAlpha)
+            {
+                scale = (alpha > 0.0f) ? 1.0f / alpha : 0.0f;
+            }
+
+            dstRow[x * 4 + 0] = QuantizeColor(src[x * 4 + 0] * scale);
+            dstRow[x * 4 + 1] = QuantizeColor(src[x * 4 + 1] * scale);
+            dstRow[x * 4 + 2] = QuantizeColor(src[x * 4 + 2] * scale);
+            dstRow[x * 4 + 3] = QuantizeColor(alpha);
+        }
+    }
+}
+
+csmFloat32* CubismRenderTarget_Software::GetColorBuffer() const
+{
+    return _colorBuffer;
+}
+
+csmUint32 CubismRenderTarget_Software::GetBufferWidth() const
+{
+    return _bufferWidth;
+}
+
+csmUint32 CubismRenderTarget_Software::GetBufferHeight() const
+{
+    return _bufferHeight;
+}
+
+csmBool CubismRenderTarget_Software::IsValid() const
+{
+    return _colorBuffer != NULL;
+}
+
+CubismRenderTarget_Software* CubismRenderTarget_Software::GetOldRenderTarget() const
+{
+    return _oldRenderTarget;
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
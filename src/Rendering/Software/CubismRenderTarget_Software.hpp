@@ -0,0 +1,116 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+//  前方宣言
+class CubismRasterizer_Software;
+
+/**
+ * @brief   ソフトウェアレンダラの描画先<br>
+ *          ピクセルはPremultipliedAlphaのRGBAを32bit浮動小数点で保持する。<br>
+ *          行はOpenGLと同じく下から上の順に並ぶ。
+ */
+class CubismRenderTarget_Software
+{
+public:
+    /**
+     * @brief   コンストラクタ
+     *
+     */
+    CubismRenderTarget_Software();
+
+    /**
+     * @brief   指定の描画ターゲットに向けて描画開始
+     *
+     * @param   rasterizer              描画を行うラスタライザ
+     * @param   restoreRenderTarget     EndDrawで戻す描画先。NULLの場合は描画先なしに戻す
+     */
+    void BeginDraw(CubismRasterizer_Software& rasterizer, CubismRenderTarget_Software* restoreRenderTarget);
+
+    /**
+     * @brief   描画終了
+     *
+     * @param   rasterizer  描画を行うラスタライザ
+     */
+    void EndDraw(CubismRasterizer_Software& rasterizer);
+
+    /**
+     * @brief   レンダリングターゲットのクリア
+     *           描画途中の内容は先に確定させてからクリアする
+     *
+     * @param   rasterizer  描画を行うラスタライザ
+     * @param   r   赤(0.0~1.0)
+     * @param   g   緑(0.0~1.0)
+     * @param   b   青(0.0~1.0)
+     * @param   a   α(0.0~1.0)
+     */
+    void Clear(CubismRasterizer_Software& rasterizer, float r, float g, float b, float a);
+
+    /**
+     *  @brief  CubismRenderTarget作成
+     *
+     *  @param  displayBufferWidth     作成するバッファ幅
+     *  @param  displayBufferHeight    作成するバッファ高さ
+     */
+    csmBool CreateRenderTarget(csmUint32 displayBufferWidth, csmUint32 displayBufferHeight);
+
+    /**
+     * @brief   CubismRenderTargetの削除
+     */
+    void DestroyRenderTarget();
+
+    /**
+     * @brief   描画結果をRGBA8で読み出す<br>
+     *          画像ファイルと同じく上の行から順に書き込む
+     *
+     * @param   dst             書き込み先。stride * 高さ以上の領域が必要
+     * @param   stride          書き込み先の1行あたりのバイト数。0の場合は幅 * 4
+     * @param   straightAlpha   trueの場合はPremultipliedAlphaを解除して書き込む
+     */
+    void ReadPixels(csmUint8* dst, csmUint32 stride, csmBool straightAlpha) const;
+
+    /**
+     * @brief   カラーバッファの取得
+     */
+    csmFloat32* GetColorBuffer() const;
+
+    /**
+     * @brief   バッファ幅取得
+     */
+    csmUint32 GetBufferWidth() const;
+
+    /**
+     * @brief   バッファ高さ取得
+     */
+    csmUint32 GetBufferHeight() const;
+
+    /**
+     * @brief   現在有効かどうか
+     */
+    csmBool IsValid() const;
+
+    /**
+     * @brief   旧描画先の取得
+     */
+    CubismRenderTarget_Software* GetOldRenderTarget() const;
+
+private:
+    csmFloat32*                     _colorBuffer;           ///< RGBAを並べたカラーバッファ
+    CubismRenderTarget_Software*    _oldRenderTarget;       ///< 旧描画先
+    csmUint32                       _bufferWidth;           ///< Create時に指定された幅
+    csmUint32                       _bufferHeight;          ///< Create時に指定された高さ
+};
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
@@ -0,0 +1,1255 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismRenderer_Software.hpp"
+#include "CubismOffscreenManager_Software.hpp"
+#include "Math/CubismMatrix44.hpp"
+#include "Type/csmVector.hpp"
+#include "Model/CubismModel.hpp"
+#include "Math/CubismMath.hpp"
+#include "Utils/CubismProfiler.hpp"
+#include <math.h>
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+namespace {
+    const csmFloat32 RenderTargetReverseUvArray[] = {
+        0.0f, 1.0f,
+        1.0f, 1.0f,
+        0.0f, 0.0f,
+        1.0f, 0.0f,
+    };
+
+    const csmFloat32 ModelRenderTargetVertexArray[] = {
+        -1.0f, -1.0f,
+         1.0f, -1.0f,
+        -1.0f,  1.0f,
+         1.0f,  1.0f,
+    };
+
+    const csmUint16 ModelRenderTargetIndexArray[] = {
+        0, 1, 2,
+        2, 1, 3,
+    };
+}
+
+/*********************************************************************************************************************
+*                                      CubismClippingManager_Software
+********************************************************************************************************************/
+void CubismClippingManager_Software::SetupClippingContext(CubismModel& model, CubismRenderer_Software* renderer, CubismRenderTarget_Software* lastRenderTarget, CubismRenderer::DrawableObjectType drawableObjectType)
+{
+    CSM_PROFILE_ZONE(Zone_ClippingSetup, &model);
+
+    // 全てのクリッピングを用意する
+    // 同じクリップ（複数の場合はまとめて１つのクリップ）を使う場合は１度だけ設定する
+    csmInt32 usingClipCount = 0;
+    for (csmUint32 clipIndex = 0; clipIndex < _clippingContextListForMask.GetSize(); clipIndex++)
+    {
+        // １つのクリッピングマスクに関して
+        CubismClippingContext_Software* cc = _clippingContextListForMask[clipIndex];
+
+        // このクリップを利用する描画オブジェクト群全体を囲む矩形を計算
+        CalcClippedTotalBounds(model, cc, drawableObjectType);
+
+        if (cc->_isUsing)
+        {
+            usingClipCount++; //使用中としてカウント
+        }
+    }
+
+    if (usingClipCount <= 0)
+    {
+        return;
+    }
+
+    // 後の計算のためにインデックスの最初をセット
+    switch (drawableObjectType)
+    {
+    case CubismRenderer::DrawableObjectType_Drawable:
+    default:
+        _currentMaskBuffer = renderer->GetDrawableMaskBuffer(0);
+        break;
+    case CubismRenderer::DrawableObjectType_Offscreen:
+        _currentMaskBuffer = renderer->GetOffscreenMaskBuffer(0);
+        break;
+    }
+    // ----- マスク描画処理 -----
+    _currentMaskBuffer->BeginDraw(renderer->_rasterizer, lastRenderTarget);
+
+    // 各マスクのレイアウトを決定していく
+    SetupLayoutBounds(usingClipCount);
+
+    // サイズがレンダーテクスチャの枚数と合わない場合は合わせる
+    if (static_cast<csmInt32>(_clearedMaskBufferFlags.GetSize()) != _renderTextureCount)
+    {
+        _clearedMaskBufferFlags.Clear();
+
+        for (csmInt32 i = 0; i < _renderTextureCount; ++i)
+        {
+            _clearedMaskBufferFlags.PushBack(false);
+        }
+    }
+    else
+    {
+        // マスクのクリアフラグを毎フレーム開始時に初期化
+        for (csmInt32 i = 0; i < _renderTextureCount; ++i)
+        {
+            _clearedMaskBufferFlags[i] = false;
+        }
+    }
+
+    // 実際にマスクを生成する
+    // 全てのマスクをどの様にレイアウトして描くかを決定し、ClipContext , ClippedDrawContext に記憶する
+    for (csmUint32 clipIndex = 0; clipIndex < _clippingContextListForMask.GetSize(); clipIndex++)
+    {
+        // --- 実際に１つのマスクを描く ---
+        CubismClippingContext_Software* clipContext = _clippingContextListForMask[clipIndex];
+        csmRectF* allClippedDrawRect = clipContext->_allClippedDrawRect; //このマスクを使う、全ての描画オブジェクトの論理座標上の囲み矩形
+        csmRectF* layoutBoundsOnTex01 = clipContext->_layoutBounds; //この中にマスクを収める
+        const csmFloat32 MARGIN = 0.05f;
+
+        // clipContextに設定したレンダーターゲットをインデックスで取得
+        CubismRenderTarget_Software* maskBuffer = NULL;
+        switch (drawableObjectType)
+        {
+        case CubismRenderer::DrawableObjectType_Drawable:
+        default:
+            maskBuffer = renderer->GetDrawableMaskBuffer(clipContext->_bufferIndex);
+            break;
+        case CubismRenderer::DrawableObjectType_Offscreen:
+            maskBuffer = renderer->GetOffscreenMaskBuffer(clipContext->_bufferIndex);
+            break;
+        }
+
+        // 現在のレンダーターゲットがclipContextのものと異なる場合
+        if (_currentMaskBuffer != maskBuffer)
+        {
+            _currentMaskBuffer->EndDraw(renderer->_rasterizer);
+            _currentMaskBuffer = maskBuffer;
+            // マスク用RenderTextureをactiveにセット
+            _currentMaskBuffer->BeginDraw(renderer->_rasterizer, lastRenderTarget);
+        }
+
+        // モデル座標上の矩形を、適宜マージンを付けて使う
+        _tmpBoundsOnModel.SetRect(allClippedDrawRect);
+        _tmpBoundsOnModel.Expand(allClippedDrawRect->Width * MARGIN, allClippedDrawRect->Height * MARGIN);
+        csmFloat32 scaleX = layoutBoundsOnTex01->Width / _tmpBoundsOnModel.Width;
+        csmFloat32 scaleY = layoutBoundsOnTex01->Height / _tmpBoundsOnModel.Height;
+
+        // マスク生成時に使う行列を求める
+        CreateMatrixForMask(false, layoutBoundsOnTex01, scaleX, scaleY);
+
+        clipContext->_matrixForMask.SetMatrix(_tmpMatrixForMask.GetArray());
+        clipContext->_matrixForDraw.SetMatrix(_tmpMatrixForDraw.GetArray());
+
+        if (drawableObjectType == CubismRenderer::DrawableObjectType_Offscreen)
+        {
+            // clipContext * mvp^-1
+            CubismMatrix44 invertMvp = renderer->GetMvpMatrix().GetInvert();
+            clipContext->_matrixForDraw.MultiplyByMatrix(&invertMvp);
+        }
+
+        // 実際の描画を行う
+        const csmInt32 clipDrawCount = clipContext->_clippingIdCount;
+        for (csmInt32 i = 0; i < clipDrawCount; i++)
+        {
+            const csmInt32 clipDrawIndex = clipContext->_clippingIdList[i];
+
+            // 頂点情報が更新されておらず、信頼性がない場合は描画をパスする
+            if (!model.GetDrawableDynamicFlagVertexPositionsDidChange(clipDrawIndex))
+            {
+                continue;
+            }
+
+            renderer->IsCulling(model.GetDrawableCulling(clipDrawIndex) != 0);
+
+            // マスクがクリアされていないなら処理する
+            if (!_clearedMaskBufferFlags[clipContext->_bufferIndex])
+            {
+                // マスクをクリアする
+                // 1が無効（描かれない）領域、0が有効（描かれる）領域
+                _currentMaskBuffer->Clear(renderer->_rasterizer, 1.0f, 1.0f, 1.0f, 1.0f);
+                _clearedMaskBufferFlags[clipContext->_bufferIndex] = true;
+            }
+
+            // 今回専用の変換を適用して描く
+            // チャンネルも切り替える必要がある(A,R,G,B)
+            renderer->SetClippingContextBufferForMask(clipContext);
+
+            renderer->DrawMeshSoftware(model, clipDrawIndex);
+        }
+    }
+
+    // --- 後処理 ---
+    _currentMaskBuffer->EndDraw(renderer->_rasterizer);
+    renderer->SetClippingContextBufferForMask(NULL);
+}
+
+/*********************************************************************************************************************
+*                                      CubismClippingContext_Software
+********************************************************************************************************************/
+CubismClippingContext_Software::CubismClippingContext_Software(CubismClippingManager<CubismClippingContext_Software, CubismRenderTarget_Software>* manager, CubismModel& model, const csmInt32* clippingDrawableIndices, csmInt32 clipCount)
+    : CubismClippingContext(clippingDrawableIndices, clipCount)
+{
+    _owner = manager;
+}
+
+CubismClippingContext_Software::~CubismClippingContext_Software()
+{
+}
+
+CubismClippingManager<CubismClippingContext_Software, CubismRenderTarget_Software>* CubismClippingContext_Software::GetClippingManager()
+{
+    return _owner;
+}
+
+/*********************************************************************************************************************
+*                                      CubismRenderer_Software
+********************************************************************************************************************/
+CubismRenderer* CubismRenderer::Create(csmUint32 width, csmUint32 height)
+{
+    return CSM_NEW CubismRenderer_Software(width, height);
+}
+
+void CubismRenderer::StaticRelease()
+{
+    CubismRenderer_Software::DoStaticRelease();
+}
+
+CubismRenderer_Software::CubismRenderer_Software(csmUint32 width, csmUint32 height)
+    : CubismRenderer(width, height)
+    , _drawableClippingManager(NULL)
+    , _offscreenClippingManager(NULL)
+    , _clippingContextBufferForMask(NULL)
+    , _clippingContextBufferForDrawable(NULL)
+    , _clippingContextBufferForOffscreen(NULL)
+    , _renderTarget(NULL)
+    , _currentRenderTarget(NULL)
+    , _currentOffscreen(NULL)
+    , _modelRootRenderTarget(NULL)
+{
+    // テクスチャ対応マップの容量を確保しておく.
+    _textures.PrepareCapacity(32, true);
+}
+
+CubismRenderer_Software::~CubismRenderer_Software()
+{
+    CSM_DELETE_SELF(CubismClippingManager_Software, _drawableClippingManager);
+    CSM_DELETE_SELF(CubismClippingManager_Software, _offscreenClippingManager);
+
+    for (csmUint32 i = 0; i < _modelRenderTargets.GetSize(); ++i)
+    {
+        if (_modelRenderTargets[i].IsValid())
+        {
+            _modelRenderTargets[i].DestroyRenderTarget();
+        }
+    }
+    _modelRenderTargets.Clear();
+
+    _defaultRenderTarget.DestroyRenderTarget();
+
+    for (csmUint32 i = 0; i < _drawableMasks.GetSize(); ++i)
+    {
+        if (_drawableMasks[i].IsValid())
+        {
+            _drawableMasks[i].DestroyRenderTarget();
+        }
+    }
+    _drawableMasks.Clear();
+
+    for (csmUint32 i = 0; i < _offscreenMasks.GetSize(); ++i)
+    {
+        if (_offscreenMasks[i].IsValid())
+        {
+            _offscreenMasks[i].DestroyRenderTarget();
+        }
+    }
+    _offscreenMasks.Clear();
+}
+
+void CubismRenderer_Software::DoStaticRelease()
+{
+    // プールしているオフスクリーンの描画先はメモリ上のバッファのため、ここでまとめて解放する
+    CubismOffscreenManager_Software::ReleaseInstance();
+}
+
+void CubismRenderer_Software::Initialize(CubismModel* model)
+{
+    Initialize(model, 1);
+}
+
+void CubismRenderer_Software::Initialize(CubismModel* model, csmInt32 maskBufferCount)
+{
+    // 1未満は1に補正する
+    if (maskBufferCount < 1)
+    {
+        maskBufferCount = 1;
+        CubismLogWarning("The number of render textures must be an integer greater than or equal to 1. Set the number of render textures to 1.");
+    }
+
+    for (csmUint32 i = 0; i < _modelRenderTargets.GetSize(); ++i)
+    {
+        _modelRenderTargets[i].DestroyRenderTarget();
+    }
+    _modelRenderTargets.Clear();
+    if (model->IsBlendModeEnabled())
+    {
+        // オフスクリーンの作成
+        // 合成先はラスタライズ時に直接読み出せるため、コピー用のバッファは作成しない
+        CubismRenderTarget_Software renderTarget;
+        renderTarget.CreateRenderTarget(_modelRenderTargetWidth, _modelRenderTargetHeight);
+        _modelRenderTargets.PushBack(renderTarget);
+    }
+
+    if (model->IsUsingMasking())
+    {
+        _drawableClippingManager = CSM_NEW CubismClippingManager_Software();  //クリッピングマスク・バッファ前処理方式を初期化
+        _drawableClippingManager->Initialize(
+            *model,
+            maskBufferCount,
+            CubismRenderer::DrawableObjectType_Drawable
+        );
+
+        _drawableMasks.Clear();
+        for (csmInt32 i = 0; i < maskBufferCount; ++i)
+        {
+            CubismRenderTarget_Software masks;
+            masks.CreateRenderTarget(_drawableClippingManager->GetClippingMaskBufferSize().X, _drawableClippingManager->GetClippingMaskBufferSize().Y);
+            _drawableMasks.PushBack(masks);
+        }
+    }
+
+    if (model->IsUsingMaskingForOffscreen())
+    {
+        _offscreenClippingManager = CSM_NEW CubismClippingManager_Software();  //クリッピングマスク・バッファ前処理方式を初期化
+        _offscreenClippingManager->Initialize(
+            *model,
+            maskBufferCount,
+            CubismRenderer::DrawableObjectType_Offscreen
+        );
+
+        _offscreenMasks.Clear();
+        for (csmInt32 i = 0; i < maskBufferCount; ++i)
+        {
+            CubismRenderTarget_Software offscreenMask;
+            offscreenMask.CreateRenderTarget(_offscreenClippingManager->GetClippingMaskBufferSize().X, _offscreenClippingManager->GetClippingMaskBufferSize().Y);
+            _offscreenMasks.PushBack(offscreenMask);
+        }
+    }
+
+    _sortedObjectsIndexList.Resize(model->GetDrawableCount() + model->GetOffscreenCount(), 0);
+    _sortedObjectsTypeList.Resize(model->GetDrawableCount() + model->GetOffscreenCount(), DrawableObjectType_Drawable);
+
+    const csmInt32 offscreenCount = model->GetOffscreenCount();
+
+    // オフスクリーンの数が0の場合は何もしない
+    if (offscreenCount > 0)
+    {
+        _offscreenList = csmVector<CubismOffscreenRenderTarget_Software>(offscreenCount);
+        for (csmInt32 offscreenIndex = 0; offscreenIndex < offscreenCount; ++offscreenIndex)
+        {
+            CubismOffscreenRenderTarget_Software renderTarget;
+            renderTarget.SetOffscreenIndex(offscreenIndex);
+            _offscreenList.PushBack(renderTarget);
+        }
+
+        // 全てのオフスクリーンを登録し終わってから行う
+        SetupParentOffscreens(model, offscreenCount);
+        SetupOffscreenChildDrawables(model, offscreenCount);
+    }
+
+    CubismRenderer::Initialize(model, maskBufferCount);  //親クラスの処理を呼ぶ
+}
+
+void CubismRenderer_Software::SetupParentOffscreens(const CubismModel* model, csmInt32 offscreenCount)
+{
+    CubismOffscreenRenderTarget_Software* parentOffscreen;
+    for (csmInt32 offscreenIndex = 0; offscreenIndex < offscreenCount; ++offscreenIndex)
+    {
+        parentOffscreen = NULL;
+        const csmInt32 ownerIndex = model->GetOffscreenOwnerIndices()[offscreenIndex];
+        csmInt32 parentIndex = model->GetPartParentPartIndex(ownerIndex);
+
+        // 親のオフスクリーンを探す
+        while (parentIndex != CubismModel::CubismNoIndex_Parent)
+        {
+            for (csmInt32 i = 0; i < offscreenCount; ++i)
+            {
+                if (model->GetOffscreenOwnerIndices()[_offscreenList.At(i).GetOffscreenIndex()] != parentIndex)
+                {
+                    continue;  //オフスクリーンのインデックスが親と一致しなければスキップ
+                }
+
+                parentOffscreen = &_offscreenList.At(i);
+                break;
+            }
+
+            if (parentOffscreen != NULL)
+            {
+                break;  // 親のオフスクリーンが見つかった場合はループを抜ける
+            }
+
+            parentIndex = model->GetPartParentPartIndex(parentIndex);
+        }
+
+        // 親のオフスクリーンを設定
+        _offscreenList.At(offscreenIndex).SetParentPartOffscreen(parentOffscreen);
+    }
+}
+
+void CubismRenderer_Software::SetupOffscreenChildDrawables(const CubismModel* model, csmInt32 offscreenCount)
+{
+    // 階層情報は値で返るため一度だけ取得する
+    const csmVector<CubismModelPartInfo> partsHierarchy = model->GetPartsHierarchy();
+
+    _offscreenChildDrawableIndices.Clear();
+    _offscreenChildDrawableOffsets.Clear();
+
+    csmVector<csmInt32> offscreenStack;
+    for (csmInt32 offscreenIndex = 0; offscreenIndex < offscreenCount; ++offscreenIndex)
+    {
+        _offscreenChildDrawableOffsets.PushBack(_offscreenChildDrawableIndices.GetSize());
+
+        // 子孫のオフスクリーンも辿ってDrawableを集める
+        offscreenStack.Clear();
+        offscreenStack.PushBack(offscreenIndex);
+        while (offscreenStack.GetSize() > 0)
+        {
+            const csmInt32 targetOffscreenIndex = offscreenStack[offscreenStack.GetSize() - 1];
+            offscreenStack.Remove(offscreenStack.GetSize() - 1);
+
+            const PartChildDrawObjects& childDrawObjects = partsHierarchy[model->GetOffscreenOwnerIndices()[targetOffscreenIndex]].ChildDrawObjects;
+            for (csmUint32 i = 0; i < childDrawObjects.DrawableIndices.GetSize(); ++i)
+            {
+                _offscreenChildDrawableIndices.PushBack(childDrawObjects.DrawableIndices[i]);
+            }
+            for (csmUint32 i = 0; i < childDrawObjects.OffscreenIndices.GetSize(); ++i)
+            {
+                offscreenStack.PushBack(childDrawObjects.OffscreenIndices[i]);
+            }
+        }
+    }
+    _offscreenChildDrawableOffsets.PushBack(_offscreenChildDrawableIndices.GetSize());
+}
+
+void CubismRenderer_Software::DoDrawModel()
+{
+    _currentRenderTarget = GetRenderTarget();
+    _rasterizer.SetRenderTarget(_currentRenderTarget);
+
+    BeforeDrawModelRenderTarget();
+    // モデル描画直前の描画先を保存
+    CubismRenderTarget_Software* lastRenderTarget = _currentRenderTarget;
+
+    //------------ クリッピングマスク・バッファ前処理方式の場合 ------------
+    if (_drawableClippingManager != NULL)
+    {
+        // サイズが違う場合はここで作成しなおし
+        for (csmInt32 i = 0; i < _drawableClippingManager->GetRenderTextureCount(); ++i)
+        {
+            if (_drawableMasks[i].GetBufferWidth() != static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().X) ||
+                _drawableMasks[i].GetBufferHeight() != static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().Y))
+            {
+                _drawableMasks[i].CreateRenderTarget(
+                    static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().X), static_cast<csmUint32>(_drawableClippingManager->GetClippingMaskBufferSize().Y));
+            }
+        }
+
+        if (IsUsingHighPrecisionMask())
+        {
+            _drawableClippingManager->SetupMatrixForHighPrecision(*GetModel(), false, DrawableObjectType_Drawable);
+        }
+        else
+        {
+            _drawableClippingManager->SetupClippingContext(*GetModel(), this, lastRenderTarget, DrawableObjectType_Drawable);
+        }
+    }
+
+    if (_offscreenClippingManager != NULL)
+    {
+        // サイズが違う場合はここで作成しなおし
+        for (csmInt32 i = 0; i < _offscreenClippingManager->GetRenderTextureCount(); ++i)
+        {
+            if (_offscreenMasks[i].GetBufferWidth() != static_cast<csmUint32>(_offscreenClippingManager->GetClippingMaskBufferSize().X) ||
+                _offscreenMasks[i].GetBufferHeight() != static_cast<csmUint32>(_offscreenClippingManager->GetClippingMaskBufferSize().Y))
+            {
+                _offscreenMasks[i].CreateRenderTarget(
+                    static_cast<csmUint32>(_offscreenClippingManager->GetClippingMaskBufferSize().X), static_cast<csmUint32>(_offscreenClippingManager->GetClippingMaskBufferSize().Y));
+            }
+        }
+
+        if (IsUsingHighPrecisionMask())
+        {
+            _offscreenClippingManager->SetupMatrixForHighPrecision(*GetModel(), false, DrawableObjectType_Offscreen, GetMvpMatrix());
+        }
+        else
+        {
+            _offscreenClippingManager->SetupClippingContext(*GetModel(), this, lastRenderTarget, DrawableObjectType_Offscreen);
+        }
+    }
+
+    // モデルの描画順に従って描画する
+    DrawObjectLoop(lastRenderTarget);
+
+    AfterDrawModelRenderTarget();
+
+    // 描画先の内容をアプリケーションから読めるよう確定させる
+    _rasterizer.Flush();
+}
+
+void CubismRenderer_Software::DrawObjectLoop(CubismRenderTarget_Software* lastRenderTarget)
+{
+    const csmInt32 drawableCount = GetModel()->GetDrawableCount();
+    const csmInt32 offscreenCount = GetModel()->GetOffscreenCount();
+    const csmInt32 totalCount = drawableCount + offscreenCount;
+    const csmInt32* renderOrder = GetModel()->GetRenderOrders();
+
+    _currentOffscreen = NULL;
+    _currentRenderTarget = lastRenderTarget;
+    _modelRootRenderTarget = lastRenderTarget;
+
+    // インデックスを描画順でソート
+    for (csmInt32 i = 0; i < totalCount; ++i)
+    {
+        const csmInt32 order = renderOrder[i];
+
+        if (i < drawableCount)
+        {
+            _sortedObjectsIndexList[order] = i;
+            _sortedObjectsTypeList[order] = DrawableObjectType_Drawable;
+        }
+        else if (i < totalCount)
+        {
+            _sortedObjectsIndexList[order] = i - drawableCount;
+            _sortedObjectsTypeList[order] = DrawableObjectType_Offscreen;
+        }
+    }
+
+    // 描画
+    for (csmInt32 i = 0; i < totalCount; ++i)
+    {
+        const csmInt32 objectIndex = _sortedObjectsIndexList[i];
+        const csmInt32 objectType = _sortedObjectsTypeList[i];
+
+        RenderObject(objectIndex, objectType);
+    }
+
+    while (_currentOffscreen != NULL)
+    {
+        // オフスクリーンが残っている場合は親オフスクリーンへの伝搬を行う
+        SubmitDrawToParentOffscreen(_currentOffscreen->GetOffscreenIndex(), DrawableObjectType_Offscreen);
+    }
+}
+
+void CubismRenderer_Software::RenderObject(const csmInt32 objectIndex, const csmInt32 objectType)
+{
+    switch (objectType)
+    {
+    case DrawableObjectType_Drawable:
+        // Drawable
+        DrawDrawable(objectIndex);
+        break;
+    case DrawableObjectType_Offscreen:
+        // Offscreen
+        AddOffscreen(objectIndex);
+        break;
+    default:
+        // 不明なタイプはエラーログを出す
+        CubismLogError("Unknown drawable type: %d", objectType);
+        break;
+    }
+}
+
+void CubismRenderer_Software::DrawDrawable(csmInt32 drawableIndex)
+{
+    // Drawableが表示状態でなければ処理をパスする
+    if (!GetModel()->GetDrawableDynamicFlagIsVisible(drawableIndex))
+    {
+        return;
+    }
+
+    SubmitDrawToParentOffscreen(drawableIndex, DrawableObjectType_Drawable);
+
+    // クリッピングマスク
+    CubismClippingContext_Software* clipContext = (_drawableClippingManager != NULL) ?
+        (*_drawableClippingManager->GetClippingContextListForDraw())[drawableIndex] :
+        NULL;
+
+    if (clipContext != NULL && IsUsingHighPrecisionMask()) // マスクを書く必要がある
+    {
+        DrawHighPrecisionMask(clipContext, GetDrawableMaskBuffer(clipContext->_bufferIndex));
+    }
+
+    // クリッピングマスクをセットする
+    SetClippingContextBufferForDrawable(clipContext);
+
+    IsCulling(GetModel()->GetDrawableCulling(drawableIndex) != 0);
+
+    DrawMeshSoftware(*GetModel(), drawableIndex);
+}
+
+void CubismRenderer_Software::SubmitDrawToParentOffscreen(const csmInt32 objectIndex, const DrawableObjectType objectType)
+{
+    if (_currentOffscreen == NULL ||
+        objectIndex == CubismModel::CubismNoIndex_Offscreen)
+    {
+        return;
+    }
+
+    csmInt32 currentOwnerIndex = GetModel()->GetOffscreenOwnerIndices()[_currentOffscreen->GetOffscreenIndex()];
+
+    // オーナーが不明な場合は処理を終了
+    if (currentOwnerIndex == CubismModel::CubismNoIndex_Offscreen)
+    {
+        return;
+    }
+
+    csmInt32 targetParentIndex = CubismModel::CubismNoIndex_Parent;
+    // 描画オブジェクトのタイプ別に親パーツのインデックスを取得
+    switch (objectType)
+    {
+    case DrawableObjectType_Drawable:
+        targetParentIndex = GetModel()->GetDrawableParentPartIndex(objectIndex);
+        break;
+    case DrawableObjectType_Offscreen:
+        targetParentIndex = GetModel()->GetPartParentPartIndex(GetModel()->GetOffscreenOwnerIndices()[objectIndex]);
+        break;
+    default:
+        // 不明なタイプだった場合は処理を終了
+        return;
+    }
+
+    // 階層を辿って現在のオフスクリーンのオーナーのパーツがいたら処理を終了する。
+    while (targetParentIndex != CubismModel::CubismNoIndex_Parent)
+    {
+        // オブジェクトの親が現在のオーナーと同じ場合は処理を終了
+        if (targetParentIndex == currentOwnerIndex)
+        {
+            return;
+        }
+
+        targetParentIndex = GetModel()->GetPartParentPartIndex(targetParentIndex);
+    }
+
+    /**
+     * 呼び出し元の描画オブジェクトは現オフスクリーンの描画対象でない。
+     * つまり描画順グループの仕様により、現オフスクリーンの描画対象は全て描画完了しているので
+     * 現オフスクリーンを描画する。
+     */
+    DrawOffscreen(_currentOffscreen);
+
+    // さらに親のオフスクリーンに伝搬可能なら伝搬する。
+    SubmitDrawToParentOffscreen(objectIndex, objectType);
+}
+
+void CubismRenderer_Software::AddOffscreen(csmInt32 offscreenIndex)
+{
+    // 以前のオフスクリーンレンダリングターゲットを親に伝搬する処理を追加する
+    if (_currentOffscreen != NULL && _currentOffscreen->GetOffscreenIndex() != offscreenIndex)
+    {
+        csmBool isParent = false;
+        csmInt32 ownerIndex = GetModel()->GetOffscreenOwnerIndices()[offscreenIndex];
+        csmInt32 parentIndex = GetModel()->GetPartParentPartIndex(ownerIndex);
+
+        csmInt32 currentOffscreenIndex = _currentOffscreen->GetOffscreenIndex();
+        csmInt32 currentOffscreenOwnerIndex = GetModel()->GetOffscreenOwnerIndices()[currentOffscreenIndex];
+        while (parentIndex != CubismModel::CubismNoIndex_Parent)
+        {
+            if (parentIndex == currentOffscreenOwnerIndex)
+            {
+                isParent = true;
+                break;
+            }
+            parentIndex = GetModel()->GetPartParentPartIndex(parentIndex);
+        }
+
+        if (!isParent)
+        {
+            // 現在のオフスクリーンレンダリングターゲットがあるなら、親に伝搬する
+            SubmitDrawToParentOffscreen(offscreenIndex, DrawableObjectType_Offscreen);
+        }
+    }
+
+    CubismOffscreenRenderTarget_Software* offscreen = &_offscreenList.At(offscreenIndex);
+
+    // 子孫Drawableを囲む範囲だけのレンダーターゲットを確保する
+    UpdateOffscreenDrawRect(offscreen);
+
+    // 以前のオフスクリーンレンダリングターゲットを取得
+    CubismOffscreenRenderTarget_Software* oldOffscreen = offscreen->GetParentPartOffscreen();
+
+    offscreen->SetOldOffscreen(oldOffscreen);
+
+    CubismRenderTarget_Software* oldRenderTarget = NULL;
+    if (oldOffscreen != NULL)
+    {
+        oldRenderTarget = oldOffscreen->GetRenderTarget();
+    }
+
+    if (oldRenderTarget == NULL)
+    {
+        oldRenderTarget = _modelRootRenderTarget; // ルートの描画先を使用する
+    }
+
+    // 別バッファに描画を開始
+    offscreen->GetRenderTarget()->BeginDraw(_rasterizer, oldRenderTarget);
+    offscreen->GetRenderTarget()->Clear(_rasterizer, 0.0f, 0.0f, 0.0f, 0.0f);
+
+    // 現在のオフスクリーンレンダリングターゲットを設定
+    _currentOffscreen = offscreen;
+    _currentRenderTarget = offscreen->GetRenderTarget();
+}
+
+void CubismRenderer_Software::UpdateOffscreenDrawRect(CubismOffscreenRenderTarget_Software* offscreen)
+{
+    const csmInt32 canvasWidth = static_cast<csmInt32>(_modelRenderTargetWidth);
+    const csmInt32 canvasHeight = static_cast<csmInt32>(_modelRenderTargetHeight);
+    const csmInt32 offscreenIndex = offscreen->GetOffscreenIndex();
+    CubismMatrix44 mvp = GetMvpMatrix();
+    const csmFloat32* m = mvp.GetArray();
+
+    // 表示中の子孫Drawableの頂点をモデル描画先のピクセル座標に変換して範囲を求める
+    csmFloat32 minX = FLT_MAX, minY = FLT_MAX;
+    csmFloat32 maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (csmInt32 i = _offscreenChildDrawableOffsets[offscreenIndex]; i < _offscreenChildDrawableOffsets[offscreenIndex + 1]; ++i)
+    {
+        const csmInt32 drawableIndex = _offscreenChildDrawableIndices[i];
+        if (!GetModel()->GetDrawableDynamicFlagIsVisible(drawableIndex))
+        {
+            continue;
+        }
+
+        const csmInt32 vertexCount = GetModel()->GetDrawableVertexCount(drawableIndex);
+        const csmFloat32* vertices = GetModel()->GetDrawableVertices(drawableIndex);
+        const csmInt32 loop = vertexCount * Constant::VertexStep;
+        for (csmInt32 pi = Constant::VertexOffset; pi < loop; pi += Constant::VertexStep)
+        {
+            const csmFloat32 x = vertices[pi];
+            const csmFloat32 y = vertices[pi + 1];
+            csmFloat32 w = m[3] * x + m[7] * y + m[15];
+            if (w == 0.0f)
+            {
+                w = 1.0f;
+            }
+            const csmFloat32 pixelX = ((m[0] * x + m[4] * y + m[12]) / w * 0.5f + 0.5f) * canvasWidth;
+            const csmFloat32 pixelY = ((m[1] * x + m[5] * y + m[13]) / w * 0.5f + 0.5f) * canvasHeight;
+
+            minX = (pixelX < minX) ? pixelX : minX;
+            minY = (pixelY < minY) ? pixelY : minY;
+            maxX = (pixelX > maxX) ? pixelX : maxX;
+            maxY = (pixelY > maxY) ? pixelY : maxY;
+        }
+    }
+
+    csmInt32 left = 0;
+    csmInt32 bottom = 0;
+    csmInt32 right = 0;
+    csmInt32 top = 0;
+    if (minX <= maxX && minY <= maxY)
+    {
+        // 外側に丸めた上で1ピクセルの余白を取り、モデル描画先の範囲に収める
+        left = static_cast<csmInt32>(CubismMath::Max(floorf(minX) - 1.0f, 0.0f));
+        bottom = static_cast<csmInt32>(CubismMath::Max(floorf(minY) - 1.0f, 0.0f));
+        right = static_cast<csmInt32>(CubismMath::Min(ceilf(maxX) + 1.0f, static_cast<csmFloat32>(canvasWidth)));
+        top = static_cast<csmInt32>(CubismMath::Min(ceilf(maxY) + 1.0f, static_cast<csmFloat32>(canvasHeight)));
+    }
+
+    // 描画範囲が毎フレーム僅かに変化してもレンダーターゲットを再利用できるよう、幅・高さをプールの単位に切り上げる
+    // モデル描画先を超える場合はその軸全体を使用する
+    const CubismOffscreenManager_Software* offscreenManager = CubismOffscreenManager_Software::GetInstance();
+    csmInt32 width = static_cast<csmInt32>(offscreenManager->GetBucketedSize((right - left > 1) ? right - left : 1));
+    csmInt32 height = static_cast<csmInt32>(offscreenManager->GetBucketedSize((top - bottom > 1) ? top - bottom : 1));
+    if (width >= canvasWidth)
+    {
+        left = 0;
+        width = canvasWidth;
+    }
+    else if (left + width > canvasWidth)
+    {
+        left = canvasWidth - width;
+    }
+    if (height >= canvasHeight)
+    {
+        bottom = 0;
+        height = canvasHeight;
+    }
+    else if (bottom + height > canvasHeight)
+    {
+        bottom = canvasHeight - height;
+    }
+
+    offscreen->SetDrawRect(left, bottom, width, height, _modelRenderTargetWidth, _modelRenderTargetHeight);
+}
+
+void CubismRenderer_Software::DrawOffscreen(CubismOffscreenRenderTarget_Software* currentOffscreen)
+{
+    csmInt32 offscreenIndex = currentOffscreen->GetOffscreenIndex();
+    // クリッピングマスク
+    CubismClippingContext_Software* clipContext = (_offscreenClippingManager != NULL) ?
+        (*_offscreenClippingManager->GetClippingContextListForOffscreen())[offscreenIndex] :
+        NULL;
+
+    if (clipContext != NULL && IsUsingHighPrecisionMask()) // マスクを書く必要がある
+    {
+        DrawHighPrecisionMask(clipContext, GetOffscreenMaskBuffer(clipContext->_bufferIndex));
+    }
+
+    // クリッピングマスクをセットする
+    SetClippingContextBufferForOffscreen(clipContext);
+
+    IsCulling(GetModel()->GetOffscreenCulling(offscreenIndex) != 0);
+
+    DrawOffscreenSoftware(*GetModel(), currentOffscreen);
+}
+
+void CubismRenderer_Software::DrawHighPrecisionMask(CubismClippingContext_Software* clipContext, CubismRenderTarget_Software* maskBuffer)
+{
+    if (clipContext->_isUsing) // 書くことになっていた
+    {
+        // ---------- マスク描画処理 ----------
+        // マスク用RenderTextureをactiveにセット
+        maskBuffer->BeginDraw(_rasterizer, _currentRenderTarget);
+
+        // マスクをクリアする
+        // 1が無効（描かれない）領域、0が有効（描かれる）領域
+        maskBuffer->Clear(_rasterizer, 1.0f, 1.0f, 1.0f, 1.0f);
+    }
+
+    const csmInt32 clipDrawCount = clipContext->_clippingIdCount;
+    for (csmInt32 index = 0; index < clipDrawCount; ++index)
+    {
+        const csmInt32 clipDrawIndex = clipContext->_clippingIdList[index];
+
+        // 頂点情報が更新されておらず、信頼性がない場合は描画をパスする
+        if (!GetModel()->GetDrawableDynamicFlagVertexPositionsDidChange(clipDrawIndex))
+        {
+            continue;
+        }
+
+        IsCulling(GetModel()->GetDrawableCulling(clipDrawIndex) != 0);
+
+        // 今回専用の変換を適用して描く
+        // チャンネルも切り替える必要がある(A,R,G,B)
+        SetClippingContextBufferForMask(clipContext);
+
+        DrawMeshSoftware(*GetModel(), clipDrawIndex);
+    }
+
+    // --- 後処理 ---
+    if (clipContext->_isUsing)
+    {
+        maskBuffer->EndDraw(_rasterizer);
+    }
+    SetClippingContextBufferForMask(NULL);
+}
+
+void CubismRenderer_Software::DrawMeshSoftware(const CubismModel& model, const csmInt32 index)
+{
+    // テクスチャが設定されていなければ描画しない
+    if (!_textures.IsExist(model.GetDrawableTextureIndex(index)))
+    {
+        return;
+    }
+
+    const CubismTexture_Software& texture = _textures[model.GetDrawableTextureIndex(index)];
+    if (texture.Pixels == NULL)
+    {
+        return;
+    }
+
+    CubismRasterizer_Software::DrawState state;
+    state.Texture = &texture;
+    state.IsCulling = IsCulling();
+    state.IsPremultipliedAlpha = IsPremultipliedAlpha();
+
+    const csmFloat32* positions = model.GetDrawableVertices(index);
+    const csmFloat32* uvs = reinterpret_cast<const csmFloat32*>(model.GetDrawableVertexUvs(index));
+    const csmInt32 vertexCount = model.GetDrawableVertexCount(index);
+    const csmUint16* indices = model.GetDrawableVertexIndices(index);
+    const csmInt32 indexCount = model.GetDrawableVertexIndexCount(index);
+
+    if (IsGeneratingMask())  // マスク生成時
+    {
+        CubismClippingContext_Software* clipContext = GetClippingContextBufferForMask();
+        state.Type = CubismRasterizer_Software::DrawType_Mask;
+        state.ChannelFlag = *clipContext->GetClippingManager()->GetChannelFlagAsColor(clipContext->_layoutChannelIndex);
+
+        // マスクはレイアウトされた範囲の外に描画しない
+        const csmRectF* rect = clipContext->_layoutBounds;
+        state.MaskBounds[0] = rect->X * 2.0f - 1.0f;
+        state.MaskBounds[1] = rect->Y * 2.0f - 1.0f;
+        state.MaskBounds[2] = rect->GetRight() * 2.0f - 1.0f;
+        state.MaskBounds[3] = rect->GetBottom() * 2.0f - 1.0f;
+
+        _rasterizer.DrawTriangles(state, positions, uvs, vertexCount, indices, indexCount, clipContext->_matrixForMask, NULL);
+    }
+    else
+    {
+        state.Type = CubismRasterizer_Software::DrawType_Mesh;
+        SetupBlendState(model.GetDrawableBlendModeType(index), state);
+
+        // 座標変換
+        CubismMatrix44 mvpMatrix = GetMvpMatrix();
+        if (_currentOffscreen != NULL)
+        {
+            // オフスクリーンは描画範囲だけを確保しているため、その範囲がNDC全体になるよう変換する
+            CubismMatrix44 canvasToOffscreen = _currentOffscreen->GetCanvasToOffscreenMatrix();
+            canvasToOffscreen.MultiplyByMatrix(&mvpMatrix);
+            mvpMatrix = canvasToOffscreen;
+        }
+
+        if (model.IsBlendModeEnabled())
+        {
+            // ブレンドモードではモデルカラーは最後に処理するため不透明度のみ対応させる
+            const csmFloat32 drawableOpacity = model.GetDrawableOpacity(index);
+            state.BaseColor.A = drawableOpacity;
+            if (IsPremultipliedAlpha())
+            {
+                state.BaseColor.R = drawableOpacity;
+                state.BaseColor.G = drawableOpacity;
+                state.BaseColor.B = drawableOpacity;
+            }
+        }
+        else
+        {
+            // ブレンドモード使用しない場合はDrawable単位でモデルカラーを処理する
+            state.BaseColor = GetModelColorWithOpacity(model.GetDrawableOpacity(index));
+        }
+        const CubismModelMultiplyAndScreenColor& overrideMultiplyAndScreenColor = model.GetOverrideMultiplyAndScreenColor();
+        state.MultiplyColor = overrideMultiplyAndScreenColor.GetDrawableMultiplyColor(index);
+        state.ScreenColor = overrideMultiplyAndScreenColor.GetDrawableScreenColor(index);
+
+        CubismClippingContext_Software* clipContext = GetClippingContextBufferForDrawable();
+        const CubismMatrix44* clipMatrix = NULL;
+        if (clipContext != NULL)
+        {
+            state.MaskRenderTarget = GetDrawableMaskBuffer(clipContext->_bufferIndex);
+            state.IsInvertedMask = model.GetDrawableInvertedMask(index);
+            state.ChannelFlag = *clipContext->GetClippingManager()->GetChannelFlagAsColor(clipContext->_layoutChannelIndex);
+            clipMatrix = &clipContext->_matrixForDraw;
+        }
+
+        _rasterizer.DrawTriangles(state, positions, uvs, vertexCount, indices, indexCount, mvpMatrix, clipMatrix);
+    }
+
+    // 後処理
+    SetClippingContextBufferForDrawable(NULL);
+    SetClippingContextBufferForMask(NULL);
+}
+
+void CubismRenderer_Software::DrawOffscreenSoftware(const CubismModel& model, CubismOffscreenRenderTarget_Software* offscreen)
+{
+    CSM_PROFILE_ZONE(Zone_OffscreenComposite, &model);
+
+    const csmInt32 offscreenIndex = offscreen->GetOffscreenIndex();
+
+    offscreen->GetRenderTarget()->EndDraw(_rasterizer);
+    _currentOffscreen = _currentOffscreen->GetOldOffscreen();
+    _currentRenderTarget = offscreen->GetRenderTarget()->GetOldRenderTarget();
+
+    CubismRasterizer_Software::DrawState state;
+    state.Type = CubismRasterizer_Software::DrawType_RenderTarget;
+    state.SourceRenderTarget = offscreen->GetRenderTarget();
+    state.IsCulling = IsCulling();
+    // オフスクリーンはPremultipliedAlphaを利用する
+    state.IsPremultipliedAlpha = true;
+    SetupBlendState(model.GetOffscreenBlendModeType(offscreenIndex), state);
+
+    // 親オフスクリーンへ描画する場合は親の描画範囲に合わせて変換する
+    CubismMatrix44 mvpMatrix;
+    mvpMatrix.LoadIdentity();
+    if (offscreen->GetOldOffscreen() != NULL)
+    {
+        mvpMatrix = offscreen->GetOldOffscreen()->GetCanvasToOffscreenMatrix();
+    }
+
+    // PMAなのと不透明度だけを変更したいためすべてOpacityで初期化
+    const csmFloat32 offscreenOpacity = model.GetOffscreenOpacity(offscreenIndex);
+    state.BaseColor = CubismTextureColor(offscreenOpacity, offscreenOpacity, offscreenOpacity, offscreenOpacity);
+    const CubismModelMultiplyAndScreenColor& overrideMultiplyAndScreenColor = model.GetOverrideMultiplyAndScreenColor();
+    state.MultiplyColor = overrideMultiplyAndScreenColor.GetOffscreenMultiplyColor(offscreenIndex);
+    state.ScreenColor = overrideMultiplyAndScreenColor.GetOffscreenScreenColor(offscreenIndex);
+
+    CubismClippingContext_Software* clipContext = GetClippingContextBufferForOffscreen();
+    const CubismMatrix44* clipMatrix = NULL;
+    if (clipContext != NULL)
+    {
+        state.MaskRenderTarget = GetOffscreenMaskBuffer(clipContext->_bufferIndex);
+        state.IsInvertedMask = model.GetOffscreenInvertedMask(offscreenIndex);
+        state.ChannelFlag = *clipContext->GetClippingManager()->GetChannelFlagAsColor(clipContext->_layoutChannelIndex);
+        clipMatrix = &clipContext->_matrixForDraw;
+    }
+
+    // オフスクリーンの描画範囲をモデル描画先のNDC座標で指定する（マスクの座標系と一致させるため）
+    _rasterizer.DrawTriangles(state, offscreen->GetDrawRectVertexArray(), RenderTargetReverseUvArray, 4,
+                              ModelRenderTargetIndexArray, 6, mvpMatrix, clipMatrix);
+
+    // 後処理
+    offscreen->StopUsingRenderTexture();
+    SetClippingContextBufferForOffscreen(NULL);
+    SetClippingContextBufferForMask(NULL);
+}
+
+void CubismRenderer_Software::SetupBlendState(const csmBlendMode& blendMode, CubismRasterizer_Software::DrawState& state) const
+{
+    const csmInt32 colorBlendType = blendMode.GetColorBlendType();
+    const csmInt32 alphaBlendType = blendMode.GetAlphaBlendType();
+
+    state.ColorBlendType = colorBlendType;
+    state.AlphaBlendType = alphaBlendType;
+
+    switch (colorBlendType)
+    {
+    case Core::csmColorBlendType_Normal:
+        // Normal Over　のときは5.2以前の描画方法を利用する
+        if (alphaBlendType == Core::csmAlphaBlendType_Over)
+        {
+            state.Blend = CubismRasterizer_Software::BlendType_Normal;
+            return;
+        }
+        break;
+    case Core::csmColorBlendType_AddCompatible:
+        // AddCompatible は5.2以前の描画方法を利用する
+        state.Blend = CubismRasterizer_Software::BlendType_Add;
+        return;
+    case Core::csmColorBlendType_MultiplyCompatible:
+        // MultCompatible は5.2以前の描画方法を利用する
+        state.Blend = CubismRasterizer_Software::BlendType_Multiply;
+        return;
+    default:
+        break;
+    }
+
+    // 5.3以降
+    // 合成先はラスタライザが直接読み出すため、コピーは不要
+    state.Blend = CubismRasterizer_Software::BlendType_Advanced;
+}
+
+void CubismRenderer_Software::SaveProfile()
+{
+}
+
+void CubismRenderer_Software::RestoreProfile()
+{
+}
+
+void CubismRenderer_Software::BeforeDrawModelRenderTarget()
+{
+    if (_modelRenderTargets.GetSize() == 0)
+    {
+        return;
+    }
+
+    // オフスクリーンのバッファのサイズが違う場合は作り直し
+    for (csmUint32 i = 0; i < _modelRenderTargets.GetSize(); ++i)
+    {
+        if (_modelRenderTargets[i].GetBufferWidth() != _modelRenderTargetWidth || _modelRenderTargets[i].GetBufferHeight() != _modelRenderTargetHeight)
+        {
+            _modelRenderTargets[i].CreateRenderTarget(_modelRenderTargetWidth, _modelRenderTargetHeight);
+        }
+    }
+
+    // 別バッファに描画を開始
+    _modelRenderTargets[0].BeginDraw(_rasterizer, _currentRenderTarget);
+    _modelRenderTargets[0].Clear(_rasterizer, 0.0f, 0.0f, 0.0f, 0.0f);
+    _currentRenderTarget = &_modelRenderTargets[0];
+}
+
+void CubismRenderer_Software::AfterDrawModelRenderTarget()
+{
+    if (_modelRenderTargets.GetSize() == 0)
+    {
+        return;
+    }
+
+    // 元のバッファに描画する
+    _modelRenderTargets[0].EndDraw(_rasterizer);
+    _currentRenderTarget = _modelRenderTargets[0].GetOldRenderTarget();
+
+    // この時点の内容はPMAになっているため、通常の合成で描画先に重ねる
+    CubismRasterizer_Software::DrawState state;
+    state.Type = CubismRasterizer_Software::DrawType_RenderTarget;
+    state.Blend = CubismRasterizer_Software::BlendType_Normal;
+    state.SourceRenderTarget = &_modelRenderTargets[0];
+    state.IsPremultipliedAlpha = true;
+    state.BaseColor = GetModelColor();
+    state.BaseColor.R *= state.BaseColor.A;
+    state.BaseColor.G *= state.BaseColor.A;
+    state.BaseColor.B *= state.BaseColor.A;
+
+    CubismMatrix44 matrix;
+    matrix.LoadIdentity();
+    _rasterizer.DrawTriangles(state, ModelRenderTargetVertexArray, RenderTargetReverseUvArray, 4,
+                              ModelRenderTargetIndexArray, 6, matrix, NULL);
+}
+
+void CubismRenderer_Software::BindTexture(csmUint32 modelTextureIndex, const csmUint8* pixels, csmUint32 width, csmUint32 height)
+{
+    CubismTexture_Software texture;
+    texture.Pixels = pixels;
+    texture.Width = width;
+    texture.Height = height;
+    _textures[modelTextureIndex] = texture;
+}
+
+const csmMap<csmInt32, CubismTexture_Software>& CubismRenderer_Software::GetBindedTextures() const
+{
+    return _textures;
+}
+
+void CubismRenderer_Software::SetRenderTarget(CubismRenderTarget_Software* renderTarget)
+{
+    _renderTarget = renderTarget;
+}
+
+CubismRenderTarget_Software* CubismRenderer_Software::GetRenderTarget()
+{
+    if (_renderTarget != NULL)
+    {
+        return _renderTarget;
+    }
+
+    // 描画先が設定されていなければ、モデル描画先のサイズで作成したものを使用する
+    if (_defaultRenderTarget.GetBufferWidth() != _modelRenderTargetWidth || _defaultRenderTarget.GetBufferHeight() != _modelRenderTargetHeight)
+    {
+        _defaultRenderTarget.CreateRenderTarget(_modelRenderTargetWidth, _modelRenderTargetHeight);
+    }
+    return &_defaultRenderTarget;
+}
+
+void CubismRenderer_Software::SetThreadCount(csmUint32 threadCount)
+{
+    _rasterizer.SetThreadCount(threadCount);
+}
+
+csmUint32 CubismRenderer_Software::GetThreadCount() const
+{
+    return _rasterizer.GetThreadCount();
+}
+
+void CubismRenderer_Software::SetDrawableClippingMaskBufferSize(csmFloat32 width, csmFloat32 height)
+{
+    if (_drawableClippingManager == NULL)
+    {
+        return;
+    }
+
+    // インスタンス破棄前にレンダーテクスチャの数を保存
+    const csmInt32 renderTextureCount = _drawableClippingManager->GetRenderTextureCount();
+
+    // RenderTargetのサイズを変更するためにインスタンスを破棄・再作成する
+    CSM_DELETE_SELF(CubismClippingManager_Software, _drawableClippingManager);
+
+    _drawableClippingManager = CSM_NEW CubismClippingManager_Software();
+
+    _drawableClippingManager->SetClippingMaskBufferSize(width, height);
+
+    _drawableClippingManager->Initialize(
+        *GetModel(),
+        renderTextureCount,
+        CubismRenderer::DrawableObjectType_Drawable
+    );
+}
+
+void CubismRenderer_Software::SetOffscreenClippingMaskBufferSize(csmFloat32 width, csmFloat32 height)
+{
+    if (_offscreenClippingManager == NULL)
+    {
+        return;
+    }
+
+    // インスタンス破棄前にレンダーテクスチャの数を保存
+    const csmInt32 renderTextureCount = _offscreenClippingManager->GetRenderTextureCount();
+
+    // RenderTargetのサイズを変更するためにインスタンスを破棄・再作成する
+    CSM_DELETE_SELF(CubismClippingManager_Software, _offscreenClippingManager);
+
+    _offscreenClippingManager = CSM_NEW CubismClippingManager_Software();
+
+    _offscreenClippingManager->SetClippingMaskBufferSize(width, height);
+
+    _offscreenClippingManager->Initialize(
+        *GetModel(),
+        renderTextureCount,
+        CubismRenderer::DrawableObjectType_Offscreen
+    );
+}
+
+csmInt32 CubismRenderer_Software::GetDrawableRenderTextureCount() const
+{
+    return _drawableClippingManager->GetRenderTextureCount();
+}
+
+csmInt32 CubismRenderer_Software::GetOffscreenRenderTextureCount() const
+{
+    return _offscreenClippingManager->GetRenderTextureCount();
+}
+
+CubismVector2 CubismRenderer_Software::GetDrawableClippingMaskBufferSize() const
+{
+    return _drawableClippingManager->GetClippingMaskBufferSize();
+}
+
+CubismVector2 CubismRenderer_Software::GetOffscreenClippingMaskBufferSize() const
+{
+    return _offscreenClippingManager->GetClippingMaskBufferSize();
+}
+
+CubismRenderTarget_Software* CubismRenderer_Software::GetDrawableMaskBuffer(csmInt32 index)
+{
+    return &_drawableMasks[index];
+}
+
+CubismRenderTarget_Software* CubismRenderer_Software::GetOffscreenMaskBuffer(csmInt32 index)
+{
+    return &_offscreenMasks[index];
+}
+
+CubismOffscreenRenderTarget_Software* CubismRenderer_Software::GetCurrentOffscreen() const
+{
+    return _currentOffscreen;
+}
+
+void CubismRenderer_Software::SetClippingContextBufferForMask(CubismClippingContext_Software* clip)
+{
+    _clippingContextBufferForMask = clip;
+}
+
+CubismClippingContext_Software* CubismRenderer_Software::GetClippingContextBufferForMask() const
+{
+    return _clippingContextBufferForMask;
+}
+
+void CubismRenderer_Software::SetClippingContextBufferForDrawable(CubismClippingContext_Software* clip)
+{
+    _clippingContextBufferForDrawable = clip;
+}
+
+CubismClippingContext_Software* CubismRenderer_Software::GetClippingContextBufferForDrawable() const
+{
+    return _clippingContextBufferForDrawable;
+}
+
+void CubismRenderer_Software::SetClippingContextBufferForOffscreen(CubismClippingContext_Software* clip)
+{
+    _clippingContextBufferForOffscreen = clip;
+}
+
+CubismClippingContext_Software* CubismRenderer_Software::GetClippingContextBufferForOffscreen() const
+{
+    return _clippingContextBufferForOffscreen;
+}
+
+const csmBool inline CubismRenderer_Software::IsGeneratingMask() const
+{
+    return (GetClippingContextBufferForMask() != NULL);
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
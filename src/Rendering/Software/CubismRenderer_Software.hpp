@@ -0,0 +1,455 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "../CubismRenderer.hpp"
+#include "../CubismClippingManager.hpp"
+#include "CubismFramework.hpp"
+#include "CubismRasterizer_Software.hpp"
+#include "CubismRenderTarget_Software.hpp"
+#include "CubismOffscreenRenderTarget_Software.hpp"
+#include "Type/csmVector.hpp"
+#include "Type/csmRectF.hpp"
+#include "Math/CubismVector2.hpp"
+#include "Type/csmMap.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+//  前方宣言
+class CubismRenderer_Software;
+class CubismClippingContext_Software;
+
+/**
+ * @brief  クリッピングマスクの処理を実行するクラス
+ *
+ */
+class CubismClippingManager_Software : public CubismClippingManager<CubismClippingContext_Software, CubismRenderTarget_Software>
+{
+public:
+
+    /**
+     * @brief   クリッピングコンテキストを作成する。モデル描画時に実行する。
+     *
+     * @param[in]   model              ->  モデルのインスタンス
+     * @param[in]   renderer           ->  レンダラのインスタンス
+     * @param[in]   lastRenderTarget   ->  マスク描画後に戻す描画先
+     * @param[in]   drawableObjectType ->  描画オブジェクトのタイプ
+     */
+    void SetupClippingContext(CubismModel& model, CubismRenderer_Software* renderer, CubismRenderTarget_Software* lastRenderTarget, CubismRenderer::DrawableObjectType drawableObjectType);
+};
+
+/**
+ * @brief   クリッピングマスクのコンテキスト
+ */
+class CubismClippingContext_Software : public CubismClippingContext
+{
+    friend class CubismClippingManager_Software;
+    friend class CubismRenderer_Software;
+
+public:
+    /**
+     * @brief   引数付きコンストラクタ
+     *
+     * @param[in]   manager                  ->  マスクを管理しているマネージャのインスタンス
+     * @param[in]   model                    ->  モデルのインスタンス
+     * @param[in]   clippingDrawableIndices  ->  クリップしているDrawableのインデックスリスト
+     * @param[in]   clipCount                ->  クリップしているDrawableの個数
+     */
+    CubismClippingContext_Software(CubismClippingManager<CubismClippingContext_Software, CubismRenderTarget_Software>* manager, CubismModel& model, const csmInt32* clippingDrawableIndices, csmInt32 clipCount);
+
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~CubismClippingContext_Software();
+
+    /**
+     * @brief   このマスクを管理するマネージャのインスタンスを取得する。
+     *
+     * @return  クリッピングマネージャのインスタンス
+     */
+    CubismClippingManager<CubismClippingContext_Software, CubismRenderTarget_Software>* GetClippingManager();
+
+    CubismClippingManager<CubismClippingContext_Software, CubismRenderTarget_Software>* _owner;        ///< このマスクを管理しているマネージャのインスタンス
+};
+
+/**
+ * @brief   CPUだけでモデルを描画するレンダラ<br>
+ *          GPUのないサーバーでのサムネイルや動画の生成に使用する。<br>
+ *          描画結果はOpenGLレンダラと同じ規則で求め、CubismRenderTarget_Software::ReadPixelsでRGBA8として取り出す。
+ */
+class CubismRenderer_Software : public CubismRenderer
+{
+    friend class CubismRenderer;
+    friend class CubismClippingManager_Software;
+
+public:
+    /**
+     * @brief    レンダラの初期化処理を実行する
+     *           引数に渡したモデルからレンダラの初期化処理に必要な情報を取り出すことができる
+     *
+     * @param[in]  model -> モデルのインスタンス
+     */
+    void Initialize(Framework::CubismModel* model) override;
+
+    /**
+     * @brief   レンダラの初期化処理を実行する
+     *           引数に渡したモデルからレンダラの初期化処理に必要な情報を取り出すことができる
+     *
+     * @param[in]  model           -> モデルのインスタンス
+     * @param[in]  maskBufferCount -> マスクの分割数
+     */
+    void Initialize(Framework::CubismModel* model, csmInt32 maskBufferCount) override;
+
+    /**
+     * @bref オフスクリーンの親を探して設定する
+     *
+     * @param model -> モデルのインスタンス
+     * @param offscreenCount -> オフスクリーンの数
+     */
+    void SetupParentOffscreens(const CubismModel* model, csmInt32 offscreenCount);
+
+    /**
+     * @brief   オフスクリーンごとに、描画対象となる子孫Drawableのインデックスを収集する。<br>
+     *           オフスクリーンの描画範囲の計算に使用する。
+     *
+     * @param[in]   model           ->  モデルのインスタンス
+     * @param[in]   offscreenCount  ->  オフスクリーンの数
+     */
+    void SetupOffscreenChildDrawables(const CubismModel* model, csmInt32 offscreenCount);
+
+    /**
+     * @brief   テクスチャのバインド処理<br>
+     *          ピクセルはコピーしないため、モデルを描画する間は保持しておくこと。<br>
+     *          PremultipliedAlphaかどうかはIsPremultipliedAlphaの設定に従う
+     *
+     * @param[in]   modelTextureIndex  ->  セットするモデルテクスチャの番号
+     * @param[in]   pixels             ->  上の行から並べたRGBA8のピクセル
+     * @param[in]   width              ->  テクスチャの幅
+     * @param[in]   height             ->  テクスチャの高さ
+     */
+    void BindTexture(csmUint32 modelTextureIndex, const csmUint8* pixels, csmUint32 width, csmUint32 height);
+
+    /**
+     * @brief   バインドされたテクスチャのリストを取得する
+     *
+     * @return  テクスチャのリスト
+     */
+    const csmMap<csmInt32, CubismTexture_Software>& GetBindedTextures() const;
+
+    /**
+     * @brief   モデルの描画先を設定する<br>
+     *          複数のモデルを重ねる場合は同じ描画先を設定する。クリアはアプリケーション側で行う
+     *
+     * @param[in]   renderTarget    ->  描画先。NULLの場合はレンダラが持つ描画先を使用する
+     */
+    void SetRenderTarget(CubismRenderTarget_Software* renderTarget);
+
+    /**
+     * @brief   モデルの描画先を取得する<br>
+     *          SetRenderTargetで設定していない場合は、モデル描画先のサイズでレンダラが作成した描画先を返す
+     *
+     * @return  描画先
+     */
+    CubismRenderTarget_Software* GetRenderTarget();
+
+    /**
+     * @brief   ラスタライズに使用するスレッド数を設定する<br>
+     *          既定は1で、呼び出し元のスレッドだけで描画する。ワーカースレッドはレンダラごとに作られるため、<br>
+     *          複数のモデルを描画する場合は合計がハードウェアのスレッド数を超えないように設定する
+     *
+     * @param[in]   threadCount ->  呼び出し元を含むスレッド数。0の場合はハードウェアのスレッド数
+     */
+    void SetThreadCount(csmUint32 threadCount);
+
+    /**
+     * @brief   ラスタライズに使用するスレッド数を取得する
+     *
+     * @return  スレッド数
+     */
+    csmUint32 GetThreadCount() const;
+
+    /**
+     * @brief  クリッピングマスクバッファのサイズを設定する
+     *
+     * @param[in]  width  -> クリッピングマスクバッファの幅
+     * @param[in]  height -> クリッピングマスクバッファの高さ
+     */
+    void SetDrawableClippingMaskBufferSize(csmFloat32 width, csmFloat32 height);
+
+    /**
+     * @brief  オフスクリーン用クリッピングマスクバッファのサイズを設定する
+     *
+     * @param[in]  width  -> クリッピングマスクバッファの幅
+     * @param[in]  height -> クリッピングマスクバッファの高さ
+     */
+    void SetOffscreenClippingMaskBufferSize(csmFloat32 width, csmFloat32 height);
+
+    /**
+     * @brief  描画オブジェクトのレンダーテクスチャの枚数を取得する。
+     *
+     * @return  描画オブジェクトのレンダーテクスチャの枚数
+     */
+    csmInt32 GetDrawableRenderTextureCount() const;
+
+    /**
+     * @brief  オフスクリーンのレンダーテクスチャの枚数を取得する。
+     *
+     * @return  オフスクリーンのレンダーテクスチャの枚数
+     */
+    csmInt32 GetOffscreenRenderTextureCount() const;
+
+    /**
+     * @brief  描画オブジェクトのクリッピングマスクバッファのサイズを取得する
+     *
+     * @return 描画オブジェクトのクリッピングマスクバッファのサイズ
+     */
+    CubismVector2 GetDrawableClippingMaskBufferSize() const;
+
+    /**
+     * @brief  オフスクリーンのクリッピングマスクバッファのサイズを取得する
+     *
+     * @return オフスクリーンのクリッピングマスクバッファのサイズ
+     */
+    CubismVector2 GetOffscreenClippingMaskBufferSize() const;
+
+    /**
+     * @brief  描画オブジェクトのクリッピングマスクのバッファを取得する
+     *
+     * @return 描画オブジェクトのクリッピングマスクのバッファへのポインタ
+     */
+    CubismRenderTarget_Software* GetDrawableMaskBuffer(csmInt32 index);
+
+    /**
+     * @brief  オフスクリーンのクリッピングマスクのバッファを取得する
+     *
+     * @return オフスクリーンのクリッピングマスクのバッファへのポインタ
+     */
+    CubismRenderTarget_Software* GetOffscreenMaskBuffer(csmInt32 index);
+
+    /**
+     * @brief  現在のオフスクリーンのフレームバッファを取得する
+     *
+     * @return 現在のオフスクリーンのフレームバッファを返す
+     */
+    CubismOffscreenRenderTarget_Software* GetCurrentOffscreen() const;
+
+protected:
+    /**
+     * @brief   コンストラクタ
+     *
+     * @param[in] width -> モデルを描画したバッファの幅
+     * @param[in] height -> モデルを描画したバッファの高さ
+     */
+    CubismRenderer_Software(csmUint32 width, csmUint32 height);
+
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~CubismRenderer_Software();
+
+    /**
+     * @brief   モデルを描画する実際の処理
+     *
+     */
+    virtual void DoDrawModel() override;
+
+    /**
+     * @brief   描画オブジェクト（アートメッシュ、オフスクリーン）を描画するループ処理
+     *
+     * @param[in]   lastRenderTarget ->  モデル描画直前の描画先
+     */
+    void DrawObjectLoop(CubismRenderTarget_Software* lastRenderTarget);
+
+    /**
+     * @brief 各オブジェクトの描画処理を呼ぶ。
+     *
+     * @param[in]   objectIndex  ->  描画対象のオブジェクトのインデックス
+     * @param[in]   objectType  ->  描画対象のオブジェクトのタイプ
+     */
+    void RenderObject(csmInt32 objectIndex, csmInt32 objectType);
+
+    /**
+     * @brief   描画オブジェクト（アートメッシュ）を描画する。
+     *
+     * @param[in]   drawableIndex ->  描画対象のメッシュのインデックス
+     */
+    void DrawDrawable(csmInt32 drawableIndex);
+
+    /**
+     * @brief   親オフスクリーンへオフスクリーンの描画結果の伝搬を試みる。
+     *
+     * @param[in] objectIndex 処理をするオブジェクトのインデックス
+     * @param objectType 処理をするオブジェクトのタイプ
+     */
+    void SubmitDrawToParentOffscreen(csmInt32 objectIndex, DrawableObjectType objectType);
+
+    /**
+     * @brief   描画オブジェクト（オフスクリーン）を追加する。
+     *
+     * @param[in]   offscreenIndex ->  描画対象のオフスクリーンのインデックス
+     */
+    void AddOffscreen(csmInt32 offscreenIndex);
+
+    /**
+     * @brief   オフスクリーンの子孫Drawableを囲む矩形を計算し、オフスクリーンの描画範囲として設定する。
+     *
+     * @param[in]   offscreen   ->  描画範囲を設定するオフスクリーン
+     */
+    void UpdateOffscreenDrawRect(CubismOffscreenRenderTarget_Software* offscreen);
+
+    /**
+     * @brief   描画オブジェクト（オフスクリーン）を描画する。
+     *
+     * @param[in]   currentOffscreen ->  描画対象のオフスクリーン
+     */
+    void DrawOffscreen(CubismOffscreenRenderTarget_Software* currentOffscreen);
+
+    /**
+     * @brief   高精細マスクを描画オブジェクトの描画直前に生成する。
+     *
+     * @param[in]   clipContext     ->  生成するクリッピングコンテキスト
+     * @param[in]   maskBuffer      ->  マスクを描くバッファ
+     */
+    void DrawHighPrecisionMask(CubismClippingContext_Software* clipContext, CubismRenderTarget_Software* maskBuffer);
+
+    /**
+     * @brief    描画オブジェクト（アートメッシュ）を描画する。
+     *
+     * @param[in]   model       ->  描画対象のモデル
+     * @param[in]   index       ->  描画対象のメッシュのインデックス
+     */
+    void DrawMeshSoftware(const CubismModel& model, const csmInt32 index);
+
+    /**
+     * @brief   オフスクリーンの内容を親の描画先へ合成する。
+     *
+     * @param[in]   model       ->  描画対象のモデル
+     * @param[in]   offscreen ->  描画対象のオフスクリーン
+     */
+    void DrawOffscreenSoftware(const CubismModel& model, CubismOffscreenRenderTarget_Software* offscreen);
+
+private:
+    // Prevention of copy Constructor
+    CubismRenderer_Software(const CubismRenderer_Software&);
+    CubismRenderer_Software& operator=(const CubismRenderer_Software&);
+
+    /**
+     * @brief   レンダラが保持する静的なリソースを解放する
+     */
+    static void DoStaticRelease();
+
+    /**
+     * @brief   ブレンドモードに対応する合成方法を描画ステートに設定する。<br>
+     *          合成先はラスタライズ時に直接読むため、描画先のコピーは行わない。
+     *
+     * @param[in]   blendMode   ->  描画オブジェクトのブレンドモード
+     * @param[out]  state       ->  設定先の描画ステート
+     */
+    void SetupBlendState(const csmBlendMode& blendMode, CubismRasterizer_Software::DrawState& state) const;
+
+    /**
+     * @brief   モデル描画直前のステートを保持する<br>
+     *          保持するステートは持たないため何もしない
+     */
+    void SaveProfile() override;
+
+    /**
+     * @brief   モデル描画直前のステートを復帰させる<br>
+     *          保持するステートは持たないため何もしない
+     */
+    void RestoreProfile() override;
+
+    /**
+     * @brief   モデル描画直前のオフスクリーン設定
+     */
+    virtual void BeforeDrawModelRenderTarget();
+
+    /**
+     * @brief   モデル描画後のオフスクリーン設定
+     */
+    virtual void AfterDrawModelRenderTarget();
+
+    /**
+     * @brief   マスクテクスチャに描画するクリッピングコンテキストをセットする。
+     *
+     * @param[in]   clip     ->  マスクテクスチャに描画するクリッピングコンテキスト
+     */
+    void SetClippingContextBufferForMask(CubismClippingContext_Software* clip);
+
+    /**
+     * @brief   マスクテクスチャに描画するクリッピングコンテキストを取得する。
+     *
+     * @return  マスクテクスチャに描画するクリッピングコンテキスト
+     */
+    CubismClippingContext_Software* GetClippingContextBufferForMask() const;
+
+    /**
+     * @brief   drawableで画面上に描画するクリッピングコンテキストをセットする。
+     *
+     * @param[in]   clip     ->  drawableで画面上に描画するクリッピングコンテキスト
+     */
+    void SetClippingContextBufferForDrawable(CubismClippingContext_Software* clip);
+
+    /**
+     * @brief   drawableで画面上に描画するクリッピングコンテキストを取得する。
+     *
+     * @return  drawableで画面上に描画するクリッピングコンテキスト
+     */
+    CubismClippingContext_Software* GetClippingContextBufferForDrawable() const;
+
+    /**
+     * @brief   offscreenで画面上に描画するクリッピングコンテキストをセットする。
+     *
+     * @param[in]   clip     ->  offscreenで画面上に描画するクリッピングコンテキスト
+     */
+    void SetClippingContextBufferForOffscreen(CubismClippingContext_Software* clip);
+
+    /**
+     * @brief   offscreenで画面上に描画するクリッピングコンテキストを取得する。
+     *
+     * @return  offscreenで画面上に描画するクリッピングコンテキスト
+     */
+    CubismClippingContext_Software* GetClippingContextBufferForOffscreen() const;
+
+    /**
+     * @brief   マスク生成時かを判定する
+     *
+     * @return  判定値
+     */
+    const csmBool inline IsGeneratingMask() const;
+
+    CubismRasterizer_Software _rasterizer;                    ///< 三角形を塗りつぶすラスタライザ
+    csmMap<csmInt32, CubismTexture_Software> _textures;       ///< モデルが参照するテクスチャとレンダラでバインドしているテクスチャとのマップ
+    csmVector<csmInt32> _sortedObjectsIndexList;       ///< 描画オブジェクトのインデックスを描画順に並べたリスト
+    csmVector<DrawableObjectType> _sortedObjectsTypeList;       ///< 描画オブジェクトの種別を描画順に並べたリスト
+    CubismClippingManager_Software* _drawableClippingManager;               ///< クリッピングマスク管理オブジェクト
+    CubismClippingManager_Software* _offscreenClippingManager;               ///< クリッピングマスク管理オブジェクト
+    CubismClippingContext_Software* _clippingContextBufferForMask;  ///< マスクテクスチャに描画するためのクリッピングコンテキスト
+    CubismClippingContext_Software* _clippingContextBufferForDrawable;  ///< 画面上描画するためのクリッピングコンテキスト
+    CubismClippingContext_Software* _clippingContextBufferForOffscreen;  ///< 画面上描画するためのクリッピングコンテキスト
+
+    CubismRenderTarget_Software* _renderTarget; ///< アプリケーションが設定したモデルの描画先
+    CubismRenderTarget_Software _defaultRenderTarget; ///< 描画先が設定されていない場合に使用する描画先
+    csmVector<CubismRenderTarget_Software> _modelRenderTargets; ///< モデル全体を描画する先のバッファ
+
+    csmVector<CubismRenderTarget_Software> _drawableMasks; ///< Drawableのマスク描画用のバッファ
+    csmVector<CubismRenderTarget_Software> _offscreenMasks; ///< オフスクリーン機能マスク描画用のバッファ
+
+    csmVector<CubismOffscreenRenderTarget_Software> _offscreenList; ///< モデルのオフスクリーン
+    CubismRenderTarget_Software* _currentRenderTarget; ///< 現在の描画先
+    CubismOffscreenRenderTarget_Software* _currentOffscreen; ///< 現在のオフスクリーンのフレームバッファ
+
+    CubismRenderTarget_Software* _modelRootRenderTarget; ///< モデル描画のルートの描画先
+
+    csmVector<csmInt32> _offscreenChildDrawableIndices; ///< オフスクリーンごとの子孫Drawableのインデックスを連結したリスト
+    csmVector<csmInt32> _offscreenChildDrawableOffsets; ///< _offscreenChildDrawableIndices内での各オフスクリーンの開始位置
+};
+
+}}}}
+//------------ LIVE2D NAMESPACE ------------
@@ -0,0 +1,119 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismGpuTimer_Vulkan.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+CubismGpuTimer_Vulkan::CubismGpuTimer_Vulkan(VkDevice device, VkPhysicalDevice physicalDevice)
+    : _device(device)
+    , _physicalDevice(physicalDevice)
+    , _queryPool(VK_NULL_HANDLE)
+    , _commandBuffer(VK_NULL_HANDLE)
+    , _timestampPeriod(1.0f)
+    , _timestampMask(~0ull)
+{
+}
+
+CubismGpuTimer_Vulkan::~CubismGpuTimer_Vulkan()
+{
+    Release();
+}
+
+void CubismGpuTimer_Vulkan::SetCommandBuffer(VkCommandBuffer commandBuffer)
+{
+    _commandBuffer = commandBuffer;
+}
+
+csmBool CubismGpuTimer_Vulkan::CreateQueries(csmUint32 queryCount)
+{
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(_physicalDevice, &properties);
+    if (!properties.limits.timestampComputeAndGraphics || properties.limits.timestampPeriod <= 0.0f)
+    {
+        return false;
+    }
+    _timestampPeriod = properties.limits.timestampPeriod;
+
+    // コマンドバッファのキューファミリーはレンダラーからは分からないため、
+    // グラフィックスに使えるキューファミリーのうち最も少ない有効ビット数に合わせる
+    csmUint32 familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(_physicalDevice, &familyCount, nullptr);
+    csmVector<VkQueueFamilyProperties> families;
+    families.Resize(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(_physicalDevice, &familyCount, families.GetPtr());
+
+    csmUint32 validBits = 64;
+    for (csmUint32 i = 0; i < familyCount; ++i)
+    {
+        if ((families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) && families[i].timestampValidBits > 0 && families[i].timestampValidBits < validBits)
+        {
+            validBits = families[i].timestampValidBits;
+        }
+    }
+    _timestampMask = (validBits >= 64) ? ~0ull : ((1ull << validBits) - 1);
+
+    VkQueryPoolCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    createInfo.queryCount = queryCount;
+    if (vkCreateQueryPool(_device, &createInfo, nullptr, &_queryPool) != VK_SUCCESS)
+    {
+        CubismLogError("failed to create timestamp query pool!");
+        _queryPool = VK_NULL_HANDLE;
+        return false;
+    }
+
+    return true;
+}
+
+void CubismGpuTimer_Vulkan::DestroyQueries()
+{
+    if (_queryPool != VK_NULL_HANDLE)
+    {
+        vkDestroyQueryPool(_device, _queryPool, nullptr);
+        _queryPool = VK_NULL_HANDLE;
+    }
+}
+
+void CubismGpuTimer_Vulkan::ResetQueries(csmUint32 firstQuery, csmUint32 queryCount)
+{
+    vkCmdResetQueryPool(_commandBuffer, _queryPool, firstQuery, queryCount);
+}
+
+void CubismGpuTimer_Vulkan::WriteTimestamp(csmUint32 query)
+{
+    vkCmdWriteTimestamp(_commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, _queryPool, query);
+}
+
+CubismGpuTimer::ReadResult CubismGpuTimer_Vulkan::ReadTimestamps(csmUint32 firstQuery, csmUint32 queryCount, csmUint64* nanoseconds)
+{
+    // VK_QUERY_RESULT_WAIT_BIT を付けず、終わっていなければ VK_NOT_READY で戻らせる
+    const VkResult result = vkGetQueryPoolResults(_device, _queryPool, firstQuery, queryCount,
+                                                  sizeof(csmUint64) * queryCount, nanoseconds, sizeof(csmUint64),
+                                                  VK_QUERY_RESULT_64_BIT);
+    if (result == VK_NOT_READY)
+    {
+        return ReadResult_NotReady;
+    }
+    if (result != VK_SUCCESS)
+    {
+        return ReadResult_Invalid;
+    }
+
+    // 有効ビットより上位のビットは未定義のため、差を取る前に落とす
+    for (csmUint32 i = 0; i < queryCount; ++i)
+    {
+        nanoseconds[i] = static_cast<csmUint64>(static_cast<double>(nanoseconds[i] & _timestampMask) * _timestampPeriod);
+    }
+    return ReadResult_Ready;
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
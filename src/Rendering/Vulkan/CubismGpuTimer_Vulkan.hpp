@@ -0,0 +1,97 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+#include <vulkan/vulkan.h>
+#include "../CubismGpuTimer.hpp"
+#include "CubismFramework.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+/**
+ * @brief   Vulkanのタイムスタンプクエリで描画時間を計測するクラス<br>
+ *          タイムスタンプは SetCommandBuffer() で設定したコマンドバッファに記録する。<br>
+ *          グラフィックスキューでタイムスタンプを使えないデバイス（timestampComputeAndGraphics がfalse）では計測しない。
+ */
+class CubismGpuTimer_Vulkan : public CubismGpuTimer
+{
+public:
+    /**
+     * @brief   コンストラクタ
+     *
+     * @param[in]   device          ->  論理デバイス
+     * @param[in]   physicalDevice  ->  物理デバイス
+     */
+    CubismGpuTimer_Vulkan(VkDevice device, VkPhysicalDevice physicalDevice);
+
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~CubismGpuTimer_Vulkan();
+
+    /**
+     * @brief   タイムスタンプを記録するコマンドバッファを設定する<br>
+     *           BeginFrame() の前に、レンダーパスの外で記録中のコマンドバッファを設定すること
+     *
+     * @param[in]   commandBuffer   ->  コマンドバッファ
+     */
+    void SetCommandBuffer(VkCommandBuffer commandBuffer);
+
+protected:
+    /**
+     * @brief   タイムスタンプを記録するクエリプールを作成する
+     *
+     * @param[in]   queryCount  ->  クエリの数
+     *
+     * @return  作成できた場合はtrue
+     */
+    csmBool CreateQueries(csmUint32 queryCount) override;
+
+    /**
+     * @brief   作成したクエリプールを破棄する
+     */
+    void DestroyQueries() override;
+
+    /**
+     * @brief   クエリを再び記録できる状態に戻すコマンドを記録する
+     *
+     * @param[in]   firstQuery  ->  最初のクエリ
+     * @param[in]   queryCount  ->  クエリの数
+     */
+    void ResetQueries(csmUint32 firstQuery, csmUint32 queryCount) override;
+
+    /**
+     * @brief   クエリにGPUのタイムスタンプを記録するコマンドを記録する
+     *
+     * @param[in]   query   ->  クエリ
+     */
+    void WriteTimestamp(csmUint32 query) override;
+
+    /**
+     * @brief   記録したタイムスタンプをGPUの処理を待たずに読み出す
+     *
+     * @param[in]   firstQuery  ->  最初のクエリ
+     * @param[in]   queryCount  ->  クエリの数
+     * @param[out]  nanoseconds ->  ナノ秒に換算したタイムスタンプ
+     *
+     * @return  読み出しの結果
+     */
+    ReadResult ReadTimestamps(csmUint32 firstQuery, csmUint32 queryCount, csmUint64* nanoseconds) override;
+
+private:
+    VkDevice            _device;            ///< 論理デバイス
+    VkPhysicalDevice    _physicalDevice;    ///< 物理デバイス
+    VkQueryPool         _queryPool;         ///< タイムスタンプのクエリプール
+    VkCommandBuffer     _commandBuffer;     ///< タイムスタンプを記録するコマンドバッファ
+    csmFloat32          _timestampPeriod;   ///< タイムスタンプの1単位のナノ秒
+    csmUint64           _timestampMask;     ///< タイムスタンプの有効なビットのマスク
+};
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
@@ -27,7 +27,7 @@ CubismRenderTarget_Vulkan* CubismOffscreenManager_Vulkan::GetOffscreenRenderTarg
     UpdateRenderTargetCount();
 
     // 使われていないリソースコンテナがあればそれを返す
-    CubismRenderTarget_Vulkan* offscreenRenderTarget = GetUnusedOffscreenRenderTarget();
+    CubismRenderTarget_Vulkan* offscreenRenderTarget = GetUnusedOffscreenRenderTarget(displayBufferWidth, displayBufferHeight);
     if (offscreenRenderTarget != nullptr)
     {
         // サイズが違う場合は再作成する
@@ -8,10 +8,12 @@
 #include "CubismRenderer_Vulkan.hpp"
 #include "CubismDeviceInfo_Vulkan.hpp"
 #include "CubismOffscreenManager_Vulkan.hpp"
+#include "CubismGpuTimer_Vulkan.hpp"
 #include "Math/CubismMatrix44.hpp"
 #include "Type/csmVector.hpp"
 #include "Model/CubismModel.hpp"
 #include "Rendering/csmBlendMode.hpp"
+#include "Utils/CubismProfiler.hpp"
 
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
@@ -175,6 +177,8 @@ void CubismClippingManager_Vulkan::SetupClippingContext(CubismModel& model, VkCo
                                                         CubismRenderer_Vulkan* renderer, csmInt32 commandBufferCurrent,
                                                         CubismRenderer::DrawableObjectType drawableObjectType)
 {
+    CSM_PROFILE_ZONE(Zone_ClippingSetup, &model);
+
     // 全てのクリッピングを用意する
     // 同じクリップ（複数の場合はまとめて１つのクリップ）を使う場合は１度だけ設定する
     csmInt32 usingClipCount = 0;
@@ -794,6 +798,7 @@ CubismRenderer_Vulkan::CubismRenderer_Vulkan(csmUint32 width, csmUint32 height)
                                                , _copyDescriptorSetLayout(VK_NULL_HANDLE)
                                                , _clearColor()
                                                , _commandBufferCurrent(0)
+                                               , _gpuTimer(NULL)
 {
 }
 
@@ -801,6 +806,7 @@ CubismRenderer_Vulkan::~CubismRenderer_Vulkan()
 {
     CSM_DELETE_SELF(CubismClippingManager_Vulkan, _drawableClippingManager);
     CSM_DELETE_SELF(CubismClippingManager_Vulkan, _offscreenClippingManager);
+    CSM_DELETE(_gpuTimer);
 
     // オフスクリーンを作成していたのなら開放
     for (csmInt32 i = 0; i < _modelRenderTargets.GetSize(); i++)
@@ -2391,6 +2397,9 @@ void CubismRenderer_Vulkan::DoDrawModel()
     vkBeginCommandBuffer(updateCommandBuffer, &beginInfo);
     vkBeginCommandBuffer(drawCommandBuffer, &beginInfo);
 
+    BeginGpuTiming(drawCommandBuffer);
+    const csmInt32 maskSection = BeginGpuTimingSection(CubismGpuTimer::SectionType_Mask, 0);
+
     if (_drawableClippingManager != NULL)
     {
         // サイズが違う場合はここで作成しなおし
@@ -2450,6 +2459,8 @@ void CubismRenderer_Vulkan::DoDrawModel()
         }
     }
 
+    EndGpuTimingSection(maskSection);
+
     SubmitCommand(updateCommandBuffer, _updateFinishedSemaphores[_commandBufferCurrent]);
     SubmitCommand(drawCommandBuffer, VK_NULL_HANDLE, _updateFinishedSemaphores[_commandBufferCurrent]);
 
@@ -2730,6 +2741,7 @@ void CubismRenderer_Vulkan::DrawObjectLoop(VkCommandBuffer updateCommandBuffer,
     //描画
     vkBeginCommandBuffer(updateCommandBuffer, &beginInfo);
     vkBeginCommandBuffer(drawCommandBuffer, &beginInfo);
+    const csmInt32 drawLoopSection = BeginGpuTimingSection(CubismGpuTimer::SectionType_DrawLoop, 0);
     BeginRenderTarget(drawCommandBuffer, false);
 
     for (csmInt32 i = 0; i < totalCount; ++i)
@@ -2748,6 +2760,8 @@ void CubismRenderer_Vulkan::DrawObjectLoop(VkCommandBuffer updateCommandBuffer,
     }
 
     EndRenderTarget(drawCommandBuffer);
+    EndGpuTimingSection(drawLoopSection);
+    EndGpuTiming();
 
     SubmitCommand(updateCommandBuffer, _updateFinishedSemaphores[_commandBufferCurrent]);
     SubmitCommand(drawCommandBuffer, VK_NULL_HANDLE, _updateFinishedSemaphores[_commandBufferCurrent]);
@@ -2755,6 +2769,64 @@ void CubismRenderer_Vulkan::DrawObjectLoop(VkCommandBuffer updateCommandBuffer,
     PostDraw();
 }
 
+void CubismRenderer_Vulkan::BeginGpuTiming(VkCommandBuffer drawCommandBuffer)
+{
+    if (!IsUsingGpuTiming())
+    {
+        // 計測をやめたらクエリプールも解放する
+        if (_gpuTimer != NULL)
+        {
+            CSM_DELETE(_gpuTimer);
+            _gpuTimer = NULL;
+        }
+        return;
+    }
+
+    if (_gpuTimer == NULL)
+    {
+        _gpuTimer = CSM_NEW CubismGpuTimer_Vulkan(s_device, s_physicalDevice);
+    }
+
+    _gpuTimer->SetCommandBuffer(drawCommandBuffer);
+    _gpuTimer->BeginFrame(GetModel()->GetOffscreenCount());
+}
+
+void CubismRenderer_Vulkan::EndGpuTiming()
+{
+    if (_gpuTimer != NULL)
+    {
+        _gpuTimer->EndFrame();
+    }
+}
+
+csmInt32 CubismRenderer_Vulkan::BeginGpuTimingSection(CubismGpuTimer::SectionType type, csmInt32 index)
+{
+    if (_gpuTimer == NULL)
+    {
+        return -1;
+    }
+
+    return _gpuTimer->BeginSection(type, index);
+}
+
+void CubismRenderer_Vulkan::EndGpuTimingSection(csmInt32 section)
+{
+    if (_gpuTimer != NULL)
+    {
+        _gpuTimer->EndSection(section);
+    }
+}
+
+const CubismRenderer::CubismGpuTimingStats& CubismRenderer_Vulkan::GetGpuTimingStats() const
+{
+    if (_gpuTimer == NULL)
+    {
+        return CubismRenderer::GetGpuTimingStats();
+    }
+
+    return _gpuTimer->GetStats();
+}
+
 void CubismRenderer_Vulkan::RenderObject(csmInt32 objectIndex, csmInt32 objectType,
                                          VkCommandBuffer updateCommandBuffer, VkCommandBuffer drawCommandBuffer, const VkCommandBufferBeginInfo& beginInfo)
 {
@@ -3016,6 +3088,7 @@ void CubismRenderer_Vulkan::DrawOffscreen(CubismOffscreenRenderTarget_Vulkan* cu
     _currentOffscreen = parentOffscreen;
 
     csmInt32 offscreenIndex = currentOffscreen->GetOffscreenIndex();
+    const csmInt32 offscreenSection = BeginGpuTimingSection(CubismGpuTimer::SectionType_Offscreen, offscreenIndex);
 
     // クリッピングマスク
     CubismClippingContext_Vulkan* clipContext = (_offscreenClippingManager != NULL)
@@ -3101,12 +3174,16 @@ void CubismRenderer_Vulkan::DrawOffscreen(CubismOffscreenRenderTarget_Vulkan* cu
 
     // オフスクリーンテクスチャを親に描画
     DrawOffscreenVulkan(*GetModel(), currentOffscreen, clipContext, updateCommandBuffer, drawCommandBuffer);
+
+    EndGpuTimingSection(offscreenSection);
 }
 
 void CubismRenderer_Vulkan::DrawOffscreenVulkan(const CubismModel& model, CubismOffscreenRenderTarget_Vulkan* offscreen,
                                                 CubismClippingContext_Vulkan* clipContext,
                                                 VkCommandBuffer updateCommandBuffer, VkCommandBuffer drawCommandBuffer)
 {
+    CSM_PROFILE_ZONE(Zone_OffscreenComposite, &model);
+
     if (offscreen == NULL)
     {
         return;
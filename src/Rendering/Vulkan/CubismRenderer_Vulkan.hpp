@@ -9,6 +9,7 @@
 #include <string>
 #include "../CubismRenderer.hpp"
 #include "../CubismClippingManager.hpp"
+#include "../CubismGpuTimer.hpp"
 #include <vulkan/vulkan.h>
 #include "CubismFramework.hpp"
 #include "CubismRenderTarget_Vulkan.hpp"
@@ -48,6 +49,7 @@ VkRect2D GetScissor(csmFloat32 offsetX, csmFloat32 offsetY, csmFloat32 width, cs
 class CubismRenderer_Vulkan;
 class CubismClippingContext_Vulkan;
 class CubismDeviceInfo_Vulkan;
+class CubismGpuTimer_Vulkan;
 
 /**
  * @brief  クリッピングマスクの処理を実行するクラス
@@ -801,6 +803,14 @@ public:
      */
     CubismRenderTarget_Vulkan* GetDrawableMaskBuffer(csmUint32 backbufferNum, csmInt32 offscreenIndex);
 
+    /**
+     * @brief   GPUでの描画時間の最新の計測結果を取得する。<br>
+     *           グラフィックスキューでタイムスタンプを使えないデバイスでは結果は得られない。
+     *
+     * @return  計測結果。まだ結果がない場合は IsValid がfalse
+     */
+    const CubismGpuTimingStats& GetGpuTimingStats() const override;
+
 private:
 
     /**
@@ -958,6 +968,36 @@ private:
      */
     void EnsurePreviousRenderFinished(VkCommandBuffer commandBuffer, const CubismRenderTarget_Vulkan* nextRenderTarget);
 
+    /**
+     * @brief   GPUでの描画時間の計測を始める。<br>
+     *           計測が有効ならタイマーを用意し、無効になっていればタイマーを破棄する。
+     *
+     * @param[in]   drawCommandBuffer   -> タイムスタンプを記録するコマンドバッファ。レンダーパスの外で記録中であること
+     */
+    void BeginGpuTiming(VkCommandBuffer drawCommandBuffer);
+
+    /**
+     * @brief   GPUでの描画時間の計測を終える。
+     */
+    void EndGpuTiming();
+
+    /**
+     * @brief   GPUでの描画時間を計測する区間を開始する。
+     *
+     * @param[in]   type    -> 区間の種類
+     * @param[in]   index   -> オフスクリーンのインデックス。それ以外の区間では0
+     *
+     * @return  区間の番号。計測しない場合は-1
+     */
+    csmInt32 BeginGpuTimingSection(CubismGpuTimer::SectionType type, csmInt32 index);
+
+    /**
+     * @brief   GPUでの描画時間を計測する区間を終了する。
+     *
+     * @param[in]   section -> BeginGpuTimingSection() が返した区間の番号
+     */
+    void EndGpuTimingSection(csmInt32 section);
+
     CubismClippingContext_Vulkan* _clippingContextBufferForOffscreen; ///< オフスクリーン用クリッピングコンテキスト
     CubismOffscreenRenderTarget_Vulkan* _currentOffscreen; ///< 現在のオフスクリーン
     CubismRenderTarget_Vulkan* _currentRenderTarget; ///< 現在のレンダーターゲット
@@ -1016,6 +1056,8 @@ private:
     csmVector<VkCommandBuffer> _drawCommandBuffers; ///< 描画用コマンドバッファ
 
     csmBool _isClearedModelRenderTarget; ///< レンダーターゲットをクリアしたか
+
+    CubismGpuTimer_Vulkan* _gpuTimer; ///< GPUでの描画時間を計測するタイマー。計測していなければNULL
 };
 }}}}
 
@@ -9,6 +9,7 @@
 #include <stdlib.h>
 #include "Type/csmString.hpp"
 #include "CubismDebug.hpp"
+#include "CubismProfiler.hpp"
 
 using namespace std; // for strtof
 
@@ -471,6 +472,8 @@ Value* CubismJson::ParseValue(const csmChar* buffer, csmInt32 length, csmInt32 b
         return NULL;
     }
 
+    CSM_PROFILE_COUNT(Counter_JsonNodes, 1);
+
     Value* o = NULL;
     csmInt32 i = begin;
     csmFloat32 f;
@@ -0,0 +1,483 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismProfiler.hpp"
+
+#ifdef CSM_PROFILE
+
+#include "Type/csmVector.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Utils {
+
+namespace {
+    const csmChar* ZoneNames[] = {
+        "Motion",
+        "Expression",
+        "Updater",
+        "Physics",
+        "ModelUpdate",
+        "ClippingSetup",
+        "Draw",
+        "OffscreenComposite",
+    };
+
+    const csmChar* CounterNames[] = {
+        "drawCalls",
+        "stateChanges",
+        "vertexBytes",
+        "allocations",
+        "jsonNodes",
+    };
+
+    std::atomic<csmBool>                    s_isRunning(false);
+    std::mutex                              s_mutex;                                        ///< 記録の読み書きの排他
+    std::chrono::steady_clock::time_point   s_epoch;                                        ///< Startを呼んだ時刻
+    std::atomic<csmUint64>                  s_frameCounters[CubismProfiler::Counter_Count]; ///< 現在のフレームで数えた値
+    std::atomic<csmUint32>                  s_nextThreadId(1);                              ///< 次にスレッドに割り当てる識別子
+
+    CubismProfiler::ZoneRecord*     s_frameZones = NULL;            ///< 現在のフレームの処理
+    CubismProfiler::ZoneRecord*     s_completedZones = NULL;        ///< 計測を終えたフレームの処理。コールバックに渡す
+    csmUint32                       s_frameZoneCount = 0;           ///< 現在のフレームの処理の数
+    csmUint32                       s_droppedZoneCount = 0;         ///< 現在のフレームで記録できなかった処理の数
+
+    CubismProfiler::ZoneRecord*     s_zoneHistory = NULL;           ///< 処理のリングバッファ
+    csmUint32                       s_zoneCapacity = 0;             ///< 処理のリングバッファの容量
+    csmUint32                       s_zoneHead = 0;                 ///< 処理のリングバッファの最も古い位置
+    csmUint32                       s_zoneCount = 0;                ///< 処理のリングバッファに保持している数
+
+    CubismProfiler::FrameRecord*    s_frameHistory = NULL;          ///< フレームのリングバッファ
+    csmUint32                       s_frameCapacity = 0;            ///< フレームのリングバッファの容量
+    csmUint32                       s_frameHead = 0;                ///< フレームのリングバッファの最も古い位置
+    csmUint32                       s_frameCount = 0;               ///< フレームのリングバッファに保持している数
+
+    csmUint64                       s_frameIndex = 0;               ///< 現在のフレームの番号
+    csmUint64                       s_frameBeginMicroseconds = 0;   ///< 現在のフレームの開始時刻
+
+    CubismProfiler::FrameCallback   s_frameCallback = NULL;         ///< フレームの計測が終わったときに呼ぶ関数
+    void*                           s_frameCallbackUserData = NULL; ///< コールバックに渡す値
+
+    thread_local CubismProfileScope*    s_currentScope = NULL;      ///< このスレッドで最も内側の計測中のスコープ
+    thread_local csmUint32              s_threadId = 0;             ///< このスレッドの識別子。0は未割り当て
+
+    /**
+     * @brief   書式付き文字列を書き出し先に追加する
+     */
+    void AppendFormat(csmVector<csmChar>& buffer, const csmChar* format, ...)
+    {
+        csmChar text[256];
+        va_list va;
+        va_start(va, format);
+        const csmInt32 length = vsnprintf(text, sizeof(text), format, va);
+        va_end(va);
+
+        for (csmInt32 i = 0; i < length && i < static_cast<csmInt32>(sizeof(text)) - 1; ++i)
+        {
+            buffer.PushBack(text[i]);
+        }
+    }
+
+    /**
+     * @brief   JSONの文字列として書き出し先に追加する
+     */
+    void AppendJsonString(csmVector<csmChar>& buffer, const csmChar* str)
+    {
+        buffer.PushBack('"');
+        for (const csmChar* p = str; *p != '\0'; ++p)
+        {
+            if (*p == '"' || *p == '\\')
+            {
+                buffer.PushBack('\\');
+            }
+            buffer.PushBack(*p);
+        }
+        buffer.PushBack('"');
+    }
+
+    /**
+     * @brief   数えた値をJSONのオブジェクトのメンバとして書き出し先に追加する
+     */
+    void AppendCounters(csmVector<csmChar>& buffer, const csmUint64* counters)
+    {
+        for (csmInt32 i = 0; i < CubismProfiler::Counter_Count; ++i)
+        {
+            AppendFormat(buffer, "%s\"%s\":%llu", (i == 0) ? "" : ",", CounterNames[i], static_cast<unsigned long long>(counters[i]));
+        }
+    }
+}
+
+void CubismProfiler::Start(csmUint32 frameCapacity, csmUint32 zoneCapacity)
+{
+    Stop();
+
+    if (frameCapacity == 0 || zoneCapacity == 0)
+    {
+        CubismLogWarning("The capacity of the profiler must be greater than 0.");
+        return;
+    }
+
+    // 計測中に確保しないよう、記録先はまとめて確保しておく
+    s_frameZones = static_cast<ZoneRecord*>(CSM_MALLOC(sizeof(ZoneRecord) * zoneCapacity));
+    s_completedZones = static_cast<ZoneRecord*>(CSM_MALLOC(sizeof(ZoneRecord) * zoneCapacity));
+    s_zoneHistory = static_cast<ZoneRecord*>(CSM_MALLOC(sizeof(ZoneRecord) * zoneCapacity));
+    s_frameHistory = static_cast<FrameRecord*>(CSM_MALLOC(sizeof(FrameRecord) * frameCapacity));
+    if (s_frameZones == NULL || s_completedZones == NULL || s_zoneHistory == NULL || s_frameHistory == NULL)
+    {
+        CubismLogError("Failed to allocate the profiler buffers.");
+        Stop();
+        return;
+    }
+
+    s_zoneCapacity = zoneCapacity;
+    s_frameCapacity = frameCapacity;
+    s_frameZoneCount = 0;
+    s_droppedZoneCount = 0;
+    s_zoneHead = 0;
+    s_zoneCount = 0;
+    s_frameHead = 0;
+    s_frameCount = 0;
+    s_frameIndex = 0;
+    for (csmInt32 i = 0; i < Counter_Count; ++i)
+    {
+        s_frameCounters[i].store(0);
+    }
+
+    s_epoch = std::chrono::steady_clock::now();
+    s_frameBeginMicroseconds = 0;
+    s_isRunning.store(true);
+}
+
+void CubismProfiler::Stop()
+{
+    s_isRunning.store(false);
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    if (s_frameZones != NULL)
+    {
+        CSM_FREE(s_frameZones);
+        s_frameZones = NULL;
+    }
+    if (s_completedZones != NULL)
+    {
+        CSM_FREE(s_completedZones);
+        s_completedZones = NULL;
+    }
+    if (s_zoneHistory != NULL)
+    {
+        CSM_FREE(s_zoneHistory);
+        s_zoneHistory = NULL;
+    }
+    if (s_frameHistory != NULL)
+    {
+        CSM_FREE(s_frameHistory);
+        s_frameHistory = NULL;
+    }
+
+    s_zoneCapacity = 0;
+    s_frameCapacity = 0;
+    s_frameZoneCount = 0;
+    s_zoneCount = 0;
+    s_frameCount = 0;
+}
+
+csmBool CubismProfiler::IsRunning()
+{
+    return s_isRunning.load();
+}
+
+void CubismProfiler::EndFrame()
+{
+    if (!IsRunning())
+    {
+        return;
+    }
+
+    FrameRecord frame;
+    csmUint32 zoneCount;
+    FrameCallback callback;
+    void* userData;
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+
+        frame.FrameIndex = s_frameIndex;
+        frame.BeginMicroseconds = s_frameBeginMicroseconds;
+        frame.EndMicroseconds = GetMicroseconds();
+        for (csmInt32 i = 0; i < Counter_Count; ++i)
+        {
+            frame.Counters[i] = s_frameCounters[i].exchange(0);
+        }
+        frame.ZoneCount = s_frameZoneCount;
+        frame.DroppedZoneCount = s_droppedZoneCount;
+
+        // 記録中のバッファと入れ替え、コールバックの間も次のフレームを記録できるようにする
+        ZoneRecord* completedZones = s_frameZones;
+        s_frameZones = s_completedZones;
+        s_completedZones = completedZones;
+        zoneCount = s_frameZoneCount;
+        s_frameZoneCount = 0;
+        s_droppedZoneCount = 0;
+
+        // リングバッファに追加し、溢れた分は古いものから上書きする
+        for (csmUint32 i = 0; i < zoneCount; ++i)
+        {
+            s_completedZones[i].FrameIndex = frame.FrameIndex;
+            s_zoneHistory[(s_zoneHead + s_zoneCount) % s_zoneCapacity] = s_completedZones[i];
+            if (s_zoneCount < s_zoneCapacity)
+            {
+                ++s_zoneCount;
+            }
+            else
+            {
+                s_zoneHead = (s_zoneHead + 1) % s_zoneCapacity;
+            }
+        }
+
+        s_frameHistory[(s_frameHead + s_frameCount) % s_frameCapacity] = frame;
+        if (s_frameCount < s_frameCapacity)
+        {
+            ++s_frameCount;
+        }
+        else
+        {
+            s_frameHead = (s_frameHead + 1) % s_frameCapacity;
+        }
+
+        ++s_frameIndex;
+        s_frameBeginMicroseconds = frame.EndMicroseconds;
+
+        callback = s_frameCallback;
+        userData = s_frameCallbackUserData;
+    }
+
+    if (callback != NULL)
+    {
+        callback(frame, s_completedZones, zoneCount, userData);
+    }
+}
+
+void CubismProfiler::SetFrameCallback(FrameCallback callback, void* userData)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    s_frameCallback = callback;
+    s_frameCallbackUserData = userData;
+}
+
+csmUint32 CubismProfiler::GetFrameCount()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    return s_frameCount;
+}
+
+csmBool CubismProfiler::GetFrame(csmUint32 index, FrameRecord& frame)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    if (index >= s_frameCount)
+    {
+        return false;
+    }
+
+    frame = s_frameHistory[(s_frameHead + index) % s_frameCapacity];
+    return true;
+}
+
+csmBool CubismProfiler::GetModelStatistics(csmUint64 frameIndex, const void* model, csmUint64* zoneMicroseconds, csmUint64* counters)
+{
+    for (csmInt32 i = 0; i < Zone_Count; ++i)
+    {
+        zoneMicroseconds[i] = 0;
+    }
+    for (csmInt32 i = 0; i < Counter_Count; ++i)
+    {
+        counters[i] = 0;
+    }
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    csmBool isFound = false;
+    for (csmUint32 i = 0; i < s_zoneCount; ++i)
+    {
+        const ZoneRecord& zone = s_zoneHistory[(s_zoneHead + i) % s_zoneCapacity];
+        if (zone.FrameIndex != frameIndex || zone.Model != model)
+        {
+            continue;
+        }
+
+        zoneMicroseconds[zone.ZoneType] += zone.EndMicroseconds - zone.BeginMicroseconds;
+        for (csmInt32 j = 0; j < Counter_Count; ++j)
+        {
+            counters[j] += zone.Counters[j];
+        }
+        isFound = true;
+    }
+
+    return isFound;
+}
+
+void CubismProfiler::WriteChromeTrace(csmString& json)
+{
+    csmVector<csmChar> buffer;
+
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+
+        buffer.PrepareCapacity(static_cast<csmInt32>(s_zoneCount * 192 + s_frameCount * 256 + 64));
+        AppendFormat(buffer, "{\"traceEvents\":[");
+
+        csmBool isFirst = true;
+        for (csmUint32 i = 0; i < s_frameCount; ++i)
+        {
+            const FrameRecord& frame = s_frameHistory[(s_frameHead + i) % s_frameCapacity];
+
+            // フレームはスレッド0の区間として、数えた値はカウンタとして出力する
+            AppendFormat(buffer, "%s{\"name\":\"Frame\",\"cat\":\"cubism\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":%llu,\"dur\":%llu,\"args\":{\"frame\":%llu,",
+                         isFirst ? "" : ",",
+                         static_cast<unsigned long long>(frame.BeginMicroseconds),
+                         static_cast<unsigned long long>(frame.EndMicroseconds - frame.BeginMicroseconds),
+                         static_cast<unsigned long long>(frame.FrameIndex));
+            AppendCounters(buffer, frame.Counters);
+            AppendFormat(buffer, "}},{\"name\":\"Counters\",\"cat\":\"cubism\",\"ph\":\"C\",\"pid\":0,\"ts\":%llu,\"args\":{",
+                         static_cast<unsigned long long>(frame.EndMicroseconds));
+            AppendCounters(buffer, frame.Counters);
+            AppendFormat(buffer, "}}");
+            isFirst = false;
+        }
+
+        for (csmUint32 i = 0; i < s_zoneCount; ++i)
+        {
+            const ZoneRecord& zone = s_zoneHistory[(s_zoneHead + i) % s_zoneCapacity];
+
+            AppendFormat(buffer, "%s{\"name\":", isFirst ? "" : ",");
+            AppendJsonString(buffer, (zone.Name != NULL) ? zone.Name : ZoneNames[zone.ZoneType]);
+            AppendFormat(buffer, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%llu,\"dur\":%llu,\"args\":{\"frame\":%llu,\"model\":\"%p\",",
+                         ZoneNames[zone.ZoneType],
+                         zone.ThreadId,
+                         static_cast<unsigned long long>(zone.BeginMicroseconds),
+                         static_cast<unsigned long long>(zone.EndMicroseconds - zone.BeginMicroseconds),
+                         static_cast<unsigned long long>(zone.FrameIndex),
+                         zone.Model);
+            AppendCounters(buffer, zone.Counters);
+            AppendFormat(buffer, "}}");
+            isFirst = false;
+        }
+
+        AppendFormat(buffer, "]}");
+    }
+
+    json = csmString(buffer.GetPtr(), static_cast<csmInt32>(buffer.GetSize()));
+}
+
+void CubismProfiler::AddCounter(Counter counter, csmUint64 value)
+{
+    if (!IsRunning())
+    {
+        return;
+    }
+
+    s_frameCounters[counter].fetch_add(value, std::memory_order_relaxed);
+
+    // モデル単位で集計できるよう、計測中の処理にも加える
+    if (s_currentScope != NULL)
+    {
+        s_currentScope->_record.Counters[counter] += value;
+    }
+}
+
+const csmChar* CubismProfiler::GetZoneName(Zone zone)
+{
+    return (zone >= 0 && zone < Zone_Count) ? ZoneNames[zone] : "";
+}
+
+const csmChar* CubismProfiler::GetCounterName(Counter counter)
+{
+    return (counter >= 0 && counter < Counter_Count) ? CounterNames[counter] : "";
+}
+
+void CubismProfiler::PushZone(const ZoneRecord& record)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    if (s_frameZones == NULL)
+    {
+        return;
+    }
+
+    if (s_frameZoneCount < s_zoneCapacity)
+    {
+        s_frameZones[s_frameZoneCount++] = record;
+    }
+    else
+    {
+        ++s_droppedZoneCount;
+    }
+}
+
+csmUint64 CubismProfiler::GetMicroseconds()
+{
+    return static_cast<csmUint64>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_epoch).count());
+}
+
+csmUint32 CubismProfiler::GetThreadId()
+{
+    if (s_threadId == 0)
+    {
+        s_threadId = s_nextThreadId.fetch_add(1);
+    }
+    return s_threadId;
+}
+
+CubismProfileScope::CubismProfileScope(CubismProfiler::Zone zone, const void* model, const csmChar* name)
+    : _parent(NULL)
+    , _isActive(CubismProfiler::IsRunning())
+{
+    if (!_isActive)
+    {
+        return;
+    }
+
+    _record.ZoneType = zone;
+    _record.Name = name;
+    _record.Model = model;
+    _record.FrameIndex = 0;
+    _record.ThreadId = CubismProfiler::GetThreadId();
+    for (csmInt32 i = 0; i < CubismProfiler::Counter_Count; ++i)
+    {
+        _record.Counters[i] = 0;
+    }
+
+    _parent = s_currentScope;
+    s_currentScope = this;
+    _record.BeginMicroseconds = CubismProfiler::GetMicroseconds();
+}
+
+CubismProfileScope::~CubismProfileScope()
+{
+    if (!_isActive)
+    {
+        return;
+    }
+
+    _record.EndMicroseconds = CubismProfiler::GetMicroseconds();
+    s_currentScope = _parent;
+
+    CubismProfiler::PushZone(_record);
+}
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------
+
+#endif
@@ -0,0 +1,260 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+#include "Type/csmString.hpp"
+
+/**
+ * 計測用のマクロ<br>
+ * CSM_PROFILE が定義されていない場合は何も展開されず、計測のコストはかからない。
+ */
+#ifdef CSM_PROFILE
+#define CSM_PROFILE_CONCAT_INNER(a, b)              a##b
+#define CSM_PROFILE_CONCAT(a, b)                    CSM_PROFILE_CONCAT_INNER(a, b)
+#define CSM_PROFILE_ZONE(zone, model)               Live2D::Cubism::Framework::Utils::CubismProfileScope CSM_PROFILE_CONCAT(csmProfileScope, __LINE__)(Live2D::Cubism::Framework::Utils::CubismProfiler::zone, model, NULL)
+#define CSM_PROFILE_NAMED_ZONE(zone, model, name)   Live2D::Cubism::Framework::Utils::CubismProfileScope CSM_PROFILE_CONCAT(csmProfileScope, __LINE__)(Live2D::Cubism::Framework::Utils::CubismProfiler::zone, model, name)
+#define CSM_PROFILE_COUNT(counter, value)           Live2D::Cubism::Framework::Utils::CubismProfiler::AddCounter(Live2D::Cubism::Framework::Utils::CubismProfiler::counter, value)
+#else
+#define CSM_PROFILE_ZONE(zone, model)
+#define CSM_PROFILE_NAMED_ZONE(zone, model, name)
+#define CSM_PROFILE_COUNT(counter, value)
+#endif
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Utils {
+
+//  前方宣言
+class CubismProfileScope;
+
+/**
+ * @brief   フレーム内の処理ごとの時間と回数を計測するクラス<br>
+ *          フレームワーク内の計測箇所は CSM_PROFILE を定義してビルドした場合にだけ有効になる。<br>
+ *          計測結果はフレームごとにまとめ、コールバックとリングバッファで受け取れる。
+ */
+class CubismProfiler
+{
+    friend class CubismProfileScope;
+
+public:
+    /**
+     * @brief   計測する処理の種類
+     */
+    enum Zone
+    {
+        Zone_Motion,                ///< モーションの更新
+        Zone_Expression,            ///< 表情の更新
+        Zone_Updater,               ///< ICubismUpdaterの更新
+        Zone_Physics,               ///< 物理演算の評価
+        Zone_ModelUpdate,           ///< Coreによるモデルの更新
+        Zone_ClippingSetup,         ///< クリッピングマスクの生成
+        Zone_Draw,                  ///< モデルの描画
+        Zone_OffscreenComposite,    ///< オフスクリーンの合成
+        Zone_Count,                 ///< 種類の数
+    };
+
+    /**
+     * @brief   数える項目
+     */
+    enum Counter
+    {
+        Counter_DrawCalls,          ///< 描画命令の回数
+        Counter_StateChanges,       ///< シェーダ・描画先などの切り替えの回数
+        Counter_VertexBytes,        ///< 描画で送った頂点とインデックスのバイト数
+        Counter_Allocations,        ///< フレームワークのアロケータでの確保の回数
+        Counter_JsonNodes,          ///< 解析したJSONの値の数
+        Counter_Count,              ///< 項目の数
+    };
+
+    /**
+     * @brief   1回分の処理の計測結果
+     */
+    struct ZoneRecord
+    {
+        Zone            ZoneType;                   ///< 処理の種類
+        const csmChar*  Name;                       ///< 詳細な名前。NULLの場合は処理の種類の名前を使う
+        const void*     Model;                      ///< 対象のモデル。モデルに依存しない場合はNULL
+        csmUint64       FrameIndex;                 ///< 計測したフレームの番号
+        csmUint64       BeginMicroseconds;          ///< 開始時刻（Start呼び出しからのマイクロ秒）
+        csmUint64       EndMicroseconds;            ///< 終了時刻（Start呼び出しからのマイクロ秒）
+        csmUint32       ThreadId;                   ///< 計測したスレッドの識別子
+        csmUint64       Counters[Counter_Count];    ///< 処理中に数えた値。入れ子の処理の分は含まない
+    };
+
+    /**
+     * @brief   1フレーム分の計測結果
+     */
+    struct FrameRecord
+    {
+        csmUint64       FrameIndex;                 ///< フレームの番号
+        csmUint64       BeginMicroseconds;          ///< 開始時刻（Start呼び出しからのマイクロ秒）
+        csmUint64       EndMicroseconds;            ///< 終了時刻（Start呼び出しからのマイクロ秒）
+        csmUint64       Counters[Counter_Count];    ///< フレーム全体で数えた値
+        csmUint32       ZoneCount;                  ///< 記録した処理の数
+        csmUint32       DroppedZoneCount;           ///< 容量を超えて記録できなかった処理の数
+    };
+
+    /**
+     * @brief   フレームの計測が終わったときに呼ばれる関数
+     *
+     * @param[in]   frame       ->  フレームの計測結果
+     * @param[in]   zones       ->  フレーム内の処理の計測結果の配列
+     * @param[in]   zoneCount   ->  処理の計測結果の数
+     * @param[in]   userData    ->  SetFrameCallbackで渡した値
+     */
+    typedef void (*FrameCallback)(const FrameRecord& frame, const ZoneRecord* zones, csmUint32 zoneCount, void* userData);
+
+    /**
+     * @brief   計測を開始する<br>
+     *          計測中の処理がない状態で呼ぶこと
+     *
+     * @param[in]   frameCapacity   ->  保持するフレームの数
+     * @param[in]   zoneCapacity    ->  保持する処理の数。1フレームで記録できる処理の数も兼ねる
+     */
+    static void Start(csmUint32 frameCapacity = 120, csmUint32 zoneCapacity = 16384);
+
+    /**
+     * @brief   計測を終了し、保持している結果を破棄する<br>
+     *          計測中の処理がない状態で呼ぶこと
+     */
+    static void Stop();
+
+    /**
+     * @brief   計測中か
+     *
+     * @return  計測中であればtrue
+     */
+    static csmBool IsRunning();
+
+    /**
+     * @brief   フレームを区切る<br>
+     *          前回の呼び出し（初回はStart）からの計測結果を1フレームとしてまとめ、コールバックを呼ぶ。<br>
+     *          複数のスレッドから同時に呼ばないこと
+     */
+    static void EndFrame();
+
+    /**
+     * @brief   フレームの計測が終わったときに呼ぶ関数を設定する<br>
+     *          コールバックの中から計測結果を取得する関数を呼んでもよい
+     *
+     * @param[in]   callback    ->  呼ぶ関数。NULLの場合は呼ばない
+     * @param[in]   userData    ->  関数に渡す値
+     */
+    static void SetFrameCallback(FrameCallback callback, void* userData);
+
+    /**
+     * @brief   保持しているフレームの数を取得する
+     *
+     * @return  フレームの数
+     */
+    static csmUint32 GetFrameCount();
+
+    /**
+     * @brief   保持しているフレームの計測結果を取得する
+     *
+     * @param[in]   index   ->  古い順のインデックス
+     * @param[out]  frame   ->  フレームの計測結果
+     *
+     * @return  取得できた場合はtrue
+     */
+    static csmBool GetFrame(csmUint32 index, FrameRecord& frame);
+
+    /**
+     * @brief   フレーム内の指定のモデルの計測結果を集計する<br>
+     *          処理の時間は種類ごとの合計で、入れ子の処理の時間を含む。数えた値はモデルの処理全体の合計
+     *
+     * @param[in]   frameIndex          ->  フレームの番号
+     * @param[in]   model               ->  対象のモデル
+     * @param[out]  zoneMicroseconds    ->  処理の種類ごとの時間（Zone_Count個）
+     * @param[out]  counters            ->  数えた値（Counter_Count個）
+     *
+     * @return  フレームにモデルの計測結果があった場合はtrue
+     */
+    static csmBool GetModelStatistics(csmUint64 frameIndex, const void* model, csmUint64* zoneMicroseconds, csmUint64* counters);
+
+    /**
+     * @brief   保持している計測結果をChromeのトレース形式（chrome://tracing, Perfetto）のJSONで書き出す
+     *
+     * @param[out]  json    ->  書き出したJSON
+     */
+    static void WriteChromeTrace(csmString& json);
+
+    /**
+     * @brief   値を数える<br>
+     *          計測中でない場合は何もしない
+     *
+     * @param[in]   counter ->  数える項目
+     * @param[in]   value   ->  加える値
+     */
+    static void AddCounter(Counter counter, csmUint64 value);
+
+    /**
+     * @brief   処理の種類の名前を取得する
+     */
+    static const csmChar* GetZoneName(Zone zone);
+
+    /**
+     * @brief   数える項目の名前を取得する
+     */
+    static const csmChar* GetCounterName(Counter counter);
+
+private:
+    /**
+     * @brief   計測を終えた処理を現在のフレームに記録する
+     */
+    static void PushZone(const ZoneRecord& record);
+
+    /**
+     * @brief   Start呼び出しからの経過時間をマイクロ秒で取得する
+     */
+    static csmUint64 GetMicroseconds();
+
+    /**
+     * @brief   呼び出したスレッドの識別子を取得する
+     */
+    static csmUint32 GetThreadId();
+
+    CubismProfiler();
+};
+
+/**
+ * @brief   スコープの間の時間を計測するクラス<br>
+ *          通常は CSM_PROFILE_ZONE マクロを通して使用する
+ */
+class CubismProfileScope
+{
+    friend class CubismProfiler;
+
+public:
+    /**
+     * @brief   コンストラクタ。計測を開始する
+     *
+     * @param[in]   zone    ->  処理の種類
+     * @param[in]   model   ->  対象のモデル。モデルに依存しない場合はNULL
+     * @param[in]   name    ->  詳細な名前。文字列は計測結果を破棄するまで有効であること
+     */
+    CubismProfileScope(CubismProfiler::Zone zone, const void* model, const csmChar* name);
+
+    /**
+     * @brief   デストラクタ。計測を終了して記録する
+     */
+    ~CubismProfileScope();
+
+private:
+    // Prevention of copy Constructor
+    CubismProfileScope(const CubismProfileScope&);
+    CubismProfileScope& operator=(const CubismProfileScope&);
+
+    CubismProfiler::ZoneRecord  _record;        ///< 計測結果
+    CubismProfileScope*         _parent;        ///< 外側で計測中のスコープ
+    csmBool                     _isActive;      ///< 計測しているか
+};
+
+}}}}
+
+//------------ LIVE2D NAMESPACE ------------